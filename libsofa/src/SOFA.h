@@ -78,6 +78,34 @@ http://www.sofaconventions.org
 #include "../src/SOFAUnits.h"
 #include "../src/SOFAVersion.h"
 #include "../src/SOFAHelper.h"
+#include "../src/SOFAGeometry.h"
+#include "../src/SOFAFIRDataSet.h"
+#include "../src/SOFAParallel.h"
+#include "../src/SOFASphericalHarmonics.h"
+#include "../src/SOFAFileWriter.h"
+#include "../src/SOFAGridResampler.h"
+#include "../src/SOFAMultiRadiusInterpolator.h"
+#include "../src/SOFASymmetricFIRDataSet.h"
+#include "../src/SOFAFFT.h"
+#include "../src/SOFABinauralConvolver.h"
+#include "../src/SOFANonUniformConvolver.h"
+#include "../src/SOFARoomConvolver.h"
+#include "../src/SOFADirectFilterBank.h"
+#include "../src/SOFAMinimumPhase.h"
+#include "../src/SOFAFractionalDelayLine.h"
+#include "../src/SOFASampleRateConverter.h"
+#include "../src/SOFAImpulseResponseTrimmer.h"
+#include "../src/SOFAMultiSourceRenderer.h"
+#include "../src/SOFABiquadFilterBank.h"
+#include "../src/SOFATransferFunctionConverter.h"
+#include "../src/SOFASOSConverter.h"
+#include "../src/SOFAHeadTrackedBRIR.h"
+#include "../src/SOFAVirtualLoudspeakerRenderer.h"
+#include "../src/SOFAEarlyLateDecomposition.h"
+#include "../src/SOFAArrayBeamformer.h"
+#include "../src/SOFAAmbisonicEncoder.h"
+#include "../src/SOFAPositionIndex.h"
+#include "../src/SOFANavigationRenderer.h"
 
 //==============================================================================
 /// private files
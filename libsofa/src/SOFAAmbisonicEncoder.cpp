@@ -0,0 +1,615 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAAmbisonicEncoder.cpp
+ *   @brief      Ambisonic encoding of the DRIRs of spherical microphone arrays
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAAmbisonicEncoder.h"
+#include "../src/SOFAFractionalDelayLine.h"
+#include "../src/SOFASphericalHarmonics.h"
+#include "../src/SOFAGeometry.h"
+#include "../src/SOFALinearAlgebra.h"
+#include "../src/SOFAParallel.h"
+#include "../src/SOFAFFT.h"
+#include "../src/SOFAExceptions.h"
+#include <algorithm>
+#include <complex>
+#include <cmath>
+
+using namespace sofa;
+
+namespace AmbisonicEncoderLocal
+{
+    const double kPi = 3.14159265358979323846;
+
+    /// largest deviation of the receiver distances from the array radius (relative)
+    const double kRadiusTolerance = 0.01;
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Spherical Bessel functions of the first and second kinds, j_n( x )
+     *                  and y_n( x ) for n in [ 0 order ], x > 0
+     *
+     *  @details        y_n is computed by upward recurrence. So is j_n when x > order ;
+     *                  otherwise, where the upward recurrence is unstable, its power series
+     *                  is summed.
+     */
+    /************************************************************************************/
+    inline void sphericalBessel(double *j,
+                                double *y,
+                                const unsigned int order,
+                                const double x)
+    {
+        const double s = std::sin( x );
+        const double c = std::cos( x );
+
+        y[0] = -c / x;
+        if( order >= 1 )
+        {
+            y[1] = -c / ( x * x ) - s / x;
+        }
+        for( unsigned int n = 2; n <= order; n++ )
+        {
+            y[n] = ( 2.0 * n - 1.0 ) / x * y[ n - 1 ] - y[ n - 2 ];
+        }
+
+        if( x > static_cast< double >( order ) )
+        {
+            j[0] = s / x;
+            if( order >= 1 )
+            {
+                j[1] = s / ( x * x ) - c / x;
+            }
+            for( unsigned int n = 2; n <= order; n++ )
+            {
+                j[n] = ( 2.0 * n - 1.0 ) / x * j[ n - 1 ] - j[ n - 2 ];
+            }
+        }
+        else
+        {
+            /// j_n( x ) = x^n / (2n+1)!! sum_k ( -x^2/2 )^k / ( k! (2n+3) (2n+5) ... (2n+2k+1) )
+            double leading = 1.0;
+
+            for( unsigned int n = 0; n <= order; n++ )
+            {
+                if( n > 0 )
+                {
+                    leading *= x / ( 2.0 * n + 1.0 );
+                }
+
+                double term = 1.0;
+                double sum  = 1.0;
+
+                for( unsigned int k = 1; k < 100 && std::abs( term ) > 1e-17 * std::abs( sum ); k++ )
+                {
+                    term *= -0.5 * x * x / ( k * ( 2.0 * n + 2.0 * k + 1.0 ) );
+                    sum  += term;
+                }
+
+                j[n] = leading * sum;
+            }
+        }
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Mode strengths d_n( kr ), n in [ 0 order ] : a plane wave from u gives
+     *                  the pressure coefficients 4 pi d_n Y_nm( u ) (orthonormal harmonics)
+     *
+     *  @details        Open sphere : i^n j_n( kr ). Rigid sphere : i^n ( j_n - j_n' h_n / h_n' )
+     *                  = i^n ( -i ) / ( (kr)^2 h_n'( kr ) ), h_n = j_n - i y_n being the
+     *                  outgoing Hankel function for the exp( +i w t ) convention of the DFT.
+     */
+    /************************************************************************************/
+    inline void modeStrengths(std::complex< double > *d,
+                              const unsigned int order,
+                              const double x,
+                              const bool rigid)
+    {
+        if( x <= 0.0 )
+        {
+            d[0] = 1.0;
+            std::fill( d + 1, d + order + 1, std::complex< double >( 0.0 ) );
+            return;
+        }
+
+        std::vector< double > j( order + 2 );
+        std::vector< double > y( order + 2 );
+
+        sphericalBessel( &j[0], &y[0], order + 1, x );
+
+        std::complex< double > power( 1.0, 0.0 );   ///< i^n
+
+        for( unsigned int n = 0; n <= order; n++ )
+        {
+            if( rigid == false )
+            {
+                d[n] = power * j[n];
+            }
+            else
+            {
+                /// f_n' = n / x f_n - f_{n+1}
+                const double jd = n / x * j[n] - j[ n + 1 ];
+                const double yd = n / x * y[n] - y[ n + 1 ];
+
+                d[n] = power * std::complex< double >( 0.0, -1.0 ) / ( x * x * std::complex< double >( jd, -yd ) );
+            }
+
+            power *= std::complex< double >( 0.0, 1.0 );
+        }
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Delays IRs [ K N ] into filters [ K length ] (fractional delays are
+     *                  interpolated)
+     *
+     */
+    /************************************************************************************/
+    inline void applyDelays(double *filters,
+                            const double *irs,
+                            const double *delays,
+                            const std::size_t numChannels,
+                            const std::size_t numDataSamples,
+                            const std::size_t length)
+    {
+        for( std::size_t k = 0; k < numChannels; k++ )
+        {
+            sofa::dsp::FractionalDelayLine::ApplyDelay( filters + k * length, length, irs + k * numDataSamples, numDataSamples, delays[k] );
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+AmbisonicEncoder::AmbisonicEncoder()
+: arrayType( kRigidSphere )
+, maxRadialGain( 20.0 )
+, radialFilterLength( 1024 )
+, speedOfSound( 343.0 )
+, order( 0 )
+, numMeasurements( 0 )
+, numReceivers( 0 )
+, responseLength( 0 )
+, latency( 0 )
+, samplingRate( 0.0 )
+, arrayRadius( 0.0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the acoustic model of the array (default rigid sphere)
+ *
+ */
+/************************************************************************************/
+void AmbisonicEncoder::SetArrayType(const sofa::AmbisonicEncoder::ArrayType type)
+{
+    arrayType = type;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Upper bound of the gain of the radial filters (default 20 dB)
+ *
+ */
+/************************************************************************************/
+void AmbisonicEncoder::SetMaxRadialGain(const double decibels)
+{
+    maxRadialGain = std::max( 0.0, decibels );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Length of the radial filters, rounded up to a power of two
+ *                  (default 1024 samples)
+ *
+ */
+/************************************************************************************/
+void AmbisonicEncoder::SetRadialFilterLength(const unsigned int length)
+{
+    radialFilterLength = sofa::dsp::FFT::NextPowerOfTwo( std::max( 4u, length ) );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Speed of sound used for the mode strengths (default 343 m/s)
+ *
+ */
+/************************************************************************************/
+void AmbisonicEncoder::SetSpeedOfSound(const double metersPerSecond)
+{
+    if( metersPerSecond > 0.0 )
+    {
+        speedOfSound = metersPerSecond;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the Ambisonic responses of all the measurements
+ *  @param[in]      file : the DRIRs of a spherical array
+ *  @param[in]      order_ : Ambisonic order
+ *  @param[in]      regularization : Tikhonov weight of the spherical-harmonic fit, relative
+ *                  to the mean energy of the basis
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool AmbisonicEncoder::Compute(const sofa::SingleRoomDRIR &file,
+                               const unsigned int order_,
+                               const double regularization)
+{
+    using namespace AmbisonicEncoderLocal;
+
+    const long M = file.GetNumMeasurements();
+    const long R = file.GetNumReceivers();
+    const long N = file.GetNumDataSamples();
+
+    const std::size_t K = sofa::SphericalHarmonics::GetNumCoefficients( order_ );
+
+    double fs = 0.0;
+    std::vector< double > dataIR;
+    std::vector< double > delay;
+
+    if( M <= 0 || R <= 0 || N <= 0
+       || file.GetSamplingRate( fs ) == false
+       || file.GetDataIR( dataIR ) == false
+       || file.GetDataDelay( delay ) == false )
+    {
+        SOFA_THROW( "cannot read the DRIRs" );
+        return false;
+    }
+
+    //==============================================================================
+    /// receiver directions and radius : ReceiverPosition [ R C I ]
+    sofa::Coordinates::Type coordinates;
+    sofa::Units::Type units;
+
+    std::vector< double > values;
+    std::vector< std::size_t > dims;
+
+    if( file.GetReceiverPosition( coordinates, units ) == false
+       || file.GetValues( values, "ReceiverPosition" ) == false )
+    {
+        SOFA_THROW( "cannot read 'ReceiverPosition'" );
+        return false;
+    }
+
+    file.GetVariableDimensions( dims, "ReceiverPosition" );
+
+    if( dims.size() != 3 || dims[0] != static_cast< std::size_t >( R ) || dims[1] != 3 || dims[2] != 1 )
+    {
+        SOFA_THROW( "the receiver positions shall be the same for all the measurements" );
+        return false;
+    }
+
+    std::vector< double > directions;
+    sofa::Geometry::ToCartesian( directions, values, coordinates );
+
+    std::vector< double > distances( R );
+    double radius = 0.0;
+
+    for( long r = 0; r < R; r++ )
+    {
+        distances[r] = sofa::Geometry::Normalize( &directions[ 3 * r ] );
+        radius += distances[r] / R;
+    }
+
+    for( long r = 0; r < R; r++ )
+    {
+        if( radius <= 0.0 || std::abs( distances[r] - radius ) > kRadiusTolerance * radius )
+        {
+            SOFA_THROW( "the receivers are not on a sphere centered on the listener" );
+            return false;
+        }
+    }
+
+    /// Data.Delay is [ I R ] or [ M R ], rounded to the sample
+    const bool delayVaries = ( delay.size() == static_cast< std::size_t >( M * R ) );
+
+    if( delayVaries == false && delay.size() != static_cast< std::size_t >( R ) )
+    {
+        SOFA_THROW( "invalid 'Data.Delay' dimensions" );
+        return false;
+    }
+
+    std::vector< double > delays( M * R );
+    std::size_t length = N;
+
+    for( std::size_t i = 0; i < delays.size(); i++ )
+    {
+        delays[i] = delay[ ( delayVaries == true ) ? i : i % R ];
+        length    = std::max( length, sofa::dsp::FractionalDelayLine::GetDelayedLength( N, delays[i] ) );
+    }
+
+    //==============================================================================
+    /// spatial encoding : P [ K R ], the regularized fit over the receiver directions
+    const sofa::SphericalHarmonicDecomposition::Matrix fitMatrix = sofa::SphericalHarmonicDecomposition::GetFitMatrix( directions, order_, regularization );
+
+    //==============================================================================
+    /// radial filters : regularized inverse of the mode strengths, linear phase
+    const unsigned int L = radialFilterLength;
+    const std::size_t bins = L / 2 + 1;
+
+    /// conj( d ) / ( |d|^2 + mu^2 ) is at most 1 / ( 2 mu )
+    const double mu = 0.5 / std::pow( 10.0, maxRadialGain / 20.0 );
+
+    std::vector< float > filterRe( ( order_ + 1 ) * bins );
+    std::vector< float > filterIm( ( order_ + 1 ) * bins );
+
+    sofa::Parallel::For( 0, bins, [ & ]( const std::size_t first, const std::size_t last )
+    {
+        std::vector< std::complex< double > > d( order_ + 1 );
+
+        for( std::size_t k = first; k < last; k++ )
+        {
+            const double kr = 2.0 * kPi * k * fs / L * radius / speedOfSound;
+
+            modeStrengths( &d[0], order_, kr, arrayType == kRigidSphere );
+
+            /// delay of L/2 samples
+            const double sign = ( k % 2 == 0 ) ? 1.0 : -1.0;
+
+            for( unsigned int n = 0; n <= order_; n++ )
+            {
+                const std::complex< double > h = sign * std::conj( d[n] ) / ( std::norm( d[n] ) + mu * mu );
+
+                filterRe[ n * bins + k ] = static_cast< float >( h.real() );
+                filterIm[ n * bins + k ] = static_cast< float >( h.imag() );
+            }
+        }
+    } );
+
+    std::vector< double > newRadialFilters( ( order_ + 1 ) * L );
+
+    {
+        sofa::dsp::FFT fft( L );
+        std::vector< float > time( L );
+
+        for( unsigned int n = 0; n <= order_; n++ )
+        {
+            fft.Inverse( &time[0], &filterRe[ n * bins ], &filterIm[ n * bins ] );
+
+            /// Hann window centered on the delay
+            for( unsigned int i = 0; i < L; i++ )
+            {
+                const double window = 0.5 - 0.5 * std::cos( 2.0 * kPi * i / L );
+                newRadialFilters[ n * L + i ] = window * time[i];
+            }
+        }
+    }
+
+    //==============================================================================
+    /// spectra of the radial filters for the convolution
+    const std::size_t newResponseLength = length + L - 1;
+
+    const unsigned int F = sofa::dsp::FFT::NextPowerOfTwo( static_cast< unsigned int >( newResponseLength ) );
+    const std::size_t B  = F / 2 + 1;
+
+    std::vector< float > radialRe( ( order_ + 1 ) * B );
+    std::vector< float > radialIm( ( order_ + 1 ) * B );
+
+    {
+        sofa::dsp::FFT fft( F );
+        std::vector< float > time( F, 0.0f );
+
+        for( unsigned int n = 0; n <= order_; n++ )
+        {
+            for( unsigned int i = 0; i < L; i++ )
+            {
+                time[i] = static_cast< float >( newRadialFilters[ n * L + i ] );
+            }
+
+            fft.Forward( &radialRe[ n * B ], &radialIm[ n * B ], &time[0] );
+        }
+    }
+
+    //==============================================================================
+    /// encoding of each measurement
+    std::vector< double > newResponses( M * K * newResponseLength );
+
+    /// N3D responses : sqrt( 4 pi ) Y_nm( u ) = ( 4 pi d_n Y_nm( u ) ) / ( sqrt( 4 pi ) d_n )
+    const double gain = 1.0 / std::sqrt( 4.0 * kPi );
+
+    std::vector< double > filters( R * length );
+    std::vector< double > encoded( K * length );
+
+    for( long m = 0; m < M; m++ )
+    {
+        applyDelays( &filters[0], &dataIR[ m * R * N ], &delays[ m * R ], R, N, length );
+
+        /// [ K length ] = P [ K R ] x [ R length ]
+        sofa::LinearAlgebra::Gemm( &encoded[0], &( *fitMatrix )[0], &filters[0], K, R, length );
+
+        sofa::Parallel::For( 0, K, [ & ]( const std::size_t first, const std::size_t last )
+        {
+            sofa::dsp::FFT fft( F );
+
+            std::vector< float > time( F );
+            std::vector< float > re( B );
+            std::vector< float > im( B );
+
+            for( std::size_t k = first; k < last; k++ )
+            {
+                const unsigned int n = static_cast< unsigned int >( std::floor( std::sqrt( static_cast< double >( k ) ) ) );
+
+                std::fill( time.begin(), time.end(), 0.0f );
+                for( std::size_t i = 0; i < length; i++ )
+                {
+                    time[i] = static_cast< float >( gain * encoded[ k * length + i ] );
+                }
+
+                fft.Forward( &re[0], &im[0], &time[0] );
+
+                const float *hRe = &radialRe[ n * B ];
+                const float *hIm = &radialIm[ n * B ];
+
+                for( std::size_t b = 0; b < B; b++ )
+                {
+                    const float xRe = re[b];
+                    const float xIm = im[b];
+
+                    re[b] = xRe * hRe[b] - xIm * hIm[b];
+                    im[b] = xRe * hIm[b] + xIm * hRe[b];
+                }
+
+                fft.Inverse( &time[0], &re[0], &im[0] );
+
+                double *response = &newResponses[ ( m * K + k ) * newResponseLength ];
+
+                for( std::size_t i = 0; i < newResponseLength; i++ )
+                {
+                    response[i] = static_cast< double >( time[i] );
+                }
+            }
+        } );
+    }
+
+    order           = order_;
+    numMeasurements = M;
+    numReceivers    = R;
+    responseLength  = newResponseLength;
+    latency         = L / 2;
+    samplingRate    = fs;
+    arrayRadius     = radius;
+
+    radialFilters.swap( newRadialFilters );
+    responses.swap( newResponses );
+
+    return true;
+}
+
+unsigned int AmbisonicEncoder::GetOrder() const
+{
+    return order;
+}
+
+unsigned int AmbisonicEncoder::GetNumCoefficients() const
+{
+    return sofa::SphericalHarmonics::GetNumCoefficients( order );
+}
+
+unsigned long AmbisonicEncoder::GetNumMeasurements() const
+{
+    return numMeasurements;
+}
+
+unsigned long AmbisonicEncoder::GetNumReceivers() const
+{
+    return numReceivers;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Length of the responses : Data.IR plus the largest Data.Delay plus the
+ *                  length of the radial filters minus one
+ *
+ */
+/************************************************************************************/
+unsigned long AmbisonicEncoder::GetResponseLength() const
+{
+    return responseLength;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Delay of the radial filters, in samples (half their length)
+ *
+ */
+/************************************************************************************/
+unsigned long AmbisonicEncoder::GetLatency() const
+{
+    return latency;
+}
+
+double AmbisonicEncoder::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Mean distance between the receivers and the listener, in meters
+ *
+ */
+/************************************************************************************/
+double AmbisonicEncoder::GetArrayRadius() const
+{
+    return arrayRadius;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Ambisonic response of one measurement
+ *  @param[in]      coefficient : ACN index, in [ 0 (order+1)^2 [
+ *  @return         responseLength samples
+ *
+ */
+/************************************************************************************/
+const double * AmbisonicEncoder::GetResponse(const unsigned long measurement,
+                                             const unsigned int coefficient) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && coefficient < GetNumCoefficients() );
+
+    return &responses[ ( measurement * GetNumCoefficients() + coefficient ) * responseLength ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Radial filter of one order
+ *  @return         2 * latency samples
+ *
+ */
+/************************************************************************************/
+const double * AmbisonicEncoder::GetRadialFilter(const unsigned int n) const
+{
+    SOFA_ASSERT( n <= order );
+
+    return &radialFilters[ n * 2 * latency ];
+}
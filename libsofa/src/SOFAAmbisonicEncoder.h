@@ -0,0 +1,145 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAAmbisonicEncoder.h
+ *   @brief      Ambisonic encoding of the DRIRs of spherical microphone arrays
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_AMBISONIC_ENCODER_H__
+#define _SOFA_AMBISONIC_ENCODER_H__
+
+#include "../src/SOFASingleRoomDRIR.h"
+
+namespace sofa
+{
+
+    /************************************************************************************/
+    /*!
+     *  @class          AmbisonicEncoder
+     *  @brief          Ambisonic room responses from the DRIRs of a spherical microphone
+     *                  array (SingleRoomDRIR)
+     *
+     *  @details        The encoding matrix of each frequency bin is the product of a spatial
+     *                  part and of radial filters :
+     *                  - the spatial part is the regularized spherical-harmonic fit over the
+     *                    receiver directions (SphericalHarmonicDecomposition::GetFitMatrix,
+     *                    cached per array geometry) ; it does not depend on the frequency and
+     *                    is applied to the time samples ;
+     *                  - the radial filters invert the mode strength of each order (open or
+     *                    rigid sphere of the radius of the array), with a Tikhonov
+     *                    regularization bounding their gain. They are designed as linear-phase
+     *                    FIR filters (GetLatency) and applied by FFT convolution.
+     *
+     *                  The receivers shall lie on a sphere centered on the listener, at the
+     *                  same positions for all the measurements. Data.Delay is applied, with
+     *                  fractional delays interpolated (FractionalDelayLine::ApplyDelay).
+     *                  The responses are in ACN order with N3D normalization
+     *                  (a plane wave of unit amplitude from direction u gives Y_nm( u ), with
+     *                  Y_00 = 1). The measurements and the coefficients are processed in
+     *                  parallel (sofa::Parallel).
+     */
+    /************************************************************************************/
+    class SOFA_API AmbisonicEncoder
+    {
+    public:
+        enum ArrayType
+        {
+            kOpenSphere     = 0,    ///< omnidirectional microphones in free field
+            kRigidSphere    = 1     ///< microphones flush-mounted on a rigid sphere
+        };
+
+    public:
+        AmbisonicEncoder();
+        ~AmbisonicEncoder() {};
+
+        //==============================================================================
+        void SetArrayType(const sofa::AmbisonicEncoder::ArrayType type);
+        void SetMaxRadialGain(const double decibels);
+        void SetRadialFilterLength(const unsigned int length);
+        void SetSpeedOfSound(const double metersPerSecond);
+
+        //==============================================================================
+        bool Compute(const sofa::SingleRoomDRIR &file,
+                     const unsigned int order,
+                     const double regularization = 1e-3);
+
+        //==============================================================================
+        unsigned int GetOrder() const;
+        unsigned int GetNumCoefficients() const;
+        unsigned long GetNumMeasurements() const;
+        unsigned long GetNumReceivers() const;
+        unsigned long GetResponseLength() const;
+        unsigned long GetLatency() const;
+        double GetSamplingRate() const;
+        double GetArrayRadius() const;
+
+        const double * GetResponse(const unsigned long measurement,
+                                   const unsigned int coefficient) const;
+
+        const double * GetRadialFilter(const unsigned int n) const;
+
+    private:
+        sofa::AmbisonicEncoder::ArrayType arrayType;
+        double maxRadialGain;                       ///< in dB
+        unsigned int radialFilterLength;
+        double speedOfSound;                        ///< in m/s
+
+        unsigned int order;
+        unsigned long numMeasurements;
+        unsigned long numReceivers;
+        unsigned long responseLength;
+        unsigned long latency;                      ///< in samples
+        double samplingRate;
+        double arrayRadius;                         ///< in meters
+
+        std::vector< double > radialFilters;        ///< [ order+1 2*latency ]
+        std::vector< double > responses;            ///< [ M K responseLength ]
+
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( AmbisonicEncoder );
+    };
+
+}
+
+#endif /* _SOFA_AMBISONIC_ENCODER_H__ */
@@ -0,0 +1,557 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAArrayBeamformer.cpp
+ *   @brief      Delay-and-sum beamforming of SingleRoomDRIR receiver arrays
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAArrayBeamformer.h"
+#include "../src/SOFAGeometry.h"
+#include "../src/SOFALinearAlgebra.h"
+#include "../src/SOFAParallel.h"
+#include "../src/SOFAFFT.h"
+#include "../src/SOFAExceptions.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+namespace ArrayBeamformerLocal
+{
+    const double kPi = 3.14159265358979323846;
+
+    /// number of frequency bins of one batched matrix product
+    const std::size_t kBinsPerBatch = 512;
+
+    /// distance (in bins) of the recurrence computing the steering vectors
+    const std::size_t kSteeringStride = 8;
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Reads ReceiverPosition [ R C I ] or [ R C M ] as [ M R 3 ] cartesian
+     *                  positions
+     *
+     */
+    /************************************************************************************/
+    inline bool getReceiverPositions(std::vector< double > &positions,
+                                     const sofa::File &file,
+                                     const std::size_t numMeasurements,
+                                     const std::size_t numReceivers)
+    {
+        sofa::Coordinates::Type coordinates;
+        sofa::Units::Type units;
+
+        std::vector< double > values;
+        std::vector< std::size_t > dims;
+
+        if( file.GetReceiverPosition( coordinates, units ) == false
+           || file.GetValues( values, "ReceiverPosition" ) == false )
+        {
+            return false;
+        }
+
+        file.GetVariableDimensions( dims, "ReceiverPosition" );
+
+        if( dims.size() != 3 || dims[0] != numReceivers || dims[1] != 3
+           || ( dims[2] != 1 && dims[2] != numMeasurements )
+           || values.size() != numReceivers * 3 * dims[2] )
+        {
+            return false;
+        }
+
+        std::vector< double > points( numMeasurements * numReceivers * 3 );
+
+        for( std::size_t m = 0; m < numMeasurements; m++ )
+        {
+            const std::size_t column = ( dims[2] == 1 ) ? 0 : m;
+
+            for( std::size_t r = 0; r < numReceivers; r++ )
+            {
+                for( std::size_t c = 0; c < 3; c++ )
+                {
+                    points[ ( m * numReceivers + r ) * 3 + c ] = values[ ( r * 3 + c ) * dims[2] + column ];
+                }
+            }
+        }
+
+        sofa::Geometry::ToCartesian( positions, points, coordinates );
+
+        return true;
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Multiplies a spectrum by exp( j phase k ), k in [ 0 count [
+     *
+     */
+    /************************************************************************************/
+    inline void rotate(float *re,
+                       float *im,
+                       const std::size_t count,
+                       const double phase)
+    {
+        const double stepRe = std::cos( phase );
+        const double stepIm = std::sin( phase );
+
+        double zRe = 1.0;
+        double zIm = 0.0;
+
+        for( std::size_t k = 0; k < count; k++ )
+        {
+            const double xRe = re[k];
+            const double xIm = im[k];
+
+            re[k] = static_cast< float >( xRe * zRe - xIm * zIm );
+            im[k] = static_cast< float >( xRe * zIm + xIm * zRe );
+
+            const double tmp = zRe * stepRe - zIm * stepIm;
+            zIm = zRe * stepIm + zIm * stepRe;
+            zRe = tmp;
+        }
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Fills gain * exp( j phase k ), k in [ first first+count [
+     *
+     *  @details        The first kSteeringStride values are computed in double precision ;
+     *                  each following one is the value kSteeringStride bins before, rotated,
+     *                  so that the loop has no dependency within a SIMD vector
+     */
+    /************************************************************************************/
+    inline void steer(float *re,
+                      float *im,
+                      const std::size_t first,
+                      const std::size_t count,
+                      const double phase,
+                      const double gain)
+    {
+        const double stepRe = std::cos( phase );
+        const double stepIm = std::sin( phase );
+
+        double zRe = gain * std::cos( phase * static_cast< double >( first ) );
+        double zIm = gain * std::sin( phase * static_cast< double >( first ) );
+
+        const std::size_t head = std::min( count, kSteeringStride );
+
+        for( std::size_t k = 0; k < head; k++ )
+        {
+            re[k] = static_cast< float >( zRe );
+            im[k] = static_cast< float >( zIm );
+
+            const double tmp = zRe * stepRe - zIm * stepIm;
+            zIm = zRe * stepIm + zIm * stepRe;
+            zRe = tmp;
+        }
+
+        const float strideRe = static_cast< float >( std::cos( phase * kSteeringStride ) );
+        const float strideIm = static_cast< float >( std::sin( phase * kSteeringStride ) );
+
+        for( std::size_t k = kSteeringStride; k < count; k++ )
+        {
+            re[k] = re[ k - kSteeringStride ] * strideRe - im[ k - kSteeringStride ] * strideIm;
+            im[k] = re[ k - kSteeringStride ] * strideIm + im[ k - kSteeringStride ] * strideRe;
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+ArrayBeamformer::ArrayBeamformer()
+: speedOfSound( 343.0 )
+, numMeasurements( 0 )
+, numReceivers( 0 )
+, numDirections( 0 )
+, responseLength( 0 )
+, latency( 0 )
+, samplingRate( 0.0 )
+, arrayRadius( 0.0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Speed of sound used for the steering delays (default 343 m/s)
+ *
+ */
+/************************************************************************************/
+void ArrayBeamformer::SetSpeedOfSound(const double metersPerSecond)
+{
+    if( metersPerSecond > 0.0 )
+    {
+        speedOfSound = metersPerSecond;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the look directions
+ *  @param[in]      directions : [ D 2 ] azimuth and elevation (degree, SOFA convention)
+ *  @return         false if the directions are empty or not given by pairs
+ *
+ */
+/************************************************************************************/
+bool ArrayBeamformer::SetDirections(const std::vector< double > &directions)
+{
+    if( directions.empty() == true || directions.size() % 2 != 0 )
+    {
+        return false;
+    }
+
+    const std::size_t D = directions.size() / 2;
+
+    lookDirections.resize( 3 * D );
+
+    for( std::size_t d = 0; d < D; d++ )
+    {
+        const double spherical[3] = { directions[ 2 * d ], directions[ 2 * d + 1 ], 1.0 };
+
+        sofa::Geometry::SphericalToCartesian( &lookDirections[ 3 * d ], spherical );
+    }
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the directional responses of all the measurements
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool ArrayBeamformer::Compute(const sofa::SingleRoomDRIR &file)
+{
+    using namespace ArrayBeamformerLocal;
+
+    const long M = file.GetNumMeasurements();
+    const long R = file.GetNumReceivers();
+    const long N = file.GetNumDataSamples();
+
+    const std::size_t D = lookDirections.size() / 3;
+
+    if( D == 0 )
+    {
+        SOFA_THROW( "no look direction" );
+        return false;
+    }
+
+    double fs = 0.0;
+    std::vector< double > dataIR;
+    std::vector< double > delay;
+    std::vector< double > positions;
+
+    if( M <= 0 || R <= 0 || N <= 0
+       || file.GetSamplingRate( fs ) == false
+       || file.GetDataIR( dataIR ) == false
+       || file.GetDataDelay( delay ) == false )
+    {
+        SOFA_THROW( "cannot read the DRIRs" );
+        return false;
+    }
+
+    if( getReceiverPositions( positions, file, M, R ) == false )
+    {
+        SOFA_THROW( "cannot read 'ReceiverPosition'" );
+        return false;
+    }
+
+    /// Data.Delay is [ I R ] or [ M R ]
+    const bool delayVaries = ( delay.size() == static_cast< std::size_t >( M * R ) );
+
+    if( delayVaries == false && delay.size() != static_cast< std::size_t >( R ) )
+    {
+        SOFA_THROW( "invalid 'Data.Delay' dimensions" );
+        return false;
+    }
+
+    double maxDelay = 0.0;
+    for( std::size_t i = 0; i < delay.size(); i++ )
+    {
+        maxDelay = std::max( maxDelay, delay[i] );
+    }
+
+    double radius = 0.0;
+    for( std::size_t i = 0; i < positions.size() / 3; i++ )
+    {
+        const double *p = &positions[ 3 * i ];
+        radius = std::max( radius, std::sqrt( p[0] * p[0] + p[1] * p[1] + p[2] * p[2] ) );
+    }
+
+    /// the steering delays lie in [ 0 2 * newLatency ]
+    const std::size_t newLatency = static_cast< std::size_t >( std::ceil( radius * fs / speedOfSound ) );
+    const std::size_t length     = N + static_cast< std::size_t >( std::ceil( maxDelay ) ) + 2 * newLatency;
+
+    const unsigned int F = sofa::dsp::FFT::NextPowerOfTwo( static_cast< unsigned int >( length ) );
+    const std::size_t K  = F / 2 + 1;
+
+    //==============================================================================
+    /// groups of measurements sharing the same receiver positions
+    std::vector< std::vector< unsigned long > > groups;
+
+    for( unsigned long m = 0; m < static_cast< unsigned long >( M ); m++ )
+    {
+        const double *p = &positions[ m * R * 3 ];
+
+        std::size_t g = 0;
+        for( ; g < groups.size(); g++ )
+        {
+            if( std::equal( p, p + R * 3, &positions[ groups[g][0] * R * 3 ] ) == true )
+            {
+                break;
+            }
+        }
+
+        if( g == groups.size() )
+        {
+            groups.push_back( std::vector< unsigned long >() );
+        }
+
+        groups[g].push_back( m );
+    }
+
+    std::vector< double > newResponses( M * D * length );
+    std::vector< double > newEnergies( M * D );
+
+    for( std::size_t g = 0; g < groups.size(); g++ )
+    {
+        const std::vector< unsigned long > &group = groups[g];
+        const std::size_t G = group.size();
+
+        //==============================================================================
+        /// spectra of the DRIRs [ R G K ], delayed by Data.Delay
+        std::vector< float > xRe( R * G * K );
+        std::vector< float > xIm( R * G * K );
+
+        sofa::Parallel::For( 0, R * G, [ & ]( const std::size_t first, const std::size_t last )
+        {
+            sofa::dsp::FFT fft( F );
+            std::vector< float > time( F );
+
+            for( std::size_t i = first; i < last; i++ )
+            {
+                const std::size_t r = i / G;
+                const unsigned long m = group[ i % G ];
+
+                const double *ir = &dataIR[ ( m * R + r ) * N ];
+
+                std::fill( time.begin(), time.end(), 0.0f );
+                for( long n = 0; n < N; n++ )
+                {
+                    time[n] = static_cast< float >( ir[n] );
+                }
+
+                fft.Forward( &xRe[ i * K ], &xIm[ i * K ], &time[0] );
+
+                const double d = delay[ ( delayVaries == true ) ? m * R + r : r ];
+
+                if( d > 0.0 )
+                {
+                    rotate( &xRe[ i * K ], &xIm[ i * K ], K, -2.0 * kPi * d / F );
+                }
+            }
+        } );
+
+        //==============================================================================
+        /// steering matrices [ D R ] applied by groups of bins : Y = W X
+        const double *p = &positions[ group[0] * R * 3 ];
+
+        std::vector< float > wRe( D * R * kBinsPerBatch );
+        std::vector< float > wIm( D * R * kBinsPerBatch );
+
+        std::vector< float > yRe( D * G * K );
+        std::vector< float > yIm( D * G * K );
+
+        for( std::size_t k0 = 0; k0 < K; k0 += kBinsPerBatch )
+        {
+            const std::size_t count = std::min( kBinsPerBatch, K - k0 );
+
+            sofa::Parallel::For( 0, D * R, [ & ]( const std::size_t first, const std::size_t last )
+            {
+                for( std::size_t i = first; i < last; i++ )
+                {
+                    const double *u = &lookDirections[ 3 * ( i / R ) ];
+                    const double *q = &p[ 3 * ( i % R ) ];
+
+                    /// delay (in samples) aligning the receiver on a plane wave coming from u
+                    const double tau = newLatency + fs * ( q[0] * u[0] + q[1] * u[1] + q[2] * u[2] ) / speedOfSound;
+
+                    steer( &wRe[ i * kBinsPerBatch ], &wIm[ i * kBinsPerBatch ], k0, count, -2.0 * kPi * tau / F, 1.0 / R );
+                }
+            } );
+
+            sofa::LinearAlgebra::ComplexGemmBatched( &yRe[k0], &yIm[k0],
+                                                     &wRe[0], &wIm[0],
+                                                     &xRe[k0], &xIm[k0],
+                                                     D, R, G, count,
+                                                     kBinsPerBatch, K, K );
+        }
+
+        //==============================================================================
+        /// directional responses
+        sofa::Parallel::For( 0, D * G, [ & ]( const std::size_t first, const std::size_t last )
+        {
+            sofa::dsp::FFT fft( F );
+            std::vector< float > time( F );
+
+            for( std::size_t i = first; i < last; i++ )
+            {
+                const std::size_t d = i / G;
+                const unsigned long m = group[ i % G ];
+
+                fft.Inverse( &time[0], &yRe[ i * K ], &yIm[ i * K ] );
+
+                double *response = &newResponses[ ( m * D + d ) * length ];
+                double energy = 0.0;
+
+                for( std::size_t n = 0; n < length; n++ )
+                {
+                    response[n] = static_cast< double >( time[n] );
+                    energy += response[n] * response[n];
+                }
+
+                newEnergies[ m * D + d ] = energy;
+            }
+        } );
+    }
+
+    numMeasurements = M;
+    numReceivers    = R;
+    numDirections   = D;
+    responseLength  = length;
+    latency         = newLatency;
+    samplingRate    = fs;
+    arrayRadius     = radius;
+
+    responses.swap( newResponses );
+    energies.swap( newEnergies );
+
+    return true;
+}
+
+unsigned long ArrayBeamformer::GetNumMeasurements() const
+{
+    return numMeasurements;
+}
+
+unsigned long ArrayBeamformer::GetNumReceivers() const
+{
+    return numReceivers;
+}
+
+unsigned long ArrayBeamformer::GetNumDirections() const
+{
+    return numDirections;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Length of the directional responses : Data.IR plus the largest
+ *                  Data.Delay plus twice the latency
+ *
+ */
+/************************************************************************************/
+unsigned long ArrayBeamformer::GetResponseLength() const
+{
+    return responseLength;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Common delay added to the directional responses, in samples (the
+ *                  propagation time across the array radius)
+ *
+ */
+/************************************************************************************/
+unsigned long ArrayBeamformer::GetLatency() const
+{
+    return latency;
+}
+
+double ArrayBeamformer::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Largest distance between a receiver and the listener, in meters
+ *
+ */
+/************************************************************************************/
+double ArrayBeamformer::GetArrayRadius() const
+{
+    return arrayRadius;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Directional response of one measurement toward one look direction
+ *  @return         responseLength samples
+ *
+ */
+/************************************************************************************/
+const double * ArrayBeamformer::GetResponse(const unsigned long measurement,
+                                            const unsigned long direction) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && direction < numDirections );
+
+    return &responses[ ( measurement * numDirections + direction ) * responseLength ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Energy of a directional response (sum of the squared samples)
+ *
+ */
+/************************************************************************************/
+double ArrayBeamformer::GetEnergy(const unsigned long measurement,
+                                  const unsigned long direction) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && direction < numDirections );
+
+    return energies[ measurement * numDirections + direction ];
+}
@@ -0,0 +1,129 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAArrayBeamformer.h
+ *   @brief      Delay-and-sum beamforming of SingleRoomDRIR receiver arrays
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_ARRAY_BEAMFORMER_H__
+#define _SOFA_ARRAY_BEAMFORMER_H__
+
+#include "../src/SOFASingleRoomDRIR.h"
+
+namespace sofa
+{
+
+    /************************************************************************************/
+    /*!
+     *  @class          ArrayBeamformer
+     *  @brief          Delay-and-sum beamforming of the receiver arrays of a SingleRoomDRIR
+     *                  file : directional room responses (plane-wave decomposition on a set
+     *                  of look directions)
+     *
+     *  @details        The steering matrix [ D R ] of each frequency bin is built from
+     *                  ReceiverPosition : the response toward a look direction u is the mean
+     *                  of the DRIRs of the R receivers, each one delayed by ( r . u ) / c so
+     *                  that a plane wave coming from u adds up in phase. A common delay
+     *                  (GetLatency) keeps all the delays positive.
+     *
+     *                  The DRIRs (Data.Delay included, fractional delays applied in the
+     *                  frequency domain) are transformed once ; the steering matrices are
+     *                  then applied to all the measurements sharing the same receiver
+     *                  positions with one batched complex matrix product per group of
+     *                  frequency bins (sofa::LinearAlgebra::ComplexGemmBatched).
+     *
+     *                  The look directions are given in the coordinate system of
+     *                  ReceiverPosition (relative to the listener).
+     */
+    /************************************************************************************/
+    class SOFA_API ArrayBeamformer
+    {
+    public:
+        ArrayBeamformer();
+        ~ArrayBeamformer() {};
+
+        //==============================================================================
+        void SetSpeedOfSound(const double metersPerSecond);
+        bool SetDirections(const std::vector< double > &directions);
+
+        //==============================================================================
+        bool Compute(const sofa::SingleRoomDRIR &file);
+
+        //==============================================================================
+        unsigned long GetNumMeasurements() const;
+        unsigned long GetNumReceivers() const;
+        unsigned long GetNumDirections() const;
+        unsigned long GetResponseLength() const;
+        unsigned long GetLatency() const;
+        double GetSamplingRate() const;
+        double GetArrayRadius() const;
+
+        const double * GetResponse(const unsigned long measurement,
+                                   const unsigned long direction) const;
+
+        double GetEnergy(const unsigned long measurement,
+                         const unsigned long direction) const;
+
+    private:
+        double speedOfSound;                        ///< in m/s
+        std::vector< double > lookDirections;       ///< [ D 3 ] unit vectors
+
+        unsigned long numMeasurements;
+        unsigned long numReceivers;
+        unsigned long numDirections;
+        unsigned long responseLength;
+        unsigned long latency;                      ///< in samples
+        double samplingRate;
+        double arrayRadius;                         ///< in meters
+
+        std::vector< double > responses;            ///< [ M D responseLength ]
+        std::vector< double > energies;             ///< [ M D ]
+
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( ArrayBeamformer );
+    };
+
+}
+
+#endif /* _SOFA_ARRAY_BEAMFORMER_H__ */
@@ -0,0 +1,481 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFABinauralConvolver.cpp
+ *   @brief      Partitioned convolution of a mono signal with HRIRs
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFABinauralConvolver.h"
+#include "../src/SOFAFIRDataSet.h"
+#include "../src/SOFAGeometry.h"
+#include "../src/SOFASimd.h"
+#include "../src/SOFAExceptions.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+using namespace sofa::dsp;
+
+namespace BinauralConvolverLocal
+{
+    /// Data.Delay is interpolated like in FractionalDelayLine::ApplyDelay (windowed sinc, 32 taps)
+    const unsigned int kDelayInterpolationOrder = 16;
+}
+
+using namespace BinauralConvolverLocal;
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      file : the HRIRs
+ *  @param[in]      blockSize_ : number of samples per call to Process, a power of two
+ *  @param[in]      method : convolution method
+ *
+ */
+/************************************************************************************/
+BinauralConvolver::BinauralConvolver(const sofa::SimpleFreeFieldHRIR &file,
+                                     const unsigned int blockSize_,
+                                     const sofa::dsp::BinauralConvolver::Method method)
+: blockSize( blockSize_ )
+, numMeasurements( 0 )
+, samplingRate( 0.0 )
+, filterLength( 0 )
+, directForm( false )
+, hasDelays( false )
+, delayOffset( 0.0 )
+, measurement( 0 )
+, current( 0 )
+, fft( 2 * blockSize_ )
+, position( 0 )
+{
+    sofa::FIRDataSet dataSet;
+
+    if( dataSet.Load( file ) == false )
+    {
+        SOFA_THROW( "cannot load the HRIRs" );
+    }
+
+    init( dataSet, method );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      dataSet : the HRIRs, possibly processed (e.g. MinimumPhaseDecomposition)
+ *  @param[in]      blockSize_ : number of samples per call to Process, a power of two
+ *  @param[in]      method : convolution method
+ *
+ */
+/************************************************************************************/
+BinauralConvolver::BinauralConvolver(const sofa::FIRDataSet &dataSet,
+                                     const unsigned int blockSize_,
+                                     const sofa::dsp::BinauralConvolver::Method method)
+: blockSize( blockSize_ )
+, numMeasurements( 0 )
+, samplingRate( 0.0 )
+, filterLength( 0 )
+, directForm( false )
+, hasDelays( false )
+, delayOffset( 0.0 )
+, measurement( 0 )
+, current( 0 )
+, fft( 2 * blockSize_ )
+, position( 0 )
+{
+    init( dataSet, method );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Prepares the filters, the delays and the spatial index
+ *
+ */
+/************************************************************************************/
+void BinauralConvolver::init(const sofa::FIRDataSet &dataSet,
+                             const sofa::dsp::BinauralConvolver::Method method)
+{
+    if( dataSet.GetNumReceivers() != 2 )
+    {
+        SOFA_THROW( "two receivers are required" );
+    }
+
+    const unsigned long M = dataSet.GetNumMeasurements();
+    const unsigned long N = dataSet.GetNumDataSamples();
+
+    //==============================================================================
+    /// filters, and Data.Delay applied separately
+    const std::size_t length = N;
+    std::vector< double > h( M * 2 * length, 0.0 );
+
+    delays.resize( M * 2 );
+
+    /// negative delays (e.g. extracted from minimum-phase IRs) cannot be applied causally :
+    /// all the delays are then shifted by the same offset, which keeps the ITDs
+    double minDelay = 0.0;
+
+    for( unsigned long m = 0; m < M; m++ )
+    {
+        for( unsigned long r = 0; r < 2; r++ )
+        {
+            minDelay = std::min( minDelay, dataSet.GetDelay( m, r ) );
+        }
+    }
+
+    delayOffset = -minDelay;
+
+    double maxDelay = 0.0;
+
+    for( unsigned long m = 0; m < M; m++ )
+    {
+        for( unsigned long r = 0; r < 2; r++ )
+        {
+            const double *ir = dataSet.GetIR( m, r );
+            std::copy( ir, ir + N, &h[ ( m * 2 + r ) * length ] );
+
+            const double delay = dataSet.GetDelay( m, r ) + delayOffset;
+
+            delays[ m * 2 + r ] = static_cast< float >( delay );
+            maxDelay = std::max( maxDelay, delay );
+        }
+    }
+
+    hasDelays = ( maxDelay > 0.0 );
+
+    if( hasDelays == true )
+    {
+        delayLine.reset( new sofa::dsp::FractionalDelayLine( 2, maxDelay, blockSize,
+                                                             sofa::dsp::FractionalDelayLine::kWindowedSinc,
+                                                             kDelayInterpolationOrder ) );
+    }
+
+    if( method == kAutomatic )
+    {
+        directForm = ( length <= sofa::dsp::DirectFilterBank::GetCrossover( blockSize ) );
+    }
+    else
+    {
+        directForm = ( method == kDirect );
+    }
+
+    if( directForm == true )
+    {
+        directFilters.Prepare( &h[0], M, 2, static_cast< unsigned int >( length ), blockSize );
+    }
+    else
+    {
+        filters.Prepare( &h[0], M * 2, length, blockSize );
+    }
+
+    //==============================================================================
+    std::vector< double > directions( dataSet.GetSourceCartesianPositions() );
+    for( unsigned long m = 0; m < M; m++ )
+    {
+        sofa::Geometry::Normalize( &directions[ 3 * m ] );
+    }
+    index.Build( directions );
+
+    numMeasurements = M;
+    samplingRate    = dataSet.GetSamplingRate();
+    filterLength    = static_cast< unsigned int >( length );
+
+    const unsigned int P = filters.GetNumPartitions();
+    const unsigned int K = filters.GetNumBins();
+
+    frame.assign( 2 * blockSize, 0.0f );
+    spectraRe.assign( static_cast< std::size_t >( P ) * K, 0.0f );
+    spectraIm.assign( static_cast< std::size_t >( P ) * K, 0.0f );
+    accumulatorRe.assign( K, 0.0f );
+    accumulatorIm.assign( K, 0.0f );
+    output.assign( 2 * blockSize, 0.0f );
+
+    fadeIn.resize( blockSize );
+    for( unsigned int i = 0; i < blockSize; i++ )
+    {
+        fadeIn[i] = static_cast< float >( i + 1 ) / static_cast< float >( blockSize );
+    }
+
+    previous.assign( 2 * blockSize, 0.0f );
+    dry.assign( 2 * blockSize, 0.0f );
+}
+
+unsigned int BinauralConvolver::GetBlockSize() const
+{
+    return blockSize;
+}
+
+unsigned int BinauralConvolver::GetNumPartitions() const
+{
+    return filters.GetNumPartitions();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Length of the filters (Data.Delay is applied separately)
+ *
+ */
+/************************************************************************************/
+unsigned int BinauralConvolver::GetFilterLength() const
+{
+    return filterLength;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the method in use (kDirect or kPartitioned)
+ *
+ */
+/************************************************************************************/
+sofa::dsp::BinauralConvolver::Method BinauralConvolver::GetMethod() const
+{
+    return ( directForm == true ) ? kDirect : kPartitioned;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Offset added to all the delays, in samples : minus the most negative
+ *                  Data.Delay, or 0 if there is none
+ *
+ */
+/************************************************************************************/
+double BinauralConvolver::GetDelayOffset() const
+{
+    return delayOffset;
+}
+
+unsigned long BinauralConvolver::GetNumMeasurements() const
+{
+    return numMeasurements;
+}
+
+double BinauralConvolver::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Selects the HRIRs used for the next blocks
+ *
+ *  @details        Can be called from any thread. The change is crossfaded over the
+ *                  next block.
+ */
+/************************************************************************************/
+void BinauralConvolver::SetMeasurement(const unsigned long measurement_)
+{
+    SOFA_ASSERT( measurement_ < numMeasurements );
+
+    measurement.store( std::min( measurement_, numMeasurements - 1 ) );
+}
+
+unsigned long BinauralConvolver::GetMeasurement() const
+{
+    return measurement.load();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the measurement whose direction is the closest to a given one
+ *  @param[in]      direction : cartesian direction (SOFA frame)
+ *
+ */
+/************************************************************************************/
+unsigned long BinauralConvolver::FindMeasurement(const double direction[3]) const
+{
+    double d[3] = { direction[0], direction[1], direction[2] };
+    sofa::Geometry::Normalize( d );
+
+    return index.FindNearest( d );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Clears the state of the convolution
+ *
+ */
+/************************************************************************************/
+void BinauralConvolver::Reset()
+{
+    std::fill( frame.begin(), frame.end(), 0.0f );
+    std::fill( spectraRe.begin(), spectraRe.end(), 0.0f );
+    std::fill( spectraIm.begin(), spectraIm.end(), 0.0f );
+    position = 0;
+
+    directFilters.Reset();
+
+    if( delayLine != nullptr )
+    {
+        delayLine->Reset();
+    }
+
+    current = measurement.load();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Renders one block
+ *  @param[out]     left : numSamples samples
+ *  @param[out]     right : numSamples samples
+ *  @param[in]      input : numSamples samples
+ *  @param[in]      numSamples : shall be equal to the block size
+ *  @return         false if numSamples differs from the block size (nothing is done)
+ *
+ */
+/************************************************************************************/
+bool BinauralConvolver::Process(float *left,
+                                float *right,
+                                const float *input,
+                                const unsigned int numSamples)
+{
+    if( numSamples != blockSize )
+    {
+        SOFA_ASSERT( false );
+        return false;
+    }
+
+    const unsigned int B = blockSize;
+
+    const unsigned long target  = measurement.load();
+    const bool transition       = ( target != current );
+
+    float *outputs[2]       = { left, right };
+    float *filtered[2]      = { left, right };
+    float *previousHRIR[2]  = { &previous[0], &previous[ B ] };
+
+    if( hasDelays == true )
+    {
+        filtered[0] = &dry[0];
+        filtered[1] = &dry[ B ];
+    }
+
+    //==============================================================================
+    if( directForm == true )
+    {
+        if( transition == true )
+        {
+            directFilters.Process( filtered, previousHRIR, input, B, target, current );
+        }
+        else
+        {
+            directFilters.Process( filtered, input, B, target );
+        }
+    }
+    else
+    {
+        const unsigned int P = filters.GetNumPartitions();
+        const unsigned int K = filters.GetNumBins();
+
+        /// slide the input frame and transform it
+        std::copy( frame.begin() + B, frame.end(), frame.begin() );
+        std::copy( input, input + B, frame.begin() + B );
+
+        position = ( position + 1 ) % P;
+
+        fft.Forward( &spectraRe[ position * K ], &spectraIm[ position * K ], &frame[0] );
+
+        for( unsigned int r = 0; r < 2; r++ )
+        {
+            convolvePartitions( filtered[r], target * 2 + r );
+
+            if( transition == true )
+            {
+                convolvePartitions( previousHRIR[r], current * 2 + r );
+            }
+        }
+    }
+
+    //==============================================================================
+    if( transition == true )
+    {
+        for( unsigned int r = 0; r < 2; r++ )
+        {
+            sofa::Simd::Crossfade( filtered[r], previousHRIR[r], filtered[r], &fadeIn[0], B );
+        }
+    }
+
+    if( hasDelays == true )
+    {
+        delayLine->Process( outputs, filtered, B, &delays[ current * 2 ], &delays[ target * 2 ] );
+    }
+
+    current = target;
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Convolves the current input spectra with one filter
+ *  @param[out]     y : B samples
+ *  @param[in]      filter : index m * 2 + r
+ *
+ */
+/************************************************************************************/
+void BinauralConvolver::convolvePartitions(float *y,
+                                           const std::size_t filter)
+{
+    const unsigned int B = blockSize;
+    const unsigned int P = filters.GetNumPartitions();
+    const unsigned int K = filters.GetNumBins();
+
+    std::fill( accumulatorRe.begin(), accumulatorRe.end(), 0.0f );
+    std::fill( accumulatorIm.begin(), accumulatorIm.end(), 0.0f );
+
+    /// partition p is applied to the frame received p blocks ago
+    for( unsigned int p = 0; p < P; p++ )
+    {
+        const unsigned int slot = ( position + P - p ) % P;
+
+        sofa::Simd::ComplexMultiplyAccumulate( &accumulatorRe[0],
+                                               &accumulatorIm[0],
+                                               &spectraRe[ slot * K ],
+                                               &spectraIm[ slot * K ],
+                                               filters.GetRe( filter, p ),
+                                               filters.GetIm( filter, p ),
+                                               K );
+    }
+
+    fft.Inverse( &output[0], &accumulatorRe[0], &accumulatorIm[0] );
+
+    /// overlap-save : the first half is aliased
+    std::copy( output.begin() + B, output.end(), y );
+}
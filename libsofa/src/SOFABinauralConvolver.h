@@ -0,0 +1,189 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFABinauralConvolver.h
+ *   @brief      Partitioned convolution of a mono signal with HRIRs
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_BINAURAL_CONVOLVER_H__
+#define _SOFA_BINAURAL_CONVOLVER_H__
+
+#include "../src/SOFASimpleFreeFieldHRIR.h"
+#include "../src/SOFAFIRDataSet.h"
+#include "../src/SOFAPartitionedFilterBank.h"
+#include "../src/SOFADirectFilterBank.h"
+#include "../src/SOFASpatialIndex.h"
+#include "../src/SOFAFFT.h"
+#include "../src/SOFAFractionalDelayLine.h"
+#include <atomic>
+#include <memory>
+
+namespace sofa
+{
+
+    namespace dsp
+    {
+
+        /************************************************************************************/
+        /*!
+         *  @class          BinauralConvolver
+         *  @brief          Real-time binaural rendering of a mono signal with a SimpleFreeFieldHRIR
+         *
+         *  @details        All the HRIRs are converted, at construction, to frequency-domain
+         *                  partitions of one block. Each block of input is convolved with the
+         *                  HRIRs of the current measurement by uniformly partitioned overlap-save
+         *                  (one FFT per block, one complex multiply-accumulate per partition and
+         *                  per ear, one inverse FFT per ear). There is no latency : the output
+         *                  of a block includes the contribution of the same input block.
+         *
+         *                  Short filters are rather convolved in direct form (DirectFilterBank),
+         *                  also without latency, when their length is below the crossover
+         *                  measured on the host for the block size.
+         *
+         *                  When the measurement changes, the block is rendered with both the
+         *                  previous and the new HRIRs, and the two outputs are crossfaded (only
+         *                  during that block). Data.Delay is not included in the filters but
+         *                  applied after them, by a fractional delay line per ear (windowed sinc
+         *                  of 32 taps, as FractionalDelayLine::ApplyDelay) whose delay is ramped
+         *                  sample by sample over the crossfade, so that the ITD changes smoothly.
+         *                  Delays below 15 samples use the interpolator off-center (no latency
+         *                  is added). If some delays are negative, all the delays are shifted
+         *                  by the same offset (GetDelayOffset), so that the ITDs are kept.
+         *                  Process does not allocate, nor lock.
+         */
+        /************************************************************************************/
+        class SOFA_API BinauralConvolver
+        {
+        public:
+            enum Method
+            {
+                kAutomatic      = 0,    ///< direct form below the measured crossover, FFT above
+                kDirect         = 1,    ///< direct form (time domain)
+                kPartitioned    = 2     ///< uniformly partitioned overlap-save
+            };
+
+        public:
+            BinauralConvolver(const sofa::SimpleFreeFieldHRIR &file,
+                              const unsigned int blockSize,
+                              const sofa::dsp::BinauralConvolver::Method method = kAutomatic);
+
+            BinauralConvolver(const sofa::FIRDataSet &dataSet,
+                              const unsigned int blockSize,
+                              const sofa::dsp::BinauralConvolver::Method method = kAutomatic);
+            ~BinauralConvolver() {};
+
+            //==============================================================================
+            unsigned int GetBlockSize() const;
+            unsigned int GetNumPartitions() const;
+            unsigned int GetFilterLength() const;
+            double GetDelayOffset() const;
+            sofa::dsp::BinauralConvolver::Method GetMethod() const;
+            unsigned long GetNumMeasurements() const;
+            double GetSamplingRate() const;
+
+            //==============================================================================
+            void SetMeasurement(const unsigned long measurement);
+            unsigned long GetMeasurement() const;
+
+            unsigned long FindMeasurement(const double direction[3]) const;
+
+            //==============================================================================
+            bool Process(float *left,
+                         float *right,
+                         const float *input,
+                         const unsigned int numSamples);
+
+            void Reset();
+
+        private:
+            void init(const sofa::FIRDataSet &dataSet,
+                      const sofa::dsp::BinauralConvolver::Method method);
+
+            void convolvePartitions(float *y,
+                                    const std::size_t filter);
+
+        private:
+            const unsigned int blockSize;
+            unsigned long numMeasurements;
+            double samplingRate;
+            unsigned int filterLength;
+            bool directForm;
+            bool hasDelays;                             ///< Data.Delay is not zero everywhere
+            double delayOffset;                         ///< added to all the delays if some are negative
+
+            sofa::dsp::DirectFilterBank directFilters;  ///< group m, channel r
+
+            sofa::dsp::PartitionedFilterBank filters;   ///< filter m * 2 + r
+            sofa::SpatialIndex index;                   ///< source directions
+
+            std::atomic< unsigned long > measurement;
+            unsigned long current;                      ///< measurement rendered in the last block
+
+            sofa::dsp::FFT fft;
+
+            std::vector< float > frame;                 ///< [ 2B ] last two input blocks
+            std::vector< float > spectraRe;             ///< [ P B+1 ] spectra of the last P frames
+            std::vector< float > spectraIm;
+            unsigned int position;                      ///< slot of the most recent frame
+
+            std::vector< float > accumulatorRe;         ///< [ B+1 ]
+            std::vector< float > accumulatorIm;
+            std::vector< float > output;                ///< [ 2B ]
+
+            std::vector< float > fadeIn;                ///< [ B ] crossfade ramp
+            std::vector< float > previous;              ///< [ 2 B ] output of the previous HRIRs
+            std::vector< float > dry;                   ///< [ 2 B ] output of the HRIRs, before the delays
+
+            std::vector< float > delays;                ///< [ M 2 ] Data.Delay, in samples
+            std::unique_ptr< sofa::dsp::FractionalDelayLine > delayLine;   ///< null if hasDelays is false
+
+        private:
+            /// avoid shallow and copy constructor
+            SOFA_AVOID_COPY_CONSTRUCTOR( BinauralConvolver );
+        };
+
+    }
+
+}
+
+#endif /* _SOFA_BINAURAL_CONVOLVER_H__ */
@@ -0,0 +1,512 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFABiquadFilterBank.cpp
+ *   @brief      Vectorized second-order section filters
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFABiquadFilterBank.h"
+#include "../src/SOFAGeometry.h"
+#include "../src/SOFASimd.h"
+#include "../src/SOFAExceptions.h"
+#include <algorithm>
+
+using namespace sofa;
+using namespace sofa::dsp;
+
+namespace BiquadFilterBankLocal
+{
+    /// coefficients of a normalized section : b0 b1 b2 a1 a2
+    const unsigned int kNumCoefficients = 5;
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Expands values stored as [ I D ] to [ M D ]
+     *  @return         false if the size is neither D nor M D
+     *
+     */
+    /************************************************************************************/
+    bool Expand(std::vector< double > &values,
+                const std::size_t M,
+                const std::size_t D)
+    {
+        if( values.size() == M * D )
+        {
+            return true;
+        }
+        else if( values.size() == D )
+        {
+            std::vector< double > expanded( M * D );
+
+            for( std::size_t m = 0; m < M; m++ )
+            {
+                std::copy( values.begin(), values.end(), expanded.begin() + m * D );
+            }
+
+            values.swap( expanded );
+            return true;
+        }
+
+        return false;
+    }
+}
+
+using namespace BiquadFilterBankLocal;
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      file : the second-order sections
+ *
+ */
+/************************************************************************************/
+SOSBank::SOSBank(const sofa::SimpleFreeFieldSOS &file)
+: numMeasurements( 0 )
+, numReceivers( 0 )
+, numSections( 0 )
+, samplingRate( 0.0 )
+{
+    const long M = file.GetNumMeasurements();
+    const long R = file.GetNumReceivers();
+    const long N = file.GetNumDataSamples();
+
+    if( M <= 0 || R <= 0 || N <= 0 || N % 6 != 0 )
+    {
+        SOFA_THROW( "invalid SOFA dimensions" );
+    }
+
+    const unsigned int Q = static_cast< unsigned int >( N / 6 );
+
+    double fs = 0.0;
+
+    if( file.GetSamplingRate( fs ) == false )
+    {
+        SOFA_THROW( "invalid 'Data.SamplingRate' variable" );
+    }
+
+    std::vector< double > sos;
+
+    if( file.GetDataSOS( sos ) == false )
+    {
+        SOFA_THROW( "invalid 'Data.SOS' variable" );
+    }
+
+    std::vector< double > delay;
+
+    if( file.GetValues( delay, "Data.Delay" ) == false || Expand( delay, M, R ) == false )
+    {
+        SOFA_THROW( "invalid 'Data.Delay' variable" );
+    }
+
+    sofa::Coordinates::Type coordinates;
+    sofa::Units::Type units;
+
+    std::vector< double > positions;
+
+    if( file.GetSourcePosition( coordinates, units ) == false
+     || file.GetValues( positions, "SourcePosition" ) == false
+     || Expand( positions, M, 3 ) == false )
+    {
+        SOFA_THROW( "invalid 'SourcePosition' variable" );
+    }
+
+    //==============================================================================
+    coefficients.resize( M * R * Q * kNumCoefficients );
+
+    for( std::size_t s = 0; s < static_cast< std::size_t >( M ) * R * Q; s++ )
+    {
+        const double *section = &sos[ s * 6 ];
+
+        if( section[3] == 0.0 )
+        {
+            SOFA_THROW( "invalid second-order section (a0 = 0)" );
+        }
+
+        const double scale = 1.0 / section[3];
+
+        float *normalized = &coefficients[ s * kNumCoefficients ];
+
+        normalized[0] = static_cast< float >( section[0] * scale );
+        normalized[1] = static_cast< float >( section[1] * scale );
+        normalized[2] = static_cast< float >( section[2] * scale );
+        normalized[3] = static_cast< float >( section[4] * scale );
+        normalized[4] = static_cast< float >( section[5] * scale );
+    }
+
+    std::vector< double > directions;
+    sofa::Geometry::ToCartesian( directions, positions, coordinates );
+
+    for( long m = 0; m < M; m++ )
+    {
+        sofa::Geometry::Normalize( &directions[ 3 * m ] );
+    }
+    index.Build( directions );
+
+    numMeasurements = static_cast< unsigned long >( M );
+    numReceivers    = static_cast< unsigned long >( R );
+    numSections     = Q;
+    samplingRate    = fs;
+
+    delays.swap( delay );
+}
+
+unsigned long SOSBank::GetNumMeasurements() const
+{
+    return numMeasurements;
+}
+
+unsigned long SOSBank::GetNumReceivers() const
+{
+    return numReceivers;
+}
+
+unsigned int SOSBank::GetNumSections() const
+{
+    return numSections;
+}
+
+double SOSBank::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Normalized sections of a measurement and receiver
+ *  @return         Q sections of ( b0 b1 b2 a1 a2 )
+ *
+ */
+/************************************************************************************/
+const float * SOSBank::GetCoefficients(const unsigned long measurement, const unsigned long receiver) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers );
+
+    return &coefficients[ ( static_cast< std::size_t >( measurement ) * numReceivers + receiver ) * numSections * kNumCoefficients ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Data.Delay of a measurement and receiver, in samples
+ *
+ */
+/************************************************************************************/
+double SOSBank::GetDelay(const unsigned long measurement, const unsigned long receiver) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers );
+
+    return delays[ static_cast< std::size_t >( measurement ) * numReceivers + receiver ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the measurement whose direction is the closest to a given one
+ *  @param[in]      direction : cartesian direction (SOFA frame)
+ *
+ */
+/************************************************************************************/
+unsigned long SOSBank::FindMeasurement(const double direction[3]) const
+{
+    double d[3] = { direction[0], direction[1], direction[2] };
+    sofa::Geometry::Normalize( d );
+
+    return index.FindNearest( d );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      numVoices_ : number of independent cascades
+ *  @param[in]      numSections_ : number of second-order sections per cascade
+ *  @param[in]      maxBlockSize_ : largest number of samples per call to Process
+ *
+ *  @details        All the voices are initialized as identity filters
+ */
+/************************************************************************************/
+BiquadFilterBank::BiquadFilterBank(const unsigned int numVoices_,
+                                   const unsigned int numSections_,
+                                   const unsigned int maxBlockSize_)
+: numVoices( numVoices_ )
+, numSections( numSections_ )
+, maxBlockSize( maxBlockSize_ )
+, numGroups( static_cast< unsigned int >( ( numVoices_ + sofa::Simd::kVectorSize - 1 ) / sofa::Simd::kVectorSize ) )
+{
+    if( numVoices == 0 || numSections == 0 || maxBlockSize == 0 )
+    {
+        SOFA_THROW( "invalid filter bank dimensions" );
+    }
+
+    const std::size_t W = sofa::Simd::kVectorSize;
+    const std::size_t Q = numSections;
+    const std::size_t G = numGroups;
+
+    coefficients.assign( G * Q * kNumCoefficients * W, 0.0f );
+
+    /// identity : b0 = 1
+    for( std::size_t i = 0; i < G * Q; i++ )
+    {
+        std::fill( &coefficients[ i * kNumCoefficients * W ], &coefficients[ i * kNumCoefficients * W ] + W, 1.0f );
+    }
+
+    previous = coefficients;
+
+    states.assign( G * Q * 2 * W, 0.0f );
+    ramping.assign( G, 0 );
+    initialized.assign( numVoices, 0 );
+
+    work.assign( maxBlockSize * W, 0.0f );
+    ramp.assign( maxBlockSize, 0.0f );
+}
+
+unsigned int BiquadFilterBank::GetNumVoices() const
+{
+    return numVoices;
+}
+
+unsigned int BiquadFilterBank::GetNumSections() const
+{
+    return numSections;
+}
+
+unsigned int BiquadFilterBank::GetMaxBlockSize() const
+{
+    return maxBlockSize;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the sections of a voice
+ *  @param[in]      voice : index of the voice
+ *  @param[in]      sections : Q sections of ( b0 b1 b2 a1 a2 ), e.g. SOSBank::GetCoefficients
+ *  @param[in]      interpolate : if true, the coefficients are interpolated over the next
+ *                  block (except the first time the coefficients of the voice are set)
+ *
+ */
+/************************************************************************************/
+void BiquadFilterBank::SetCoefficients(const unsigned int voice,
+                                       const float *sections,
+                                       const bool interpolate)
+{
+    SOFA_ASSERT( voice < numVoices );
+
+    if( voice >= numVoices )
+    {
+        return;
+    }
+
+    const std::size_t W = sofa::Simd::kVectorSize;
+    const std::size_t Q = numSections;
+    const std::size_t g = voice / W;
+    const std::size_t l = voice % W;
+
+    const bool smooth = ( interpolate == true && initialized[ voice ] != 0 );
+
+    for( std::size_t q = 0; q < Q; q++ )
+    {
+        for( unsigned int c = 0; c < kNumCoefficients; c++ )
+        {
+            const std::size_t i = ( ( g * Q + q ) * kNumCoefficients + c ) * W + l;
+
+            coefficients[i] = sections[ q * kNumCoefficients + c ];
+
+            if( smooth == false )
+            {
+                previous[i] = coefficients[i];
+            }
+        }
+    }
+
+    initialized[ voice ] = 1;
+
+    if( smooth == true )
+    {
+        ramping[g] = 1;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Clears the states of all the voices
+ *
+ */
+/************************************************************************************/
+void BiquadFilterBank::Reset()
+{
+    std::fill( states.begin(), states.end(), 0.0f );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Filters one block of each voice
+ *  @param[out]     outputs : one buffer of numSamples samples per voice
+ *                  (may be the same buffers as the inputs)
+ *  @param[in]      inputs : one buffer of numSamples samples per voice (several voices may
+ *                  share the same input, e.g. the two ears of a source)
+ *  @param[in]      numSamples : at most the maximum block size
+ *  @return         false if numSamples is out of range (nothing is done)
+ *
+ */
+/************************************************************************************/
+bool BiquadFilterBank::Process(float *const *outputs,
+                               const float *const *inputs,
+                               const unsigned int numSamples)
+{
+    if( numSamples > maxBlockSize )
+    {
+        SOFA_ASSERT( false );
+        return false;
+    }
+
+    using namespace sofa::Simd;
+
+    const unsigned int W = static_cast< unsigned int >( kVectorSize );
+    const unsigned int Q = numSections;
+
+    for( unsigned int n = 0; n < numSamples; n++ )
+    {
+        ramp[n] = static_cast< float >( n + 1 ) / static_cast< float >( numSamples );
+    }
+
+    for( unsigned int g = 0; g < numGroups; g++ )
+    {
+        const unsigned int voice0       = g * W;
+        const unsigned int numActive    = std::min( W, numVoices - voice0 );
+
+        /// interleaves the inputs of the group
+        for( unsigned int n = 0; n < numSamples; n++ )
+        {
+            float *x = &work[ n * W ];
+
+            for( unsigned int l = 0; l < numActive; l++ )
+            {
+                x[l] = inputs[ voice0 + l ][n];
+            }
+
+            for( unsigned int l = numActive; l < W; l++ )
+            {
+                x[l] = 0.0f;
+            }
+        }
+
+        for( unsigned int q = 0; q < Q; q++ )
+        {
+            const float *to     = &coefficients[ ( g * Q + q ) * kNumCoefficients * W ];
+            float *from         = &previous[ ( g * Q + q ) * kNumCoefficients * W ];
+            float *state        = &states[ ( g * Q + q ) * 2 * W ];
+
+            Vector s1 = Load( state );
+            Vector s2 = Load( state + W );
+
+            if( ramping[g] != 0 )
+            {
+                Vector start[ kNumCoefficients ];
+                Vector delta[ kNumCoefficients ];
+
+                for( unsigned int c = 0; c < kNumCoefficients; c++ )
+                {
+                    start[c] = Load( from + c * W );
+                    delta[c] = Sub( Load( to + c * W ), start[c] );
+                }
+
+                for( unsigned int n = 0; n < numSamples; n++ )
+                {
+                    const Vector r  = Set( ramp[n] );
+                    const Vector b0 = MultiplyAdd( start[0], r, delta[0] );
+                    const Vector b1 = MultiplyAdd( start[1], r, delta[1] );
+                    const Vector b2 = MultiplyAdd( start[2], r, delta[2] );
+                    const Vector a1 = MultiplyAdd( start[3], r, delta[3] );
+                    const Vector a2 = MultiplyAdd( start[4], r, delta[4] );
+
+                    const Vector x = Load( &work[ n * W ] );
+                    const Vector y = MultiplyAdd( s1, b0, x );
+
+                    s1 = Sub( MultiplyAdd( s2, b1, x ), Mul( a1, y ) );
+                    s2 = Sub( Mul( b2, x ), Mul( a2, y ) );
+
+                    Store( &work[ n * W ], y );
+                }
+
+                std::copy( to, to + kNumCoefficients * W, from );
+            }
+            else
+            {
+                const Vector b0 = Load( to );
+                const Vector b1 = Load( to + W );
+                const Vector b2 = Load( to + 2 * W );
+                const Vector a1 = Load( to + 3 * W );
+                const Vector a2 = Load( to + 4 * W );
+
+                for( unsigned int n = 0; n < numSamples; n++ )
+                {
+                    const Vector x = Load( &work[ n * W ] );
+                    const Vector y = MultiplyAdd( s1, b0, x );
+
+                    s1 = Sub( MultiplyAdd( s2, b1, x ), Mul( a1, y ) );
+                    s2 = Sub( Mul( b2, x ), Mul( a2, y ) );
+
+                    Store( &work[ n * W ], y );
+                }
+            }
+
+            Store( state, s1 );
+            Store( state + W, s2 );
+        }
+
+        if( numSamples > 0 )
+        {
+            ramping[g] = 0;
+        }
+
+        /// de-interleaves the outputs
+        for( unsigned int n = 0; n < numSamples; n++ )
+        {
+            const float *y = &work[ n * W ];
+
+            for( unsigned int l = 0; l < numActive; l++ )
+            {
+                outputs[ voice0 + l ][n] = y[l];
+            }
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,168 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFABiquadFilterBank.h
+ *   @brief      Vectorized second-order section filters
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_BIQUAD_FILTER_BANK_H__
+#define _SOFA_BIQUAD_FILTER_BANK_H__
+
+#include "../src/SOFASimpleFreeFieldSOS.h"
+#include "../src/SOFASpatialIndex.h"
+
+namespace sofa
+{
+
+    namespace dsp
+    {
+
+        /************************************************************************************/
+        /*!
+         *  @class          SOSBank
+         *  @brief          Second-order sections of all the measurements of a SimpleFreeFieldSOS
+         *
+         *  @details        Data.SOS [M R 6Q] holds ( b0 b1 b2 a0 a1 a2 ) for each section ; the
+         *                  sections are stored normalized by a0, as ( b0 b1 b2 a1 a2 ) in
+         *                  single precision, ready for BiquadFilterBank::SetCoefficients.
+         */
+        /************************************************************************************/
+        class SOFA_API SOSBank
+        {
+        public:
+            SOSBank(const sofa::SimpleFreeFieldSOS &file);
+            ~SOSBank() {};
+
+            //==============================================================================
+            unsigned long GetNumMeasurements() const;
+            unsigned long GetNumReceivers() const;
+            unsigned int GetNumSections() const;
+            double GetSamplingRate() const;
+
+            const float * GetCoefficients(const unsigned long measurement, const unsigned long receiver) const;
+
+            double GetDelay(const unsigned long measurement, const unsigned long receiver) const;
+
+            unsigned long FindMeasurement(const double direction[3]) const;
+
+        private:
+            unsigned long numMeasurements;
+            unsigned long numReceivers;
+            unsigned int numSections;
+            double samplingRate;
+
+            std::vector< float > coefficients;          ///< [ M R Q 5 ]
+            std::vector< double > delays;               ///< [ M R ] Data.Delay, in samples
+            sofa::SpatialIndex index;                   ///< source directions
+
+        private:
+            /// avoid shallow and copy constructor
+            SOFA_AVOID_COPY_CONSTRUCTOR( SOSBank );
+        };
+
+        /************************************************************************************/
+        /*!
+         *  @class          BiquadFilterBank
+         *  @brief          Cascades of second-order sections for many voices (e.g. one per
+         *                  source and ear), vectorized across the voices
+         *
+         *  @details        Transposed direct form II. The coefficients and states are stored in
+         *                  structure-of-arrays layout [ group section coefficient lane ], so that
+         *                  each SIMD lane runs one voice, sofa::Simd::kVectorSize voices at a time.
+         *
+         *                  When the coefficients of a voice change, they are interpolated linearly,
+         *                  sample by sample, over the next block. The stability triangle of a
+         *                  biquad is convex, so interpolating between stable sections is stable.
+         *                  SetCoefficients and Process shall be called from the same thread.
+         *                  Process does not allocate.
+         */
+        /************************************************************************************/
+        class SOFA_API BiquadFilterBank
+        {
+        public:
+            BiquadFilterBank(const unsigned int numVoices,
+                             const unsigned int numSections,
+                             const unsigned int maxBlockSize);
+            ~BiquadFilterBank() {};
+
+            //==============================================================================
+            unsigned int GetNumVoices() const;
+            unsigned int GetNumSections() const;
+            unsigned int GetMaxBlockSize() const;
+
+            //==============================================================================
+            void SetCoefficients(const unsigned int voice,
+                                 const float *sections,
+                                 const bool interpolate = true);
+
+            bool Process(float *const *outputs,
+                         const float *const *inputs,
+                         const unsigned int numSamples);
+
+            void Reset();
+
+        private:
+            const unsigned int numVoices;
+            const unsigned int numSections;
+            const unsigned int maxBlockSize;
+            const unsigned int numGroups;               ///< numVoices / W, rounded up
+
+            std::vector< float > coefficients;          ///< [ G Q 5 W ] coefficients at the end of the next block
+            std::vector< float > previous;              ///< [ G Q 5 W ] coefficients at its beginning
+            std::vector< float > states;                ///< [ G Q 2 W ]
+            std::vector< char > ramping;                ///< [ G ] coefficients of the group are interpolated
+            std::vector< char > initialized;            ///< [ V ] coefficients of the voice have been set
+
+            std::vector< float > work;                  ///< [ maxBlockSize W ] interleaved samples of a group
+            std::vector< float > ramp;                  ///< [ maxBlockSize ]
+
+        private:
+            /// avoid shallow and copy constructor
+            SOFA_AVOID_COPY_CONSTRUCTOR( BiquadFilterBank );
+        };
+
+    }
+
+}
+
+#endif /* _SOFA_BIQUAD_FILTER_BANK_H__ */
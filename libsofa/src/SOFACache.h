@@ -0,0 +1,177 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFACache.h
+ *   @brief      Bounded cache of shared results
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_CACHE_H__
+#define _SOFA_CACHE_H__
+
+#include "../src/SOFAPlatform.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace sofa
+{
+
+    /************************************************************************************/
+    /*!
+     *  @class          Cache
+     *  @brief          Bounded, thread-safe cache of shared results, keyed by a hash
+     *
+     *  @details        Each entry also stores a signature (dimensions and parameters of
+     *                  the computation) that is compared on every hit, so that a collision
+     *                  of the hash gives a miss instead of the result of another computation.
+     *                  Beyond the capacity, the least recently used entries are released
+     *                  (the objects holding them keep theirs).
+     */
+    /************************************************************************************/
+    template< typename T >
+    class Cache
+    {
+    public:
+        typedef std::shared_ptr< const T > Value;
+
+    public:
+        Cache(const std::size_t capacity_ = 16)
+        : capacity( capacity_ )
+        , useCounter( 0 )
+        {
+        }
+
+        /************************************************************************************/
+        /*!
+         *  @brief          Returns the value of a key, or nullptr if there is none or if
+         *                  its signature differs
+         *
+         */
+        /************************************************************************************/
+        Value Find(const unsigned long long key, const std::vector< double > &signature)
+        {
+            std::lock_guard< std::mutex > lock( mutex );
+
+            typename std::map< unsigned long long, Entry >::iterator it = entries.find( key );
+
+            if( it == entries.end() || it->second.signature != signature )
+            {
+                return Value();
+            }
+
+            it->second.lastUse = ++useCounter;
+
+            return it->second.value;
+        }
+
+        /************************************************************************************/
+        /*!
+         *  @brief          Stores a value (replacing the one of the same key) and releases
+         *                  the least recently used entries beyond the capacity
+         *
+         */
+        /************************************************************************************/
+        void Insert(const unsigned long long key, const std::vector< double > &signature, const Value &value)
+        {
+            std::lock_guard< std::mutex > lock( mutex );
+
+            Entry &entry    = entries[ key ];
+            entry.signature = signature;
+            entry.value     = value;
+            entry.lastUse   = ++useCounter;
+
+            while( entries.size() > capacity )
+            {
+                typename std::map< unsigned long long, Entry >::iterator oldest = entries.begin();
+
+                for( typename std::map< unsigned long long, Entry >::iterator it = entries.begin(); it != entries.end(); ++it )
+                {
+                    if( it->second.lastUse < oldest->second.lastUse )
+                    {
+                        oldest = it;
+                    }
+                }
+
+                entries.erase( oldest );
+            }
+        }
+
+        void Clear()
+        {
+            std::lock_guard< std::mutex > lock( mutex );
+            entries.clear();
+        }
+
+        std::size_t GetSize() const
+        {
+            std::lock_guard< std::mutex > lock( mutex );
+            return entries.size();
+        }
+
+        std::size_t GetCapacity() const
+        {
+            return capacity;
+        }
+
+    private:
+        struct Entry
+        {
+            std::vector< double > signature;
+            Value value;
+            unsigned long long lastUse;
+        };
+
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( Cache );
+
+    private:
+        const std::size_t capacity;
+        std::map< unsigned long long, Entry > entries;
+        unsigned long long useCounter;
+        mutable std::mutex mutex;
+    };
+
+}
+
+#endif /* _SOFA_CACHE_H__ */
@@ -0,0 +1,518 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFADirectFilterBank.cpp
+ *   @brief      Direct-form convolution with short FIR filters
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFADirectFilterBank.h"
+#include "../src/SOFAFFT.h"
+#include "../src/SOFASimd.h"
+#include "../src/SOFAExceptions.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <mutex>
+
+using namespace sofa;
+using namespace sofa::dsp;
+
+namespace DirectFilterBankLocal
+{
+    /// measured crossovers, per block size
+    std::map< unsigned int, unsigned int > crossovers;
+    std::mutex mutex;
+
+    /// duration of the benchmark of one configuration
+    const std::chrono::milliseconds kBenchmarkDuration( 2 );
+
+    /// longest filter length tried by MeasureCrossover
+    const unsigned int kMaxCrossover = 2048;
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Convolves NC channels of a group
+     *  @param[in]      x : current input ; x + n - k is valid for k < L
+     *  @param[in]      h : [ L C ] coefficients of the group, from channel c0
+     *
+     */
+    /************************************************************************************/
+    template< unsigned int NC >
+    void Convolve(float *const *outputs,
+                  const float *x,
+                  const float *h,
+                  const unsigned int C,
+                  const unsigned int L,
+                  const unsigned int numSamples)
+    {
+        using namespace sofa::Simd;
+
+        const unsigned int W = static_cast< unsigned int >( kVectorSize );
+
+        unsigned int n = 0;
+
+        /// two vectors of output per channel, for independent accumulations
+        for( ; n + 2 * W <= numSamples; n += 2 * W )
+        {
+            Vector acc0[ NC ];
+            Vector acc1[ NC ];
+
+            for( unsigned int c = 0; c < NC; c++ )
+            {
+                acc0[c] = Set( 0.0f );
+                acc1[c] = Set( 0.0f );
+            }
+
+            for( unsigned int k = 0; k < L; k++ )
+            {
+                const Vector x0 = Load( x + n - k );
+                const Vector x1 = Load( x + n + W - k );
+
+                for( unsigned int c = 0; c < NC; c++ )
+                {
+                    const Vector coefficient = Set( h[ k * C + c ] );
+
+                    acc0[c] = MultiplyAdd( acc0[c], coefficient, x0 );
+                    acc1[c] = MultiplyAdd( acc1[c], coefficient, x1 );
+                }
+            }
+
+            for( unsigned int c = 0; c < NC; c++ )
+            {
+                Store( outputs[c] + n, acc0[c] );
+                Store( outputs[c] + n + W, acc1[c] );
+            }
+        }
+
+        for( ; n + W <= numSamples; n += W )
+        {
+            Vector acc[ NC ];
+
+            for( unsigned int c = 0; c < NC; c++ )
+            {
+                acc[c] = Set( 0.0f );
+            }
+
+            for( unsigned int k = 0; k < L; k++ )
+            {
+                const Vector x0 = Load( x + n - k );
+
+                for( unsigned int c = 0; c < NC; c++ )
+                {
+                    acc[c] = MultiplyAdd( acc[c], Set( h[ k * C + c ] ), x0 );
+                }
+            }
+
+            for( unsigned int c = 0; c < NC; c++ )
+            {
+                Store( outputs[c] + n, acc[c] );
+            }
+        }
+
+        for( ; n < numSamples; n++ )
+        {
+            const float *xn = x + n;
+
+            for( unsigned int c = 0; c < NC; c++ )
+            {
+                float sum = 0.0f;
+
+                for( unsigned int k = 0; k < L; k++ )
+                {
+                    sum += h[ k * C + c ] * *( xn - k );
+                }
+
+                outputs[c][n] = sum;
+            }
+        }
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Returns the best time of a function called repeatedly for a while
+     *
+     */
+    /************************************************************************************/
+    template< typename Function >
+    double Benchmark(Function function)
+    {
+        double best = -1.0;
+
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        while( std::chrono::steady_clock::now() - start < kBenchmarkDuration )
+        {
+            const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+
+            function();
+
+            const double elapsed = std::chrono::duration< double >( std::chrono::steady_clock::now() - t0 ).count();
+
+            if( best < 0.0 || elapsed < best )
+            {
+                best = elapsed;
+            }
+        }
+
+        return best;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+DirectFilterBank::DirectFilterBank()
+: numGroups( 0 )
+, numChannels( 0 )
+, filterLength( 0 )
+, maxBlockSize( 0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Stores the filters in interleaved layout, and clears the input
+ *  @param[in]      filters : [ G C L ]
+ *  @param[in]      numGroups_ : G
+ *  @param[in]      numChannels_ : C
+ *  @param[in]      filterLength_ : L
+ *  @param[in]      maxBlockSize_ : largest number of samples per call to Process
+ *
+ */
+/************************************************************************************/
+void DirectFilterBank::Prepare(const double *filters,
+                               const std::size_t numGroups_,
+                               const unsigned int numChannels_,
+                               const unsigned int filterLength_,
+                               const unsigned int maxBlockSize_)
+{
+    if( numGroups_ == 0 || numChannels_ == 0 || filterLength_ == 0 || maxBlockSize_ == 0 )
+    {
+        SOFA_THROW( "invalid filter bank dimensions" );
+    }
+
+    numGroups       = numGroups_;
+    numChannels     = numChannels_;
+    filterLength    = filterLength_;
+    maxBlockSize    = maxBlockSize_;
+
+    const std::size_t G = numGroups;
+    const unsigned int C = numChannels;
+    const unsigned int L = filterLength;
+
+    coefficients.resize( G * L * C );
+
+    for( std::size_t g = 0; g < G; g++ )
+    {
+        for( unsigned int c = 0; c < C; c++ )
+        {
+            const double *h = filters + ( g * C + c ) * L;
+
+            for( unsigned int k = 0; k < L; k++ )
+            {
+                coefficients[ ( g * L + k ) * C + c ] = static_cast< float >( h[k] );
+            }
+        }
+    }
+
+    buffer.assign( L - 1 + maxBlockSize, 0.0f );
+}
+
+std::size_t DirectFilterBank::GetNumGroups() const
+{
+    return numGroups;
+}
+
+unsigned int DirectFilterBank::GetNumChannels() const
+{
+    return numChannels;
+}
+
+unsigned int DirectFilterBank::GetFilterLength() const
+{
+    return filterLength;
+}
+
+unsigned int DirectFilterBank::GetMaxBlockSize() const
+{
+    return maxBlockSize;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Convolves a block of input with the filters of a group
+ *  @param[out]     outputs : one buffer of numSamples samples per channel
+ *  @param[in]      input : numSamples samples
+ *  @param[in]      numSamples : at most the maximum block size
+ *  @param[in]      group : index of the group
+ *  @return         false if numSamples or group is out of range (nothing is done)
+ *
+ *  @details        The input history is shared by the groups, so the group can change
+ *                  from one block to the next
+ */
+/************************************************************************************/
+bool DirectFilterBank::Process(float *const *outputs,
+                               const float *input,
+                               const unsigned int numSamples,
+                               const std::size_t group)
+{
+    if( numSamples > maxBlockSize || group >= numGroups )
+    {
+        SOFA_ASSERT( false );
+        return false;
+    }
+
+    const unsigned int L = filterLength;
+
+    std::copy( input, input + numSamples, buffer.begin() + ( L - 1 ) );
+
+    convolveGroup( outputs, numSamples, group );
+
+    /// keep the last L-1 input samples
+    std::memmove( &buffer[0], &buffer[ numSamples ], ( L - 1 ) * sizeof( float ) );
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Convolves a block of input with the filters of two groups (e.g. for
+ *                  a crossfade between two measurements)
+ *  @param[out]     outputs : one buffer of numSamples samples per channel, for group
+ *  @param[out]     otherOutputs : one buffer of numSamples samples per channel, for otherGroup
+ *  @param[in]      input : numSamples samples
+ *  @param[in]      numSamples : at most the maximum block size
+ *  @return         false if numSamples or a group is out of range (nothing is done)
+ *
+ */
+/************************************************************************************/
+bool DirectFilterBank::Process(float *const *outputs,
+                               float *const *otherOutputs,
+                               const float *input,
+                               const unsigned int numSamples,
+                               const std::size_t group,
+                               const std::size_t otherGroup)
+{
+    if( numSamples > maxBlockSize || group >= numGroups || otherGroup >= numGroups )
+    {
+        SOFA_ASSERT( false );
+        return false;
+    }
+
+    const unsigned int L = filterLength;
+
+    std::copy( input, input + numSamples, buffer.begin() + ( L - 1 ) );
+
+    convolveGroup( outputs, numSamples, group );
+    convolveGroup( otherOutputs, numSamples, otherGroup );
+
+    std::memmove( &buffer[0], &buffer[ numSamples ], ( L - 1 ) * sizeof( float ) );
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Convolves the current block (in the buffer) with the filters of a group
+ *
+ */
+/************************************************************************************/
+void DirectFilterBank::convolveGroup(float *const *outputs,
+                                     const unsigned int numSamples,
+                                     const std::size_t group) const
+{
+    const unsigned int C = numChannels;
+    const unsigned int L = filterLength;
+
+    const float *x = &buffer[ L - 1 ];
+    const float *h = &coefficients[ group * L * C ];
+
+    /// the channels by 4, then the remaining ones
+    unsigned int c = 0;
+
+    for( ; c + 4 <= C; c += 4 )
+    {
+        DirectFilterBankLocal::Convolve< 4 >( outputs + c, x, h + c, C, L, numSamples );
+    }
+
+    switch( C - c )
+    {
+        case 3 : DirectFilterBankLocal::Convolve< 3 >( outputs + c, x, h + c, C, L, numSamples ); break;
+        case 2 : DirectFilterBankLocal::Convolve< 2 >( outputs + c, x, h + c, C, L, numSamples ); break;
+        case 1 : DirectFilterBankLocal::Convolve< 1 >( outputs + c, x, h + c, C, L, numSamples ); break;
+        default : break;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Clears the input history
+ *
+ */
+/************************************************************************************/
+void DirectFilterBank::Reset()
+{
+    std::fill( buffer.begin(), buffer.end(), 0.0f );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Measures the longest filter for which the direct form is faster than
+ *                  the uniformly partitioned FFT convolution, for a given block size
+ *  @param[in]      blockSize : number of samples per block, a power of two
+ *  @param[in]      numChannels_ : number of filters applied to the same input
+ *  @return         a filter length (a power of two), 0 if the FFT is always faster
+ *
+ *  @details        Both methods are benchmarked on the host for lengths 8, 16, 32...
+ *                  The FFT cost is one forward transform, then per channel one complex
+ *                  multiply-accumulate per partition and one inverse transform.
+ */
+/************************************************************************************/
+unsigned int DirectFilterBank::MeasureCrossover(const unsigned int blockSize,
+                                                const unsigned int numChannels_)
+{
+    if( sofa::dsp::FFT::IsPowerOfTwo( blockSize ) == false || blockSize < 2 || numChannels_ == 0 )
+    {
+        SOFA_THROW( "invalid crossover configuration" );
+    }
+
+    const unsigned int B = blockSize;
+    const unsigned int K = B + 1;
+    const unsigned int C = numChannels_;
+
+    sofa::dsp::FFT fft( 2 * B );
+
+    std::vector< float > input( B, 0.5f );
+    std::vector< float > frame( 2 * B, 0.5f );
+    std::vector< float > outputs( C * 2 * B, 0.0f );
+    std::vector< float * > outputPointers( C );
+
+    for( unsigned int c = 0; c < C; c++ )
+    {
+        outputPointers[c] = &outputs[ c * 2 * B ];
+    }
+
+    unsigned int crossover = 0;
+
+    for( unsigned int L = 8; L <= DirectFilterBankLocal::kMaxCrossover; L *= 2 )
+    {
+        const unsigned int P = ( L + B - 1 ) / B;
+
+        std::vector< double > filters( C * L, 0.01 );
+        sofa::dsp::DirectFilterBank direct;
+        direct.Prepare( &filters[0], 1, C, L, B );
+
+        std::vector< float > spectraRe( P * K, 0.1f );
+        std::vector< float > spectraIm( P * K, 0.1f );
+        std::vector< float > accRe( K, 0.0f );
+        std::vector< float > accIm( K, 0.0f );
+
+        const double directTime = DirectFilterBankLocal::Benchmark( [ & ]()
+        {
+            direct.Process( &outputPointers[0], &input[0], B );
+        } );
+
+        const double fftTime = DirectFilterBankLocal::Benchmark( [ & ]()
+        {
+            fft.Forward( &spectraRe[0], &spectraIm[0], &frame[0] );
+
+            for( unsigned int c = 0; c < C; c++ )
+            {
+                std::fill( accRe.begin(), accRe.end(), 0.0f );
+                std::fill( accIm.begin(), accIm.end(), 0.0f );
+
+                for( unsigned int p = 0; p < P; p++ )
+                {
+                    sofa::Simd::ComplexMultiplyAccumulate( &accRe[0], &accIm[0],
+                                                           &spectraRe[ p * K ], &spectraIm[ p * K ],
+                                                           &spectraRe[ p * K ], &spectraIm[ p * K ],
+                                                           K );
+                }
+
+                fft.Inverse( outputPointers[c], &accRe[0], &accIm[0] );
+            }
+        } );
+
+        if( directTime >= fftTime )
+        {
+            break;
+        }
+
+        crossover = L;
+    }
+
+    return crossover;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Crossover for a block size and two channels (binaural rendering),
+ *                  measured once and then cached
+ *
+ */
+/************************************************************************************/
+unsigned int DirectFilterBank::GetCrossover(const unsigned int blockSize)
+{
+    {
+        std::lock_guard< std::mutex > lock( DirectFilterBankLocal::mutex );
+
+        std::map< unsigned int, unsigned int >::const_iterator it = DirectFilterBankLocal::crossovers.find( blockSize );
+
+        if( it != DirectFilterBankLocal::crossovers.end() )
+        {
+            return it->second;
+        }
+    }
+
+    const unsigned int crossover = MeasureCrossover( blockSize, 2 );
+
+    std::lock_guard< std::mutex > lock( DirectFilterBankLocal::mutex );
+
+    DirectFilterBankLocal::crossovers[ blockSize ] = crossover;
+
+    return crossover;
+}
@@ -0,0 +1,137 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFADirectFilterBank.h
+ *   @brief      Direct-form convolution with short FIR filters
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_DIRECT_FILTER_BANK_H__
+#define _SOFA_DIRECT_FILTER_BANK_H__
+
+#include "../src/SOFAPlatform.h"
+
+namespace sofa
+{
+
+    namespace dsp
+    {
+
+        /************************************************************************************/
+        /*!
+         *  @class          DirectFilterBank
+         *  @brief          Direct-form (time-domain) convolution with short FIR filters
+         *
+         *  @details        The filters are organized in groups of channels (e.g. one group per
+         *                  measurement, one channel per ear). The coefficients of a group are
+         *                  interleaved by channel ( [ L C ] ), so that the channels of a group
+         *                  are computed together from the same input samples. The kernel is
+         *                  vectorized over time (sofa::Simd::Vector).
+         *
+         *                  For short filters, this is faster than a partitioned FFT convolution
+         *                  and has no latency; GetCrossover measures the limit on the host.
+         *                  Process does not allocate.
+         */
+        /************************************************************************************/
+        class SOFA_API DirectFilterBank
+        {
+        public:
+            DirectFilterBank();
+            ~DirectFilterBank() {};
+
+            void Prepare(const double *filters,
+                         const std::size_t numGroups,
+                         const unsigned int numChannels,
+                         const unsigned int filterLength,
+                         const unsigned int maxBlockSize);
+
+            //==============================================================================
+            std::size_t GetNumGroups() const;
+            unsigned int GetNumChannels() const;
+            unsigned int GetFilterLength() const;
+            unsigned int GetMaxBlockSize() const;
+
+            //==============================================================================
+            bool Process(float *const *outputs,
+                         const float *input,
+                         const unsigned int numSamples,
+                         const std::size_t group = 0);
+
+            bool Process(float *const *outputs,
+                         float *const *otherOutputs,
+                         const float *input,
+                         const unsigned int numSamples,
+                         const std::size_t group,
+                         const std::size_t otherGroup);
+
+            void Reset();
+
+            //==============================================================================
+            static unsigned int MeasureCrossover(const unsigned int blockSize,
+                                                 const unsigned int numChannels = 2);
+
+            static unsigned int GetCrossover(const unsigned int blockSize);
+
+        private:
+            void convolveGroup(float *const *outputs,
+                               const unsigned int numSamples,
+                               const std::size_t group) const;
+
+        private:
+            std::size_t numGroups;
+            unsigned int numChannels;
+            unsigned int filterLength;
+            unsigned int maxBlockSize;
+
+            std::vector< float > coefficients;      ///< [ G L C ]
+            std::vector< float > buffer;            ///< [ L-1 + maxBlockSize ] past and current input
+
+        private:
+            /// avoid shallow and copy constructor
+            SOFA_AVOID_COPY_CONSTRUCTOR( DirectFilterBank );
+        };
+
+    }
+
+}
+
+#endif /* _SOFA_DIRECT_FILTER_BANK_H__ */
@@ -0,0 +1,712 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAEarlyLateDecomposition.cpp
+ *   @brief      Split of room impulse responses into early parts and a shared tail
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAEarlyLateDecomposition.h"
+#include "../src/SOFAFractionalDelayLine.h"
+#include "../src/SOFAParallel.h"
+#include "../src/SOFAExceptions.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+namespace EarlyLateDecompositionLocal
+{
+    const double kPi = 3.14159265358979323846;
+
+    /// fraction of the samples of gaussian noise beyond one standard deviation : erfc( 1 / sqrt( 2 ) )
+    const double kGaussianEchoDensity = 0.317310507862914;
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Expands Data.Delay ( [ I R E ] or [ M R E ] ) to [ M R E ], and returns
+     *                  the length of the delayed IRs
+     *  @return         false if Data.Delay has not the expected size
+     *
+     */
+    /************************************************************************************/
+    inline bool getDelays(std::vector< double > &delays,
+                          std::size_t &length,
+                          const std::vector< double > &delay,
+                          const std::size_t numMeasurements,
+                          const std::size_t numChannels,
+                          const std::size_t numDataSamples)
+    {
+        const bool delayVaries = ( delay.size() == numMeasurements * numChannels );
+
+        if( delayVaries == false && delay.size() != numChannels )
+        {
+            return false;
+        }
+
+        delays.resize( numMeasurements * numChannels );
+        length = numDataSamples;
+
+        for( std::size_t i = 0; i < delays.size(); i++ )
+        {
+            delays[i] = delay[ ( delayVaries == true ) ? i : i % numChannels ];
+            length    = std::max( length, sofa::dsp::FractionalDelayLine::GetDelayedLength( numDataSamples, delays[i] ) );
+        }
+
+        return true;
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Delays IRs [ K N ] into filters [ K length ] (fractional delays are
+     *                  interpolated)
+     *
+     */
+    /************************************************************************************/
+    inline void applyDelays(std::vector< double > &filters,
+                            const double *irs,
+                            const double *delays,
+                            const std::size_t numChannels,
+                            const std::size_t numDataSamples,
+                            const std::size_t length)
+    {
+        filters.resize( numChannels * length );
+
+        for( std::size_t k = 0; k < numChannels; k++ )
+        {
+            sofa::dsp::FractionalDelayLine::ApplyDelay( &filters[ k * length ], length, irs + k * numDataSamples, numDataSamples, delays[k] );
+        }
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Time (in samples) at which the normalized echo density of an IR
+     *                  reaches 1, or length if it never does
+     *  @param[in]      h : the IR
+     *  @param[in]      length : number of samples
+     *  @param[in]      window : length of the sliding window
+     *
+     */
+    /************************************************************************************/
+    inline std::size_t estimateMixingTime(const double *h,
+                                          const std::size_t length,
+                                          const std::size_t window)
+    {
+        const std::size_t hop = std::max< std::size_t >( 1, window / 4 );
+
+        for( std::size_t start = 0; start + window <= length; start += hop )
+        {
+            double energy = 0.0;
+            for( std::size_t n = start; n < start + window; n++ )
+            {
+                energy += h[n] * h[n];
+            }
+
+            if( energy <= 0.0 )
+            {
+                continue;
+            }
+
+            const double sigma = std::sqrt( energy / static_cast< double >( window ) );
+
+            std::size_t count = 0;
+            for( std::size_t n = start; n < start + window; n++ )
+            {
+                count += ( std::fabs( h[n] ) > sigma ) ? 1 : 0;
+            }
+
+            const double density = static_cast< double >( count ) / static_cast< double >( window ) / kGaussianEchoDensity;
+
+            if( density >= 1.0 )
+            {
+                return start + window / 2;
+            }
+        }
+
+        return length;
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Power-complementary crossfade : fade out of the early part (the fade
+     *                  in of the tail is sqrt( 1 - g^2 ))
+     *
+     */
+    /************************************************************************************/
+    inline double fadeOut(const std::size_t n,
+                          const std::size_t length)
+    {
+        return std::cos( 0.5 * kPi * ( static_cast< double >( n ) + 0.5 ) / static_cast< double >( length ) );
+    }
+
+    inline double fadeIn(const std::size_t n,
+                         const std::size_t length)
+    {
+        return std::sin( 0.5 * kPi * ( static_cast< double >( n ) + 0.5 ) / static_cast< double >( length ) );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+EarlyLateDecomposition::EarlyLateDecomposition()
+: windowLength( 0.02 )
+, crossfadeLength( 0.005 )
+, maxMixingTime( 0.25 )
+, numMeasurements( 0 )
+, numReceivers( 0 )
+, numEmitters( 0 )
+, numDataSamples( 0 )
+, samplingRate( 0.0 )
+, mixingTime( 0 )
+, earlyLength( 0 )
+, tailOffset( 0 )
+, maxTailDeviation( 0.0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Length of the sliding window of the echo density (default 20 ms)
+ *
+ */
+/************************************************************************************/
+void EarlyLateDecomposition::SetWindowLength(const double seconds)
+{
+    windowLength = std::max( 0.0, seconds );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Length of the crossfade between the early part and the tail,
+ *                  centered on the mixing time (default 5 ms)
+ *
+ */
+/************************************************************************************/
+void EarlyLateDecomposition::SetCrossfadeLength(const double seconds)
+{
+    crossfadeLength = std::max( 0.0, seconds );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Upper bound of the mixing time (default 250 ms)
+ *
+ */
+/************************************************************************************/
+void EarlyLateDecomposition::SetMaxMixingTime(const double seconds)
+{
+    maxMixingTime = std::max( 0.0, seconds );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Splits the BRIRs of a MultiSpeakerBRIR file
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool EarlyLateDecomposition::Compute(const sofa::MultiSpeakerBRIR &file)
+{
+    using namespace EarlyLateDecompositionLocal;
+
+    const long M = file.GetNumMeasurements();
+    const long R = file.GetNumReceivers();
+    const long E = file.GetNumEmitters();
+    const long N = file.GetNumDataSamples();
+
+    double fs = 0.0;
+    std::vector< double > delay;
+
+    if( M <= 0 || R <= 0 || E <= 0 || N <= 0
+       || file.GetSamplingRate( fs ) == false
+       || file.GetValues( delay, "Data.Delay" ) == false )
+    {
+        SOFA_THROW( "cannot read the BRIRs" );
+        return false;
+    }
+
+    std::vector< double > delays;
+    std::size_t length = 0;
+
+    if( getDelays( delays, length, delay, M, R * E, N ) == false )
+    {
+        SOFA_THROW( "invalid 'Data.Delay' dimensions" );
+        return false;
+    }
+
+    const Reader reader = [ & ]( const unsigned long measurement, std::vector< double > &filters )
+    {
+        /// only the slab of this measurement is read
+        std::vector< double > slab;
+
+        if( file.GetDataIR( slab, measurement ) == false )
+        {
+            return false;
+        }
+
+        applyDelays( filters, &slab[0], &delays[ measurement * R * E ], R * E, N, length );
+
+        return true;
+    };
+
+    return compute( reader, M, R, E, length, fs );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Splits the DRIRs of a SingleRoomDRIR file
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool EarlyLateDecomposition::Compute(const sofa::SingleRoomDRIR &file)
+{
+    using namespace EarlyLateDecompositionLocal;
+
+    const long M = file.GetNumMeasurements();
+    const long R = file.GetNumReceivers();
+    const long N = file.GetNumDataSamples();
+
+    double fs = 0.0;
+    std::vector< double > delay;
+
+    if( M <= 0 || R <= 0 || N <= 0
+       || file.GetSamplingRate( fs ) == false
+       || file.GetDataDelay( delay ) == false )
+    {
+        SOFA_THROW( "cannot read the DRIRs" );
+        return false;
+    }
+
+    std::vector< double > delays;
+    std::size_t length = 0;
+
+    if( getDelays( delays, length, delay, M, R, N ) == false )
+    {
+        SOFA_THROW( "invalid 'Data.Delay' dimensions" );
+        return false;
+    }
+
+    const Reader reader = [ & ]( const unsigned long measurement, std::vector< double > &filters )
+    {
+        /// only the slab of this measurement is read
+        std::vector< double > slab;
+
+        if( file.GetDataIR( slab, measurement ) == false )
+        {
+            return false;
+        }
+
+        applyDelays( filters, &slab[0], &delays[ measurement * R ], R, N, length );
+
+        return true;
+    };
+
+    return compute( reader, M, R, 1, length, fs );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Estimates the mixing time, keeps the early parts and extracts the
+ *                  shared tails
+ *  @param[in]      reader : returns the IRs [ R E N ] of one measurement
+ *
+ *  @details        Each measurement is read once ; the measurements holding the
+ *                  representative tails (at most one per receiver) are read a second time
+ */
+/************************************************************************************/
+bool EarlyLateDecomposition::compute(const Reader &reader,
+                                     const unsigned long M,
+                                     const unsigned long R,
+                                     const unsigned long E,
+                                     const unsigned long N,
+                                     const double fs)
+{
+    using namespace EarlyLateDecompositionLocal;
+
+    const std::size_t RE = R * E;
+
+    const std::size_t window = std::max< std::size_t >( 16, static_cast< std::size_t >( std::floor( windowLength * fs + 0.5 ) ) );
+    const std::size_t fade   = std::max< std::size_t >( 1, static_cast< std::size_t >( std::floor( crossfadeLength * fs + 0.5 ) ) );
+    const std::size_t bound  = std::min< std::size_t >( N, static_cast< std::size_t >( std::floor( maxMixingTime * fs + 0.5 ) ) );
+
+    /// the early parts end before the maximum mixing time plus the crossfade : only these
+    /// heads are kept, with the energy of the rest of each IR
+    const std::size_t H = std::min< std::size_t >( N, bound + fade );
+
+    std::vector< double > filters;
+    std::vector< double > heads( M * RE * H );
+    std::vector< double > restEnergies( M * RE );
+
+    //==============================================================================
+    /// mixing time of each IR ; each measurement is read once
+    std::vector< double > newMixingTimes( M * RE );
+
+    double meanMixingTime = 0.0;
+
+    for( unsigned long m = 0; m < M; m++ )
+    {
+        if( reader( m, filters ) == false )
+        {
+            SOFA_THROW( "cannot read the IRs" );
+            return false;
+        }
+
+        sofa::Parallel::For( 0, RE, [ & ]( const std::size_t first, const std::size_t last )
+        {
+            for( std::size_t i = first; i < last; i++ )
+            {
+                const double *h = &filters[ i * N ];
+
+                newMixingTimes[ m * RE + i ] = static_cast< double >( estimateMixingTime( h, N, window ) );
+
+                std::copy( h, h + H, &heads[ ( m * RE + i ) * H ] );
+
+                double energy = 0.0;
+                for( std::size_t n = H; n < N; n++ )
+                {
+                    energy += h[n] * h[n];
+                }
+
+                restEnergies[ m * RE + i ] = energy;
+            }
+        } );
+
+        for( std::size_t i = 0; i < RE; i++ )
+        {
+            meanMixingTime += newMixingTimes[ m * RE + i ];
+        }
+    }
+
+    meanMixingTime /= static_cast< double >( M * RE );
+
+    /// the estimates of the IRs fluctuate : their mean is used
+    const std::size_t newMixingTime = std::min( bound, static_cast< std::size_t >( std::floor( meanMixingTime + 0.5 ) ) );
+
+    /// the crossfade is centered on the mixing time ; without room for a tail, the IRs are kept whole
+    std::size_t newTailOffset   = ( newMixingTime > fade / 2 ) ? newMixingTime - fade / 2 : 0;
+    std::size_t newEarlyLength  = newTailOffset + fade;
+
+    if( newEarlyLength >= N )
+    {
+        newTailOffset  = N;
+        newEarlyLength = N;
+    }
+
+    const std::size_t fadeLength = newEarlyLength - std::min( newEarlyLength, newTailOffset );
+
+    //==============================================================================
+    /// early parts, and late energy of each IR, from the heads
+    std::vector< double > newEarly( M * RE * newEarlyLength );
+    std::vector< double > lateEnergies( M * RE, 0.0 );
+
+    for( std::size_t i = 0; i < M * RE; i++ )
+    {
+        const double *h = &heads[ i * H ];
+        double *y       = &newEarly[ i * newEarlyLength ];
+
+        std::copy( h, h + newEarlyLength, y );
+
+        double energy = restEnergies[i];
+
+        for( std::size_t n = 0; n < fadeLength; n++ )
+        {
+            y[ newTailOffset + n ] *= fadeOut( n, fadeLength );
+
+            const double late = h[ newTailOffset + n ] * fadeIn( n, fadeLength );
+            energy += late * late;
+        }
+
+        for( std::size_t n = newEarlyLength; n < H; n++ )
+        {
+            energy += h[n] * h[n];
+        }
+
+        lateEnergies[i] = energy;
+    }
+
+    std::vector< double >().swap( heads );
+
+    //==============================================================================
+    /// shared tails : the IR with the median late energy, scaled to the mean late energy
+    const std::size_t tailLength = N - newTailOffset;
+
+    std::vector< double > newTails( R * tailLength, 0.0 );
+    std::vector< std::size_t > representatives( R, 0 );       ///< [ R ] index m * E + e
+    std::vector< double > gains( R, 0.0 );
+
+    double deviation = 0.0;
+
+    for( unsigned long r = 0; r < R && tailLength > 0; r++ )
+    {
+        std::vector< double > energies;
+        energies.reserve( M * E );
+
+        double mean = 0.0;
+
+        for( unsigned long m = 0; m < M; m++ )
+        {
+            for( unsigned long e = 0; e < E; e++ )
+            {
+                energies.push_back( lateEnergies[ ( m * R + r ) * E + e ] );
+                mean += energies.back();
+            }
+        }
+
+        mean /= static_cast< double >( energies.size() );
+
+        std::vector< double > sorted( energies );
+        std::nth_element( sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end() );
+
+        const double median = sorted[ sorted.size() / 2 ];
+
+        std::size_t representative = 0;
+
+        for( std::size_t i = 0; i < energies.size(); i++ )
+        {
+            if( std::fabs( energies[i] - median ) < std::fabs( energies[ representative ] - median ) )
+            {
+                representative = i;
+            }
+
+            if( energies[i] > 0.0 && mean > 0.0 )
+            {
+                deviation = std::max( deviation, std::fabs( 10.0 * std::log10( energies[i] / mean ) ) );
+            }
+        }
+
+        representatives[r]  = representative;
+        gains[r]            = ( energies[ representative ] > 0.0 ) ? std::sqrt( mean / energies[ representative ] ) : 0.0;
+    }
+
+    /// the measurements holding the representative tails are read again, once each
+    std::vector< unsigned long > receivers( R );
+    for( unsigned long r = 0; r < R; r++ )
+    {
+        receivers[r] = r;
+    }
+
+    std::sort( receivers.begin(), receivers.end(), [ & ]( const unsigned long a, const unsigned long b )
+    {
+        return representatives[a] / E < representatives[b] / E;
+    } );
+
+    long loaded = -1;
+
+    for( std::size_t k = 0; k < R && tailLength > 0; k++ )
+    {
+        const unsigned long r = receivers[k];
+        const unsigned long m = static_cast< unsigned long >( representatives[r] / E );
+        const unsigned long e = static_cast< unsigned long >( representatives[r] % E );
+
+        if( loaded != static_cast< long >( m ) )
+        {
+            if( reader( m, filters ) == false )
+            {
+                SOFA_THROW( "cannot read the IRs" );
+                return false;
+            }
+
+            loaded = static_cast< long >( m );
+        }
+
+        const double *h = &filters[ ( r * E + e ) * N ] + newTailOffset;
+        double *y       = &newTails[ r * tailLength ];
+
+        for( std::size_t n = 0; n < tailLength; n++ )
+        {
+            y[n] = gains[r] * h[n] * ( ( n < fadeLength ) ? fadeIn( n, fadeLength ) : 1.0 );
+        }
+    }
+
+    //==============================================================================
+    numMeasurements     = M;
+    numReceivers        = R;
+    numEmitters         = E;
+    numDataSamples      = N;
+    samplingRate        = fs;
+    mixingTime          = static_cast< unsigned long >( newMixingTime );
+    earlyLength         = static_cast< unsigned long >( newEarlyLength );
+    tailOffset          = static_cast< unsigned long >( newTailOffset );
+    maxTailDeviation    = deviation;
+
+    mixingTimes.swap( newMixingTimes );
+    early.swap( newEarly );
+    tails.swap( newTails );
+
+    return true;
+}
+
+unsigned long EarlyLateDecomposition::GetNumMeasurements() const
+{
+    return numMeasurements;
+}
+
+unsigned long EarlyLateDecomposition::GetNumReceivers() const
+{
+    return numReceivers;
+}
+
+unsigned long EarlyLateDecomposition::GetNumEmitters() const
+{
+    return numEmitters;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Length of the IRs (Data.IR plus the largest delay)
+ *
+ */
+/************************************************************************************/
+unsigned long EarlyLateDecomposition::GetNumDataSamples() const
+{
+    return numDataSamples;
+}
+
+double EarlyLateDecomposition::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Mixing time used for all the IRs, in seconds
+ *
+ */
+/************************************************************************************/
+double EarlyLateDecomposition::GetMixingTime() const
+{
+    return ( samplingRate > 0.0 ) ? static_cast< double >( mixingTime ) / samplingRate : 0.0;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Mixing time estimated for one IR, in seconds
+ *
+ */
+/************************************************************************************/
+double EarlyLateDecomposition::GetMixingTime(const unsigned long measurement,
+                                             const unsigned long receiver,
+                                             const unsigned long emitter) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers && emitter < numEmitters );
+
+    return mixingTimes[ ( measurement * numReceivers + receiver ) * numEmitters + emitter ] / samplingRate;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Length of the early parts, in samples (up to the end of the crossfade)
+ *
+ */
+/************************************************************************************/
+unsigned long EarlyLateDecomposition::GetEarlyLength() const
+{
+    return earlyLength;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the early part of one IR (GetEarlyLength samples, Data.Delay
+ *                  included)
+ *
+ */
+/************************************************************************************/
+const double * EarlyLateDecomposition::GetEarly(const unsigned long measurement,
+                                                const unsigned long receiver,
+                                                const unsigned long emitter) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers && emitter < numEmitters );
+
+    return &early[ ( ( measurement * numReceivers + receiver ) * numEmitters + emitter ) * earlyLength ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Time (in samples) of the first sample of the tails
+ *
+ */
+/************************************************************************************/
+unsigned long EarlyLateDecomposition::GetTailOffset() const
+{
+    return tailOffset;
+}
+
+unsigned long EarlyLateDecomposition::GetTailLength() const
+{
+    return numDataSamples - tailOffset;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the tail shared by all the IRs of one receiver (GetTailLength
+ *                  samples, starting at GetTailOffset), or nullptr if there is no tail
+ *
+ */
+/************************************************************************************/
+const double * EarlyLateDecomposition::GetTail(const unsigned long receiver) const
+{
+    SOFA_ASSERT( receiver < numReceivers );
+
+    if( GetTailLength() == 0 )
+    {
+        return nullptr;
+    }
+
+    return &tails[ receiver * GetTailLength() ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Largest deviation (in dB) of the late energy of an IR from the energy
+ *                  of the shared tail
+ *
+ */
+/************************************************************************************/
+double EarlyLateDecomposition::GetMaxTailDeviation() const
+{
+    return maxTailDeviation;
+}
@@ -0,0 +1,161 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAEarlyLateDecomposition.h
+ *   @brief      Split of room impulse responses into early parts and a shared tail
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_EARLY_LATE_DECOMPOSITION_H__
+#define _SOFA_EARLY_LATE_DECOMPOSITION_H__
+
+#include "../src/SOFAMultiSpeakerBRIR.h"
+#include "../src/SOFASingleRoomDRIR.h"
+#include <functional>
+
+namespace sofa
+{
+
+    /************************************************************************************/
+    /*!
+     *  @class          EarlyLateDecomposition
+     *  @brief          Split of room impulse responses into direction-dependent early parts
+     *                  and a late reverberation tail shared by all the measurements
+     *
+     *  @details        The mixing time of each IR (Data.Delay included) is estimated as the
+     *                  time at which its normalized echo density reaches 1 (Abel and Huang :
+     *                  fraction of the samples of a sliding window above its standard
+     *                  deviation, divided by the value expected for gaussian noise). The mean
+     *                  of the estimates, bounded by a maximum mixing time, is used for all the
+     *                  IRs.
+     *
+     *                  The early parts (up to the mixing time, with a raised-cosine fade out)
+     *                  are kept for every measurement, receiver and emitter. The late part is
+     *                  the same for all of them up to its level : for each receiver, the tail
+     *                  of the IR whose late energy is the median one is kept (with the
+     *                  complementary fade in), scaled to the mean late energy. The deviation of
+     *                  the late energy of each IR from that mean measures the approximation.
+     *
+     *                  The files are read one measurement at a time, and each measurement
+     *                  once : only the first samples of the IRs (maximum mixing time plus
+     *                  crossfade) and the energy of the rest are kept ; the measurements of
+     *                  the selected tails are read again. The IRs of each measurement are
+     *                  processed in parallel (sofa::Parallel).
+     */
+    /************************************************************************************/
+    class SOFA_API EarlyLateDecomposition
+    {
+    public:
+        EarlyLateDecomposition();
+        ~EarlyLateDecomposition() {};
+
+        //==============================================================================
+        void SetWindowLength(const double seconds);
+        void SetCrossfadeLength(const double seconds);
+        void SetMaxMixingTime(const double seconds);
+
+        //==============================================================================
+        bool Compute(const sofa::MultiSpeakerBRIR &file);
+        bool Compute(const sofa::SingleRoomDRIR &file);
+
+        //==============================================================================
+        unsigned long GetNumMeasurements() const;
+        unsigned long GetNumReceivers() const;
+        unsigned long GetNumEmitters() const;
+        unsigned long GetNumDataSamples() const;
+        double GetSamplingRate() const;
+
+        double GetMixingTime() const;
+        double GetMixingTime(const unsigned long measurement,
+                             const unsigned long receiver,
+                             const unsigned long emitter) const;
+
+        unsigned long GetEarlyLength() const;
+        const double * GetEarly(const unsigned long measurement,
+                                const unsigned long receiver,
+                                const unsigned long emitter) const;
+
+        unsigned long GetTailOffset() const;
+        unsigned long GetTailLength() const;
+        const double * GetTail(const unsigned long receiver) const;
+
+        double GetMaxTailDeviation() const;
+
+    private:
+        /// reads the IRs [ R E N ] of one measurement, delayed by Data.Delay
+        typedef std::function< bool( const unsigned long measurement, std::vector< double > &filters ) > Reader;
+
+        bool compute(const Reader &reader,
+                     const unsigned long M,
+                     const unsigned long R,
+                     const unsigned long E,
+                     const unsigned long N,
+                     const double fs);
+
+    private:
+        double windowLength;                        ///< in seconds
+        double crossfadeLength;                     ///< in seconds
+        double maxMixingTime;                       ///< in seconds
+
+        unsigned long numMeasurements;
+        unsigned long numReceivers;
+        unsigned long numEmitters;
+        unsigned long numDataSamples;               ///< N plus the largest delay
+        double samplingRate;
+
+        unsigned long mixingTime;                   ///< in samples
+        unsigned long earlyLength;
+        unsigned long tailOffset;
+
+        std::vector< double > mixingTimes;          ///< [ M R E ] in samples
+        std::vector< double > early;                ///< [ M R E earlyLength ]
+        std::vector< double > tails;                ///< [ R N - tailOffset ]
+        double maxTailDeviation;                    ///< in dB
+
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( EarlyLateDecomposition );
+    };
+
+}
+
+#endif /* _SOFA_EARLY_LATE_DECOMPOSITION_H__ */
@@ -0,0 +1,795 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAFFT.cpp
+ *   @brief      Real FFT
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAFFT.h"
+#include "../src/SOFASimd.h"
+#include "../src/SOFAExceptions.h"
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+using namespace sofa;
+using namespace sofa::dsp;
+
+namespace FFTLocal
+{
+    const double kTwoPi = 6.28318530717958647692;
+
+    /// first line of the wisdom files
+    const char kWisdomHeader[] = "libsofa-fft-wisdom";
+    const unsigned int kWisdomVersion = 1;
+
+    /// duration of the benchmark of one kernel, for one size
+    const std::chrono::milliseconds kTuningDuration( 20 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Tables of one size, shared by all the FFT instances of that size
+ *
+ */
+/************************************************************************************/
+struct FFT::Plan
+{
+    unsigned int halfSize;
+    sofa::dsp::FFT::Kernel kernel;
+
+    std::vector< unsigned int > bitReversal;    ///< [ N/2 ]
+
+    std::vector< float > twiddleRe;             ///< [ N/4 ] twiddles of the N/2 complex transform (radix-2)
+    std::vector< float > twiddleIm;
+
+    /// radix-4 : for each pass of quarter size h, W_2h^k, W_4h^k ( k < h ) as [ re1 im1 re2 im2 ]
+    std::vector< std::size_t > passOffsets;
+    std::vector< float > passTwiddles;
+
+    std::vector< float > splitRe;               ///< [ N/2 + 1 ] twiddles of the real-to-complex split
+    std::vector< float > splitIm;
+
+    Plan(const unsigned int size, const sofa::dsp::FFT::Kernel kernel_);
+};
+
+namespace FFTLocal
+{
+    std::map< unsigned int, std::shared_ptr< const FFT::Plan > > plans;
+    std::map< unsigned int, FFT::Kernel > wisdom;
+    std::mutex mutex;
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Kernel used when there is no wisdom for a size
+     *
+     */
+    /************************************************************************************/
+    inline FFT::Kernel GetDefaultKernel(const unsigned int size)
+    {
+        /// the radix-4 passes are vectorized when the quarter size reaches the vector size
+        return ( size / 2 >= 16 ) ? FFT::kRadix4 : FFT::kRadix2;
+    }
+
+    inline unsigned int Log2(const unsigned int n)
+    {
+        unsigned int numBits = 0;
+        while( ( 1u << numBits ) < n )
+        {
+            numBits++;
+        }
+        return numBits;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the tables
+ *  @param[in]      size : number of real samples
+ *  @param[in]      kernel_ : complex transform kernel
+ *
+ */
+/************************************************************************************/
+FFT::Plan::Plan(const unsigned int size, const sofa::dsp::FFT::Kernel kernel_)
+: halfSize( size / 2 )
+, kernel( kernel_ )
+{
+    const unsigned int numBits = FFTLocal::Log2( halfSize );
+
+    bitReversal.resize( halfSize );
+    for( unsigned int i = 0; i < halfSize; i++ )
+    {
+        unsigned int reversed = 0;
+        for( unsigned int b = 0; b < numBits; b++ )
+        {
+            reversed |= ( ( i >> b ) & 1u ) << ( numBits - 1 - b );
+        }
+        bitReversal[i] = reversed;
+    }
+
+    if( kernel == FFT::kRadix2 )
+    {
+        twiddleRe.resize( halfSize / 2 );
+        twiddleIm.resize( halfSize / 2 );
+        for( unsigned int k = 0; k < halfSize / 2; k++ )
+        {
+            const double phase = -FFTLocal::kTwoPi * k / halfSize;
+            twiddleRe[k] = static_cast< float >( std::cos( phase ) );
+            twiddleIm[k] = static_cast< float >( std::sin( phase ) );
+        }
+    }
+    else
+    {
+        /// a radix-2 stage first if the number of stages is odd
+        for( unsigned int h = ( numBits % 2 == 1 ) ? 2 : 1; 4 * h <= halfSize; h *= 4 )
+        {
+            passOffsets.push_back( passTwiddles.size() );
+
+            const std::size_t offset = passTwiddles.size();
+            passTwiddles.resize( offset + 4 * h );
+
+            for( unsigned int k = 0; k < h; k++ )
+            {
+                const double phase1 = -FFTLocal::kTwoPi * k / ( 2 * h );
+                const double phase2 = -FFTLocal::kTwoPi * k / ( 4 * h );
+
+                passTwiddles[ offset + k ]          = static_cast< float >( std::cos( phase1 ) );
+                passTwiddles[ offset + h + k ]      = static_cast< float >( std::sin( phase1 ) );
+                passTwiddles[ offset + 2 * h + k ]  = static_cast< float >( std::cos( phase2 ) );
+                passTwiddles[ offset + 3 * h + k ]  = static_cast< float >( std::sin( phase2 ) );
+            }
+        }
+    }
+
+    splitRe.resize( halfSize + 1 );
+    splitIm.resize( halfSize + 1 );
+    for( unsigned int k = 0; k <= halfSize; k++ )
+    {
+        const double phase = -FFTLocal::kTwoPi * k / size;
+        splitRe[k] = static_cast< float >( std::cos( phase ) );
+        splitIm[k] = static_cast< float >( std::sin( phase ) );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if size is a power of two (and not 0)
+ *
+ */
+/************************************************************************************/
+bool FFT::IsPowerOfTwo(const unsigned int size_)
+{
+    return ( size_ > 0 && ( size_ & ( size_ - 1 ) ) == 0 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the smallest power of two greater than or equal to size
+ *
+ */
+/************************************************************************************/
+unsigned int FFT::NextPowerOfTwo(const unsigned int size_)
+{
+    unsigned int n = 1;
+    while( n < size_ )
+    {
+        n <<= 1;
+    }
+    return n;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns a short name of a kernel, as used in the wisdom files
+ *
+ */
+/************************************************************************************/
+const char * FFT::GetKernelName(const sofa::dsp::FFT::Kernel kernel)
+{
+    switch( kernel )
+    {
+        case kRadix2    : return "radix-2";
+        case kRadix4    : return "radix-4";
+        default         : return "unknown";
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the shared plan of a size, computing it if needed
+ *
+ */
+/************************************************************************************/
+std::shared_ptr< const FFT::Plan > FFT::getPlan(const unsigned int size_)
+{
+    std::lock_guard< std::mutex > lock( FFTLocal::mutex );
+
+    std::map< unsigned int, std::shared_ptr< const Plan > >::const_iterator it = FFTLocal::plans.find( size_ );
+
+    if( it != FFTLocal::plans.end() )
+    {
+        return it->second;
+    }
+
+    std::map< unsigned int, Kernel >::const_iterator tuned = FFTLocal::wisdom.find( size_ );
+
+    const Kernel kernel = ( tuned != FFTLocal::wisdom.end() ) ? tuned->second : FFTLocal::GetDefaultKernel( size_ );
+
+    std::shared_ptr< const Plan > plan( new Plan( size_, kernel ) );
+
+    FFTLocal::plans[ size_ ] = plan;
+
+    return plan;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Frees the cached plans (the instances keep theirs)
+ *
+ */
+/************************************************************************************/
+void FFT::ClearCache()
+{
+    std::lock_guard< std::mutex > lock( FFTLocal::mutex );
+
+    FFTLocal::plans.clear();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      size_ : number of real samples, a power of two (at least 4)
+ *
+ */
+/************************************************************************************/
+FFT::FFT(const unsigned int size_)
+: size( size_ )
+, halfSize( size_ / 2 )
+{
+    if( IsPowerOfTwo( size ) == false || size < 4 )
+    {
+        SOFA_THROW( "the FFT size shall be a power of two, at least 4" );
+    }
+
+    plan = getPlan( size );
+
+    workRe.resize( halfSize );
+    workIm.resize( halfSize );
+}
+
+unsigned int FFT::GetSize() const
+{
+    return size;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Number of bins of the spectrum, N/2+1
+ *
+ */
+/************************************************************************************/
+unsigned int FFT::GetNumBins() const
+{
+    return halfSize + 1;
+}
+
+sofa::dsp::FFT::Kernel FFT::GetKernel() const
+{
+    return plan->kernel;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          In-place complex transform of size N/2 (unscaled)
+ *
+ *  @details        Decimation in time, after a bit reversal. The radix-4 kernel merges two
+ *                  radix-2 stages in a pass : for a quarter size h, the butterfly of
+ *                  x[k], x[k+h], x[k+2h], x[k+3h] uses W_2h^k, then W_4h^k and -i W_4h^k.
+ */
+/************************************************************************************/
+void FFT::complexTransform(const Plan &plan, float *re, float *im, const bool inverse)
+{
+    const unsigned int n = plan.halfSize;
+
+    for( unsigned int i = 0; i < n; i++ )
+    {
+        const unsigned int j = plan.bitReversal[i];
+        if( j > i )
+        {
+            std::swap( re[i], re[j] );
+            std::swap( im[i], im[j] );
+        }
+    }
+
+    const float sign = ( inverse == true ) ? -1.0f : 1.0f;
+
+    //==============================================================================
+    if( plan.kernel == kRadix2 )
+    {
+        for( unsigned int length = 2; length <= n; length <<= 1 )
+        {
+            const unsigned int half     = length / 2;
+            const unsigned int stride   = n / length;
+
+            for( unsigned int start = 0; start < n; start += length )
+            {
+                for( unsigned int k = 0; k < half; k++ )
+                {
+                    const float wr = plan.twiddleRe[ k * stride ];
+                    const float wi = sign * plan.twiddleIm[ k * stride ];
+
+                    const unsigned int a = start + k;
+                    const unsigned int b = a + half;
+
+                    const float tr = re[b] * wr - im[b] * wi;
+                    const float ti = re[b] * wi + im[b] * wr;
+
+                    re[b] = re[a] - tr;
+                    im[b] = im[a] - ti;
+                    re[a] += tr;
+                    im[a] += ti;
+                }
+            }
+        }
+
+        return;
+    }
+
+    //==============================================================================
+    /// radix-4
+    if( FFTLocal::Log2( n ) % 2 == 1 )
+    {
+        for( unsigned int a = 0; a < n; a += 2 )
+        {
+            const float tr = re[ a + 1 ];
+            const float ti = im[ a + 1 ];
+
+            re[ a + 1 ] = re[a] - tr;
+            im[ a + 1 ] = im[a] - ti;
+            re[a] += tr;
+            im[a] += ti;
+        }
+    }
+
+    unsigned int h = ( FFTLocal::Log2( n ) % 2 == 1 ) ? 2 : 1;
+
+    for( std::size_t pass = 0; pass < plan.passOffsets.size(); pass++, h *= 4 )
+    {
+        const float *w1r = &plan.passTwiddles[ plan.passOffsets[ pass ] ];
+        const float *w1i = w1r + h;
+        const float *w2r = w1r + 2 * h;
+        const float *w2i = w1r + 3 * h;
+
+        for( unsigned int start = 0; start < n; start += 4 * h )
+        {
+            float *r0 = re + start;
+            float *i0 = im + start;
+            float *r1 = r0 + h;
+            float *i1 = i0 + h;
+            float *r2 = r1 + h;
+            float *i2 = i1 + h;
+            float *r3 = r2 + h;
+            float *i3 = i2 + h;
+
+            unsigned int k = 0;
+
+            if( h >= sofa::Simd::kVectorSize )
+            {
+                using namespace sofa::Simd;
+
+                const Vector s = Set( sign );
+
+                for( ; k < h; k += static_cast< unsigned int >( kVectorSize ) )
+                {
+                    const Vector ar0 = Load( r0 + k ), ai0 = Load( i0 + k );
+                    const Vector ar1 = Load( r1 + k ), ai1 = Load( i1 + k );
+                    const Vector ar2 = Load( r2 + k ), ai2 = Load( i2 + k );
+                    const Vector ar3 = Load( r3 + k ), ai3 = Load( i3 + k );
+
+                    const Vector c1 = Load( w1r + k ), s1 = Mul( s, Load( w1i + k ) );
+                    const Vector c2 = Load( w2r + k ), s2 = Mul( s, Load( w2i + k ) );
+
+                    /// first stage : W_2h^k
+                    const Vector tr1 = Sub( Mul( ar1, c1 ), Mul( ai1, s1 ) );
+                    const Vector ti1 = Add( Mul( ar1, s1 ), Mul( ai1, c1 ) );
+                    const Vector tr3 = Sub( Mul( ar3, c1 ), Mul( ai3, s1 ) );
+                    const Vector ti3 = Add( Mul( ar3, s1 ), Mul( ai3, c1 ) );
+
+                    const Vector br0 = Add( ar0, tr1 ), bi0 = Add( ai0, ti1 );
+                    const Vector br1 = Sub( ar0, tr1 ), bi1 = Sub( ai0, ti1 );
+                    const Vector br2 = Add( ar2, tr3 ), bi2 = Add( ai2, ti3 );
+                    const Vector br3 = Sub( ar2, tr3 ), bi3 = Sub( ai2, ti3 );
+
+                    /// second stage : W_4h^k and -i W_4h^k
+                    const Vector ur2 = Sub( Mul( br2, c2 ), Mul( bi2, s2 ) );
+                    const Vector ui2 = Add( Mul( br2, s2 ), Mul( bi2, c2 ) );
+                    const Vector ur3 = Sub( Mul( br3, c2 ), Mul( bi3, s2 ) );
+                    const Vector ui3 = Add( Mul( br3, s2 ), Mul( bi3, c2 ) );
+
+                    const Vector vr3 = Mul( s, ui3 );
+                    const Vector vi3 = Mul( s, ur3 );
+
+                    Store( r0 + k, Add( br0, ur2 ) );
+                    Store( i0 + k, Add( bi0, ui2 ) );
+                    Store( r2 + k, Sub( br0, ur2 ) );
+                    Store( i2 + k, Sub( bi0, ui2 ) );
+                    Store( r1 + k, Add( br1, vr3 ) );
+                    Store( i1 + k, Sub( bi1, vi3 ) );
+                    Store( r3 + k, Sub( br1, vr3 ) );
+                    Store( i3 + k, Add( bi1, vi3 ) );
+                }
+            }
+
+            for( ; k < h; k++ )
+            {
+                const float c1 = w1r[k], s1 = sign * w1i[k];
+                const float c2 = w2r[k], s2 = sign * w2i[k];
+
+                const float tr1 = r1[k] * c1 - i1[k] * s1;
+                const float ti1 = r1[k] * s1 + i1[k] * c1;
+                const float tr3 = r3[k] * c1 - i3[k] * s1;
+                const float ti3 = r3[k] * s1 + i3[k] * c1;
+
+                const float br0 = r0[k] + tr1, bi0 = i0[k] + ti1;
+                const float br1 = r0[k] - tr1, bi1 = i0[k] - ti1;
+                const float br2 = r2[k] + tr3, bi2 = i2[k] + ti3;
+                const float br3 = r2[k] - tr3, bi3 = i2[k] - ti3;
+
+                const float ur2 = br2 * c2 - bi2 * s2;
+                const float ui2 = br2 * s2 + bi2 * c2;
+                const float ur3 = br3 * c2 - bi3 * s2;
+                const float ui3 = br3 * s2 + bi3 * c2;
+
+                r0[k] = br0 + ur2;
+                i0[k] = bi0 + ui2;
+                r2[k] = br0 - ur2;
+                i2[k] = bi0 - ui2;
+                r1[k] = br1 + sign * ui3;
+                i1[k] = bi1 - sign * ur3;
+                r3[k] = br1 - sign * ui3;
+                i3[k] = bi1 + sign * ur3;
+            }
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Forward transform
+ *  @param[out]     re : N/2+1 real parts
+ *  @param[out]     im : N/2+1 imaginary parts
+ *  @param[in]      input : N real samples
+ *
+ */
+/************************************************************************************/
+void FFT::Forward(float *re,
+                  float *im,
+                  const float *input)
+{
+    const unsigned int n = halfSize;
+
+    /// even samples as real part, odd samples as imaginary part
+    for( unsigned int i = 0; i < n; i++ )
+    {
+        workRe[i] = input[ 2 * i ];
+        workIm[i] = input[ 2 * i + 1 ];
+    }
+
+    complexTransform( *plan, &workRe[0], &workIm[0], false );
+
+    const float *splitRe = &plan->splitRe[0];
+    const float *splitIm = &plan->splitIm[0];
+
+    /// X[k] = E[k] + W^k O[k], with E and O the spectra of the even and odd samples
+    for( unsigned int k = 0; k <= n; k++ )
+    {
+        const unsigned int a = ( k == n ) ? 0 : k;
+        const unsigned int b = ( k == 0 ) ? 0 : n - k;
+
+        const float zr  = workRe[a];
+        const float zi  = workIm[a];
+        const float zcr = workRe[b];
+        const float zci = -workIm[b];
+
+        const float er  = 0.5f * ( zr + zcr );
+        const float ei  = 0.5f * ( zi + zci );
+        const float orr = 0.5f * ( zi - zci );
+        const float oi  = -0.5f * ( zr - zcr );
+
+        re[k] = er + splitRe[k] * orr - splitIm[k] * oi;
+        im[k] = ei + splitRe[k] * oi + splitIm[k] * orr;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Inverse transform (scaled by 1/N)
+ *  @param[out]     output : N real samples
+ *  @param[in]      re : N/2+1 real parts
+ *  @param[in]      im : N/2+1 imaginary parts (those of DC and Nyquist are ignored)
+ *
+ */
+/************************************************************************************/
+void FFT::Inverse(float *output,
+                  const float *re,
+                  const float *im)
+{
+    const unsigned int n = halfSize;
+
+    const float *splitRe = &plan->splitRe[0];
+    const float *splitIm = &plan->splitIm[0];
+
+    for( unsigned int k = 0; k < n; k++ )
+    {
+        /// the spectrum of a real signal is real at DC and Nyquist : im[0] and im[n] are ignored
+        const float xr  = re[k];
+        const float xi  = ( k == 0 ) ? 0.0f : im[k];
+        const float xcr = re[ n - k ];
+        const float xci = ( k == 0 ) ? 0.0f : -im[ n - k ];
+
+        const float er  = 0.5f * ( xr + xcr );
+        const float ei  = 0.5f * ( xi + xci );
+
+        /// O[k] = ( X[k] - conj( X[n-k] ) ) / 2 * conj( W^k )
+        const float dr  = 0.5f * ( xr - xcr );
+        const float di  = 0.5f * ( xi - xci );
+        const float orr = dr * splitRe[k] + di * splitIm[k];
+        const float oi  = di * splitRe[k] - dr * splitIm[k];
+
+        /// Z = E + i O
+        workRe[k] = er - oi;
+        workIm[k] = ei + orr;
+    }
+
+    complexTransform( *plan, &workRe[0], &workIm[0], true );
+
+    const float scale = 1.0f / static_cast< float >( n );
+
+    for( unsigned int i = 0; i < n; i++ )
+    {
+        output[ 2 * i ]     = workRe[i] * scale;
+        output[ 2 * i + 1 ] = workIm[i] * scale;
+    }
+}
+
+//==============================================================================
+// Autotuning
+//==============================================================================
+
+/************************************************************************************/
+/*!
+ *  @brief          Benchmarks the kernels for all the sizes from 4 to maxSize and keeps
+ *                  the fastest in the wisdom
+ *  @param[in]      maxSize : largest size to tune (rounded up to a power of two)
+ *
+ *  @details        Takes about 40 ms per size. The cached plans are freed, so that
+ *                  the new instances use the tuned kernels.
+ */
+/************************************************************************************/
+void FFT::Autotune(const unsigned int maxSize)
+{
+    const unsigned int lastSize = NextPowerOfTwo( std::max( 4u, maxSize ) );
+
+    std::map< unsigned int, Kernel > tuned;
+
+    for( unsigned int size_ = 4; size_ <= lastSize; size_ *= 2 )
+    {
+        const unsigned int n = size_ / 2;
+
+        std::vector< float > re( n );
+        std::vector< float > im( n );
+
+        double bestTime = 0.0;
+        Kernel best     = FFTLocal::GetDefaultKernel( size_ );
+
+        for( int k = 0; k < kNumKernels; k++ )
+        {
+            const Plan plan( size_, static_cast< Kernel >( k ) );
+
+            for( unsigned int i = 0; i < n; i++ )
+            {
+                re[i] = static_cast< float >( i % 7 );
+                im[i] = 0.0f;
+            }
+
+            /// minimum over runs of a few transforms, to ignore the interruptions
+            const unsigned int numTransforms = std::max( 1u, 4096u / n );
+            double time = -1.0;
+
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+            while( std::chrono::steady_clock::now() - start < FFTLocal::kTuningDuration )
+            {
+                const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+
+                for( unsigned int t = 0; t < numTransforms; t++ )
+                {
+                    complexTransform( plan, &re[0], &im[0], ( t % 2 ) == 1 );
+                }
+
+                const double elapsed = std::chrono::duration< double >( std::chrono::steady_clock::now() - t0 ).count();
+
+                if( time < 0.0 || elapsed < time )
+                {
+                    time = elapsed;
+                }
+            }
+
+            if( k == 0 || time < bestTime )
+            {
+                bestTime    = time;
+                best        = static_cast< Kernel >( k );
+            }
+        }
+
+        tuned[ size_ ] = best;
+    }
+
+    std::lock_guard< std::mutex > lock( FFTLocal::mutex );
+
+    for( std::map< unsigned int, Kernel >::const_iterator it = tuned.begin(); it != tuned.end(); ++it )
+    {
+        FFTLocal::wisdom[ it->first ] = it->second;
+    }
+
+    FFTLocal::plans.clear();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes the wisdom to a text file
+ *  @return         false if the file cannot be written
+ *
+ *  @details        The file records the instruction set, since the timings are only
+ *                  valid for the build that measured them
+ */
+/************************************************************************************/
+bool FFT::SaveWisdom(const std::string &path)
+{
+    std::ofstream file( path.c_str() );
+
+    if( file.is_open() == false )
+    {
+        return false;
+    }
+
+    std::lock_guard< std::mutex > lock( FFTLocal::mutex );
+
+    file << FFTLocal::kWisdomHeader << " " << FFTLocal::kWisdomVersion << " " << sofa::Simd::GetInstructionSet() << std::endl;
+
+    for( std::map< unsigned int, Kernel >::const_iterator it = FFTLocal::wisdom.begin(); it != FFTLocal::wisdom.end(); ++it )
+    {
+        file << it->first << " " << GetKernelName( it->second ) << std::endl;
+    }
+
+    return file.good();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads the wisdom from a file written by SaveWisdom
+ *  @return         false if the file cannot be read, is invalid, or was written by
+ *                  a build using another instruction set (the wisdom is then unchanged)
+ *
+ */
+/************************************************************************************/
+bool FFT::LoadWisdom(const std::string &path)
+{
+    std::ifstream file( path.c_str() );
+
+    if( file.is_open() == false )
+    {
+        return false;
+    }
+
+    std::string header;
+    unsigned int version = 0;
+    std::string instructionSet;
+
+    file >> header >> version >> instructionSet;
+
+    if( file.fail() == true
+       || header != FFTLocal::kWisdomHeader
+       || version != FFTLocal::kWisdomVersion
+       || instructionSet != sofa::Simd::GetInstructionSet() )
+    {
+        return false;
+    }
+
+    std::map< unsigned int, Kernel > loaded;
+
+    unsigned int size_ = 0;
+    std::string name;
+
+    while( file >> size_ >> name )
+    {
+        bool found = false;
+
+        for( int k = 0; k < kNumKernels; k++ )
+        {
+            if( name == GetKernelName( static_cast< Kernel >( k ) ) )
+            {
+                loaded[ size_ ] = static_cast< Kernel >( k );
+                found = true;
+            }
+        }
+
+        if( found == false || IsPowerOfTwo( size_ ) == false )
+        {
+            return false;
+        }
+    }
+
+    if( file.eof() == false )
+    {
+        return false;
+    }
+
+    std::lock_guard< std::mutex > lock( FFTLocal::mutex );
+
+    for( std::map< unsigned int, Kernel >::const_iterator it = loaded.begin(); it != loaded.end(); ++it )
+    {
+        FFTLocal::wisdom[ it->first ] = it->second;
+    }
+
+    FFTLocal::plans.clear();
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Forgets the wisdom : the new plans use the default kernels
+ *
+ */
+/************************************************************************************/
+void FFT::ForgetWisdom()
+{
+    std::lock_guard< std::mutex > lock( FFTLocal::mutex );
+
+    FFTLocal::wisdom.clear();
+    FFTLocal::plans.clear();
+}
@@ -0,0 +1,150 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAFFT.h
+ *   @brief      Real FFT
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_FFT_H__
+#define _SOFA_FFT_H__
+
+#include "../src/SOFAPlatform.h"
+#include <memory>
+
+namespace sofa
+{
+
+    namespace dsp
+    {
+
+        /************************************************************************************/
+        /*!
+         *  @class          FFT
+         *  @brief          Real FFT of a power-of-two size
+         *
+         *  @details        The spectrum of N real samples is given by its N/2+1 first bins, in
+         *                  split format (separate real and imaginary parts). Inverse( Forward( x ) )
+         *                  gives back x (the inverse transform is scaled by 1/N). The output of
+         *                  Inverse is real : the imaginary parts of the DC and Nyquist bins are
+         *                  ignored.
+         *                  The real transform is computed with a complex transform of size N/2.
+         *
+         *                  The tables of a size (the plan) are computed once and shared by all
+         *                  the instances through a cache. The complex transform uses either a
+         *                  radix-2 kernel or a vectorized radix-4 kernel : Autotune benchmarks
+         *                  both on the host, and the choices (the wisdom) can be saved to a file
+         *                  and loaded at the next startup.
+         *
+         *                  The transforms do not allocate ; an instance holds a work buffer,
+         *                  so it shall not be used by several threads at once.
+         */
+        /************************************************************************************/
+        class SOFA_API FFT
+        {
+        public:
+            enum Kernel
+            {
+                kRadix2     = 0,    ///< scalar radix-2 butterflies
+                kRadix4     = 1,    ///< radix-4 butterflies, vectorized (sofa::Simd)
+                kNumKernels = 2
+            };
+
+        public:
+            FFT(const unsigned int size);
+            ~FFT() {};
+
+            unsigned int GetSize() const;
+            unsigned int GetNumBins() const;
+            sofa::dsp::FFT::Kernel GetKernel() const;
+
+            void Forward(float *re,
+                         float *im,
+                         const float *input);
+
+            void Inverse(float *output,
+                         const float *re,
+                         const float *im);
+
+            //==============================================================================
+            static bool IsPowerOfTwo(const unsigned int size);
+            static unsigned int NextPowerOfTwo(const unsigned int size);
+
+            static const char * GetKernelName(const sofa::dsp::FFT::Kernel kernel);
+
+            //==============================================================================
+            static void Autotune(const unsigned int maxSize);
+
+            static bool SaveWisdom(const std::string &path);
+            static bool LoadWisdom(const std::string &path);
+            static void ForgetWisdom();
+
+            static void ClearCache();
+
+            //==============================================================================
+            /// tables shared by the instances of one size (opaque)
+            struct Plan;
+
+        private:
+            static std::shared_ptr< const Plan > getPlan(const unsigned int size);
+
+            static void complexTransform(const Plan &plan, float *re, float *im, const bool inverse);
+
+        private:
+            const unsigned int size;                ///< N (real samples)
+            const unsigned int halfSize;            ///< N/2 (size of the complex transform)
+
+            std::shared_ptr< const Plan > plan;
+
+            std::vector< float > workRe;            ///< [ N/2 ]
+            std::vector< float > workIm;
+
+        private:
+            /// avoid shallow and copy constructor
+            SOFA_AVOID_COPY_CONSTRUCTOR( FFT );
+        };
+
+    }
+
+}
+
+#endif /* _SOFA_FFT_H__ */
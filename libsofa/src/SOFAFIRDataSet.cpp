@@ -0,0 +1,755 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAFIRDataSet.cpp
+ *   @brief      In-memory FIR data set with optional reordering of the measurements
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAFIRDataSet.h"
+#include "../src/SOFAGeometry.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAUtils.h"
+#include <algorithm>
+
+using namespace sofa;
+
+namespace FIRDataSetLocal
+{
+    /// number of bits per axis used to quantize the directions
+    const unsigned int kCurveBits = 16;
+
+    typedef unsigned long long CurveKey;
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Quantizes the coordinate of a unit vector from [-1 1] to [0 2^kCurveBits[
+     *
+     */
+    /************************************************************************************/
+    inline unsigned int quantize(const double value)
+    {
+        const double maxValue   = static_cast< double >( ( 1u << kCurveBits ) - 1 );
+        const double normalized = ( sofa::smax( -1.0, sofa::smin( 1.0, value ) ) + 1.0 ) * 0.5;
+
+        return static_cast< unsigned int >( normalized * maxValue + 0.5 );
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Interleaves the bits of the three coordinates, most significant bit first
+     *
+     */
+    /************************************************************************************/
+    inline CurveKey interleave(const unsigned int X[3])
+    {
+        CurveKey key = 0;
+
+        for( int bit = kCurveBits - 1; bit >= 0; bit-- )
+        {
+            for( unsigned int i = 0; i < 3; i++ )
+            {
+                key = ( key << 1 ) | static_cast< CurveKey >( ( X[i] >> bit ) & 1u );
+            }
+        }
+
+        return key;
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Converts the coordinates to the 'transposed' Hilbert index
+     *
+     *  @details        J. Skilling, "Programming the Hilbert curve",
+     *                  AIP Conference Proceedings 707, 2004
+     */
+    /************************************************************************************/
+    inline void axesToTranspose(unsigned int X[3])
+    {
+        const unsigned int n = 3;
+        const unsigned int M = 1u << ( kCurveBits - 1 );
+
+        /// inverse undo
+        for( unsigned int Q = M; Q > 1; Q >>= 1 )
+        {
+            const unsigned int P = Q - 1;
+
+            for( unsigned int i = 0; i < n; i++ )
+            {
+                if( X[i] & Q )
+                {
+                    X[0] ^= P;
+                }
+                else
+                {
+                    const unsigned int t = ( X[0] ^ X[i] ) & P;
+                    X[0] ^= t;
+                    X[i] ^= t;
+                }
+            }
+        }
+
+        /// Gray encode
+        for( unsigned int i = 1; i < n; i++ )
+        {
+            X[i] ^= X[i-1];
+        }
+
+        unsigned int t = 0;
+        for( unsigned int Q = M; Q > 1; Q >>= 1 )
+        {
+            if( X[n-1] & Q )
+            {
+                t ^= Q - 1;
+            }
+        }
+
+        for( unsigned int i = 0; i < n; i++ )
+        {
+            X[i] ^= t;
+        }
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Position of a direction along the requested space-filling curve
+     *
+     */
+    /************************************************************************************/
+    inline CurveKey curveKey(const double cartesian[3],
+                             const sofa::FIRDataSet::Ordering &ordering)
+    {
+        double direction[3] = { cartesian[0], cartesian[1], cartesian[2] };
+        sofa::Geometry::Normalize( direction );
+
+        unsigned int X[3] =
+        {
+            quantize( direction[0] ),
+            quantize( direction[1] ),
+            quantize( direction[2] )
+        };
+
+        if( ordering == sofa::FIRDataSet::kHilbertOrder )
+        {
+            axesToTranspose( X );
+        }
+
+        return interleave( X );
+    }
+
+    struct CurveEntry
+    {
+        CurveKey key;
+        double radius;
+        unsigned long index;
+
+        bool operator< (const CurveEntry &other) const
+        {
+            if( key != other.key )
+            {
+                return key < other.key;
+            }
+
+            /// several radii in the same direction stay next to each other, closest first
+            return radius < other.radius;
+        }
+    };
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Expands a variable of size [I ...] or [M ...] to [M ...]
+     *  @return         false if the number of values matches neither I nor M
+     *
+     */
+    /************************************************************************************/
+    bool expand(std::vector< double > &values,
+                const std::size_t numMeasurements,
+                const std::size_t rowSize)
+    {
+        if( values.size() == numMeasurements * rowSize )
+        {
+            return true;
+        }
+
+        if( values.size() != rowSize )
+        {
+            return false;
+        }
+
+        const std::vector< double > row = values;
+
+        values.resize( numMeasurements * rowSize );
+
+        for( std::size_t m = 0; m < numMeasurements; m++ )
+        {
+            std::copy( row.begin(), row.end(), values.begin() + m * rowSize );
+        }
+
+        return true;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+FIRDataSet::FIRDataSet()
+: numMeasurements( 0 )
+, numReceivers( 0 )
+, numDataSamples( 0 )
+, samplingRate( 0.0 )
+, ordering( sofa::FIRDataSet::kOriginalOrder )
+, sourceCoordinates( sofa::Coordinates::kCartesian )
+, sourceUnits( sofa::Units::kMeter )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Loads the measurements of a SOFA file with DataType 'FIR'
+ *                  (e.g. SimpleFreeFieldHRIR, GeneralFIR, SimpleHeadphoneIR, SingleRoomDRIR)
+ *  @param[in]      file : the file to read from
+ *  @param[in]      ordering_ : optional reordering of the measurements after loading
+ *  @return         true on success
+ *
+ *  @details        Data.SamplingRate may be [I] or [M], but it must be the same for all
+ *                  measurements. Data.Delay and SourcePosition are expanded to [M ...]
+ */
+/************************************************************************************/
+bool FIRDataSet::Load(const sofa::File &file,
+                      const sofa::FIRDataSet::Ordering &ordering_)
+{
+    if( file.IsFIRDataType() == false )
+    {
+        SOFA_THROW( "'DataType' shall be FIR" );
+        return false;
+    }
+
+    if( file.GetVariableDimensionality( "Data.IR" ) != 3 )
+    {
+        SOFA_THROW( "invalid dimensions for 'Data.IR'" );
+        return false;
+    }
+
+    const long M = file.GetNumMeasurements();
+    const long R = file.GetNumReceivers();
+    const long N = file.GetNumDataSamples();
+
+    if( M <= 0 || R <= 0 || N <= 0 )
+    {
+        SOFA_THROW( "invalid SOFA dimensions" );
+        return false;
+    }
+
+    std::vector< double > values;
+
+    //==============================================================================
+    /// Data.SamplingRate
+    if( file.GetValues( values, "Data.SamplingRate" ) == false || values.empty() == true )
+    {
+        SOFA_THROW( "invalid 'Data.SamplingRate' variable" );
+        return false;
+    }
+
+    for( std::size_t i = 1; i < values.size(); i++ )
+    {
+        if( values[i] != values[0] )
+        {
+            SOFA_THROW( "'Data.SamplingRate' varies across measurements" );
+            return false;
+        }
+    }
+
+    const double fs = values[0];
+
+    //==============================================================================
+    /// Data.IR
+    std::vector< double > newIR;
+
+    if( file.GetValues( newIR, "Data.IR" ) == false )
+    {
+        SOFA_THROW( "invalid 'Data.IR' variable" );
+        return false;
+    }
+
+    return load( file, newIR, static_cast< unsigned long >( N ), fs, ordering_ );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Loads the measurements of a SOFA file, with IRs computed elsewhere
+ *                  (e.g. by a TransferFunctionConverter from a file with DataType 'TF')
+ *  @param[in]      file : the file to read Data.Delay and SourcePosition from
+ *  @param[in]      values : Data.IR [M R N]
+ *  @param[in]      numDataSamples_ : N
+ *  @param[in]      samplingRate_ : sampling rate of the IRs, in hertz
+ *  @param[in]      ordering_ : optional reordering of the measurements after loading
+ *  @return         true on success
+ *
+ *  @details        Data.Delay is zero if the file has no such variable
+ */
+/************************************************************************************/
+bool FIRDataSet::Load(const sofa::File &file,
+                      const std::vector< double > &values,
+                      const unsigned long numDataSamples_,
+                      const double samplingRate_,
+                      const sofa::FIRDataSet::Ordering &ordering_)
+{
+    const long M = file.GetNumMeasurements();
+    const long R = file.GetNumReceivers();
+
+    if( M <= 0 || R <= 0 || numDataSamples_ == 0
+       || values.size() != static_cast< std::size_t >( M ) * R * numDataSamples_ )
+    {
+        SOFA_THROW( "invalid dimensions for 'Data.IR'" );
+        return false;
+    }
+
+    if( samplingRate_ <= 0.0 )
+    {
+        SOFA_THROW( "invalid sampling rate" );
+        return false;
+    }
+
+    std::vector< double > newIR( values );
+
+    return load( file, newIR, numDataSamples_, samplingRate_, ordering_ );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads Data.Delay and SourcePosition, and takes the IRs
+ *  @param[in]      newIR : Data.IR [M R N], swapped into the data set
+ *
+ */
+/************************************************************************************/
+bool FIRDataSet::load(const sofa::File &file,
+                      std::vector< double > &newIR,
+                      const unsigned long N,
+                      const double fs,
+                      const sofa::FIRDataSet::Ordering &ordering_)
+{
+    const long M = file.GetNumMeasurements();
+    const long R = file.GetNumReceivers();
+
+    //==============================================================================
+    /// Data.Delay
+    std::vector< double > newDelay;
+
+    if( file.HasVariable( "Data.Delay" ) == false )
+    {
+        newDelay.assign( static_cast< std::size_t >( M ) * R, 0.0 );
+    }
+    else if( file.GetValues( newDelay, "Data.Delay" ) == false
+          || FIRDataSetLocal::expand( newDelay, M, R ) == false )
+    {
+        SOFA_THROW( "invalid 'Data.Delay' variable" );
+        return false;
+    }
+
+    //==============================================================================
+    /// SourcePosition
+    sofa::Coordinates::Type coordinates;
+    sofa::Units::Type units;
+
+    std::vector< double > positions;
+
+    if( file.GetSourcePosition( coordinates, units ) == false
+     || file.GetValues( positions, "SourcePosition" ) == false
+     || FIRDataSetLocal::expand( positions, M, 3 ) == false )
+    {
+        SOFA_THROW( "invalid 'SourcePosition' variable" );
+        return false;
+    }
+
+    //==============================================================================
+    numMeasurements     = static_cast< unsigned long >( M );
+    numReceivers        = static_cast< unsigned long >( R );
+    numDataSamples      = N;
+    samplingRate        = fs;
+    sourceCoordinates   = coordinates;
+    sourceUnits         = units;
+
+    ir.swap( newIR );
+    delay.swap( newDelay );
+    sourcePositions.swap( positions );
+
+    sofa::Geometry::ToCartesian( sourceCartesian, sourcePositions, sourceCoordinates );
+
+    originalIndices.resize( numMeasurements );
+    measurementIndices.resize( numMeasurements );
+
+    for( unsigned long m = 0; m < numMeasurements; m++ )
+    {
+        originalIndices[m]      = m;
+        measurementIndices[m]   = m;
+    }
+
+    ordering = sofa::FIRDataSet::kOriginalOrder;
+
+    Reorder( ordering_ );
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sorts the measurements along a space-filling curve
+ *  @param[in]      ordering_ : the curve to follow
+ *
+ *  @details        The curve runs over the directions of the sources (the quantized unit
+ *                  vectors), so that measurements which are close on the sphere end up
+ *                  close in memory. Data.IR, Data.Delay and SourcePosition are permuted
+ *                  together. Sources in the same direction are sorted by distance.
+ *                  kOriginalOrder restores the order of the file.
+ */
+/************************************************************************************/
+void FIRDataSet::Reorder(const sofa::FIRDataSet::Ordering &ordering_)
+{
+    std::vector< unsigned long > permutation;
+
+    computeOrdering( permutation, ordering_ );
+
+    permute( permutation );
+
+    ordering = ordering_;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the permutation that sorts the current measurements
+ *  @param[out]     permutation : permutation[ i ] is the current index of the measurement
+ *                  which goes to position i
+ *
+ */
+/************************************************************************************/
+void FIRDataSet::computeOrdering(std::vector< unsigned long > &permutation,
+                                 const sofa::FIRDataSet::Ordering &ordering_) const
+{
+    permutation.resize( numMeasurements );
+
+    if( ordering_ == sofa::FIRDataSet::kOriginalOrder )
+    {
+        /// back to the file order
+        for( unsigned long m = 0; m < numMeasurements; m++ )
+        {
+            permutation[m] = measurementIndices[m];
+        }
+
+        return;
+    }
+
+    SOFA_ASSERT( ordering_ == sofa::FIRDataSet::kMortonOrder || ordering_ == sofa::FIRDataSet::kHilbertOrder );
+
+    std::vector< FIRDataSetLocal::CurveEntry > entries( numMeasurements );
+
+    for( unsigned long m = 0; m < numMeasurements; m++ )
+    {
+        const double *cartesian = &sourceCartesian[ 3 * m ];
+
+        entries[m].key      = FIRDataSetLocal::curveKey( cartesian, ordering_ );
+        entries[m].radius   = sqrt( cartesian[0] * cartesian[0] + cartesian[1] * cartesian[1] + cartesian[2] * cartesian[2] );
+        entries[m].index    = m;
+    }
+
+    std::stable_sort( entries.begin(), entries.end() );
+
+    for( unsigned long m = 0; m < numMeasurements; m++ )
+    {
+        permutation[m] = entries[m].index;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Applies a permutation to all the per-measurement arrays
+ *
+ */
+/************************************************************************************/
+void FIRDataSet::permute(const std::vector< unsigned long > &permutation)
+{
+    SOFA_ASSERT( permutation.size() == numMeasurements );
+
+    const std::size_t irSize = static_cast< std::size_t >( numReceivers ) * numDataSamples;
+
+    std::vector< double > newIR( ir.size() );
+    std::vector< double > newDelay( delay.size() );
+    std::vector< double > newPositions( sourcePositions.size() );
+    std::vector< double > newCartesian( sourceCartesian.size() );
+    std::vector< unsigned long > newOriginalIndices( numMeasurements );
+
+    for( unsigned long m = 0; m < numMeasurements; m++ )
+    {
+        const unsigned long src = permutation[m];
+
+        std::copy( ir.begin() + src * irSize, ir.begin() + ( src + 1 ) * irSize, newIR.begin() + m * irSize );
+        std::copy( delay.begin() + src * numReceivers, delay.begin() + ( src + 1 ) * numReceivers, newDelay.begin() + m * numReceivers );
+        std::copy( sourcePositions.begin() + 3 * src, sourcePositions.begin() + 3 * ( src + 1 ), newPositions.begin() + 3 * m );
+        std::copy( sourceCartesian.begin() + 3 * src, sourceCartesian.begin() + 3 * ( src + 1 ), newCartesian.begin() + 3 * m );
+
+        newOriginalIndices[m] = originalIndices[ src ];
+    }
+
+    ir.swap( newIR );
+    delay.swap( newDelay );
+    sourcePositions.swap( newPositions );
+    sourceCartesian.swap( newCartesian );
+    originalIndices.swap( newOriginalIndices );
+
+    for( unsigned long m = 0; m < numMeasurements; m++ )
+    {
+        measurementIndices[ originalIndices[m] ] = m;
+    }
+}
+
+unsigned long FIRDataSet::GetNumMeasurements() const
+{
+    return numMeasurements;
+}
+
+unsigned long FIRDataSet::GetNumReceivers() const
+{
+    return numReceivers;
+}
+
+unsigned long FIRDataSet::GetNumDataSamples() const
+{
+    return numDataSamples;
+}
+
+double FIRDataSet::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+sofa::FIRDataSet::Ordering FIRDataSet::GetOrdering() const
+{
+    return ordering;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the N samples of the impulse response for one measurement
+ *                  and one receiver
+ *
+ */
+/************************************************************************************/
+const double * FIRDataSet::GetIR(const unsigned long measurement, const unsigned long receiver) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers );
+
+    return &ir[ ( static_cast< std::size_t >( measurement ) * numReceivers + receiver ) * numDataSamples ];
+}
+
+double * FIRDataSet::GetIR(const unsigned long measurement, const unsigned long receiver)
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers );
+
+    return &ir[ ( static_cast< std::size_t >( measurement ) * numReceivers + receiver ) * numDataSamples ];
+}
+
+const std::vector< double > & FIRDataSet::GetDataIR() const
+{
+    return ir;
+}
+
+double FIRDataSet::GetDelay(const unsigned long measurement, const unsigned long receiver) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers );
+
+    return delay[ static_cast< std::size_t >( measurement ) * numReceivers + receiver ];
+}
+
+const std::vector< double > & FIRDataSet::GetDataDelay() const
+{
+    return delay;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Replaces the impulse responses, e.g. by processed ones
+ *  @param[in]      values : [ M R N ], in the current order of the measurements
+ *  @param[in]      numDataSamples_ : N, which may differ from the current one
+ *  @return         false if the size does not match (the data set is unchanged)
+ *
+ */
+/************************************************************************************/
+bool FIRDataSet::SetDataIR(const std::vector< double > &values,
+                           const unsigned long numDataSamples_)
+{
+    if( numDataSamples_ == 0
+       || values.size() != static_cast< std::size_t >( numMeasurements ) * numReceivers * numDataSamples_ )
+    {
+        return false;
+    }
+
+    ir              = values;
+    numDataSamples  = numDataSamples_;
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Replaces the delays
+ *  @param[in]      values : [ M R ] in samples, in the current order of the measurements
+ *  @return         false if the size does not match (the data set is unchanged)
+ *
+ */
+/************************************************************************************/
+bool FIRDataSet::SetDataDelay(const std::vector< double > &values)
+{
+    if( values.size() != static_cast< std::size_t >( numMeasurements ) * numReceivers )
+    {
+        return false;
+    }
+
+    delay = values;
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Replaces the sampling rate (e.g. once Data.IR has been resampled)
+ *  @param[in]      samplingRate_ : in Hertz
+ *  @return         false if the sampling rate is not strictly positive (unchanged)
+ *
+ */
+/************************************************************************************/
+bool FIRDataSet::SetSamplingRate(const double samplingRate_)
+{
+    if( ( samplingRate_ > 0.0 ) == false )
+    {
+        return false;
+    }
+
+    samplingRate = samplingRate_;
+
+    return true;
+}
+
+sofa::Coordinates::Type FIRDataSet::GetSourceCoordinates() const
+{
+    return sourceCoordinates;
+}
+
+sofa::Units::Type FIRDataSet::GetSourceUnits() const
+{
+    return sourceUnits;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the source position of one measurement, as stored in the file
+ *
+ */
+/************************************************************************************/
+const double * FIRDataSet::GetSourcePosition(const unsigned long measurement) const
+{
+    SOFA_ASSERT( measurement < numMeasurements );
+
+    return &sourcePositions[ 3 * measurement ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the source position of one measurement, in cartesian coordinates
+ *
+ */
+/************************************************************************************/
+const double * FIRDataSet::GetSourceCartesianPosition(const unsigned long measurement) const
+{
+    SOFA_ASSERT( measurement < numMeasurements );
+
+    return &sourceCartesian[ 3 * measurement ];
+}
+
+const std::vector< double > & FIRDataSet::GetSourcePositions() const
+{
+    return sourcePositions;
+}
+
+const std::vector< double > & FIRDataSet::GetSourceCartesianPositions() const
+{
+    return sourceCartesian;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the index in the file of a measurement of the data set
+ *
+ */
+/************************************************************************************/
+unsigned long FIRDataSet::GetOriginalIndex(const unsigned long measurement) const
+{
+    SOFA_ASSERT( measurement < numMeasurements );
+
+    return originalIndices[ measurement ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the index in the data set of a measurement of the file
+ *
+ */
+/************************************************************************************/
+unsigned long FIRDataSet::GetMeasurementIndex(const unsigned long originalIndex) const
+{
+    SOFA_ASSERT( originalIndex < numMeasurements );
+
+    return measurementIndices[ originalIndex ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the permutation map : element m is the index in the file of
+ *                  measurement m of the data set
+ *
+ */
+/************************************************************************************/
+const std::vector< unsigned long > & FIRDataSet::GetOriginalIndices() const
+{
+    return originalIndices;
+}
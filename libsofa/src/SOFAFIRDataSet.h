@@ -0,0 +1,172 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAFIRDataSet.h
+ *   @brief      In-memory FIR data set with optional reordering of the measurements
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_FIR_DATA_SET_H__
+#define _SOFA_FIR_DATA_SET_H__
+
+#include "../src/SOFAFile.h"
+
+namespace sofa
+{
+
+    /************************************************************************************/
+    /*!
+     *  @class          FIRDataSet
+     *  @brief          In-memory copy of the measurements of a SOFA file with DataType 'FIR'
+     *
+     *  @details        Data.IR [M R N], Data.Delay (expanded to [M R]) and SourcePosition
+     *                  (expanded to [M C]) are loaded together, so that the measurements can
+     *                  be reordered or processed without going back to the netCDF file.
+     *                  The data set keeps track of the index of each measurement in the
+     *                  original file.
+     */
+    /************************************************************************************/
+    class SOFA_API FIRDataSet
+    {
+    public:
+        enum Ordering
+        {
+            kOriginalOrder          = 0,    ///< measurements are kept in the order of the file
+            kMortonOrder            = 1,    ///< measurements are sorted along a Morton (Z-order) curve
+            kHilbertOrder           = 2,    ///< measurements are sorted along a Hilbert curve
+            kNumOrderings           = 3
+        };
+
+    public:
+        FIRDataSet();
+        ~FIRDataSet() {};
+
+        bool Load(const sofa::File &file,
+                  const sofa::FIRDataSet::Ordering &ordering = sofa::FIRDataSet::kOriginalOrder);
+
+        bool Load(const sofa::File &file,
+                  const std::vector< double > &values,
+                  const unsigned long numDataSamples,
+                  const double samplingRate,
+                  const sofa::FIRDataSet::Ordering &ordering = sofa::FIRDataSet::kOriginalOrder);
+
+        void Reorder(const sofa::FIRDataSet::Ordering &ordering);
+
+        //==============================================================================
+        unsigned long GetNumMeasurements() const;
+        unsigned long GetNumReceivers() const;
+        unsigned long GetNumDataSamples() const;
+
+        double GetSamplingRate() const;
+
+        sofa::FIRDataSet::Ordering GetOrdering() const;
+
+        //==============================================================================
+        const double * GetIR(const unsigned long measurement, const unsigned long receiver) const;
+        double * GetIR(const unsigned long measurement, const unsigned long receiver);
+
+        const std::vector< double > & GetDataIR() const;
+
+        double GetDelay(const unsigned long measurement, const unsigned long receiver) const;
+
+        const std::vector< double > & GetDataDelay() const;
+
+        bool SetDataIR(const std::vector< double > &values,
+                       const unsigned long numDataSamples);
+
+        bool SetDataDelay(const std::vector< double > &values);
+
+        bool SetSamplingRate(const double samplingRate);
+
+        //==============================================================================
+        sofa::Coordinates::Type GetSourceCoordinates() const;
+        sofa::Units::Type GetSourceUnits() const;
+
+        const double * GetSourcePosition(const unsigned long measurement) const;
+        const double * GetSourceCartesianPosition(const unsigned long measurement) const;
+
+        const std::vector< double > & GetSourcePositions() const;
+        const std::vector< double > & GetSourceCartesianPositions() const;
+
+        //==============================================================================
+        unsigned long GetOriginalIndex(const unsigned long measurement) const;
+        unsigned long GetMeasurementIndex(const unsigned long originalIndex) const;
+
+        const std::vector< unsigned long > & GetOriginalIndices() const;
+
+    private:
+        //==============================================================================
+        bool load(const sofa::File &file,
+                  std::vector< double > &newIR,
+                  const unsigned long numDataSamples,
+                  const double samplingRate,
+                  const sofa::FIRDataSet::Ordering &ordering);
+
+        void computeOrdering(std::vector< unsigned long > &permutation,
+                             const sofa::FIRDataSet::Ordering &ordering) const;
+
+        void permute(const std::vector< unsigned long > &permutation);
+
+    private:
+        unsigned long numMeasurements;
+        unsigned long numReceivers;
+        unsigned long numDataSamples;
+
+        double samplingRate;
+
+        sofa::FIRDataSet::Ordering ordering;
+
+        std::vector< double > ir;                       ///< [ M R N ]
+        std::vector< double > delay;                    ///< [ M R ]
+
+        sofa::Coordinates::Type sourceCoordinates;
+        sofa::Units::Type sourceUnits;
+        std::vector< double > sourcePositions;          ///< [ M C ], as stored in the file
+        std::vector< double > sourceCartesian;          ///< [ M C ], cartesian
+
+        std::vector< unsigned long > originalIndices;   ///< index in the file of each measurement
+        std::vector< unsigned long > measurementIndices;///< inverse of originalIndices
+    };
+
+}
+
+#endif /* _SOFA_FIR_DATA_SET_H__ */
@@ -847,7 +847,7 @@ bool File::checkTFDataType() const
             return false;
         }
         
-        if( sofa::NcUtils::IsDouble( varReal ) == false )
+        if( sofa::NcUtils::IsFloatingPoint( varReal ) == false )
         {
             SOFA_THROW( "invalid 'Data.Real' variable" );
             return false;
@@ -868,7 +868,7 @@ bool File::checkTFDataType() const
             return false;
         }
         
-        if( sofa::NcUtils::IsDouble( varImag ) == false )
+        if( sofa::NcUtils::IsFloatingPoint( varImag ) == false )
         {
             SOFA_THROW( "invalid 'Data.Imag' variable" );
             return false;
@@ -921,7 +921,8 @@ bool File::checkTFDataType() const
     
     const netCDF::NcVarAtt attNLongName = sofa::NcUtils::GetAttribute( varN, "LongName" );
     
-    if( sofa::Units::IsValid( attNLongName ) == false )
+    /// N:LongName is free text (e.g. 'frequency'), not a unit
+    if( sofa::NcUtils::IsValid( attNLongName ) == false )
     {
         SOFA_THROW( "invalid 'LongName'" );
         return false;
@@ -954,7 +955,7 @@ bool File::checkFirDataType() const
         return false;
     }
     
-    if( sofa::NcUtils::IsDouble( varIR ) == false )
+    if( sofa::NcUtils::IsFloatingPoint( varIR ) == false )
     {
         SOFA_THROW( "invalid 'Data.IR' variable" );
         return false;
@@ -1012,7 +1013,7 @@ bool File::checkFirDataType() const
         return false;
     }
     
-    if( sofa::NcUtils::IsDouble( varDelay ) == false )
+    if( sofa::NcUtils::IsFloatingPoint( varDelay ) == false )
     {
         SOFA_THROW( "invalid 'Data.Delay' variable" );
         return false;
@@ -1054,7 +1055,7 @@ bool File::checkFireDataType() const
         return false;
     }
     
-    if( sofa::NcUtils::IsDouble( varIR ) == false )
+    if( sofa::NcUtils::IsFloatingPoint( varIR ) == false )
     {
         SOFA_THROW( "invalid 'Data.IR' variable" );
         return false;
@@ -1112,7 +1113,7 @@ bool File::checkFireDataType() const
         return false;
     }
     
-    if( sofa::NcUtils::IsDouble( varDelay ) == false )
+    if( sofa::NcUtils::IsFloatingPoint( varDelay ) == false )
     {
         SOFA_THROW( "invalid 'Data.Delay' variable" );
         return false;
@@ -1152,7 +1153,7 @@ bool File::checkSOSDataType() const
         return false;
     }
     
-    if( sofa::NcUtils::IsDouble( varSOS ) == false )
+    if( sofa::NcUtils::IsFloatingPoint( varSOS ) == false )
     {
         SOFA_THROW( "invalid 'Data.SOS' variable" );
         return false;
@@ -1210,7 +1211,7 @@ bool File::checkSOSDataType() const
         return false;
     }
     
-    if( sofa::NcUtils::IsDouble( varDelay ) == false )
+    if( sofa::NcUtils::IsFloatingPoint( varDelay ) == false )
     {
         SOFA_THROW( "invalid 'Data.Delay' variable" );
         return false;
@@ -1568,6 +1569,22 @@ bool File::getDataIR(std::vector< double > &values) const
     return NetCDFFile::GetValues( values, "Data.IR" );
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values in single precision
+ *                  (no conversion when Data.IR is stored as float)
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool File::getDataIR(std::vector< float > &values) const
+{
+    SOFA_ASSERT( HasVariable( "Data.IR" ) == true );
+    
+    return NetCDFFile::GetValues( values, "Data.IR" );
+}
+
 /************************************************************************************/
 /*!
  *  @brief          Retrieves the Data.Delay values
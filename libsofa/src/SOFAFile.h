@@ -184,6 +184,7 @@ namespace sofa
         
         //==============================================================================
         bool getDataIR(std::vector< double > &values) const;
+        bool getDataIR(std::vector< float > &values) const;
         bool getDataIR(double *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const;
         
         //==============================================================================
@@ -0,0 +1,642 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAFileWriter.cpp
+ *   @brief      Writes SOFA files derived from a template file
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAFileWriter.h"
+#include "../src/SOFAExceptions.h"
+#include "ncDim.h"
+#include "ncVar.h"
+#include "ncGroupAtt.h"
+#include "ncVarAtt.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace sofa;
+
+namespace FileWriterLocal
+{
+    /************************************************************************************/
+    /*!
+     *  @brief          Copies an attribute, whatever its type
+     *
+     */
+    /************************************************************************************/
+    template< typename Destination >
+    void copyAttribute(const Destination &destination, const netCDF::NcAtt &attribute)
+    {
+        const netCDF::NcType type = attribute.getType();
+        const std::size_t length  = attribute.getAttLength();
+
+        if( type == netCDF::NcType( netCDF::ncChar ) )
+        {
+            std::string value;
+            attribute.getValues( value );
+
+            /// strings may carry a trailing null character
+            const std::size_t end = value.find( '\0' );
+            if( end != std::string::npos )
+            {
+                value.resize( end );
+            }
+
+            destination.putAtt( attribute.getName(), value );
+        }
+        else if( type.getTypeClass() == netCDF::NcType::nc_STRING )
+        {
+            std::vector< char * > values( length );
+            attribute.getValues( &values[0] );
+
+            destination.putAtt( attribute.getName(), type, length, &values[0] );
+
+            nc_free_string( length, &values[0] );
+        }
+        else
+        {
+            std::vector< unsigned char > buffer( length * type.getSize() + 1 );
+            attribute.getValues( static_cast< void * >( &buffer[0] ) );
+
+            destination.putAtt( attribute.getName(), type, length, static_cast< const void * >( &buffer[0] ) );
+        }
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Names of the attributes of a group or a variable, in the order of the file
+     *
+     */
+    /************************************************************************************/
+    inline void getAttributesNames(std::vector< std::string > &names, const int ncid, const int varid)
+    {
+        names.clear();
+
+        int numAttributes = 0;
+        if( nc_inq_varnatts( ncid, varid, &numAttributes ) != NC_NOERR )
+        {
+            return;
+        }
+
+        for( int i = 0; i < numAttributes; i++ )
+        {
+            char name[ NC_MAX_NAME + 1 ];
+
+            if( nc_inq_attname( ncid, varid, i, name ) == NC_NOERR )
+            {
+                names.push_back( name );
+            }
+        }
+    }
+
+    inline bool compareIds(const netCDF::NcVar &a, const netCDF::NcVar &b)
+    {
+        return a.getId() < b.getId();
+    }
+
+    inline bool compareDimIds(const netCDF::NcDim &a, const netCDF::NcDim &b)
+    {
+        return a.getId() < b.getId();
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Frees the strings read by netCDF into a buffer when leaving the scope
+     *                  (also when an error is thrown)
+     *
+     */
+    /************************************************************************************/
+    struct StringsGuard
+    {
+        StringsGuard(char **strings_, const std::size_t numStrings_)
+        : strings( strings_ )
+        , numStrings( numStrings_ )
+        {
+        }
+
+        ~StringsGuard()
+        {
+            if( strings != nullptr && numStrings > 0 )
+            {
+                nc_free_string( numStrings, strings );
+            }
+        }
+
+        char **strings;
+        const std::size_t numStrings;
+    };
+
+    inline bool isFloatingPoint(const netCDF::NcType &type)
+    {
+        return ( type == netCDF::NcType( netCDF::ncFloat ) || type == netCDF::NcType( netCDF::ncDouble ) );
+    }
+
+    inline netCDF::NcType storageType(const bool floatStorage)
+    {
+        if( floatStorage == true )
+        {
+            return netCDF::ncFloat;
+        }
+        else
+        {
+            return netCDF::ncDouble;
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      templateFile : the file from which everything not overridden is copied
+ *
+ */
+/************************************************************************************/
+FileWriter::FileWriter(const sofa::NetCDFFile &templateFile)
+: templatePath( templateFile.GetFilename() )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Overrides (or adds) a global attribute
+ *
+ */
+/************************************************************************************/
+void FileWriter::SetAttribute(const std::string &attributeName,
+                              const std::string &value)
+{
+    attributes[ attributeName ] = value;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Overrides (or adds) a dimension
+ *
+ */
+/************************************************************************************/
+void FileWriter::SetDimension(const std::string &dimensionName,
+                              const std::size_t size)
+{
+    if( size == 0 )
+    {
+        SOFA_THROW( "invalid dimension " + dimensionName );
+        return;
+    }
+
+    dimensions[ dimensionName ] = size;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Overrides (or adds) a variable
+ *  @param[in]      variableName : name of the variable
+ *  @param[in]      dimensionNames : names of its dimensions, e.g. { "M", "R", "N" }
+ *  @param[in]      values : all the values, row-major
+ *
+ *  @details        An existing variable keeps its type and its attributes
+ */
+/************************************************************************************/
+void FileWriter::SetVariable(const std::string &variableName,
+                             const std::vector< std::string > &dimensionNames,
+                             const std::vector< double > &values)
+{
+    if( variables.find( variableName ) == variables.end() )
+    {
+        newVariables.push_back( variableName );
+    }
+
+    Variable &variable      = variables[ variableName ];
+    variable.dimensionNames = dimensionNames;
+    variable.values         = values;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Overrides (or adds) an attribute of a variable
+ *
+ */
+/************************************************************************************/
+void FileWriter::SetVariableAttribute(const std::string &variableName,
+                                      const std::string &attributeName,
+                                      const std::string &value)
+{
+    variableAttributes[ variableName ][ attributeName ] = value;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Removes a variable of the template from the new file
+ *                  (e.g. Data.IR when writing another DataType)
+ *
+ */
+/************************************************************************************/
+void FileWriter::RemoveVariable(const std::string &variableName)
+{
+    removedVariables.insert( variableName );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Selects the storage of a variable : single precision (nc_FLOAT)
+ *                  or double precision (nc_DOUBLE)
+ *
+ *  @details        By default, an existing variable keeps the type it has in the template,
+ *                  and a new variable is stored as double. This applies to the variables
+ *                  set with SetVariable, and to the floating-point variables copied from
+ *                  the template (their values are converted) ; Write throws if it is asked
+ *                  for a copied variable of another type
+ */
+/************************************************************************************/
+void FileWriter::SetFloatStorage(const std::string &variableName,
+                                 const bool floatStorage_)
+{
+    floatStorage[ variableName ] = floatStorage_;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets, for each measurement of the new file, the measurement of the
+ *                  template from which the variables depending on M are copied
+ *
+ */
+/************************************************************************************/
+void FileWriter::SetMeasurementOrigins(const std::vector< unsigned long > &origins)
+{
+    measurementOrigins = origins;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes the file (netCDF-4)
+ *  @param[in]      path : destination, replaced if it exists
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool FileWriter::Write(const std::string &path) const
+{
+    if( path == templatePath )
+    {
+        SOFA_THROW( "cannot overwrite the template file" );
+        return false;
+    }
+
+    const netCDF::NcFile input( templatePath, netCDF::NcFile::read );
+    const netCDF::NcFile output( path, netCDF::NcFile::replace, netCDF::NcFile::nc4 );
+
+    //==============================================================================
+    /// global attributes
+    std::vector< std::string > names;
+    FileWriterLocal::getAttributesNames( names, input.getId(), NC_GLOBAL );
+
+    for( std::size_t i = 0; i < names.size(); i++ )
+    {
+        if( attributes.find( names[i] ) == attributes.end() )
+        {
+            FileWriterLocal::copyAttribute( output, input.getAtt( names[i] ) );
+        }
+    }
+
+    for( std::map< std::string, std::string >::const_iterator it = attributes.begin(); it != attributes.end(); ++it )
+    {
+        output.putAtt( it->first, it->second );
+    }
+
+    //==============================================================================
+    /// dimensions
+    std::map< std::string, netCDF::NcDim > outputDimensions;
+
+    {
+        const std::multimap< std::string, netCDF::NcDim > dims = input.getDims();
+
+        std::vector< netCDF::NcDim > ordered;
+        for( std::multimap< std::string, netCDF::NcDim >::const_iterator it = dims.begin(); it != dims.end(); ++it )
+        {
+            ordered.push_back( it->second );
+        }
+        std::sort( ordered.begin(), ordered.end(), FileWriterLocal::compareDimIds );
+
+        for( std::size_t i = 0; i < ordered.size(); i++ )
+        {
+            const std::string name = ordered[i].getName();
+
+            std::map< std::string, std::size_t >::const_iterator it = dimensions.find( name );
+            const std::size_t size = ( it != dimensions.end() ) ? it->second : ordered[i].getSize();
+
+            outputDimensions[ name ] = output.addDim( name, size );
+        }
+
+        for( std::map< std::string, std::size_t >::const_iterator it = dimensions.begin(); it != dimensions.end(); ++it )
+        {
+            if( outputDimensions.find( it->first ) == outputDimensions.end() )
+            {
+                outputDimensions[ it->first ] = output.addDim( it->first, it->second );
+            }
+        }
+    }
+
+    //==============================================================================
+    /// variables of the template, then the new ones
+    {
+        const std::multimap< std::string, netCDF::NcVar > vars = input.getVars();
+
+        std::vector< netCDF::NcVar > ordered;
+        for( std::multimap< std::string, netCDF::NcVar >::const_iterator it = vars.begin(); it != vars.end(); ++it )
+        {
+            ordered.push_back( it->second );
+        }
+        std::sort( ordered.begin(), ordered.end(), FileWriterLocal::compareIds );
+
+        for( std::size_t i = 0; i < ordered.size(); i++ )
+        {
+            if( removedVariables.find( ordered[i].getName() ) == removedVariables.end() )
+            {
+                writeVariable( output, ordered[i], outputDimensions );
+            }
+        }
+    }
+
+    for( std::size_t i = 0; i < newVariables.size(); i++ )
+    {
+        if( input.getVar( newVariables[i] ).isNull() == false )
+        {
+            continue;
+        }
+
+        const Variable &variable = variables.find( newVariables[i] )->second;
+
+        std::vector< netCDF::NcDim > dims;
+        std::size_t numValues = 1;
+
+        for( std::size_t j = 0; j < variable.dimensionNames.size(); j++ )
+        {
+            std::map< std::string, netCDF::NcDim >::const_iterator it = outputDimensions.find( variable.dimensionNames[j] );
+
+            if( it == outputDimensions.end() )
+            {
+                SOFA_THROW( "unknown dimension " + variable.dimensionNames[j] );
+                return false;
+            }
+
+            dims.push_back( it->second );
+            numValues *= it->second.getSize();
+        }
+
+        if( variable.values.size() != numValues )
+        {
+            SOFA_THROW( "wrong number of values for " + newVariables[i] );
+            return false;
+        }
+
+        std::map< std::string, bool >::const_iterator storage = floatStorage.find( newVariables[i] );
+        const bool isFloat = ( storage != floatStorage.end() && storage->second == true );
+
+        const netCDF::NcVar var = output.addVar( newVariables[i], FileWriterLocal::storageType( isFloat ), dims );
+
+        /// a variable with an empty dimension has no values to write
+        if( numValues > 0 )
+        {
+            var.putVar( &variable.values[0] );
+        }
+
+        std::map< std::string, std::map< std::string, std::string > >::const_iterator att = variableAttributes.find( newVariables[i] );
+        if( att != variableAttributes.end() )
+        {
+            for( std::map< std::string, std::string >::const_iterator it = att->second.begin(); it != att->second.end(); ++it )
+            {
+                var.putAtt( it->first, it->second );
+            }
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes one variable of the template, overridden or copied
+ *
+ */
+/************************************************************************************/
+void FileWriter::writeVariable(const netCDF::NcFile &output,
+                               const netCDF::NcVar &source,
+                               const std::map< std::string, netCDF::NcDim > &outputDimensions) const
+{
+    const std::string name = source.getName();
+
+    std::map< std::string, Variable >::const_iterator overridden = variables.find( name );
+
+    //==============================================================================
+    /// dimensions
+    std::vector< std::string > dimensionNames;
+    std::vector< std::size_t > sourceSizes;
+
+    {
+        const std::vector< netCDF::NcDim > dims = source.getDims();
+        for( std::size_t i = 0; i < dims.size(); i++ )
+        {
+            dimensionNames.push_back( dims[i].getName() );
+            sourceSizes.push_back( dims[i].getSize() );
+        }
+    }
+
+    if( overridden != variables.end() )
+    {
+        dimensionNames = overridden->second.dimensionNames;
+    }
+
+    std::vector< netCDF::NcDim > dims;
+    std::size_t numValues = 1;
+
+    for( std::size_t i = 0; i < dimensionNames.size(); i++ )
+    {
+        std::map< std::string, netCDF::NcDim >::const_iterator it = outputDimensions.find( dimensionNames[i] );
+
+        if( it == outputDimensions.end() )
+        {
+            SOFA_THROW( "unknown dimension " + dimensionNames[i] );
+            return;
+        }
+
+        dims.push_back( it->second );
+        numValues *= it->second.getSize();
+    }
+
+    /// a variable may be stored with another precision
+    std::map< std::string, bool >::const_iterator storage = floatStorage.find( name );
+    const bool setStorage = ( storage != floatStorage.end() );
+
+    if( setStorage == true && overridden == variables.end() && FileWriterLocal::isFloatingPoint( source.getType() ) == false )
+    {
+        SOFA_THROW( "the storage of " + name + " cannot be changed (not a floating-point variable)" );
+        return;
+    }
+
+    const netCDF::NcType type = ( setStorage == true ) ? FileWriterLocal::storageType( storage->second ) : source.getType();
+    const netCDF::NcVar var   = output.addVar( name, type, dims );
+
+    if( dims.empty() == false )
+    {
+        bool shuffle = false;
+        bool deflate = false;
+        int level    = 0;
+
+        source.getCompressionParameters( shuffle, deflate, level );
+
+        if( deflate == true )
+        {
+            var.setCompression( shuffle, deflate, level );
+        }
+    }
+
+    //==============================================================================
+    /// attributes
+    std::vector< std::string > names;
+    FileWriterLocal::getAttributesNames( names, source.getParentGroup().getId(), source.getId() );
+
+    std::map< std::string, std::map< std::string, std::string > >::const_iterator att = variableAttributes.find( name );
+
+    for( std::size_t i = 0; i < names.size(); i++ )
+    {
+        if( att == variableAttributes.end() || att->second.find( names[i] ) == att->second.end() )
+        {
+            FileWriterLocal::copyAttribute( var, source.getAtt( names[i] ) );
+        }
+    }
+
+    if( att != variableAttributes.end() )
+    {
+        for( std::map< std::string, std::string >::const_iterator it = att->second.begin(); it != att->second.end(); ++it )
+        {
+            var.putAtt( it->first, it->second );
+        }
+    }
+
+    //==============================================================================
+    /// values
+    if( overridden != variables.end() )
+    {
+        if( overridden->second.values.size() != numValues )
+        {
+            SOFA_THROW( "wrong number of values for " + name );
+            return;
+        }
+
+        if( numValues > 0 )
+        {
+            var.putVar( &overridden->second.values[0] );
+        }
+        return;
+    }
+
+    std::size_t sourceNumValues = 1;
+    for( std::size_t i = 0; i < sourceSizes.size(); i++ )
+    {
+        sourceNumValues *= sourceSizes[i];
+    }
+
+    /// a copied variable stored with another precision is read as double, and converted by netCDF when written
+    const bool convert  = ( setStorage == true && type != source.getType() );
+    const bool isString = ( type.getTypeClass() == netCDF::NcType::nc_STRING );
+    const std::size_t typeSize = ( convert == true ) ? sizeof( double ) : type.getSize();
+
+    /// doubles, to align the values of any type
+    std::vector< double > buffer( ( sourceNumValues * typeSize ) / sizeof( double ) + 1 );
+
+    if( convert == true )
+    {
+        source.getVar( &buffer[0] );
+    }
+    else
+    {
+        source.getVar( static_cast< void * >( &buffer[0] ) );
+    }
+
+    /// the strings allocated by netCDF are freed on every path
+    const FileWriterLocal::StringsGuard guard( ( isString == true ) ? reinterpret_cast< char ** >( &buffer[0] ) : nullptr, sourceNumValues );
+
+    if( numValues == sourceNumValues && ( dimensionNames.empty() == true || dimensionNames[0] != "M" || measurementOrigins.empty() == true ) )
+    {
+        if( convert == true )
+        {
+            var.putVar( &buffer[0] );
+        }
+        else
+        {
+            var.putVar( static_cast< const void * >( &buffer[0] ) );
+        }
+    }
+    else if( dimensionNames.empty() == false && dimensionNames[0] == "M" && measurementOrigins.size() == dims[0].getSize() )
+    {
+        /// copy the rows following the origins of the new measurements
+        const std::size_t rowSize = ( sourceNumValues / sourceSizes[0] ) * typeSize;
+
+        const unsigned char *bytes = reinterpret_cast< const unsigned char * >( &buffer[0] );
+
+        std::vector< double > rows( ( measurementOrigins.size() * rowSize ) / sizeof( double ) + 1 );
+
+        for( std::size_t m = 0; m < measurementOrigins.size(); m++ )
+        {
+            if( measurementOrigins[m] >= sourceSizes[0] )
+            {
+                SOFA_THROW( "invalid measurement origin" );
+                return;
+            }
+
+            std::memcpy( reinterpret_cast< unsigned char * >( &rows[0] ) + m * rowSize, bytes + measurementOrigins[m] * rowSize, rowSize );
+        }
+
+        if( convert == true )
+        {
+            var.putVar( &rows[0] );
+        }
+        else
+        {
+            var.putVar( static_cast< const void * >( &rows[0] ) );
+        }
+    }
+    else
+    {
+        SOFA_THROW( "the dimensions of " + name + " have changed, but the variable has not been set" );
+    }
+}
@@ -0,0 +1,135 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAFileWriter.h
+ *   @brief      Writes SOFA files derived from a template file
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_FILE_WRITER_H__
+#define _SOFA_FILE_WRITER_H__
+
+#include "../src/SOFANcFile.h"
+#include <map>
+#include <set>
+
+namespace sofa
+{
+
+    /************************************************************************************/
+    /*!
+     *  @class          FileWriter
+     *  @brief          Writes a new SOFA file, derived from an existing one
+     *
+     *  @details        Everything (global attributes, dimensions, variables and their
+     *                  attributes) is copied from a template file, except what has been
+     *                  overridden. This keeps all the metadata of the original measurements
+     *                  when writing processed data.
+     *
+     *                  When the number of measurements changes, the variables depending on M
+     *                  that are not overridden are copied row by row, following the index in
+     *                  the template of each new measurement (see SetMeasurementOrigins).
+     */
+    /************************************************************************************/
+    class SOFA_API FileWriter
+    {
+    public:
+        FileWriter(const sofa::NetCDFFile &templateFile);
+        ~FileWriter() {};
+
+        //==============================================================================
+        void SetAttribute(const std::string &attributeName,
+                          const std::string &value);
+
+        void SetDimension(const std::string &dimensionName,
+                          const std::size_t size);
+
+        void SetVariable(const std::string &variableName,
+                         const std::vector< std::string > &dimensionNames,
+                         const std::vector< double > &values);
+
+        void SetVariableAttribute(const std::string &variableName,
+                                  const std::string &attributeName,
+                                  const std::string &value);
+
+        void RemoveVariable(const std::string &variableName);
+
+        void SetFloatStorage(const std::string &variableName,
+                             const bool floatStorage = true);
+
+        void SetMeasurementOrigins(const std::vector< unsigned long > &origins);
+
+        //==============================================================================
+        bool Write(const std::string &path) const;
+
+    private:
+        struct Variable
+        {
+            std::vector< std::string > dimensionNames;
+            std::vector< double > values;
+        };
+
+        void writeVariable(const netCDF::NcFile &output,
+                           const netCDF::NcVar &source,
+                           const std::map< std::string, netCDF::NcDim > &dimensions) const;
+
+    private:
+        const std::string templatePath;
+
+        std::map< std::string, std::string > attributes;
+        std::map< std::string, std::size_t > dimensions;
+        std::map< std::string, Variable > variables;
+        std::vector< std::string > newVariables;        ///< variables not in the template, in order of creation
+        std::map< std::string, std::map< std::string, std::string > > variableAttributes;
+        std::set< std::string > removedVariables;       ///< variables of the template not written
+        std::map< std::string, bool > floatStorage;     ///< storage type of the variables set (float or double)
+
+        std::vector< unsigned long > measurementOrigins;
+
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( FileWriter );
+    };
+
+}
+
+#endif /* _SOFA_FILE_WRITER_H__ */
@@ -0,0 +1,690 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAFractionalDelayLine.cpp
+ *   @brief      Multichannel fractional delay line
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAFractionalDelayLine.h"
+#include "../src/SOFAFFT.h"
+#include "../src/SOFASimd.h"
+#include "../src/SOFAExceptions.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+using namespace sofa::dsp;
+
+namespace FractionalDelayLineLocal
+{
+    const unsigned int kMaxLagrangeOrder   = 15;
+    const unsigned int kMaxThiranOrder     = 8;
+    const unsigned int kMaxSincOrder       = 32;
+
+    const double kPi = 3.14159265358979323846;
+
+    /// ApplyDelay : a delay within this distance of an integer is a plain shift
+    const double kIntegerTolerance = 1.0e-6;
+
+    /// ApplyDelay : number of samples per call to Process
+    const unsigned int kOfflineBlockSize = 256;
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Number of taps of an interpolator
+     *
+     */
+    /************************************************************************************/
+    unsigned int ComputeNumTaps(const FractionalDelayLine::Interpolation interpolation,
+                            const unsigned int order)
+    {
+        if( interpolation == FractionalDelayLine::kWindowedSinc )
+        {
+            return 2 * order;
+        }
+        else
+        {
+            return order + 1;
+        }
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Delay of the interpolator such that it is used in its best range
+     *                  (the remainder of the delay is an integer number of samples)
+     *
+     */
+    /************************************************************************************/
+    double GetCenter(const FractionalDelayLine::Interpolation interpolation,
+                     const unsigned int order)
+    {
+        const double N = static_cast< double >( order );
+
+        switch( interpolation )
+        {
+            case FractionalDelayLine::kLagrange     : return 0.5 * ( N - 1.0 );
+            case FractionalDelayLine::kThiran       : return N - 0.5;
+            case FractionalDelayLine::kWindowedSinc : return N - 1.0;
+        }
+
+        return 0.0;
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Rounds up to a multiple of the vector size
+     *
+     */
+    /************************************************************************************/
+    unsigned int GetNumLanes(const unsigned int numChannels)
+    {
+        const unsigned int W = static_cast< unsigned int >( sofa::Simd::kVectorSize );
+
+        return ( ( numChannels + W - 1 ) / W ) * W;
+    }
+}
+
+using namespace FractionalDelayLineLocal;
+
+/************************************************************************************/
+/*!
+ *  @brief          Constructor
+ *  @param[in]      numChannels_ : number of independent channels
+ *  @param[in]      maxDelay_ : largest delay, in samples
+ *  @param[in]      maxBlockSize_ : largest number of samples per call to Process
+ *  @param[in]      interpolation_ : interpolation method
+ *  @param[in]      order_ : order N of the interpolator (1 to 15 for Lagrange,
+ *                  1 to 8 for Thiran, 1 to 32 for the windowed sinc)
+ *
+ */
+/************************************************************************************/
+FractionalDelayLine::FractionalDelayLine(const unsigned int numChannels_,
+                                         const double maxDelay_,
+                                         const unsigned int maxBlockSize_,
+                                         const sofa::dsp::FractionalDelayLine::Interpolation interpolation_,
+                                         const unsigned int order_)
+: numChannels( numChannels_ )
+, numLanes( GetNumLanes( numChannels_ ) )
+, maxDelay( maxDelay_ )
+, maxBlockSize( maxBlockSize_ )
+, interpolation( interpolation_ )
+, order( order_ )
+, numTaps( ComputeNumTaps( interpolation_, order_ ) )
+, mask( 0 )
+, writePosition( 0 )
+{
+    unsigned int maxOrder = 0;
+
+    switch( interpolation )
+    {
+        case kLagrange      : maxOrder = kMaxLagrangeOrder; break;
+        case kThiran        : maxOrder = kMaxThiranOrder;   break;
+        case kWindowedSinc  : maxOrder = kMaxSincOrder;     break;
+    }
+
+    if( numChannels == 0 || maxBlockSize == 0 || order == 0 || order > maxOrder
+       || maxDelay < 0.0 || maxDelay > 1.0e7 )
+    {
+        SOFA_THROW( "invalid fractional delay line configuration" );
+    }
+
+    const unsigned int W = static_cast< unsigned int >( sofa::Simd::kVectorSize );
+    const unsigned int T = numTaps;
+    const unsigned int N = order;
+
+    /// holds the block being written and the oldest sample read by the interpolator
+    const unsigned int size = sofa::dsp::FFT::NextPowerOfTwo( static_cast< unsigned int >( std::ceil( maxDelay ) ) + T + maxBlockSize + 1 );
+
+    buffers.assign( numLanes * size, 0.0f );
+    mask = size - 1;
+
+    if( interpolation == kLagrange )
+    {
+        denominators.resize( T );
+
+        for( unsigned int k = 0; k < T; k++ )
+        {
+            double product = 1.0;
+
+            for( unsigned int m = 0; m < T; m++ )
+            {
+                if( m != k )
+                {
+                    product *= static_cast< double >( k ) - static_cast< double >( m );
+                }
+            }
+
+            denominators[k] = static_cast< float >( 1.0 / product );
+        }
+    }
+    else if( interpolation == kThiran )
+    {
+        thiranBinomials.resize( N + 1 );
+
+        double binomial = 1.0;
+
+        for( unsigned int k = 0; k <= N; k++ )
+        {
+            thiranBinomials[k] = static_cast< float >( ( k % 2 == 0 ) ? binomial : -binomial );
+
+            binomial = binomial * static_cast< double >( N - k ) / static_cast< double >( k + 1 );
+        }
+
+        thiranOutputs.assign( numLanes * N, 0.0f );
+    }
+
+    fractions.assign( W, 0.0f );
+    offsets.assign( W, 0 );
+    sines.assign( W, 0.0f );
+    integerTaps.assign( W, -1 );
+    coefficients.assign( T * W, 0.0f );
+    taps.assign( T * W, 0.0f );
+    results.assign( W, 0.0f );
+}
+
+unsigned int FractionalDelayLine::GetNumChannels() const
+{
+    return numChannels;
+}
+
+double FractionalDelayLine::GetMaxDelay() const
+{
+    return maxDelay;
+}
+
+FractionalDelayLine::Interpolation FractionalDelayLine::GetInterpolation() const
+{
+    return interpolation;
+}
+
+unsigned int FractionalDelayLine::GetOrder() const
+{
+    return order;
+}
+
+unsigned int FractionalDelayLine::GetNumTaps() const
+{
+    return numTaps;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Length of a signal of length samples once delayed by ApplyDelay
+ *  @param[in]      length : number of samples of the signal
+ *  @param[in]      delay : in samples (negative delays are treated as 0)
+ *
+ */
+/************************************************************************************/
+std::size_t FractionalDelayLine::GetDelayedLength(const std::size_t length,
+                                                  const double delay,
+                                                  const sofa::dsp::FractionalDelayLine::Interpolation interpolation,
+                                                  const unsigned int order)
+{
+    const double d = std::max( 0.0, delay );
+    const double nearest = std::floor( d + 0.5 );
+
+    if( std::fabs( d - nearest ) <= kIntegerTolerance )
+    {
+        return length + static_cast< std::size_t >( nearest );
+    }
+
+    /// the interpolator spreads the last sample over its taps
+    return length + static_cast< std::size_t >( std::ceil( d ) ) + ComputeNumTaps( interpolation, order );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Delays a finite signal by a constant, fractional delay (e.g. to include
+ *                  Data.Delay in a filter)
+ *  @param[out]     output : outputLength samples (GetDelayedLength to keep the whole
+ *                  delayed signal)
+ *  @param[in]      input : inputLength samples
+ *  @param[in]      delay : in samples (negative delays are treated as 0)
+ *  @param[in]      interpolation : interpolation method
+ *  @param[in]      order : order of the interpolator
+ *
+ *  @details        Integer delays are plain shifts. Otherwise the signal goes through a
+ *                  FractionalDelayLine, with an additional integer delay that puts the
+ *                  interpolator in its best range, removed afterwards : only the part of
+ *                  the interpolator response before time 0 is lost.
+ */
+/************************************************************************************/
+void FractionalDelayLine::ApplyDelay(double *output,
+                                     const std::size_t outputLength,
+                                     const double *input,
+                                     const std::size_t inputLength,
+                                     const double delay,
+                                     const sofa::dsp::FractionalDelayLine::Interpolation interpolation,
+                                     const unsigned int order)
+{
+    std::fill( output, output + outputLength, 0.0 );
+
+    const double d = std::max( 0.0, delay );
+    const double nearest = std::floor( d + 0.5 );
+
+    if( std::fabs( d - nearest ) <= kIntegerTolerance )
+    {
+        const std::size_t shift = static_cast< std::size_t >( nearest );
+
+        for( std::size_t n = 0; n < inputLength && n + shift < outputLength; n++ )
+        {
+            output[ n + shift ] = input[n];
+        }
+
+        return;
+    }
+
+    const std::size_t shift = static_cast< std::size_t >( std::floor( d ) );
+    const std::size_t center = static_cast< std::size_t >( std::ceil( GetCenter( interpolation, order ) ) );
+    const float lineDelay = static_cast< float >( static_cast< double >( center ) + d - std::floor( d ) );
+
+    sofa::dsp::FractionalDelayLine line( 1, center + 1.0, kOfflineBlockSize, interpolation, order );
+
+    std::vector< float > x( kOfflineBlockSize );
+    std::vector< float > y( kOfflineBlockSize );
+
+    float *outputs[1]       = { &y[0] };
+    const float *inputs[1]  = { &x[0] };
+
+    /// sample t of the line output is sample t + shift - center of the delayed signal
+    const std::size_t total = inputLength + center + ComputeNumTaps( interpolation, order );
+
+    for( std::size_t start = 0; start < total; start += kOfflineBlockSize )
+    {
+        const unsigned int count = static_cast< unsigned int >( std::min< std::size_t >( kOfflineBlockSize, total - start ) );
+
+        for( unsigned int i = 0; i < count; i++ )
+        {
+            x[i] = ( start + i < inputLength ) ? static_cast< float >( input[ start + i ] ) : 0.0f;
+        }
+
+        line.Process( outputs, inputs, count, &lineDelay );
+
+        for( unsigned int i = 0; i < count; i++ )
+        {
+            const std::size_t t = start + i + shift;
+
+            if( t >= center && t - center < outputLength )
+            {
+                output[ t - center ] = static_cast< double >( y[i] );
+            }
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Clears the delay lines
+ *
+ */
+/************************************************************************************/
+void FractionalDelayLine::Reset()
+{
+    std::fill( buffers.begin(), buffers.end(), 0.0f );
+    std::fill( thiranOutputs.begin(), thiranOutputs.end(), 0.0f );
+
+    writePosition = 0;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Delays one block of each channel, with a constant delay
+ *  @param[out]     outputs : one buffer of numSamples samples per channel
+ *  @param[in]      inputs : one buffer of numSamples samples per channel
+ *  @param[in]      numSamples : at most the maximum block size
+ *  @param[in]      delays : one delay per channel, in samples
+ *  @return         false if numSamples is out of range (nothing is done)
+ *
+ */
+/************************************************************************************/
+bool FractionalDelayLine::Process(float *const *outputs,
+                                  const float *const *inputs,
+                                  const unsigned int numSamples,
+                                  const float *delays)
+{
+    return Process( outputs, inputs, numSamples, delays, delays );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Delays one block of each channel, with a delay going linearly from
+ *                  one value to another over the block
+ *  @param[out]     outputs : one buffer of numSamples samples per channel
+ *                  (may be the same buffers as the inputs)
+ *  @param[in]      inputs : one buffer of numSamples samples per channel
+ *  @param[in]      numSamples : at most the maximum block size
+ *  @param[in]      fromDelays : one delay per channel before the block, in samples
+ *  @param[in]      toDelays : one delay per channel at the end of the block, in samples
+ *  @return         false if numSamples is out of range (nothing is done)
+ *
+ *  @details        Delays are clamped to [ 0, maxDelay ]
+ */
+/************************************************************************************/
+bool FractionalDelayLine::Process(float *const *outputs,
+                                  const float *const *inputs,
+                                  const unsigned int numSamples,
+                                  const float *fromDelays,
+                                  const float *toDelays)
+{
+    if( numSamples > maxBlockSize )
+    {
+        SOFA_ASSERT( false );
+        return false;
+    }
+
+    if( numSamples == 0 )
+    {
+        return true;
+    }
+
+    using namespace sofa::Simd;
+
+    const unsigned int W    = static_cast< unsigned int >( kVectorSize );
+    const unsigned int T    = numTaps;
+    const unsigned int C    = numChannels;
+    const unsigned int size = mask + 1;
+
+    for( unsigned int c = 0; c < C; c++ )
+    {
+        float *line = &buffers[ c * size ];
+
+        for( unsigned int n = 0; n < numSamples; n++ )
+        {
+            line[ ( writePosition + n ) & mask ] = inputs[c][n];
+        }
+    }
+
+    if( interpolation == kThiran )
+    {
+        /// recursive : one channel at a time
+        for( unsigned int c = 0; c < C; c++ )
+        {
+            processThiran( outputs[c], c, numSamples, fromDelays[c], toDelays[c] );
+        }
+    }
+    else
+    {
+        const float center  = static_cast< float >( GetCenter( interpolation, order ) );
+        const float upper   = static_cast< float >( maxDelay );
+        const float step    = 1.0f / static_cast< float >( numSamples );
+
+        for( unsigned int lane0 = 0; lane0 < numLanes; lane0 += W )
+        {
+            const unsigned int numActive = std::min( W, C - std::min( C, lane0 ) );
+
+            for( unsigned int n = 0; n < numSamples; n++ )
+            {
+                const float ramp            = static_cast< float >( n + 1 ) * step;
+                const unsigned int position = writePosition + n;
+
+                for( unsigned int l = 0; l < W; l++ )
+                {
+                    float delay = 0.0f;
+
+                    if( l < numActive )
+                    {
+                        const float from = fromDelays[ lane0 + l ];
+                        const float to   = toDelays[ lane0 + l ];
+
+                        delay = std::min( upper, std::max( 0.0f, from + ( to - from ) * ramp ) );
+                    }
+
+                    /// the interpolator spans [ offset, offset + T - 1 ] samples of delay
+                    const float offset  = std::max( 0.0f, std::floor( delay - center ) );
+                    float fraction      = delay - offset;
+
+                    if( interpolation == kWindowedSinc )
+                    {
+                        /// an integer delay is a single tap (the sinc would be 0 / 0 there) ; the
+                        /// coefficients are computed for any fraction, then replaced
+                        const float nearest = std::floor( fraction + 0.5f );
+
+                        integerTaps[l] = ( fraction == nearest ) ? static_cast< int >( nearest ) : -1;
+
+                        if( integerTaps[l] >= 0 )
+                        {
+                            fraction = nearest + 0.5f;
+                        }
+
+                        sines[l] = static_cast< float >( std::sin( kPi * static_cast< double >( fraction ) ) / kPi );
+                    }
+
+                    fractions[l]    = fraction;
+                    offsets[l]      = static_cast< unsigned int >( offset );
+
+                    /// gathers the taps of the lane
+                    const float *line           = &buffers[ ( lane0 + l ) * size ];
+                    const unsigned int first    = position - offsets[l];
+
+                    for( unsigned int k = 0; k < T; k++ )
+                    {
+                        taps[ k * W + l ] = line[ ( first - k ) & mask ];
+                    }
+                }
+
+                computeCoefficients();
+
+                if( interpolation == kWindowedSinc )
+                {
+                    for( unsigned int l = 0; l < numActive; l++ )
+                    {
+                        if( integerTaps[l] >= 0 )
+                        {
+                            for( unsigned int k = 0; k < T; k++ )
+                            {
+                                coefficients[ k * W + l ] = ( static_cast< int >( k ) == integerTaps[l] ) ? 1.0f : 0.0f;
+                            }
+                        }
+                    }
+                }
+
+                Vector acc = Set( 0.0f );
+
+                for( unsigned int k = 0; k < T; k++ )
+                {
+                    acc = MultiplyAdd( acc, Load( &coefficients[ k * W ] ), Load( &taps[ k * W ] ) );
+                }
+
+                Store( &results[0], acc );
+
+                for( unsigned int l = 0; l < numActive; l++ )
+                {
+                    outputs[ lane0 + l ][n] = results[l];
+                }
+            }
+        }
+    }
+
+    writePosition = ( writePosition + numSamples ) & mask;
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the FIR coefficients of the W lanes of a group, from
+ *                  their fractional delays (all the lanes at once)
+ *
+ */
+/************************************************************************************/
+void FractionalDelayLine::computeCoefficients()
+{
+    using namespace sofa::Simd;
+
+    const unsigned int W = static_cast< unsigned int >( kVectorSize );
+    const unsigned int T = numTaps;
+
+    const Vector D = Load( &fractions[0] );
+
+    if( interpolation == kLagrange )
+    {
+        /// h_k = prod_{m != k} ( D - m ) / ( k - m ), as prefix and suffix products
+        Vector left = Set( 1.0f );
+
+        for( unsigned int k = 0; k < T; k++ )
+        {
+            Store( &coefficients[ k * W ], left );
+
+            left = Mul( left, Sub( D, Set( static_cast< float >( k ) ) ) );
+        }
+
+        Vector right = Set( 1.0f );
+
+        for( unsigned int k = T; k-- > 0; )
+        {
+            const Vector h = Mul( Load( &coefficients[ k * W ] ), Mul( right, Set( denominators[k] ) ) );
+
+            Store( &coefficients[ k * W ], h );
+
+            right = Mul( right, Sub( D, Set( static_cast< float >( k ) ) ) );
+        }
+    }
+    else
+    {
+        /// h_k = sin( pi ( D - k ) ) / ( pi ( D - k ) ) * w( ( D - k ) / N ), w( t ) = ( 1 - t^2 )^2
+        /// with sin( pi ( D - k ) ) = ( -1 )^k sin( pi D ), normalized to unit gain at DC
+        const Vector sine       = Load( &sines[0] );
+        const Vector zero       = Set( 0.0f );
+        const Vector one        = Set( 1.0f );
+        const Vector inverseN   = Set( 1.0f / static_cast< float >( order ) );
+
+        Vector sum = zero;
+
+        for( unsigned int k = 0; k < T; k++ )
+        {
+            const Vector distance   = Sub( D, Set( static_cast< float >( k ) ) );
+            const Vector t          = Mul( distance, inverseN );
+            const Vector w          = Max( zero, Sub( one, Mul( t, t ) ) );
+            const Vector sinc       = Div( Mul( sine, Set( ( k % 2 == 0 ) ? 1.0f : -1.0f ) ), distance );
+
+            const Vector h          = Mul( sinc, Mul( w, w ) );
+
+            Store( &coefficients[ k * W ], h );
+
+            sum = Add( sum, h );
+        }
+
+        const Vector gain = Div( one, sum );
+
+        for( unsigned int k = 0; k < T; k++ )
+        {
+            Store( &coefficients[ k * W ], Mul( Load( &coefficients[ k * W ] ), gain ) );
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Delays one block of a channel with the Thiran allpass
+ *  @param[out]     y : numSamples samples
+ *  @param[in]      channel : index of the channel
+ *  @param[in]      numSamples : number of samples
+ *  @param[in]      fromDelay : delay before the block, in samples
+ *  @param[in]      toDelay : delay at the end of the block, in samples
+ *
+ *  @details        With u the input delayed by an integer number of samples,
+ *                  y[n] = sum_k a_{N-k} u[n-k] - sum_{k>0} a_k y[n-k], and
+ *                  a_k = (-1)^k C(N,k) prod_i ( D - N + i ) / ( D - N + k + i )
+ */
+/************************************************************************************/
+void FractionalDelayLine::processThiran(float *y,
+                                        const unsigned int channel,
+                                        const unsigned int numSamples,
+                                        const float fromDelay,
+                                        const float toDelay)
+{
+    const unsigned int N    = order;
+    const unsigned int size = mask + 1;
+    const double center     = GetCenter( interpolation, order );
+    const double upper      = maxDelay;
+
+    const float *line   = &buffers[ channel * size ];
+    float *past         = &thiranOutputs[ channel * N ];
+
+    double a[ kMaxThiranOrder + 1 ];
+
+    for( unsigned int n = 0; n < numSamples; n++ )
+    {
+        const double ramp   = static_cast< double >( n + 1 ) / static_cast< double >( numSamples );
+        const double delay  = std::min( upper, std::max( 0.0, fromDelay + ( toDelay - fromDelay ) * ramp ) );
+
+        const double offset = std::max( 0.0, std::floor( delay - center ) );
+        const double D      = std::max( center, delay - offset );
+
+        a[0] = 1.0;
+
+        for( unsigned int k = 1; k <= N; k++ )
+        {
+            double product = thiranBinomials[k];
+
+            for( unsigned int i = 0; i <= N; i++ )
+            {
+                product *= ( D - N + i ) / ( D - N + k + i );
+            }
+
+            a[k] = product;
+        }
+
+        const unsigned int first = writePosition + n - static_cast< unsigned int >( offset );
+
+        double sum = 0.0;
+
+        for( unsigned int k = 0; k <= N; k++ )
+        {
+            sum += a[ N - k ] * line[ ( first - k ) & mask ];
+        }
+
+        for( unsigned int k = 1; k <= N; k++ )
+        {
+            sum -= a[k] * past[ k - 1 ];
+        }
+
+        for( unsigned int k = N - 1; k > 0; k-- )
+        {
+            past[k] = past[ k - 1 ];
+        }
+
+        past[0] = static_cast< float >( sum );
+        y[n]    = past[0];
+    }
+}
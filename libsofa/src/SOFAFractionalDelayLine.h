@@ -0,0 +1,184 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAFractionalDelayLine.h
+ *   @brief      Multichannel fractional delay line
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_FRACTIONAL_DELAY_LINE_H__
+#define _SOFA_FRACTIONAL_DELAY_LINE_H__
+
+#include "../src/SOFAPlatform.h"
+
+namespace sofa
+{
+
+    namespace dsp
+    {
+
+        /************************************************************************************/
+        /*!
+         *  @class          FractionalDelayLine
+         *  @brief          Multichannel delay line with fractional, time-varying delays
+         *                  (e.g. to apply Data.Delay)
+         *
+         *  @details        The delay of each channel goes linearly, sample by sample, from one
+         *                  value to another over a block, so that interpolated ITDs change
+         *                  without zipper noise. The interpolation is one of :
+         *                  - Lagrange of order N (N+1 taps, maximally flat at low frequencies);
+         *                  - Thiran allpass of order N (flat magnitude, recursive);
+         *                  - windowed sinc with 2N taps (polynomial window).
+         *
+         *                  The channels are processed by groups of sofa::Simd::kVectorSize : the
+         *                  FIR coefficients of all the channels of a group are computed and
+         *                  applied in the same vector operations.
+         *
+         *                  There is no added latency : when a delay is smaller than half the
+         *                  interpolator length, the interpolator is used off-center (less
+         *                  accurate at high frequencies). The Thiran allpass is stable only for
+         *                  delays above N - 1 : smaller delays are raised to N - 0.5, and the
+         *                  filter is best suited to slowly varying delays.
+         *                  Process does not allocate.
+         *
+         *                  ApplyDelay delays a finite signal once, e.g. to include a fractional
+         *                  Data.Delay in a filter instead of rounding it to the sample.
+         */
+        /************************************************************************************/
+        class SOFA_API FractionalDelayLine
+        {
+        public:
+            enum Interpolation
+            {
+                kLagrange       = 0,
+                kThiran         = 1,
+                kWindowedSinc   = 2
+            };
+
+        public:
+            FractionalDelayLine(const unsigned int numChannels,
+                                const double maxDelay,
+                                const unsigned int maxBlockSize,
+                                const sofa::dsp::FractionalDelayLine::Interpolation interpolation = kLagrange,
+                                const unsigned int order = 3);
+            ~FractionalDelayLine() {};
+
+            //==============================================================================
+            unsigned int GetNumChannels() const;
+            double GetMaxDelay() const;
+            sofa::dsp::FractionalDelayLine::Interpolation GetInterpolation() const;
+            unsigned int GetOrder() const;
+            unsigned int GetNumTaps() const;
+
+            //==============================================================================
+            bool Process(float *const *outputs,
+                         const float *const *inputs,
+                         const unsigned int numSamples,
+                         const float *fromDelays,
+                         const float *toDelays);
+
+            bool Process(float *const *outputs,
+                         const float *const *inputs,
+                         const unsigned int numSamples,
+                         const float *delays);
+
+            void Reset();
+
+            //==============================================================================
+            static std::size_t GetDelayedLength(const std::size_t length,
+                                                const double delay,
+                                                const sofa::dsp::FractionalDelayLine::Interpolation interpolation = kWindowedSinc,
+                                                const unsigned int order = 16);
+
+            static void ApplyDelay(double *output,
+                                   const std::size_t outputLength,
+                                   const double *input,
+                                   const std::size_t inputLength,
+                                   const double delay,
+                                   const sofa::dsp::FractionalDelayLine::Interpolation interpolation = kWindowedSinc,
+                                   const unsigned int order = 16);
+
+        private:
+            void computeCoefficients();
+
+            void processThiran(float *y,
+                               const unsigned int channel,
+                               const unsigned int numSamples,
+                               const float fromDelay,
+                               const float toDelay);
+
+        private:
+            const unsigned int numChannels;
+            const unsigned int numLanes;                ///< numChannels rounded up to the vector size
+            const double maxDelay;
+            const unsigned int maxBlockSize;
+            const Interpolation interpolation;
+            const unsigned int order;
+            const unsigned int numTaps;
+
+            std::vector< float > buffers;               ///< [ lanes D ] circular buffers, D a power of two
+            unsigned int mask;                          ///< D - 1
+            unsigned int writePosition;
+
+            std::vector< float > denominators;          ///< [ taps ] Lagrange : 1 / prod( k - m )
+            std::vector< float > thiranBinomials;       ///< [ N+1 ] Thiran : (-1)^k C( N, k )
+            std::vector< float > thiranOutputs;         ///< [ lanes N ] past outputs of the allpass
+
+            /// work buffers, for one group of lanes and one sample
+            std::vector< float > fractions;             ///< [ W ] delay from the first tap
+            std::vector< unsigned int > offsets;        ///< [ W ] delay of the first tap
+            std::vector< float > sines;                 ///< [ W ] windowed sinc : sin( pi D ) / pi
+            std::vector< int > integerTaps;             ///< [ W ] windowed sinc : tap of an integer delay, or -1
+            std::vector< float > coefficients;          ///< [ taps W ]
+            std::vector< float > taps;                  ///< [ taps W ] gathered input samples
+            std::vector< float > results;               ///< [ W ]
+
+        private:
+            /// avoid shallow and copy constructor
+            SOFA_AVOID_COPY_CONSTRUCTOR( FractionalDelayLine );
+        };
+
+    }
+
+}
+
+#endif /* _SOFA_FRACTIONAL_DELAY_LINE_H__ */
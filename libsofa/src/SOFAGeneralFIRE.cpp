@@ -185,6 +185,21 @@ bool GeneralFIRE::GetDataIR(std::vector< double > &values) const
     return sofa::File::getDataIR( values );
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values in single precision
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralFIRE::GetDataIR(std::vector< float > &values) const
+{
+    /// Data.IR is [ M R N E ]
+    
+    return sofa::File::getDataIR( values );
+}
+
 
 bool GeneralFIRE::GetDataDelay(double *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const
 {
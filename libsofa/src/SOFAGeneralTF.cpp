@@ -118,3 +118,184 @@ bool GeneralTF::IsValid() const
     return true;
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the frequencies of the N dimension (variable 'N')
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralTF::GetFrequencies(std::vector< double > &values) const
+{
+    SOFA_ASSERT( HasVariable( "N" ) == true );
+    
+    return NetCDFFile::GetValues( values, "N" );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.Real values
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralTF::GetDataReal(std::vector< double > &values) const
+{
+    /// Data.Real is [ M R N ]
+    
+    return NetCDFFile::GetValues( values, "Data.Real" );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.Real values
+ *  @param[in]      values : pointer to an array of size dim1 * dim2 * dim3
+ *                  The array must be allocated large enough
+ *  @param[in]      dim1 : first dimension (M)
+ *  @param[in]      dim2 : second dimension (R)
+ *  @param[in]      dim3 : third dimension (N)
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralTF::GetDataReal(double *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const
+{
+    /// Data.Real is [ M R N ]
+    
+    return NetCDFFile::GetValues( values, dim1, dim2, dim3, "Data.Real" );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.Real values of a range of measurements
+ *  @param[in]      values : resized to numMeasurements * R * N
+ *  @param[in]      firstMeasurement : index of the first measurement to read
+ *  @param[in]      numMeasurements : number of measurements to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralTF::GetDataReal(std::vector< double > &values, const unsigned long firstMeasurement, const unsigned long numMeasurements) const
+{
+    return getMeasurements( values, firstMeasurement, numMeasurements, "Data.Real" );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.Imag values
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralTF::GetDataImag(std::vector< double > &values) const
+{
+    /// Data.Imag is [ M R N ]
+    
+    return NetCDFFile::GetValues( values, "Data.Imag" );
+}
+
+bool GeneralTF::GetDataImag(double *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const
+{
+    /// Data.Imag is [ M R N ]
+    
+    return NetCDFFile::GetValues( values, dim1, dim2, dim3, "Data.Imag" );
+}
+
+bool GeneralTF::GetDataImag(std::vector< double > &values, const unsigned long firstMeasurement, const unsigned long numMeasurements) const
+{
+    return getMeasurements( values, firstMeasurement, numMeasurements, "Data.Imag" );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves Data.Real and Data.Imag as interleaved complex values
+ *  @param[in]      values : resized to M * R * N * 2 ( re im re im ... )
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralTF::GetDataTF(std::vector< double > &values) const
+{
+    const long M = GetNumMeasurements();
+    
+    if( M <= 0 )
+    {
+        return false;
+    }
+    
+    return GetDataTF( values, 0, static_cast< unsigned long >( M ) );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves Data.Real and Data.Imag of a range of measurements as
+ *                  interleaved complex values
+ *  @param[in]      values : resized to numMeasurements * R * N * 2 ( re im re im ... )
+ *  @param[in]      firstMeasurement : index of the first measurement to read
+ *  @param[in]      numMeasurements : number of measurements to read
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GeneralTF::GetDataTF(std::vector< double > &values, const unsigned long firstMeasurement, const unsigned long numMeasurements) const
+{
+    std::vector< double > real;
+    std::vector< double > imag;
+    
+    if( getMeasurements( real, firstMeasurement, numMeasurements, "Data.Real" ) == false
+       || getMeasurements( imag, firstMeasurement, numMeasurements, "Data.Imag" ) == false )
+    {
+        return false;
+    }
+    
+    /// NB : mapped netCDF reads (imap) could interleave in place, but are much slower
+    const std::size_t size = real.size();
+    values.resize( 2 * size );
+    
+    for( std::size_t i = 0; i < size; i++ )
+    {
+        values[ 2 * i ]     = real[i];
+        values[ 2 * i + 1 ] = imag[i];
+    }
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads a range of measurements of a [ M R N ] variable
+ *
+ */
+/************************************************************************************/
+bool GeneralTF::getMeasurements(std::vector< double > &values,
+                                const unsigned long firstMeasurement,
+                                const unsigned long numMeasurements,
+                                const std::string &variableName) const
+{
+    const long M = GetNumMeasurements();
+    const long R = GetNumReceivers();
+    const long N = GetNumDataSamples();
+    
+    if( M <= 0 || R <= 0 || N <= 0
+       || firstMeasurement > static_cast< unsigned long >( M )
+       || numMeasurements > static_cast< unsigned long >( M ) - firstMeasurement )
+    {
+        return false;
+    }
+    
+    values.resize( static_cast< std::size_t >( numMeasurements ) * R * N );
+    
+    if( numMeasurements == 0 )
+    {
+        return true;
+    }
+    
+    const std::vector< std::size_t > start( { firstMeasurement, 0, 0 } );
+    const std::vector< std::size_t > count( { numMeasurements, static_cast< std::size_t >( R ), static_cast< std::size_t >( N ) } );
+    
+    return NetCDFFile::GetValues( &values[0], start, count, variableName );
+}
+
@@ -77,10 +77,30 @@ namespace sofa
         
         virtual bool IsValid() const SOFA_OVERRIDE;
         
+        //==============================================================================
+        bool GetFrequencies(std::vector< double > &values) const;
+        
+        //==============================================================================
+        bool GetDataReal(std::vector< double > &values) const;
+        bool GetDataReal(double *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const;
+        bool GetDataReal(std::vector< double > &values, const unsigned long firstMeasurement, const unsigned long numMeasurements) const;
+        
+        bool GetDataImag(std::vector< double > &values) const;
+        bool GetDataImag(double *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const;
+        bool GetDataImag(std::vector< double > &values, const unsigned long firstMeasurement, const unsigned long numMeasurements) const;
+        
+        bool GetDataTF(std::vector< double > &values) const;
+        bool GetDataTF(std::vector< double > &values, const unsigned long firstMeasurement, const unsigned long numMeasurements) const;
+        
     private:
         //==============================================================================
         bool checkGlobalAttributes() const;
         
+        bool getMeasurements(std::vector< double > &values,
+                             const unsigned long firstMeasurement,
+                             const unsigned long numMeasurements,
+                             const std::string &variableName) const;
+        
     private:
         /// avoid shallow and copy constructor
         SOFA_AVOID_COPY_CONSTRUCTOR( GeneralTF );
@@ -0,0 +1,179 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAGeometry.cpp
+ *   @brief      Geometry helpers for SOFA positions
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAGeometry.h"
+#include "../src/SOFAUtils.h"
+
+using namespace sofa;
+
+namespace GeometryLocal
+{
+    const double kPi            = 3.14159265358979323846;
+    const double kDegToRad      = kPi / 180.0;
+    const double kRadToDeg      = 180.0 / kPi;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Converts a SOFA spherical position to cartesian coordinates
+ *  @param[out]     cartesian : x y z
+ *  @param[in]      spherical : azimuth (degree), elevation (degree), radius
+ *
+ */
+/************************************************************************************/
+void sofa::Geometry::SphericalToCartesian(double cartesian[3], const double spherical[3])
+{
+    const double azimuth    = spherical[0] * GeometryLocal::kDegToRad;
+    const double elevation  = spherical[1] * GeometryLocal::kDegToRad;
+    const double radius     = spherical[2];
+
+    cartesian[0] = radius * cos( elevation ) * cos( azimuth );
+    cartesian[1] = radius * cos( elevation ) * sin( azimuth );
+    cartesian[2] = radius * sin( elevation );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Converts a cartesian position to SOFA spherical coordinates
+ *  @param[out]     spherical : azimuth (degree, in [0 360[), elevation (degree), radius
+ *  @param[in]      cartesian : x y z
+ *
+ */
+/************************************************************************************/
+void sofa::Geometry::CartesianToSpherical(double spherical[3], const double cartesian[3])
+{
+    const double x = cartesian[0];
+    const double y = cartesian[1];
+    const double z = cartesian[2];
+
+    const double radius = sqrt( x * x + y * y + z * z );
+
+    double azimuth = atan2( y, x ) * GeometryLocal::kRadToDeg;
+    if( azimuth < 0.0 )
+    {
+        azimuth += 360.0;
+    }
+
+    const double elevation = ( radius > 0.0 ) ? asin( sofa::smax( -1.0, sofa::smin( 1.0, z / radius ) ) ) * GeometryLocal::kRadToDeg : 0.0;
+
+    spherical[0] = azimuth;
+    spherical[1] = elevation;
+    spherical[2] = radius;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Normalizes a 3D vector in place and returns its former norm
+ *
+ */
+/************************************************************************************/
+double sofa::Geometry::Normalize(double vector[3])
+{
+    const double norm = sqrt( vector[0] * vector[0] + vector[1] * vector[1] + vector[2] * vector[2] );
+
+    if( norm > 0.0 )
+    {
+        vector[0] /= norm;
+        vector[1] /= norm;
+        vector[2] /= norm;
+    }
+
+    return norm;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the great-circle angle (in radians) between two directions
+ *
+ */
+/************************************************************************************/
+double sofa::Geometry::AngularDistance(const double a[3], const double b[3])
+{
+    /// atan2 of the cross and dot products is accurate for both small and large angles
+    const double cx = a[1] * b[2] - a[2] * b[1];
+    const double cy = a[2] * b[0] - a[0] * b[2];
+    const double cz = a[0] * b[1] - a[1] * b[0];
+
+    const double cross = sqrt( cx * cx + cy * cy + cz * cz );
+    const double dot   = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+
+    return atan2( cross, dot );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Converts an array of positions [K C] to cartesian coordinates
+ *  @param[out]     cartesian : resized to the size of positions
+ *  @param[in]      positions : K points stored as C = 3 consecutive values
+ *  @param[in]      coordinates : coordinate system of the input positions
+ *
+ */
+/************************************************************************************/
+void sofa::Geometry::ToCartesian(std::vector< double > &cartesian,
+                                 const std::vector< double > &positions,
+                                 const sofa::Coordinates::Type &coordinates)
+{
+    SOFA_ASSERT( positions.size() % 3 == 0 );
+
+    cartesian.resize( positions.size() );
+
+    const std::size_t numPoints = positions.size() / 3;
+
+    for( std::size_t i = 0; i < numPoints; i++ )
+    {
+        if( coordinates == sofa::Coordinates::kSpherical )
+        {
+            sofa::Geometry::SphericalToCartesian( &cartesian[ 3 * i ], &positions[ 3 * i ] );
+        }
+        else
+        {
+            cartesian[ 3 * i + 0 ] = positions[ 3 * i + 0 ];
+            cartesian[ 3 * i + 1 ] = positions[ 3 * i + 1 ];
+            cartesian[ 3 * i + 2 ] = positions[ 3 * i + 2 ];
+        }
+    }
+}
@@ -0,0 +1,116 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAGeometry.h
+ *   @brief      Geometry helpers for SOFA positions
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_GEOMETRY_H__
+#define _SOFA_GEOMETRY_H__
+
+#include "../src/SOFACoordinates.h"
+
+namespace sofa
+{
+
+    namespace Geometry
+    {
+
+        /************************************************************************************/
+        /*!
+         *  @brief          Converts a SOFA spherical position to cartesian coordinates
+         *  @param[out]     cartesian : x y z
+         *  @param[in]      spherical : azimuth (degree), elevation (degree), radius
+         *
+         *  @details        SOFA uses x pointing to the front, y to the left and z to the top,
+         *                  with azimuth counterclockwise from the front
+         */
+        /************************************************************************************/
+        SOFA_API_FUNC void SphericalToCartesian(double cartesian[3], const double spherical[3]);
+
+        /************************************************************************************/
+        /*!
+         *  @brief          Converts a cartesian position to SOFA spherical coordinates
+         *  @param[out]     spherical : azimuth (degree, in [0 360[), elevation (degree), radius
+         *  @param[in]      cartesian : x y z
+         *
+         */
+        /************************************************************************************/
+        SOFA_API_FUNC void CartesianToSpherical(double spherical[3], const double cartesian[3]);
+
+        /************************************************************************************/
+        /*!
+         *  @brief          Normalizes a 3D vector in place and returns its former norm
+         *
+         *  @details        A null vector is left untouched
+         */
+        /************************************************************************************/
+        SOFA_API_FUNC double Normalize(double vector[3]);
+
+        /************************************************************************************/
+        /*!
+         *  @brief          Returns the great-circle angle (in radians) between two directions
+         *  @param[in]      a : unit vector
+         *  @param[in]      b : unit vector
+         *
+         */
+        /************************************************************************************/
+        SOFA_API_FUNC double AngularDistance(const double a[3], const double b[3]);
+
+        /************************************************************************************/
+        /*!
+         *  @brief          Converts an array of positions [K C] to cartesian coordinates
+         *  @param[out]     cartesian : resized to the size of positions
+         *  @param[in]      positions : K points stored as C = 3 consecutive values
+         *  @param[in]      coordinates : coordinate system of the input positions
+         *
+         */
+        /************************************************************************************/
+        SOFA_API_FUNC void ToCartesian(std::vector< double > &cartesian,
+                                       const std::vector< double > &positions,
+                                       const sofa::Coordinates::Type &coordinates);
+    }
+
+}
+
+#endif /* _SOFA_GEOMETRY_H__ */
@@ -0,0 +1,571 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAGridResampler.cpp
+ *   @brief      Resampling of FIR data sets onto another grid of directions
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAGridResampler.h"
+#include "../src/SOFASphericalTriangulation.h"
+#include "../src/SOFASphericalHarmonics.h"
+#include "../src/SOFALinearAlgebra.h"
+#include "../src/SOFAFileWriter.h"
+#include "../src/SOFAGeometry.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFADate.h"
+#include "../src/SOFAHash.h"
+#include "../src/SOFACache.h"
+#include <cmath>
+
+using namespace sofa;
+
+namespace GridResamplerLocal
+{
+    /// a target closer than this to a source (on the unit sphere) copies it
+    const double kCoincidenceThreshold = 1e-9;
+
+    /// weights of the 16 most recently used grids and methods (the resamplers keep theirs)
+    sofa::Cache< sofa::SparseMatrix > cache;
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Normalized directions of a data set, [ M 3 ]
+     *
+     */
+    /************************************************************************************/
+    inline void getDirections(std::vector< double > &directions, const std::vector< double > &cartesian)
+    {
+        directions = cartesian;
+
+        for( std::size_t i = 0; i < directions.size() / 3; i++ )
+        {
+            if( sofa::Geometry::Normalize( &directions[ 3 * i ] ) <= 0.0 )
+            {
+                SOFA_THROW( "null source direction" );
+            }
+        }
+    }
+
+    inline unsigned long long hashDirections(const std::vector< double > &directions)
+    {
+        sofa::Hash hash;
+        hash.Add( directions );
+        return hash.GetValue();
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+GridResampler::GridResampler()
+: numNeighbours( 4 )
+, distancePower( 2.0 )
+, order( 10 )
+, regularization( 1e-3 )
+, sourceKey( 0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Number of sources combined by the inverse distance weighting
+ *
+ */
+/************************************************************************************/
+void GridResampler::SetNumNeighbours(const unsigned int numNeighbours_)
+{
+    numNeighbours = ( numNeighbours_ > 0 ) ? numNeighbours_ : 1;
+}
+
+unsigned int GridResampler::GetNumNeighbours() const
+{
+    return numNeighbours;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Exponent of the inverse distance weighting
+ *
+ */
+/************************************************************************************/
+void GridResampler::SetDistancePower(const double power)
+{
+    distancePower = power;
+}
+
+double GridResampler::GetDistancePower() const
+{
+    return distancePower;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Order of the spherical-harmonic method
+ *
+ */
+/************************************************************************************/
+void GridResampler::SetOrder(const unsigned int order_)
+{
+    order = order_;
+}
+
+unsigned int GridResampler::GetOrder() const
+{
+    return order;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Regularization of the spherical-harmonic method
+ *
+ */
+/************************************************************************************/
+void GridResampler::SetRegularization(const double regularization_)
+{
+    regularization = regularization_;
+}
+
+double GridResampler::GetRegularization() const
+{
+    return regularization;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes (or retrieves from the cache) the interpolation weights
+ *  @param[in]      source : data set defining the source grid
+ *  @param[in]      targetPositions_ : [ T 3 ] spherical positions (azimuth, elevation
+ *                  in degree, radius in meter) of the target grid
+ *  @param[in]      method : interpolation method
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GridResampler::Prepare(const sofa::FIRDataSet &source,
+                            const std::vector< double > &targetPositions_,
+                            const sofa::GridResampler::Method &method)
+{
+    if( targetPositions_.empty() == true || targetPositions_.size() % 3 != 0 )
+    {
+        SOFA_THROW( "invalid target grid" );
+        return false;
+    }
+
+    if( source.GetNumMeasurements() == 0 )
+    {
+        SOFA_THROW( "empty data set" );
+        return false;
+    }
+
+    std::vector< double > sourceDirections;
+    GridResamplerLocal::getDirections( sourceDirections, source.GetSourceCartesianPositions() );
+
+    std::vector< double > targetDirections( targetPositions_.size() );
+    for( std::size_t i = 0; i < targetPositions_.size() / 3; i++ )
+    {
+        const double spherical[3] = { targetPositions_[ 3 * i ], targetPositions_[ 3 * i + 1 ], 1.0 };
+        sofa::Geometry::SphericalToCartesian( &targetDirections[ 3 * i ], spherical );
+    }
+
+    const unsigned long long sourceKey_ = GridResamplerLocal::hashDirections( sourceDirections );
+
+    /// the signature holds the method, its parameters and both grids
+    std::vector< double > signature( 1, static_cast< double >( method ) );
+
+    switch( method )
+    {
+        case kBarycentric :
+            break;
+        case kInverseDistance :
+            signature.push_back( static_cast< double >( numNeighbours ) );
+            signature.push_back( distancePower );
+            break;
+        case kSphericalHarmonics :
+            signature.push_back( static_cast< double >( order ) );
+            signature.push_back( regularization );
+            break;
+        default :
+            SOFA_THROW( "unknown method" );
+            return false;
+    }
+
+    signature.push_back( static_cast< double >( sourceDirections.size() / 3 ) );
+    signature.push_back( static_cast< double >( targetDirections.size() / 3 ) );
+    signature.insert( signature.end(), sourceDirections.begin(), sourceDirections.end() );
+    signature.insert( signature.end(), targetDirections.begin(), targetDirections.end() );
+
+    sofa::Hash hash;
+    hash.Add( signature );
+
+    const unsigned long long key = hash.GetValue();
+
+    Weights newWeights = GridResamplerLocal::cache.Find( key, signature );
+
+    if( newWeights == nullptr )
+    {
+        newWeights = computeWeights( sourceDirections, targetDirections, method );
+
+        if( newWeights == nullptr )
+        {
+            return false;
+        }
+
+        GridResamplerLocal::cache.Insert( key, signature, newWeights );
+    }
+
+    targetPositions = targetPositions_;
+    sourceKey       = sourceKey_;
+    weights         = newWeights;
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the interpolation weights
+ *  @param[in]      sourceDirections : [ M 3 ] unit vectors
+ *  @param[in]      targetDirections : [ T 3 ] unit vectors
+ *
+ */
+/************************************************************************************/
+GridResampler::Weights GridResampler::computeWeights(const std::vector< double > &sourceDirections,
+                                                     const std::vector< double > &targetDirections,
+                                                     const sofa::GridResampler::Method &method) const
+{
+    const std::size_t M = sourceDirections.size() / 3;
+    const std::size_t T = targetDirections.size() / 3;
+
+    std::shared_ptr< sofa::SparseMatrix > matrix = std::make_shared< sofa::SparseMatrix >( M );
+
+    std::vector< unsigned long > columns;
+    std::vector< double > values;
+
+    if( method == kSphericalHarmonics )
+    {
+        const std::size_t K = sofa::SphericalHarmonics::GetNumCoefficients( order );
+
+        const sofa::SphericalHarmonicDecomposition::Matrix fitMatrix =
+            sofa::SphericalHarmonicDecomposition::GetFitMatrix( sourceDirections, order, regularization );
+
+        std::vector< double > basis( T * K );
+        for( std::size_t t = 0; t < T; t++ )
+        {
+            sofa::SphericalHarmonics::Evaluate( &basis[ t * K ], order, &targetDirections[ 3 * t ] );
+        }
+
+        /// W = Y_target P, [ T M ]
+        std::vector< double > dense( T * M );
+        sofa::LinearAlgebra::Gemm( &dense[0], &basis[0], &( *fitMatrix )[0], T, K, M );
+
+        columns.resize( M );
+        for( std::size_t m = 0; m < M; m++ )
+        {
+            columns[m] = static_cast< unsigned long >( m );
+        }
+
+        for( std::size_t t = 0; t < T; t++ )
+        {
+            values.assign( dense.begin() + t * M, dense.begin() + ( t + 1 ) * M );
+            matrix->AddRow( columns, values );
+        }
+
+        return matrix;
+    }
+
+    sofa::SpatialIndex index;
+    index.Build( sourceDirections );
+
+    sofa::SphericalTriangulation triangulation;
+
+    if( method == kBarycentric )
+    {
+        if( triangulation.Compute( sourceDirections ) == false )
+        {
+            SOFA_THROW( "the source grid cannot be triangulated (use inverse distance weighting)" );
+            return Weights();
+        }
+    }
+
+    std::vector< unsigned long > neighbours;
+    std::vector< double > distances;
+
+    for( std::size_t t = 0; t < T; t++ )
+    {
+        const double *target = &targetDirections[ 3 * t ];
+
+        columns.clear();
+        values.clear();
+
+        if( method == kBarycentric )
+        {
+            unsigned long vertices[3];
+            double barycentric[3];
+
+            if( triangulation.Locate( vertices, barycentric, target ) == true )
+            {
+                columns.assign( vertices, vertices + 3 );
+                values.assign( barycentric, barycentric + 3 );
+            }
+            else
+            {
+                /// outside of the measured area : nearest source
+                columns.push_back( index.FindNearest( target ) );
+                values.push_back( 1.0 );
+            }
+        }
+        else
+        {
+            index.FindNearest( neighbours, distances, target, numNeighbours );
+
+            if( distances[0] < GridResamplerLocal::kCoincidenceThreshold )
+            {
+                columns.push_back( neighbours[0] );
+                values.push_back( 1.0 );
+            }
+            else
+            {
+                double sum = 0.0;
+
+                for( std::size_t i = 0; i < neighbours.size(); i++ )
+                {
+                    const double w = 1.0 / std::pow( distances[i], distancePower );
+
+                    columns.push_back( neighbours[i] );
+                    values.push_back( w );
+                    sum += w;
+                }
+
+                for( std::size_t i = 0; i < values.size(); i++ )
+                {
+                    values[i] /= sum;
+                }
+            }
+        }
+
+        matrix->AddRow( columns, values );
+    }
+
+    return matrix;
+}
+
+unsigned long GridResampler::GetNumTargets() const
+{
+    return static_cast< unsigned long >( targetPositions.size() / 3 );
+}
+
+const std::vector< double > & GridResampler::GetTargetPositions() const
+{
+    return targetPositions;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the interpolation weights, [ T M ]
+ *
+ */
+/************************************************************************************/
+const sofa::SparseMatrix & GridResampler::GetWeights() const
+{
+    SOFA_ASSERT( weights != nullptr );
+
+    return *weights;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Resamples Data.IR and Data.Delay
+ *  @param[out]     ir : [ T R N ]
+ *  @param[out]     delay : [ T R ]
+ *  @param[in]      source : data set, measured on the grid given to Prepare
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool GridResampler::Apply(std::vector< double > &ir,
+                          std::vector< double > &delay,
+                          const sofa::FIRDataSet &source) const
+{
+    if( weights == nullptr )
+    {
+        SOFA_THROW( "the resampler is not prepared" );
+        return false;
+    }
+
+    std::vector< double > sourceDirections;
+    GridResamplerLocal::getDirections( sourceDirections, source.GetSourceCartesianPositions() );
+
+    if( GridResamplerLocal::hashDirections( sourceDirections ) != sourceKey )
+    {
+        SOFA_THROW( "the data set does not match the grid given to Prepare" );
+        return false;
+    }
+
+    const std::size_t T = GetNumTargets();
+    const std::size_t R = source.GetNumReceivers();
+    const std::size_t N = source.GetNumDataSamples();
+
+    ir.resize( T * R * N );
+    delay.resize( T * R );
+
+    weights->Apply( &ir[0], &source.GetDataIR()[0], R * N );
+    weights->Apply( &delay[0], &source.GetDataDelay()[0], R );
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes the resampled data set to a new SOFA file
+ *  @param[in]      path : destination
+ *  @param[in]      sourceFile : the file the data set was loaded from
+ *  @param[in]      source : data set, measured on the grid given to Prepare
+ *  @return         true on success
+ *
+ *  @details        The metadata of the source file are kept. The other variables depending
+ *                  on M are taken from the source measurement with the largest weight.
+ */
+/************************************************************************************/
+bool GridResampler::Write(const std::string &path,
+                          const sofa::File &sourceFile,
+                          const sofa::FIRDataSet &source) const
+{
+    std::vector< double > ir;
+    std::vector< double > delay;
+
+    if( Apply( ir, delay, source ) == false )
+    {
+        return false;
+    }
+
+    const std::size_t T = GetNumTargets();
+
+    std::vector< unsigned long > origins( T );
+    for( std::size_t t = 0; t < T; t++ )
+    {
+        origins[t] = source.GetOriginalIndex( weights->GetLargestEntry( t ) );
+    }
+
+    std::vector< std::string > dims;
+
+    sofa::FileWriter writer( sourceFile );
+
+    writer.SetDimension( "M", T );
+    writer.SetMeasurementOrigins( origins );
+
+    dims.push_back( "M" );
+    dims.push_back( "C" );
+    writer.SetVariable( "SourcePosition", dims, targetPositions );
+    writer.SetVariableAttribute( "SourcePosition", "Type", sofa::Coordinates::GetName( sofa::Coordinates::kSpherical ) );
+    writer.SetVariableAttribute( "SourcePosition", "Units", "degree, degree, meter" );
+
+    dims[1] = "R";
+    writer.SetVariable( "Data.Delay", dims, delay );
+
+    dims[1] = "R";
+    dims.push_back( "N" );
+    writer.SetVariable( "Data.IR", dims, ir );
+
+    writer.SetAttribute( sofa::Attributes::GetName( sofa::Attributes::kDateModified ), sofa::Date::GetCurrentDate().ToISO8601() );
+
+    return writer.Write( path );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Creates an equiangular grid
+ *  @param[out]     positions : [ T 3 ] spherical positions (azimuth, elevation, radius)
+ *  @param[in]      step : angular step, in degree, for both azimuth and elevation
+ *  @param[in]      radius : radius of all the positions
+ *
+ *  @details        The poles appear only once
+ */
+/************************************************************************************/
+void GridResampler::CreateEquiangularGrid(std::vector< double > &positions,
+                                          const double step,
+                                          const double radius)
+{
+    positions.clear();
+
+    if( step <= 0.0 )
+    {
+        SOFA_THROW( "invalid step" );
+        return;
+    }
+
+    const int numElevations = static_cast< int >( std::floor( 180.0 / step + 1e-9 ) );
+    const int numAzimuths   = static_cast< int >( std::ceil( 360.0 / step - 1e-9 ) );
+
+    for( int e = 0; e <= numElevations; e++ )
+    {
+        const double elevation = -90.0 + e * step;
+
+        if( std::fabs( std::fabs( elevation ) - 90.0 ) < 1e-9 )
+        {
+            positions.push_back( 0.0 );
+            positions.push_back( elevation );
+            positions.push_back( radius );
+            continue;
+        }
+
+        for( int a = 0; a < numAzimuths; a++ )
+        {
+            positions.push_back( a * step );
+            positions.push_back( elevation );
+            positions.push_back( radius );
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Frees all the cached interpolation weights
+ *
+ */
+/************************************************************************************/
+void GridResampler::ClearCache()
+{
+    GridResamplerLocal::cache.Clear();
+}
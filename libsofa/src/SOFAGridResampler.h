@@ -0,0 +1,153 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAGridResampler.h
+ *   @brief      Resampling of FIR data sets onto another grid of directions
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_GRID_RESAMPLER_H__
+#define _SOFA_GRID_RESAMPLER_H__
+
+#include "../src/SOFAFIRDataSet.h"
+#include "../src/SOFASparseMatrix.h"
+#include <memory>
+
+namespace sofa
+{
+
+    /************************************************************************************/
+    /*!
+     *  @class          GridResampler
+     *  @brief          Resamples a FIR data set onto another grid of source directions
+     *
+     *  @details        Each target measurement is a weighted sum of source measurements.
+     *                  The weights only depend on the two grids (and the method), so they
+     *                  are computed once, stored as a sparse matrix and shared, through a
+     *                  cache, by all the data sets measured on the same grid. The cache keeps
+     *                  the weights of the 16 most recently used grids and methods.
+     *
+     *                  Only the directions are interpolated : the radius of the sources
+     *                  is ignored.
+     */
+    /************************************************************************************/
+    class SOFA_API GridResampler
+    {
+    public:
+        enum Method
+        {
+            kBarycentric            = 0,    ///< linear interpolation inside the triangles of the source grid
+            kInverseDistance        = 1,    ///< inverse distance weighting of the nearest sources
+            kSphericalHarmonics     = 2,    ///< regularized spherical-harmonic fit (dense weights)
+            kNumMethods             = 3
+        };
+
+    public:
+        GridResampler();
+        ~GridResampler() {};
+
+        //==============================================================================
+        void SetNumNeighbours(const unsigned int numNeighbours);
+        unsigned int GetNumNeighbours() const;
+
+        void SetDistancePower(const double power);
+        double GetDistancePower() const;
+
+        void SetOrder(const unsigned int order);
+        unsigned int GetOrder() const;
+
+        void SetRegularization(const double regularization);
+        double GetRegularization() const;
+
+        //==============================================================================
+        bool Prepare(const sofa::FIRDataSet &source,
+                     const std::vector< double > &targetPositions,
+                     const sofa::GridResampler::Method &method);
+
+        unsigned long GetNumTargets() const;
+
+        const std::vector< double > & GetTargetPositions() const;
+
+        const sofa::SparseMatrix & GetWeights() const;
+
+        //==============================================================================
+        bool Apply(std::vector< double > &ir,
+                   std::vector< double > &delay,
+                   const sofa::FIRDataSet &source) const;
+
+        bool Write(const std::string &path,
+                   const sofa::File &sourceFile,
+                   const sofa::FIRDataSet &source) const;
+
+        //==============================================================================
+        static void CreateEquiangularGrid(std::vector< double > &positions,
+                                          const double step,
+                                          const double radius = 1.0);
+
+        static void ClearCache();
+
+    private:
+        typedef std::shared_ptr< const sofa::SparseMatrix > Weights;
+
+        Weights computeWeights(const std::vector< double > &sourceDirections,
+                               const std::vector< double > &targetDirections,
+                               const sofa::GridResampler::Method &method) const;
+
+    private:
+        unsigned int numNeighbours;
+        double distancePower;
+        unsigned int order;
+        double regularization;
+
+        std::vector< double > targetPositions;      ///< [ T 3 ] spherical (azimuth, elevation, radius)
+        unsigned long long sourceKey;               ///< hash of the source grid
+
+        Weights weights;                            ///< [ T M ]
+
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( GridResampler );
+    };
+
+}
+
+#endif /* _SOFA_GRID_RESAMPLER_H__ */
@@ -0,0 +1,123 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAHash.h
+ *   @brief      Hashing helpers for caches
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_HASH_H__
+#define _SOFA_HASH_H__
+
+#include "../src/SOFAPlatform.h"
+#include <cstring>
+
+namespace sofa
+{
+
+    /************************************************************************************/
+    /*!
+     *  @class          Hash
+     *  @brief          Incremental 64-bit FNV-1a hash, used as a key for caches
+     *
+     *  @details        Not a cryptographic hash
+     */
+    /************************************************************************************/
+    class Hash
+    {
+    public:
+        Hash()
+        : value( 14695981039346656037ULL )
+        {
+        }
+
+        void Add(const void *data, const std::size_t numBytes)
+        {
+            const unsigned char *bytes = static_cast< const unsigned char * >( data );
+
+            for( std::size_t i = 0; i < numBytes; i++ )
+            {
+                value ^= static_cast< unsigned long long >( bytes[i] );
+                value *= 1099511628211ULL;
+            }
+        }
+
+        void Add(const double x)
+        {
+            /// +0.0 and -0.0 shall give the same key
+            const double y = ( x == 0.0 ) ? 0.0 : x;
+            Add( &y, sizeof( double ) );
+        }
+
+        void Add(const unsigned long long x)
+        {
+            Add( &x, sizeof( unsigned long long ) );
+        }
+
+        void Add(const std::vector< double > &values)
+        {
+            Add( static_cast< unsigned long long >( values.size() ) );
+
+            for( std::size_t i = 0; i < values.size(); i++ )
+            {
+                Add( values[i] );
+            }
+        }
+
+        void Add(const std::string &text)
+        {
+            Add( static_cast< unsigned long long >( text.size() ) );
+            Add( text.data(), text.size() );
+        }
+
+        unsigned long long GetValue() const
+        {
+            return value;
+        }
+
+    private:
+        unsigned long long value;
+    };
+
+}
+
+#endif /* _SOFA_HASH_H__ */
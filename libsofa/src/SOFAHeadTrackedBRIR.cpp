@@ -0,0 +1,557 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAHeadTrackedBRIR.cpp
+ *   @brief      Head-tracked access to the BRIRs of a MultiSpeakerBRIR file
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAHeadTrackedBRIR.h"
+#include "../src/SOFAGeometry.h"
+#include "../src/SOFAExceptions.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+namespace HeadTrackedBRIRLocal
+{
+    /// a head orientation closer than this to a measured one (on the unit sphere) selects it alone
+    const double kCoincidenceThreshold = 1e-9;
+
+    const double kPi = 3.14159265358979323846;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+OrientationIndex::OrientationIndex()
+: numMeasurements( 0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads the ListenerView variable of a file and builds the index
+ *  @param[in]      file : ListenerView is [ I C ] or [ M C ]
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool OrientationIndex::Load(const sofa::File &file)
+{
+    const long M = file.GetNumMeasurements();
+
+    sofa::Coordinates::Type coordinates;
+    sofa::Units::Type units;
+
+    std::vector< double > values;
+
+    if( M <= 0
+       || file.GetListenerView( coordinates, units ) == false
+       || file.GetListenerView( values ) == false )
+    {
+        SOFA_THROW( "invalid 'ListenerView' variable" );
+        return false;
+    }
+
+    if( values.size() == 3 )
+    {
+        /// [ I C ] : the same orientation for all the measurements
+        std::vector< double > expanded( 3 * M );
+        for( long m = 0; m < M; m++ )
+        {
+            std::copy( values.begin(), values.end(), &expanded[ 3 * m ] );
+        }
+        values.swap( expanded );
+    }
+    else if( values.size() != static_cast< std::size_t >( 3 * M ) )
+    {
+        SOFA_THROW( "invalid 'ListenerView' dimensions" );
+        return false;
+    }
+
+    std::vector< double > directions;
+    sofa::Geometry::ToCartesian( directions, values, coordinates );
+
+    for( long m = 0; m < M; m++ )
+    {
+        if( sofa::Geometry::Normalize( &directions[ 3 * m ] ) <= 0.0 )
+        {
+            SOFA_THROW( "null listener view" );
+            return false;
+        }
+    }
+
+    index.Build( directions );
+
+    views.swap( directions );
+    numMeasurements = static_cast< unsigned long >( M );
+
+    return true;
+}
+
+unsigned long OrientationIndex::GetNumMeasurements() const
+{
+    return numMeasurements;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the listener view of one measurement, as a unit vector
+ *
+ */
+/************************************************************************************/
+const double * OrientationIndex::GetView(const unsigned long measurement) const
+{
+    SOFA_ASSERT( measurement < numMeasurements );
+
+    return &views[ 3 * measurement ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Converts a head orientation to a view direction
+ *  @param[out]     direction : unit vector (SOFA frame)
+ *  @param[in]      yaw : azimuth in degrees, counterclockwise from the front
+ *  @param[in]      pitch : elevation in degrees
+ *
+ */
+/************************************************************************************/
+void OrientationIndex::GetViewDirection(double direction[3],
+                                        const double yaw,
+                                        const double pitch)
+{
+    const double spherical[3] = { yaw, pitch, 1.0 };
+
+    sofa::Geometry::SphericalToCartesian( direction, spherical );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the measurement whose listener view is the closest to a
+ *                  given head orientation
+ *  @param[in]      yaw : azimuth in degrees
+ *  @param[in]      pitch : elevation in degrees
+ *
+ */
+/************************************************************************************/
+unsigned long OrientationIndex::FindNearest(const double yaw,
+                                            const double pitch) const
+{
+    SOFA_ASSERT( numMeasurements > 0 );
+
+    double direction[3];
+    GetViewDirection( direction, yaw, pitch );
+
+    return index.FindNearest( direction );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the measurements whose listener views are the closest to a
+ *                  given head orientation, with inverse squared distance weights
+ *  @param[out]     measurements : closest first
+ *  @param[out]     weights : sum to 1
+ *  @param[in]      yaw : azimuth in degrees
+ *  @param[in]      pitch : elevation in degrees
+ *  @param[in]      numNeighbours : number of measurements to look for
+ *
+ */
+/************************************************************************************/
+void OrientationIndex::FindNearest(std::vector< unsigned long > &measurements,
+                                   std::vector< double > &weights,
+                                   const double yaw,
+                                   const double pitch,
+                                   const unsigned long numNeighbours) const
+{
+    double direction[3];
+    GetViewDirection( direction, yaw, pitch );
+
+    std::vector< double > distances;
+    index.FindNearest( measurements, distances, direction, numNeighbours );
+
+    weights.resize( measurements.size() );
+
+    if( measurements.empty() == true )
+    {
+        return;
+    }
+
+    if( distances[0] < HeadTrackedBRIRLocal::kCoincidenceThreshold )
+    {
+        measurements.resize( 1 );
+        weights.assign( 1, 1.0 );
+        return;
+    }
+
+    double sum = 0.0;
+
+    for( std::size_t i = 0; i < measurements.size(); i++ )
+    {
+        weights[i] = 1.0 / ( distances[i] * distances[i] );
+        sum += weights[i];
+    }
+
+    for( std::size_t i = 0; i < weights.size(); i++ )
+    {
+        weights[i] /= sum;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the angle (in degrees) between the listener view of a
+ *                  measurement and a given head orientation
+ *
+ */
+/************************************************************************************/
+double OrientationIndex::GetAngle(const unsigned long measurement,
+                                  const double yaw,
+                                  const double pitch) const
+{
+    double direction[3];
+    GetViewDirection( direction, yaw, pitch );
+
+    return sofa::Geometry::AngularDistance( GetView( measurement ), direction ) * 180.0 / HeadTrackedBRIRLocal::kPi;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      file_ : the BRIRs, Data.IR [ M R E N ]
+ *  @param[in]      capacity_ : number of measurements kept in memory
+ *  @param[in]      numNeighbours_ : number of measurements returned by SetOrientation
+ *
+ *  @details        Only the listener views are read ; the measurement closest to the
+ *                  front is loaded.
+ */
+/************************************************************************************/
+HeadTrackedBRIR::HeadTrackedBRIR(const sofa::MultiSpeakerBRIR &file_,
+                                 const unsigned long capacity_,
+                                 const unsigned int numNeighbours_)
+: file( file_ )
+, capacity( std::max< unsigned long >( 1, capacity_ ) )
+, numNeighbours( std::max( 1u, numNeighbours_ ) )
+, numMeasurements( 0 )
+, numReceivers( 0 )
+, numEmitters( 0 )
+, numDataSamples( 0 )
+, samplingRate( 0.0 )
+, hysteresis( 0.0 )
+, useCounter( 0 )
+, current( 0 )
+{
+    if( file.GetSamplingRate( samplingRate ) == false
+       || index.Load( file ) == false )
+    {
+        SOFA_THROW( "cannot read the BRIRs" );
+    }
+
+    numMeasurements = static_cast< unsigned long >( file.GetNumMeasurements() );
+    numReceivers    = static_cast< unsigned long >( file.GetNumReceivers() );
+    numEmitters     = static_cast< unsigned long >( file.GetNumEmitters() );
+    numDataSamples  = static_cast< unsigned long >( file.GetNumDataSamples() );
+
+    current = index.FindNearest( 0.0, 0.0 );
+
+    SetOrientation( 0.0, 0.0 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the hysteresis of the switching : the current measurement is
+ *                  kept until another one is closer by more than this angle
+ *  @param[in]      degrees : 0 switches to the nearest measurement
+ *
+ */
+/************************************************************************************/
+void HeadTrackedBRIR::SetHysteresis(const double degrees)
+{
+    hysteresis = std::max( 0.0, degrees );
+}
+
+double HeadTrackedBRIR::GetHysteresis() const
+{
+    return hysteresis;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Updates the head orientation
+ *  @param[in]      yaw : azimuth in degrees, counterclockwise from the front
+ *  @param[in]      pitch : elevation in degrees
+ *  @return         true if the current measurement has changed
+ *
+ *  @details        The current measurement and the neighbouring ones are loaded if
+ *                  needed, and the least recently used measurements beyond the capacity
+ *                  are released.
+ */
+/************************************************************************************/
+bool HeadTrackedBRIR::SetOrientation(const double yaw,
+                                     const double pitch)
+{
+    index.FindNearest( neighbours, weights, yaw, pitch, numNeighbours );
+
+    SOFA_ASSERT( neighbours.empty() == false );
+
+    unsigned long nearest = neighbours[0];
+
+    if( nearest != current && hysteresis > 0.0 )
+    {
+        const double currentAngle = index.GetAngle( current, yaw, pitch );
+        const double nearestAngle = index.GetAngle( nearest, yaw, pitch );
+
+        if( currentAngle - nearestAngle < hysteresis )
+        {
+            nearest = current;
+        }
+    }
+
+    const bool switched = ( nearest != current );
+
+    current = nearest;
+
+    Acquire( current );
+
+    for( std::size_t i = 0; i < neighbours.size(); i++ )
+    {
+        Acquire( neighbours[i] );
+    }
+
+    release();
+
+    return switched;
+}
+
+unsigned long HeadTrackedBRIR::GetCurrentMeasurement() const
+{
+    return current;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the measurements closest to the last head orientation
+ *                  (closest first), for interpolation
+ *
+ */
+/************************************************************************************/
+const std::vector< unsigned long > & HeadTrackedBRIR::GetNeighbours() const
+{
+    return neighbours;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the interpolation weights of the neighbours (they sum to 1)
+ *
+ */
+/************************************************************************************/
+const std::vector< double > & HeadTrackedBRIR::GetWeights() const
+{
+    return weights;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Loads one measurement if it is not in memory (e.g. to prefetch the
+ *                  measurements along the expected head movement)
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool HeadTrackedBRIR::Acquire(const unsigned long measurement)
+{
+    if( measurement >= numMeasurements )
+    {
+        return false;
+    }
+
+    std::map< unsigned long, Slab >::iterator it = resident.find( measurement );
+
+    if( it != resident.end() )
+    {
+        it->second.lastUse = ++useCounter;
+        return true;
+    }
+
+    /// only the [ R E N ] slab of this measurement is read
+    Slab &slab = resident[ measurement ];
+
+    if( file.GetDataIR( slab.ir, measurement ) == false
+       || file.GetDataDelay( slab.delay, measurement ) == false )
+    {
+        resident.erase( measurement );
+
+        SOFA_THROW( "cannot read the BRIRs of the measurement" );
+        return false;
+    }
+
+    slab.lastUse = ++useCounter;
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Releases the least recently used measurements beyond the capacity
+ *                  (the current measurement and its neighbours are kept)
+ *
+ */
+/************************************************************************************/
+void HeadTrackedBRIR::release()
+{
+    const std::size_t maxResident = std::max< std::size_t >( capacity, neighbours.size() + 1 );
+
+    while( resident.size() > maxResident )
+    {
+        std::map< unsigned long, Slab >::iterator oldest = resident.begin();
+
+        for( std::map< unsigned long, Slab >::iterator it = resident.begin(); it != resident.end(); ++it )
+        {
+            if( it->second.lastUse < oldest->second.lastUse )
+            {
+                oldest = it;
+            }
+        }
+
+        resident.erase( oldest );
+    }
+}
+
+bool HeadTrackedBRIR::IsResident(const unsigned long measurement) const
+{
+    return ( resident.find( measurement ) != resident.end() );
+}
+
+unsigned long HeadTrackedBRIR::GetNumResident() const
+{
+    return static_cast< unsigned long >( resident.size() );
+}
+
+unsigned long HeadTrackedBRIR::GetCapacity() const
+{
+    return capacity;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the IR of one measurement, receiver and emitter (N samples),
+ *                  or nullptr if the measurement is not in memory
+ *
+ */
+/************************************************************************************/
+const float * HeadTrackedBRIR::GetIR(const unsigned long measurement,
+                                     const unsigned long receiver,
+                                     const unsigned long emitter) const
+{
+    SOFA_ASSERT( receiver < numReceivers );
+    SOFA_ASSERT( emitter < numEmitters );
+
+    std::map< unsigned long, Slab >::const_iterator it = resident.find( measurement );
+
+    if( it == resident.end() )
+    {
+        return nullptr;
+    }
+
+    return &it->second.ir[ ( receiver * numEmitters + emitter ) * numDataSamples ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the delay (in samples) of one measurement, receiver and
+ *                  emitter. An exception is thrown if the measurement is not in memory
+ *                  (see IsResident and Acquire)
+ *
+ */
+/************************************************************************************/
+double HeadTrackedBRIR::GetDelay(const unsigned long measurement,
+                                 const unsigned long receiver,
+                                 const unsigned long emitter) const
+{
+    SOFA_ASSERT( receiver < numReceivers );
+    SOFA_ASSERT( emitter < numEmitters );
+
+    std::map< unsigned long, Slab >::const_iterator it = resident.find( measurement );
+
+    if( it == resident.end() )
+    {
+        SOFA_THROW( "the measurement is not in memory" );
+        return 0.0;
+    }
+
+    return it->second.delay[ receiver * numEmitters + emitter ];
+}
+
+unsigned long HeadTrackedBRIR::GetNumMeasurements() const
+{
+    return numMeasurements;
+}
+
+unsigned long HeadTrackedBRIR::GetNumReceivers() const
+{
+    return numReceivers;
+}
+
+unsigned long HeadTrackedBRIR::GetNumEmitters() const
+{
+    return numEmitters;
+}
+
+unsigned long HeadTrackedBRIR::GetNumDataSamples() const
+{
+    return numDataSamples;
+}
+
+double HeadTrackedBRIR::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+const sofa::OrientationIndex & HeadTrackedBRIR::GetOrientationIndex() const
+{
+    return index;
+}
@@ -0,0 +1,215 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAHeadTrackedBRIR.h
+ *   @brief      Head-tracked access to the BRIRs of a MultiSpeakerBRIR file
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_HEAD_TRACKED_BRIR_H__
+#define _SOFA_HEAD_TRACKED_BRIR_H__
+
+#include "../src/SOFAMultiSpeakerBRIR.h"
+#include "../src/SOFASpatialIndex.h"
+#include <map>
+
+namespace sofa
+{
+
+    /************************************************************************************/
+    /*!
+     *  @class          OrientationIndex
+     *  @brief          Maps a head orientation to the nearest measured listener orientations
+     *
+     *  @details        The ListenerView of each measurement ([ I C ] or [ M C ], cartesian
+     *                  or spherical) is stored as a unit vector in a k-d tree. A head
+     *                  orientation is given by its yaw (azimuth, counterclockwise from the
+     *                  front) and pitch (elevation), in degrees.
+     */
+    /************************************************************************************/
+    class SOFA_API OrientationIndex
+    {
+    public:
+        OrientationIndex();
+        ~OrientationIndex() {};
+
+        bool Load(const sofa::File &file);
+
+        //==============================================================================
+        unsigned long GetNumMeasurements() const;
+
+        const double * GetView(const unsigned long measurement) const;
+
+        //==============================================================================
+        unsigned long FindNearest(const double yaw,
+                                  const double pitch) const;
+
+        void FindNearest(std::vector< unsigned long > &measurements,
+                         std::vector< double > &weights,
+                         const double yaw,
+                         const double pitch,
+                         const unsigned long numNeighbours) const;
+
+        double GetAngle(const unsigned long measurement,
+                        const double yaw,
+                        const double pitch) const;
+
+        static void GetViewDirection(double direction[3],
+                                     const double yaw,
+                                     const double pitch);
+
+    private:
+        unsigned long numMeasurements;
+
+        std::vector< double > views;                ///< [ M 3 ] unit vectors
+        sofa::SpatialIndex index;
+
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( OrientationIndex );
+    };
+
+    /************************************************************************************/
+    /*!
+     *  @class          HeadTrackedBRIR
+     *  @brief          Head-tracked access to the BRIRs of a MultiSpeakerBRIR file
+     *
+     *  @details        The BRIRs are loaded lazily : only the measurements (listener
+     *                  orientations) near the current head orientation are read from the
+     *                  file, one [ R E N ] slab each, and kept in single precision. The least
+     *                  recently used measurements are released beyond a given capacity.
+     *
+     *                  SetOrientation switches to the nearest measurement, with a hysteresis
+     *                  to avoid toggling between two neighbours, and returns the neighbouring
+     *                  measurements with interpolation weights.
+     *
+     *                  The file shall outlive this object. This class is meant to be used from
+     *                  a control thread : the pointers returned by GetIR are valid until the
+     *                  next call to SetOrientation or Acquire.
+     */
+    /************************************************************************************/
+    class SOFA_API HeadTrackedBRIR
+    {
+    public:
+        HeadTrackedBRIR(const sofa::MultiSpeakerBRIR &file,
+                        const unsigned long capacity = 8,
+                        const unsigned int numNeighbours = 1);
+
+        ~HeadTrackedBRIR() {};
+
+        //==============================================================================
+        void SetHysteresis(const double degrees);
+        double GetHysteresis() const;
+
+        bool SetOrientation(const double yaw,
+                            const double pitch);
+
+        unsigned long GetCurrentMeasurement() const;
+
+        const std::vector< unsigned long > & GetNeighbours() const;
+        const std::vector< double > & GetWeights() const;
+
+        //==============================================================================
+        bool Acquire(const unsigned long measurement);
+
+        bool IsResident(const unsigned long measurement) const;
+        unsigned long GetNumResident() const;
+        unsigned long GetCapacity() const;
+
+        const float * GetIR(const unsigned long measurement,
+                            const unsigned long receiver,
+                            const unsigned long emitter) const;
+
+        double GetDelay(const unsigned long measurement,
+                        const unsigned long receiver,
+                        const unsigned long emitter) const;
+
+        //==============================================================================
+        unsigned long GetNumMeasurements() const;
+        unsigned long GetNumReceivers() const;
+        unsigned long GetNumEmitters() const;
+        unsigned long GetNumDataSamples() const;
+        double GetSamplingRate() const;
+
+        const sofa::OrientationIndex & GetOrientationIndex() const;
+
+    private:
+        struct Slab
+        {
+            std::vector< float > ir;                ///< [ R E N ]
+            std::vector< double > delay;            ///< [ R E ]
+            unsigned long lastUse;
+        };
+
+        void release();
+
+    private:
+        const sofa::MultiSpeakerBRIR &file;
+
+        const unsigned long capacity;
+        const unsigned int numNeighbours;
+
+        unsigned long numMeasurements;
+        unsigned long numReceivers;
+        unsigned long numEmitters;
+        unsigned long numDataSamples;
+        double samplingRate;
+
+        double hysteresis;                          ///< in degrees
+
+        sofa::OrientationIndex index;
+
+        std::map< unsigned long, Slab > resident;   ///< slabs in memory, by measurement
+        unsigned long useCounter;
+
+        unsigned long current;
+        std::vector< unsigned long > neighbours;
+        std::vector< double > weights;
+
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( HeadTrackedBRIR );
+    };
+
+}
+
+#endif /* _SOFA_HEAD_TRACKED_BRIR_H__ */
@@ -0,0 +1,475 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAImpulseResponseTrimmer.cpp
+ *   @brief      Onset detection and truncation of FIR data sets
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAImpulseResponseTrimmer.h"
+#include "../src/SOFAFileWriter.h"
+#include "../src/SOFAParallel.h"
+#include "../src/SOFASimd.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFADate.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+namespace ImpulseResponseTrimmerLocal
+{
+    const double kPi = 3.14159265358979323846;
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Computes the energy of each sample of an IR
+     *  @param[out]     energy : N values
+     *  @param[in]      ir : N samples
+     *  @return         the largest energy
+     *
+     */
+    /************************************************************************************/
+    float ComputeEnergy(float *energy,
+                        const double *ir,
+                        const unsigned long N)
+    {
+        using namespace sofa::Simd;
+
+        for( unsigned long n = 0; n < N; n++ )
+        {
+            energy[n] = static_cast< float >( ir[n] );
+        }
+
+        unsigned long n = 0;
+
+        Vector peaks = Set( 0.0f );
+
+        for( ; n + kVectorSize <= N; n += kVectorSize )
+        {
+            const Vector x = Load( energy + n );
+            const Vector e = Mul( x, x );
+
+            Store( energy + n, e );
+
+            peaks = Max( peaks, e );
+        }
+
+        float lanes[ kVectorSize ];
+        Store( lanes, peaks );
+
+        float peak = *std::max_element( lanes, lanes + kVectorSize );
+
+        for( ; n < N; n++ )
+        {
+            energy[n] = energy[n] * energy[n];
+            peak = std::max( peak, energy[n] );
+        }
+
+        return peak;
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Finds the onset, first and end samples of an IR
+     *  @param[out]     prefix : N+1 cumulative energies
+     *  @param[in]      energy : N values
+     *
+     *  @details        At most half of the energy-loss bound is spent before the first
+     *                  sample, the rest after the end
+     */
+    /************************************************************************************/
+    void Analyze(unsigned long &onset,
+                 unsigned long &start,
+                 unsigned long &end,
+                 std::vector< double > &prefix,
+                 const float *energy,
+                 const float peak,
+                 const unsigned long N,
+                 const double maxEnergyLoss,
+                 const double threshold,
+                 const unsigned long numPreOnsetSamples)
+    {
+        prefix[0] = 0.0;
+        for( unsigned long n = 0; n < N; n++ )
+        {
+            prefix[ n + 1 ] = prefix[n] + static_cast< double >( energy[n] );
+        }
+
+        const double total = prefix[N];
+
+        if( peak <= 0.0f || total <= 0.0 )
+        {
+            onset   = 0;
+            start   = 0;
+            end     = 0;
+            return;
+        }
+
+        const float level = static_cast< float >( threshold * static_cast< double >( peak ) );
+
+        onset = 0;
+        while( energy[ onset ] < level )
+        {
+            onset++;
+        }
+
+        start = onset - std::min( onset, numPreOnsetSamples );
+
+        while( start > 0 && prefix[ start ] > 0.5 * maxEnergyLoss * total )
+        {
+            start--;
+        }
+
+        const double tailBudget = maxEnergyLoss * total - prefix[ start ];
+
+        end = N;
+        while( end > onset + 1 && total - prefix[ end - 1 ] <= tailBudget )
+        {
+            end--;
+        }
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Rising half of a Hann window, over length samples
+     *
+     */
+    /************************************************************************************/
+    double FadeIn(const unsigned long n,
+                  const unsigned long length)
+    {
+        return 0.5 * ( 1.0 - std::cos( kPi * static_cast< double >( n + 1 ) / static_cast< double >( length + 1 ) ) );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+ImpulseResponseTrimmer::ImpulseResponseTrimmer()
+: numMeasurements( 0 )
+, numReceivers( 0 )
+, numDataSamples( 0 )
+, energyLoss( 0.0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Analyses and trims all the IRs of a data set
+ *  @param[in]      dataSet : the IRs and their delays
+ *  @param[in]      maxEnergyLoss : largest fraction of the energy of each IR that may
+ *                  be removed (1e-4 : -40 dB)
+ *  @param[in]      onsetThreshold : energy of the onset relative to the peak, in dB
+ *  @param[in]      numPreOnsetSamples : samples kept (and faded in) before the onset
+ *  @param[in]      fadeOutLength : length of the fade-out, in samples
+ *  @return         true on success
+ *
+ *  @details        The energy-loss bound applies to the trimming only, not to the fades
+ */
+/************************************************************************************/
+bool ImpulseResponseTrimmer::Compute(const sofa::FIRDataSet &dataSet,
+                                     const double maxEnergyLoss,
+                                     const double onsetThreshold,
+                                     const unsigned long numPreOnsetSamples,
+                                     const unsigned long fadeOutLength)
+{
+    const unsigned long M = dataSet.GetNumMeasurements();
+    const unsigned long R = dataSet.GetNumReceivers();
+    const unsigned long N = dataSet.GetNumDataSamples();
+
+    if( M == 0 || R == 0 || N == 0 )
+    {
+        SOFA_THROW( "empty data set" );
+        return false;
+    }
+
+    if( ( maxEnergyLoss >= 0.0 && maxEnergyLoss < 1.0 ) == false || ( onsetThreshold <= 0.0 ) == false )
+    {
+        SOFA_THROW( "invalid trimming parameters" );
+        return false;
+    }
+
+    const double threshold = std::pow( 10.0, onsetThreshold / 10.0 );
+
+    const std::vector< double > &source = dataSet.GetDataIR();
+
+    //==============================================================================
+    /// analysis
+    onsets.resize( M * R );
+    starts.resize( M * R );
+    ends.resize( M * R );
+
+    sofa::Parallel::For( 0, M * R, [ & ]( const std::size_t first, const std::size_t last )
+    {
+        std::vector< float > energy( N );
+        std::vector< double > prefix( N + 1 );
+
+        for( std::size_t i = first; i < last; i++ )
+        {
+            const float peak = ImpulseResponseTrimmerLocal::ComputeEnergy( &energy[0], &source[ i * N ], N );
+
+            ImpulseResponseTrimmerLocal::Analyze( onsets[i], starts[i], ends[i], prefix, &energy[0], peak,
+                                                  N, maxEnergyLoss, threshold, numPreOnsetSamples );
+        }
+    } );
+
+    unsigned long L = 1;
+    for( std::size_t i = 0; i < M * R; i++ )
+    {
+        L = std::max( L, ends[i] - starts[i] );
+    }
+
+    //==============================================================================
+    /// truncation and fades
+    ir.assign( M * R * L, 0.0 );
+    delay.resize( M * R );
+
+    const unsigned long fadeOut = std::min( fadeOutLength, L / 2 );
+
+    std::vector< double > losses( M * R, 0.0 );
+
+    sofa::Parallel::For( 0, M * R, [ & ]( const std::size_t first, const std::size_t last )
+    {
+        for( std::size_t i = first; i < last; i++ )
+        {
+            const double *x = &source[ i * N ];
+            double *y       = &ir[ i * L ];
+
+            const unsigned long start   = starts[i];
+            const unsigned long count   = std::min( L, N - start );
+            const unsigned long fadeIn  = std::min( numPreOnsetSamples, onsets[i] - start );
+
+            double total    = 0.0;
+            double kept     = 0.0;
+
+            for( unsigned long n = 0; n < N; n++ )
+            {
+                total += x[n] * x[n];
+            }
+
+            for( unsigned long n = 0; n < count; n++ )
+            {
+                y[n] = x[ start + n ];
+                kept += y[n] * y[n];
+            }
+
+            losses[i] = ( total > 0.0 ) ? ( total - kept ) / total : 0.0;
+
+            for( unsigned long n = 0; n < fadeIn; n++ )
+            {
+                y[n] *= ImpulseResponseTrimmerLocal::FadeIn( n, fadeIn );
+            }
+
+            for( unsigned long n = 0; n < fadeOut; n++ )
+            {
+                y[ L - 1 - n ] *= ImpulseResponseTrimmerLocal::FadeIn( n, fadeOut );
+            }
+
+            delay[i] = dataSet.GetDataDelay()[i] + static_cast< double >( start );
+        }
+    } );
+
+    numMeasurements = M;
+    numReceivers    = R;
+    numDataSamples  = L;
+    energyLoss      = *std::max_element( losses.begin(), losses.end() );
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Replaces Data.IR and Data.Delay of a data set by the trimmed ones
+ *  @param[in]      dataSet : the data set that was trimmed (same measurements)
+ *  @return         false if the dimensions do not match
+ *
+ */
+/************************************************************************************/
+bool ImpulseResponseTrimmer::Apply(sofa::FIRDataSet &dataSet) const
+{
+    if( ir.empty() == true
+       || dataSet.GetNumMeasurements() != numMeasurements
+       || dataSet.GetNumReceivers() != numReceivers )
+    {
+        return false;
+    }
+
+    return ( dataSet.SetDataIR( ir, numDataSamples ) == true
+            && dataSet.SetDataDelay( delay ) == true );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes the trimmed data set to a new SOFA file
+ *  @param[in]      path : destination
+ *  @param[in]      sourceFile : the file the data set was loaded from
+ *  @param[in]      dataSet : the data set that was trimmed
+ *  @return         true on success
+ *
+ *  @details        The metadata of the source file are kept. The measurements are written
+ *                  in the current order of the data set.
+ */
+/************************************************************************************/
+bool ImpulseResponseTrimmer::Write(const std::string &path,
+                                   const sofa::File &sourceFile,
+                                   const sofa::FIRDataSet &dataSet) const
+{
+    if( ir.empty() == true
+       || dataSet.GetNumMeasurements() != numMeasurements
+       || dataSet.GetNumReceivers() != numReceivers )
+    {
+        return false;
+    }
+
+    std::vector< std::string > dims;
+
+    sofa::FileWriter writer( sourceFile );
+
+    writer.SetDimension( "N", numDataSamples );
+    writer.SetMeasurementOrigins( dataSet.GetOriginalIndices() );
+
+    dims.push_back( "M" );
+    dims.push_back( "R" );
+    writer.SetVariable( "Data.Delay", dims, delay );
+
+    dims.push_back( "N" );
+    writer.SetVariable( "Data.IR", dims, ir );
+
+    writer.SetAttribute( sofa::Attributes::GetName( sofa::Attributes::kDateModified ), sofa::Date::GetCurrentDate().ToISO8601() );
+
+    return writer.Write( path );
+}
+
+unsigned long ImpulseResponseTrimmer::GetNumMeasurements() const
+{
+    return numMeasurements;
+}
+
+unsigned long ImpulseResponseTrimmer::GetNumReceivers() const
+{
+    return numReceivers;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Common length of the trimmed IRs
+ *
+ */
+/************************************************************************************/
+unsigned long ImpulseResponseTrimmer::GetNumDataSamples() const
+{
+    return numDataSamples;
+}
+
+const double * ImpulseResponseTrimmer::GetIR(const unsigned long measurement, const unsigned long receiver) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers );
+
+    return &ir[ ( static_cast< std::size_t >( measurement ) * numReceivers + receiver ) * numDataSamples ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Data.Delay plus the number of removed leading samples
+ *
+ */
+/************************************************************************************/
+double ImpulseResponseTrimmer::GetDelay(const unsigned long measurement, const unsigned long receiver) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers );
+
+    return delay[ static_cast< std::size_t >( measurement ) * numReceivers + receiver ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          First sample of the original IR reaching the onset threshold
+ *
+ */
+/************************************************************************************/
+unsigned long ImpulseResponseTrimmer::GetOnset(const unsigned long measurement, const unsigned long receiver) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers );
+
+    return onsets[ static_cast< std::size_t >( measurement ) * numReceivers + receiver ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          First sample of the original IR that is kept (number of removed samples)
+ *
+ */
+/************************************************************************************/
+unsigned long ImpulseResponseTrimmer::GetStart(const unsigned long measurement, const unsigned long receiver) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers );
+
+    return starts[ static_cast< std::size_t >( measurement ) * numReceivers + receiver ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          End of the energy decay of the original IR, within the energy-loss bound
+ *
+ */
+/************************************************************************************/
+unsigned long ImpulseResponseTrimmer::GetEnd(const unsigned long measurement, const unsigned long receiver) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers );
+
+    return ends[ static_cast< std::size_t >( measurement ) * numReceivers + receiver ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Largest fraction of energy removed from an IR by the trimming
+ *
+ */
+/************************************************************************************/
+double ImpulseResponseTrimmer::GetEnergyLoss() const
+{
+    return energyLoss;
+}
@@ -0,0 +1,128 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAImpulseResponseTrimmer.h
+ *   @brief      Onset detection and truncation of FIR data sets
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_IMPULSE_RESPONSE_TRIMMER_H__
+#define _SOFA_IMPULSE_RESPONSE_TRIMMER_H__
+
+#include "../src/SOFAFIRDataSet.h"
+#include "../src/SOFAFile.h"
+
+namespace sofa
+{
+
+    /************************************************************************************/
+    /*!
+     *  @class          ImpulseResponseTrimmer
+     *  @brief          Removal of the silent heads and tails of the IRs of a FIR data set
+     *
+     *  @details        For each IR, the onset is the first sample whose energy reaches a
+     *                  threshold relative to the peak, and the IR starts a few samples before
+     *                  it. Those leading samples are removed, and their number is added to
+     *                  Data.Delay, so that the time of arrival (and the ITD) is unchanged.
+     *                  The end of each IR is where the energy decay (backward integration)
+     *                  meets the energy-loss bound, and all the IRs are truncated to the
+     *                  longest of these lengths. The kept pre-onset samples are faded in and
+     *                  the end of the IRs is faded out (half-Hann windows).
+     *
+     *                  The IRs are analysed in parallel (sofa::Parallel), the energy being
+     *                  computed with sofa::Simd. The trimmed data set can be applied to the
+     *                  FIRDataSet, or written to a new SOFA file.
+     */
+    /************************************************************************************/
+    class SOFA_API ImpulseResponseTrimmer
+    {
+    public:
+        ImpulseResponseTrimmer();
+        ~ImpulseResponseTrimmer() {};
+
+        bool Compute(const sofa::FIRDataSet &dataSet,
+                     const double maxEnergyLoss = 1e-4,
+                     const double onsetThreshold = -20.0,
+                     const unsigned long numPreOnsetSamples = 8,
+                     const unsigned long fadeOutLength = 16);
+
+        bool Apply(sofa::FIRDataSet &dataSet) const;
+
+        bool Write(const std::string &path,
+                   const sofa::File &sourceFile,
+                   const sofa::FIRDataSet &dataSet) const;
+
+        //==============================================================================
+        unsigned long GetNumMeasurements() const;
+        unsigned long GetNumReceivers() const;
+        unsigned long GetNumDataSamples() const;
+
+        const double * GetIR(const unsigned long measurement, const unsigned long receiver) const;
+
+        double GetDelay(const unsigned long measurement, const unsigned long receiver) const;
+
+        unsigned long GetOnset(const unsigned long measurement, const unsigned long receiver) const;
+        unsigned long GetStart(const unsigned long measurement, const unsigned long receiver) const;
+        unsigned long GetEnd(const unsigned long measurement, const unsigned long receiver) const;
+
+        double GetEnergyLoss() const;
+
+    private:
+        unsigned long numMeasurements;
+        unsigned long numReceivers;
+        unsigned long numDataSamples;
+        double energyLoss;
+
+        std::vector< double > ir;                   ///< [ M R N' ]
+        std::vector< double > delay;                ///< [ M R ] Data.Delay plus the removed samples
+        std::vector< unsigned long > onsets;        ///< [ M R ] in samples of the original IRs
+        std::vector< unsigned long > starts;        ///< [ M R ] first sample kept
+        std::vector< unsigned long > ends;          ///< [ M R ] end of the energy decay
+
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( ImpulseResponseTrimmer );
+    };
+
+}
+
+#endif /* _SOFA_IMPULSE_RESPONSE_TRIMMER_H__ */
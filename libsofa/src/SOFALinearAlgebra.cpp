@@ -0,0 +1,309 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFALinearAlgebra.cpp
+ *   @brief      Basic dense linear algebra
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFALinearAlgebra.h"
+#include "../src/SOFAParallel.h"
+#include "../src/SOFASimd.h"
+#include <cmath>
+#include <algorithm>
+
+using namespace sofa;
+
+namespace LinearAlgebraLocal
+{
+    /// number of columns of B processed at once, so that a tile of B stays in cache
+    const std::size_t kTileSize = 64;
+
+    /// minimum number of batch entries processed by one thread
+    const std::size_t kMinBatchChunk = 64;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Matrix product C = A B (row-major storage)
+ *  @param[out]     C : [ rowsA colsB ]
+ *  @param[in]      A : [ rowsA colsA ]
+ *  @param[in]      B : [ colsA colsB ]
+ *
+ */
+/************************************************************************************/
+void sofa::LinearAlgebra::Gemm(double *C,
+                               const double *A,
+                               const double *B,
+                               const std::size_t rowsA,
+                               const std::size_t colsA,
+                               const std::size_t colsB)
+{
+    const std::size_t tileSize = LinearAlgebraLocal::kTileSize;
+    const std::size_t numTiles = ( colsB + tileSize - 1 ) / tileSize;
+
+    sofa::Parallel::For( 0, numTiles, [ = ]( const std::size_t firstTile, const std::size_t lastTile )
+    {
+        for( std::size_t tile = firstTile; tile < lastTile; tile++ )
+        {
+            const std::size_t j0 = tile * tileSize;
+            const std::size_t j1 = std::min( colsB, j0 + tileSize );
+
+            for( std::size_t i = 0; i < rowsA; i++ )
+            {
+                double *c = C + i * colsB;
+
+                std::fill( c + j0, c + j1, 0.0 );
+
+                for( std::size_t k = 0; k < colsA; k++ )
+                {
+                    const double a = A[ i * colsA + k ];
+
+                    if( a == 0.0 )
+                    {
+                        continue;
+                    }
+
+                    const double *b = B + k * colsB;
+
+                    for( std::size_t j = j0; j < j1; j++ )
+                    {
+                        c[j] += a * b[j];
+                    }
+                }
+            }
+        }
+    } );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Gram matrix G = A^T A (row-major storage)
+ *  @param[out]     G : [ colsA colsA ]
+ *  @param[in]      A : [ rowsA colsA ]
+ *
+ */
+/************************************************************************************/
+void sofa::LinearAlgebra::Gram(double *G,
+                               const double *A,
+                               const std::size_t rowsA,
+                               const std::size_t colsA)
+{
+    std::fill( G, G + colsA * colsA, 0.0 );
+
+    for( std::size_t r = 0; r < rowsA; r++ )
+    {
+        const double *a = A + r * colsA;
+
+        for( std::size_t i = 0; i < colsA; i++ )
+        {
+            const double ai = a[i];
+
+            for( std::size_t j = i; j < colsA; j++ )
+            {
+                G[ i * colsA + j ] += ai * a[j];
+            }
+        }
+    }
+
+    /// fill the lower triangle
+    for( std::size_t i = 0; i < colsA; i++ )
+    {
+        for( std::size_t j = 0; j < i; j++ )
+        {
+            G[ i * colsA + j ] = G[ j * colsA + i ];
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Solves A X = B for a symmetric positive definite A
+ *  @param[in]      A : [ n n ], overwritten by its Cholesky factor (lower triangle)
+ *  @param[in]      B : [ n nrhs ], overwritten by the solution X
+ *  @return         false if A is not (numerically) positive definite
+ *
+ */
+/************************************************************************************/
+bool sofa::LinearAlgebra::CholeskySolve(double *A,
+                                        double *B,
+                                        const std::size_t n,
+                                        const std::size_t nrhs)
+{
+    /// A = L L^T
+    for( std::size_t j = 0; j < n; j++ )
+    {
+        double diagonal = A[ j * n + j ];
+
+        for( std::size_t k = 0; k < j; k++ )
+        {
+            diagonal -= A[ j * n + k ] * A[ j * n + k ];
+        }
+
+        if( diagonal <= 0.0 || std::isfinite( diagonal ) == false )
+        {
+            return false;
+        }
+
+        const double ljj = std::sqrt( diagonal );
+        A[ j * n + j ] = ljj;
+
+        for( std::size_t i = j + 1; i < n; i++ )
+        {
+            double sum = A[ i * n + j ];
+
+            for( std::size_t k = 0; k < j; k++ )
+            {
+                sum -= A[ i * n + k ] * A[ j * n + k ];
+            }
+
+            A[ i * n + j ] = sum / ljj;
+        }
+    }
+
+    /// forward substitution : L Y = B
+    for( std::size_t i = 0; i < n; i++ )
+    {
+        double *bi = B + i * nrhs;
+
+        for( std::size_t k = 0; k < i; k++ )
+        {
+            const double lik = A[ i * n + k ];
+            const double *bk = B + k * nrhs;
+
+            for( std::size_t c = 0; c < nrhs; c++ )
+            {
+                bi[c] -= lik * bk[c];
+            }
+        }
+
+        const double lii = A[ i * n + i ];
+
+        for( std::size_t c = 0; c < nrhs; c++ )
+        {
+            bi[c] /= lii;
+        }
+    }
+
+    /// back substitution : L^T X = Y
+    for( std::size_t ii = n; ii > 0; ii-- )
+    {
+        const std::size_t i = ii - 1;
+        double *bi = B + i * nrhs;
+
+        for( std::size_t k = i + 1; k < n; k++ )
+        {
+            const double lki = A[ k * n + i ];
+            const double *bk = B + k * nrhs;
+
+            for( std::size_t c = 0; c < nrhs; c++ )
+            {
+                bi[c] -= lki * bk[c];
+            }
+        }
+
+        const double lii = A[ i * n + i ];
+
+        for( std::size_t c = 0; c < nrhs; c++ )
+        {
+            bi[c] /= lii;
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Batch of complex matrix products C_b = A_b B_b, b in [ 0 batchSize [
+ *  @param[out]     Cre, Cim : [ rowsA colsB ] elements
+ *  @param[in]      Are, Aim : [ rowsA colsA ] elements
+ *  @param[in]      Bre, Bim : [ colsA colsB ] elements
+ *  @param[in]      strideA, strideB, strideC : distance between two elements
+ *
+ */
+/************************************************************************************/
+void sofa::LinearAlgebra::ComplexGemmBatched(float *Cre,
+                                             float *Cim,
+                                             const float *Are,
+                                             const float *Aim,
+                                             const float *Bre,
+                                             const float *Bim,
+                                             const std::size_t rowsA,
+                                             const std::size_t colsA,
+                                             const std::size_t colsB,
+                                             const std::size_t batchSize,
+                                             const std::size_t strideA,
+                                             const std::size_t strideB,
+                                             const std::size_t strideC)
+{
+    SOFA_ASSERT( batchSize <= strideA && batchSize <= strideB && batchSize <= strideC );
+
+    const std::size_t chunkSize = LinearAlgebraLocal::kMinBatchChunk;
+    const std::size_t numChunks = ( batchSize + chunkSize - 1 ) / chunkSize;
+
+    sofa::Parallel::For( 0, numChunks, [ = ]( const std::size_t firstChunk, const std::size_t lastChunk )
+    {
+        const std::size_t b0 = firstChunk * chunkSize;
+        const std::size_t b1 = std::min( batchSize, lastChunk * chunkSize );
+        const std::size_t size = b1 - b0;
+
+        for( std::size_t i = 0; i < rowsA; i++ )
+        {
+            for( std::size_t j = 0; j < colsB; j++ )
+            {
+                const std::size_t c = ( i * colsB + j ) * strideC + b0;
+
+                std::fill( Cre + c, Cre + c + size, 0.0f );
+                std::fill( Cim + c, Cim + c + size, 0.0f );
+
+                for( std::size_t k = 0; k < colsA; k++ )
+                {
+                    const std::size_t a = ( i * colsA + k ) * strideA + b0;
+                    const std::size_t b = ( k * colsB + j ) * strideB + b0;
+
+                    sofa::Simd::ComplexMultiplyAccumulate( Cre + c, Cim + c, Are + a, Aim + a, Bre + b, Bim + b, size );
+                }
+            }
+        }
+    } );
+}
@@ -0,0 +1,134 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFALinearAlgebra.h
+ *   @brief      Basic dense linear algebra
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_LINEAR_ALGEBRA_H__
+#define _SOFA_LINEAR_ALGEBRA_H__
+
+#include "../src/SOFAPlatform.h"
+
+namespace sofa
+{
+
+    namespace LinearAlgebra
+    {
+
+        /************************************************************************************/
+        /*!
+         *  @brief          Matrix product C = A B (row-major storage)
+         *  @param[out]     C : [ rowsA colsB ]
+         *  @param[in]      A : [ rowsA colsA ]
+         *  @param[in]      B : [ colsA colsB ]
+         *
+         *  @details        The columns of B are split across the threads of sofa::Parallel
+         */
+        /************************************************************************************/
+        SOFA_API_FUNC void Gemm(double *C,
+                                const double *A,
+                                const double *B,
+                                const std::size_t rowsA,
+                                const std::size_t colsA,
+                                const std::size_t colsB);
+
+        /************************************************************************************/
+        /*!
+         *  @brief          Gram matrix G = A^T A (row-major storage)
+         *  @param[out]     G : [ colsA colsA ]
+         *  @param[in]      A : [ rowsA colsA ]
+         *
+         */
+        /************************************************************************************/
+        SOFA_API_FUNC void Gram(double *G,
+                                const double *A,
+                                const std::size_t rowsA,
+                                const std::size_t colsA);
+
+        /************************************************************************************/
+        /*!
+         *  @brief          Solves A X = B for a symmetric positive definite A
+         *  @param[in]      A : [ n n ], overwritten by its Cholesky factor
+         *  @param[in]      B : [ n nrhs ], overwritten by the solution X
+         *  @return         false if A is not (numerically) positive definite
+         *
+         */
+        /************************************************************************************/
+        SOFA_API_FUNC bool CholeskySolve(double *A,
+                                         double *B,
+                                         const std::size_t n,
+                                         const std::size_t nrhs);
+
+        /************************************************************************************/
+        /*!
+         *  @brief          Batch of complex matrix products C_b = A_b B_b, b in [ 0 batchSize [
+         *  @param[out]     Cre, Cim : [ rowsA colsB ] elements
+         *  @param[in]      Are, Aim : [ rowsA colsA ] elements
+         *  @param[in]      Bre, Bim : [ colsA colsB ] elements
+         *  @param[in]      strideA, strideB, strideC : distance between two elements
+         *
+         *  @details        Batch-interleaved layout (split format, row-major) : the element
+         *                  ( i, j ) of a matrix is the vector of its batchSize values, starting
+         *                  at ( i * cols + j ) * stride. The inner loops run over the batch
+         *                  (sofa::Simd), which is split across the threads of sofa::Parallel.
+         */
+        /************************************************************************************/
+        SOFA_API_FUNC void ComplexGemmBatched(float *Cre,
+                                              float *Cim,
+                                              const float *Are,
+                                              const float *Aim,
+                                              const float *Bre,
+                                              const float *Bim,
+                                              const std::size_t rowsA,
+                                              const std::size_t colsA,
+                                              const std::size_t colsB,
+                                              const std::size_t batchSize,
+                                              const std::size_t strideA,
+                                              const std::size_t strideB,
+                                              const std::size_t strideC);
+    }
+
+}
+
+#endif /* _SOFA_LINEAR_ALGEBRA_H__ */
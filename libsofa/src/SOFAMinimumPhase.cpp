@@ -0,0 +1,485 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAMinimumPhase.cpp
+ *   @brief      Minimum-phase plus delay decomposition of FIR data sets
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAMinimumPhase.h"
+#include "../src/SOFAFFT.h"
+#include "../src/SOFAHash.h"
+#include "../src/SOFACache.h"
+#include "../src/SOFAParallel.h"
+#include "../src/SOFAExceptions.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+namespace MinimumPhaseLocal
+{
+    /// decompositions of the 16 most recently used data sets and parameters
+    sofa::Cache< void > cache;
+
+    /// magnitudes are floored to this fraction of the peak before the logarithm (-200 dB)
+    const double kMagnitudeFloor = 1e-10;
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Work buffers of one thread
+     *
+     */
+    /************************************************************************************/
+    struct Workspace
+    {
+        sofa::dsp::FFT fft;
+
+        std::vector< float > time;          ///< [ F ]
+        std::vector< float > re;            ///< [ F/2+1 ]
+        std::vector< float > im;
+        std::vector< float > originalRe;    ///< [ F/2+1 ] spectrum of the IR
+        std::vector< float > originalIm;
+        std::vector< double > magnitude;    ///< [ F/2+1 ]
+
+        Workspace(const unsigned int fftSize)
+        : fft( fftSize )
+        , time( fftSize )
+        , re( fftSize / 2 + 1 )
+        , im( fftSize / 2 + 1 )
+        , originalRe( fftSize / 2 + 1 )
+        , originalIm( fftSize / 2 + 1 )
+        , magnitude( fftSize / 2 + 1 )
+        {
+        }
+    };
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Computes the minimum-phase filter of one IR and its delay
+     *  @param[out]     output : length samples
+     *  @param[out]     truncationError : energy beyond length, relative to the total energy
+     *  @param[in]      ir : N samples
+     *  @return         the delay of the IR with respect to the minimum-phase filter, in samples
+     *
+     */
+    /************************************************************************************/
+    double Decompose(double *output,
+                     double &truncationError,
+                     const double *ir,
+                     const unsigned long N,
+                     const unsigned long length,
+                     Workspace &w)
+    {
+        const unsigned int F = w.fft.GetSize();
+        const unsigned int K = w.fft.GetNumBins();
+
+        std::fill( w.time.begin(), w.time.end(), 0.0f );
+        for( unsigned long n = 0; n < N; n++ )
+        {
+            w.time[n] = static_cast< float >( ir[n] );
+        }
+
+        w.fft.Forward( &w.originalRe[0], &w.originalIm[0], &w.time[0] );
+
+        for( unsigned int k = 0; k < K; k++ )
+        {
+            w.magnitude[k] = std::hypot( static_cast< double >( w.originalRe[k] ), static_cast< double >( w.originalIm[k] ) );
+        }
+
+        if( sofa::MinimumPhaseDecomposition::MinimumPhaseSpectrum( &w.re[0], &w.im[0], &w.magnitude[0], w.fft, &w.time[0] ) == false )
+        {
+            std::fill( output, output + length, 0.0 );
+            truncationError = 0.0;
+            return 0.0;
+        }
+
+        //==============================================================================
+        /// cross-correlation of the IR with the minimum-phase filter : IR * conj( minimum-phase )
+        std::vector< float > &xRe = w.originalRe;
+        std::vector< float > &xIm = w.originalIm;
+
+        for( unsigned int k = 0; k < K; k++ )
+        {
+            const float ar = xRe[k];
+            const float ai = xIm[k];
+            const float br = w.re[k];
+            const float bi = w.im[k];
+
+            xRe[k] = ar * br + ai * bi;
+            xIm[k] = ai * br - ar * bi;
+        }
+
+        /// minimum-phase filter
+        w.fft.Inverse( &w.time[0], &w.re[0], &w.im[0] );
+
+        double total = 0.0;
+        double kept  = 0.0;
+
+        for( unsigned int n = 0; n < F; n++ )
+        {
+            const double v = static_cast< double >( w.time[n] );
+            total += v * v;
+
+            if( n < length )
+            {
+                kept += v * v;
+            }
+        }
+
+        truncationError = ( total > 0.0 ) ? ( total - kept ) / total : 0.0;
+
+        /// half-Hann fade-out over the last eighth of the filter, if it is truncated
+        const bool truncated            = ( length < N );
+        const unsigned long fadeLength  = std::max( 1ul, length / 8 );
+
+        for( unsigned long n = 0; n < length; n++ )
+        {
+            double gain = 1.0;
+
+            if( truncated == true && n + fadeLength >= length )
+            {
+                const double t = static_cast< double >( n + fadeLength - length + 1 ) / static_cast< double >( fadeLength + 1 );
+                gain = 0.5 * ( 1.0 + std::cos( 3.14159265358979323846 * t ) );
+            }
+
+            output[n] = ( n < F ) ? gain * static_cast< double >( w.time[n] ) : 0.0;
+        }
+
+        //==============================================================================
+        /// peak of the cross-correlation, lags in [ -F/2, F/2 [
+        w.fft.Inverse( &w.time[0], &xRe[0], &xIm[0] );
+
+        unsigned int best = 0;
+        for( unsigned int n = 1; n < F; n++ )
+        {
+            if( w.time[n] > w.time[ best ] )
+            {
+                best = n;
+            }
+        }
+
+        const double y0 = w.time[ ( best + F - 1 ) % F ];
+        const double y1 = w.time[ best ];
+        const double y2 = w.time[ ( best + 1 ) % F ];
+
+        const double curvature = y0 - 2.0 * y1 + y2;
+        const double offset    = ( curvature < 0.0 ) ? 0.5 * ( y0 - y2 ) / curvature : 0.0;
+
+        const double lag = ( best < F / 2 ) ? static_cast< double >( best ) : static_cast< double >( best ) - F;
+
+        return lag + offset;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+MinimumPhaseDecomposition::MinimumPhaseDecomposition()
+: numMeasurements( 0 )
+, numReceivers( 0 )
+, numDataSamples( 0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Decomposes all the IRs of a data set
+ *  @param[in]      dataSet : the IRs and their delays
+ *  @param[in]      length : length of the minimum-phase filters (0 : same as the IRs)
+ *  @param[in]      oversampling : the FFT size is oversampling times the IR length
+ *                  (rounded to a power of two), to limit the aliasing of the cepstrum
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool MinimumPhaseDecomposition::Compute(const sofa::FIRDataSet &dataSet,
+                                        const unsigned long length,
+                                        const unsigned int oversampling)
+{
+    const unsigned long M = dataSet.GetNumMeasurements();
+    const unsigned long R = dataSet.GetNumReceivers();
+    const unsigned long N = dataSet.GetNumDataSamples();
+    const unsigned long L = ( length == 0 ) ? N : length;
+
+    if( M == 0 || R == 0 || N == 0 )
+    {
+        SOFA_THROW( "empty data set" );
+        return false;
+    }
+
+    const unsigned int fftSize = sofa::dsp::FFT::NextPowerOfTwo( static_cast< unsigned int >( std::max( N, L ) * std::max( 1u, oversampling ) ) );
+
+    //==============================================================================
+    sofa::Hash hash;
+    hash.Add( dataSet.GetDataIR() );
+    hash.Add( static_cast< unsigned long long >( N ) );
+    hash.Add( static_cast< unsigned long long >( L ) );
+    hash.Add( static_cast< unsigned long long >( fftSize ) );
+
+    const unsigned long long key = hash.GetValue();
+
+    /// checked on each hit of the cache
+    std::vector< double > signature( 6 );
+    signature[0] = static_cast< double >( M );
+    signature[1] = static_cast< double >( R );
+    signature[2] = static_cast< double >( N );
+    signature[3] = static_cast< double >( L );
+    signature[4] = static_cast< double >( fftSize );
+    signature[5] = dataSet.GetSamplingRate();
+
+    std::shared_ptr< const Result > cached = std::static_pointer_cast< const Result >( MinimumPhaseLocal::cache.Find( key, signature ) );
+
+    if( cached == nullptr )
+    {
+        std::shared_ptr< Result > computed( new Result() );
+
+        computed->ir.resize( M * R * L );
+        computed->extractedDelay.resize( M * R );
+
+        std::vector< double > errors( M * R, 0.0 );
+
+        sofa::Parallel::For( 0, M * R, [ & ]( const std::size_t first, const std::size_t last )
+        {
+            MinimumPhaseLocal::Workspace workspace( fftSize );
+
+            for( std::size_t i = first; i < last; i++ )
+            {
+                computed->extractedDelay[i] = MinimumPhaseLocal::Decompose( &computed->ir[ i * L ],
+                                                                            errors[i],
+                                                                            &dataSet.GetDataIR()[ i * N ],
+                                                                            N,
+                                                                            L,
+                                                                            workspace );
+            }
+        } );
+
+        computed->truncationError = *std::max_element( errors.begin(), errors.end() );
+
+        MinimumPhaseLocal::cache.Insert( key, signature, computed );
+
+        cached = computed;
+    }
+
+    //==============================================================================
+    numMeasurements = M;
+    numReceivers    = R;
+    numDataSamples  = L;
+    result          = cached;
+
+    delay.resize( M * R );
+    for( std::size_t i = 0; i < M * R; i++ )
+    {
+        delay[i] = dataSet.GetDataDelay()[i] + result->extractedDelay[i];
+    }
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Replaces Data.IR and Data.Delay of a data set by the decomposition
+ *  @param[in]      dataSet : the data set that was decomposed (same measurements)
+ *  @return         false if the dimensions do not match
+ *
+ */
+/************************************************************************************/
+bool MinimumPhaseDecomposition::Apply(sofa::FIRDataSet &dataSet) const
+{
+    if( result == nullptr
+       || dataSet.GetNumMeasurements() != numMeasurements
+       || dataSet.GetNumReceivers() != numReceivers )
+    {
+        return false;
+    }
+
+    return ( dataSet.SetDataIR( result->ir, numDataSamples ) == true
+            && dataSet.SetDataDelay( delay ) == true );
+}
+
+unsigned long MinimumPhaseDecomposition::GetNumMeasurements() const
+{
+    return numMeasurements;
+}
+
+unsigned long MinimumPhaseDecomposition::GetNumReceivers() const
+{
+    return numReceivers;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Length of the minimum-phase filters
+ *
+ */
+/************************************************************************************/
+unsigned long MinimumPhaseDecomposition::GetNumDataSamples() const
+{
+    return numDataSamples;
+}
+
+const double * MinimumPhaseDecomposition::GetIR(const unsigned long measurement, const unsigned long receiver) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers );
+
+    return &result->ir[ ( static_cast< std::size_t >( measurement ) * numReceivers + receiver ) * numDataSamples ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Delay to apply after the minimum-phase filter : Data.Delay plus the
+ *                  extracted delay, in samples
+ *
+ */
+/************************************************************************************/
+double MinimumPhaseDecomposition::GetDelay(const unsigned long measurement, const unsigned long receiver) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers );
+
+    return delay[ static_cast< std::size_t >( measurement ) * numReceivers + receiver ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Delay of the IR with respect to its minimum-phase filter, in samples
+ *
+ */
+/************************************************************************************/
+double MinimumPhaseDecomposition::GetExtractedDelay(const unsigned long measurement, const unsigned long receiver) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers );
+
+    return result->extractedDelay[ static_cast< std::size_t >( measurement ) * numReceivers + receiver ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Largest energy of a minimum-phase filter beyond the truncation length,
+ *                  relative to its total energy
+ *
+ */
+/************************************************************************************/
+double MinimumPhaseDecomposition::GetTruncationError() const
+{
+    return ( result != nullptr ) ? result->truncationError : 0.0;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Frees the cached decompositions
+ *
+ */
+/************************************************************************************/
+void MinimumPhaseDecomposition::ClearCache()
+{
+    MinimumPhaseLocal::cache.Clear();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the minimum-phase spectrum of a magnitude response (folding of
+ *                  the real cepstrum)
+ *  @param[out]     re : F/2+1 real parts
+ *  @param[out]     im : F/2+1 imaginary parts
+ *  @param[in]      magnitude : F/2+1 magnitudes, floored at -200 dB of their peak
+ *  @param[in]      fft : transform of size F
+ *  @param[in]      time : work buffer of F samples
+ *  @return         false if the magnitude response is null
+ *
+ */
+/************************************************************************************/
+bool MinimumPhaseDecomposition::MinimumPhaseSpectrum(float *re,
+                                                     float *im,
+                                                     const double *magnitude,
+                                                     sofa::dsp::FFT &fft,
+                                                     float *time)
+{
+    const unsigned int F = fft.GetSize();
+    const unsigned int K = fft.GetNumBins();
+
+    const double peak = *std::max_element( magnitude, magnitude + K );
+
+    if( peak <= 0.0 )
+    {
+        std::fill( re, re + K, 0.0f );
+        std::fill( im, im + K, 0.0f );
+        return false;
+    }
+
+    const double floor = peak * MinimumPhaseLocal::kMagnitudeFloor;
+
+    /// real cepstrum of the log-magnitude
+    for( unsigned int k = 0; k < K; k++ )
+    {
+        re[k] = static_cast< float >( std::log( std::max( magnitude[k], floor ) ) );
+        im[k] = 0.0f;
+    }
+
+    fft.Inverse( time, re, im );
+
+    /// folding : causal part doubled, anti-causal part removed
+    for( unsigned int n = 1; n < F / 2; n++ )
+    {
+        time[n] *= 2.0f;
+    }
+    for( unsigned int n = F / 2 + 1; n < F; n++ )
+    {
+        time[n] = 0.0f;
+    }
+
+    fft.Forward( re, im, time );
+
+    /// complex exponential
+    for( unsigned int k = 0; k < K; k++ )
+    {
+        const double gain  = std::exp( static_cast< double >( re[k] ) );
+        const double phase = static_cast< double >( im[k] );
+
+        re[k] = static_cast< float >( gain * std::cos( phase ) );
+        im[k] = static_cast< float >( gain * std::sin( phase ) );
+    }
+
+    return true;
+}
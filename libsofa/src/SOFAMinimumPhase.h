@@ -0,0 +1,135 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAMinimumPhase.h
+ *   @brief      Minimum-phase plus delay decomposition of FIR data sets
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_MINIMUM_PHASE_H__
+#define _SOFA_MINIMUM_PHASE_H__
+
+#include "../src/SOFAFIRDataSet.h"
+#include "../src/SOFAFFT.h"
+#include <memory>
+
+namespace sofa
+{
+
+    /************************************************************************************/
+    /*!
+     *  @class          MinimumPhaseDecomposition
+     *  @brief          Decomposition of the IRs of a FIR data set into minimum-phase filters
+     *                  plus pure delays
+     *
+     *  @details        Each IR is replaced by the minimum-phase filter with the same magnitude
+     *                  response (homomorphic method : folding of the real cepstrum), and the
+     *                  delay between the IR and that filter (peak of their cross-correlation,
+     *                  with parabolic interpolation) is added to Data.Delay. The difference of
+     *                  the delays of the two ears is the ITD.
+     *
+     *                  Minimum-phase filters concentrate their energy at the beginning, so they
+     *                  can be truncated much shorter, and interpolated between measurements
+     *                  without comb filtering.
+     *
+     *                  The IRs are processed in parallel (sofa::Parallel). The results of the
+     *                  16 most recently used data sets and parameters are kept in a cache.
+     *                  Filters shorter than the IRs are faded out over their last eighth.
+     */
+    /************************************************************************************/
+    class SOFA_API MinimumPhaseDecomposition
+    {
+    public:
+        MinimumPhaseDecomposition();
+        ~MinimumPhaseDecomposition() {};
+
+        bool Compute(const sofa::FIRDataSet &dataSet,
+                     const unsigned long length = 0,
+                     const unsigned int oversampling = 8);
+
+        bool Apply(sofa::FIRDataSet &dataSet) const;
+
+        //==============================================================================
+        unsigned long GetNumMeasurements() const;
+        unsigned long GetNumReceivers() const;
+        unsigned long GetNumDataSamples() const;
+
+        const double * GetIR(const unsigned long measurement, const unsigned long receiver) const;
+
+        double GetDelay(const unsigned long measurement, const unsigned long receiver) const;
+        double GetExtractedDelay(const unsigned long measurement, const unsigned long receiver) const;
+
+        double GetTruncationError() const;
+
+        //==============================================================================
+        static void ClearCache();
+
+        static bool MinimumPhaseSpectrum(float *re,
+                                         float *im,
+                                         const double *magnitude,
+                                         sofa::dsp::FFT &fft,
+                                         float *time);
+
+    private:
+        struct Result
+        {
+            std::vector< double > ir;               ///< [ M R length ]
+            std::vector< double > extractedDelay;   ///< [ M R ]
+            double truncationError;
+        };
+
+    private:
+        unsigned long numMeasurements;
+        unsigned long numReceivers;
+        unsigned long numDataSamples;
+
+        std::shared_ptr< const Result > result;
+        std::vector< double > delay;                ///< [ M R ] Data.Delay plus the extracted delays
+
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( MinimumPhaseDecomposition );
+    };
+
+}
+
+#endif /* _SOFA_MINIMUM_PHASE_H__ */
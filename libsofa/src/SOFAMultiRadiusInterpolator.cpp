@@ -0,0 +1,365 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAMultiRadiusInterpolator.cpp
+ *   @brief      Interpolation of FIR data sets over direction and distance
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAMultiRadiusInterpolator.h"
+#include "../src/SOFAGeometry.h"
+#include "../src/SOFAExceptions.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+MultiRadiusInterpolator::MultiRadiusInterpolator()
+: numMeasurements( 0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Groups the measurements by distance and triangulates each group
+ *  @param[in]      dataSet : the measurements
+ *  @param[in]      radiusTolerance : measurements whose distances differ by less than
+ *                  this (in meter) belong to the same shell
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool MultiRadiusInterpolator::Prepare(const sofa::FIRDataSet &dataSet,
+                                      const double radiusTolerance)
+{
+    const unsigned long M = dataSet.GetNumMeasurements();
+
+    if( M == 0 )
+    {
+        SOFA_THROW( "empty data set" );
+        return false;
+    }
+
+    if( radiusTolerance < 0.0 )
+    {
+        SOFA_THROW( "invalid tolerance" );
+        return false;
+    }
+
+    std::vector< double > directions( dataSet.GetSourceCartesianPositions() );
+    std::vector< double > radii( M );
+
+    for( unsigned long m = 0; m < M; m++ )
+    {
+        radii[m] = sofa::Geometry::Normalize( &directions[ 3 * m ] );
+
+        if( radii[m] <= 0.0 )
+        {
+            SOFA_THROW( "a source is located at the center of the listener" );
+            return false;
+        }
+    }
+
+    std::vector< unsigned long > sorted( M );
+    for( unsigned long m = 0; m < M; m++ )
+    {
+        sorted[m] = m;
+    }
+
+    std::stable_sort( sorted.begin(), sorted.end(), [ &radii ]( const unsigned long a, const unsigned long b )
+    {
+        return radii[a] < radii[b];
+    } );
+
+    //==============================================================================
+    /// consecutive radii closer than the tolerance form a shell
+    std::vector< Shell > newShells;
+
+    std::size_t begin = 0;
+    while( begin < sorted.size() )
+    {
+        std::size_t end = begin + 1;
+        while( end < sorted.size() && radii[ sorted[end] ] - radii[ sorted[ end - 1 ] ] <= radiusTolerance )
+        {
+            end++;
+        }
+
+        Shell shell;
+        shell.radius = 0.0;
+
+        std::vector< double > shellDirections;
+
+        /// keep the measurements of the shell in the order of the data set
+        shell.measurements.assign( sorted.begin() + begin, sorted.begin() + end );
+        std::sort( shell.measurements.begin(), shell.measurements.end() );
+
+        for( std::size_t i = 0; i < shell.measurements.size(); i++ )
+        {
+            const unsigned long m = shell.measurements[i];
+
+            shell.radius += radii[m];
+            shellDirections.insert( shellDirections.end(), &directions[ 3 * m ], &directions[ 3 * m ] + 3 );
+        }
+
+        shell.radius /= static_cast< double >( shell.measurements.size() );
+
+        shell.index = std::make_shared< sofa::SpatialIndex >();
+        shell.index->Build( shellDirections );
+
+        shell.triangulation = std::make_shared< sofa::SphericalTriangulation >();
+
+        if( shell.measurements.size() < 4 || shell.triangulation->Compute( shellDirections ) == false )
+        {
+            /// e.g. a single ring of measurements : nearest neighbour only
+            shell.triangulation.reset();
+        }
+
+        newShells.push_back( shell );
+
+        begin = end;
+    }
+
+    numMeasurements = M;
+    shells.swap( newShells );
+
+    return true;
+}
+
+unsigned long MultiRadiusInterpolator::GetNumMeasurements() const
+{
+    return numMeasurements;
+}
+
+unsigned long MultiRadiusInterpolator::GetNumShells() const
+{
+    return static_cast< unsigned long >( shells.size() );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the mean distance of the measurements of a shell, in meter
+ *
+ */
+/************************************************************************************/
+double MultiRadiusInterpolator::GetShellRadius(const unsigned long shell) const
+{
+    SOFA_ASSERT( shell < GetNumShells() );
+
+    return shells[ shell ].radius;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the indices (in the data set) of the measurements of a shell
+ *
+ */
+/************************************************************************************/
+const std::vector< unsigned long > & MultiRadiusInterpolator::GetShellMeasurements(const unsigned long shell) const
+{
+    SOFA_ASSERT( shell < GetNumShells() );
+
+    return shells[ shell ].measurements;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Appends the weights of a direction inside one shell
+ *
+ */
+/************************************************************************************/
+void MultiRadiusInterpolator::getShellWeights(std::vector< unsigned long > &measurements,
+                                              std::vector< double > &weights,
+                                              const Shell &shell,
+                                              const double direction[3],
+                                              const double gain) const
+{
+    if( gain <= 0.0 )
+    {
+        return;
+    }
+
+    if( shell.triangulation != nullptr )
+    {
+        unsigned long vertices[3];
+        double barycentric[3];
+
+        if( shell.triangulation->Locate( vertices, barycentric, direction ) == true )
+        {
+            for( unsigned int i = 0; i < 3; i++ )
+            {
+                measurements.push_back( shell.measurements[ vertices[i] ] );
+                weights.push_back( gain * barycentric[i] );
+            }
+            return;
+        }
+    }
+
+    measurements.push_back( shell.measurements[ shell.index->FindNearest( direction ) ] );
+    weights.push_back( gain );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the interpolation weights of a source position
+ *  @param[out]     measurements : indices of the contributing measurements
+ *  @param[out]     weights : their weights (positive, summing to 1)
+ *  @param[in]      position : cartesian position of the source, in meter
+ *
+ */
+/************************************************************************************/
+void MultiRadiusInterpolator::GetWeights(std::vector< unsigned long > &measurements,
+                                         std::vector< double > &weights,
+                                         const double position[3]) const
+{
+    SOFA_ASSERT( shells.empty() == false );
+
+    measurements.clear();
+    weights.clear();
+
+    double direction[3] = { position[0], position[1], position[2] };
+    const double radius = sofa::Geometry::Normalize( direction );
+
+    if( radius <= 0.0 )
+    {
+        /// no direction : use the front
+        direction[0] = 1.0;
+    }
+
+    /// first shell further than the source
+    std::size_t upper = 0;
+    {
+        std::size_t count = shells.size();
+        while( count > 0 )
+        {
+            const std::size_t half = count / 2;
+
+            if( shells[ upper + half ].radius < radius )
+            {
+                upper += half + 1;
+                count -= half + 1;
+            }
+            else
+            {
+                count = half;
+            }
+        }
+    }
+
+    if( upper == 0 )
+    {
+        getShellWeights( measurements, weights, shells.front(), direction, 1.0 );
+    }
+    else if( upper == shells.size() )
+    {
+        getShellWeights( measurements, weights, shells.back(), direction, 1.0 );
+    }
+    else
+    {
+        const Shell &near   = shells[ upper - 1 ];
+        const Shell &far    = shells[ upper ];
+
+        const double alpha  = ( radius - near.radius ) / ( far.radius - near.radius );
+
+        getShellWeights( measurements, weights, near, direction, 1.0 - alpha );
+        getShellWeights( measurements, weights, far, direction, alpha );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Interpolates the impulse responses at a source position
+ *  @param[out]     ir : [ R N ]
+ *  @param[out]     delay : [ R ] (can be null)
+ *  @param[in]      dataSet : the data set given to Prepare
+ *  @param[in]      position : cartesian position of the source, in meter
+ *
+ */
+/************************************************************************************/
+void MultiRadiusInterpolator::Interpolate(double *ir,
+                                          double *delay,
+                                          const sofa::FIRDataSet &dataSet,
+                                          const double position[3]) const
+{
+    SOFA_ASSERT( dataSet.GetNumMeasurements() == numMeasurements );
+
+    std::vector< unsigned long > measurements;
+    std::vector< double > weights;
+
+    GetWeights( measurements, weights, position );
+
+    const unsigned long R = dataSet.GetNumReceivers();
+    const unsigned long N = dataSet.GetNumDataSamples();
+
+    std::fill( ir, ir + R * N, 0.0 );
+
+    if( delay != nullptr )
+    {
+        std::fill( delay, delay + R, 0.0 );
+    }
+
+    for( std::size_t i = 0; i < measurements.size(); i++ )
+    {
+        const double w = weights[i];
+
+        for( unsigned long r = 0; r < R; r++ )
+        {
+            const double *x = dataSet.GetIR( measurements[i], r );
+            double *y = ir + r * N;
+
+            for( unsigned long n = 0; n < N; n++ )
+            {
+                y[n] += w * x[n];
+            }
+
+            if( delay != nullptr )
+            {
+                delay[r] += w * dataSet.GetDelay( measurements[i], r );
+            }
+        }
+    }
+}
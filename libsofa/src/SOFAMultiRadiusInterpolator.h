@@ -0,0 +1,126 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAMultiRadiusInterpolator.h
+ *   @brief      Interpolation of FIR data sets over direction and distance
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_MULTI_RADIUS_INTERPOLATOR_H__
+#define _SOFA_MULTI_RADIUS_INTERPOLATOR_H__
+
+#include "../src/SOFAFIRDataSet.h"
+#include "../src/SOFASphericalTriangulation.h"
+#include <memory>
+
+namespace sofa
+{
+
+    /************************************************************************************/
+    /*!
+     *  @class          MultiRadiusInterpolator
+     *  @brief          Interpolation of a FIR data set over direction and distance
+     *
+     *  @details        The measurements are grouped in shells of (almost) constant radius,
+     *                  and each shell is triangulated. A source position is interpolated
+     *                  with barycentric weights in the two shells surrounding its distance,
+     *                  then linearly between these shells. Finding the shells is a binary
+     *                  search, and finding the triangles uses the spatial index of each
+     *                  shell, so the cost does not grow with the number of measurements.
+     *
+     *                  Outside of the range of measured distances, the closest shell is used.
+     */
+    /************************************************************************************/
+    class SOFA_API MultiRadiusInterpolator
+    {
+    public:
+        MultiRadiusInterpolator();
+        ~MultiRadiusInterpolator() {};
+
+        bool Prepare(const sofa::FIRDataSet &dataSet,
+                     const double radiusTolerance = 0.01);
+
+        //==============================================================================
+        unsigned long GetNumMeasurements() const;
+
+        unsigned long GetNumShells() const;
+        double GetShellRadius(const unsigned long shell) const;
+        const std::vector< unsigned long > & GetShellMeasurements(const unsigned long shell) const;
+
+        //==============================================================================
+        void GetWeights(std::vector< unsigned long > &measurements,
+                        std::vector< double > &weights,
+                        const double position[3]) const;
+
+        void Interpolate(double *ir,
+                         double *delay,
+                         const sofa::FIRDataSet &dataSet,
+                         const double position[3]) const;
+
+    private:
+        struct Shell
+        {
+            double radius;
+            std::vector< unsigned long > measurements;                  ///< index in the data set of each point
+            std::shared_ptr< sofa::SphericalTriangulation > triangulation; ///< null if the shell cannot be triangulated
+            std::shared_ptr< sofa::SpatialIndex > index;
+        };
+
+        void getShellWeights(std::vector< unsigned long > &measurements,
+                             std::vector< double > &weights,
+                             const Shell &shell,
+                             const double direction[3],
+                             const double gain) const;
+
+    private:
+        unsigned long numMeasurements;
+
+        std::vector< Shell > shells;                                    ///< sorted by increasing radius
+
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( MultiRadiusInterpolator );
+    };
+
+}
+
+#endif /* _SOFA_MULTI_RADIUS_INTERPOLATOR_H__ */
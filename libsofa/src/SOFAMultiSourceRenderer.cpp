@@ -0,0 +1,474 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAMultiSourceRenderer.cpp
+ *   @brief      Frequency-domain rendering of many sources with a shared HRTF bank
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAMultiSourceRenderer.h"
+#include "../src/SOFAFractionalDelayLine.h"
+#include "../src/SOFAGeometry.h"
+#include "../src/SOFASimd.h"
+#include "../src/SOFAExceptions.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+using namespace sofa::dsp;
+
+namespace MultiSourceRendererLocal
+{
+    /// accumulators of MultiSourceRenderer
+    enum Accumulator
+    {
+        kSteady     = 0,    ///< sources whose measurement has not changed
+        kPrevious   = 1,    ///< sources whose measurement has changed, with their previous HRTFs
+        kNext       = 2,    ///< sources whose measurement has changed, with their new HRTFs
+        kNumAccumulators
+    };
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      file : the HRIRs (two receivers)
+ *  @param[in]      blockSize_ : number of samples per call to Process, a power of two
+ *
+ */
+/************************************************************************************/
+HRTFBank::HRTFBank(const sofa::SimpleFreeFieldHRIR &file,
+                   const unsigned int blockSize_)
+: blockSize( blockSize_ )
+, numMeasurements( 0 )
+, filterLength( 0 )
+, samplingRate( 0.0 )
+{
+    sofa::FIRDataSet dataSet;
+
+    if( dataSet.Load( file ) == false )
+    {
+        SOFA_THROW( "cannot load the HRIRs" );
+    }
+
+    init( dataSet );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      dataSet : the HRIRs, possibly processed (e.g. ImpulseResponseTrimmer)
+ *  @param[in]      blockSize_ : number of samples per call to Process, a power of two
+ *
+ */
+/************************************************************************************/
+HRTFBank::HRTFBank(const sofa::FIRDataSet &dataSet,
+                   const unsigned int blockSize_)
+: blockSize( blockSize_ )
+, numMeasurements( 0 )
+, filterLength( 0 )
+, samplingRate( 0.0 )
+{
+    init( dataSet );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Transforms the filters (Data.IR delayed by Data.Delay) and builds the
+ *                  spatial index
+ *
+ */
+/************************************************************************************/
+void HRTFBank::init(const sofa::FIRDataSet &dataSet)
+{
+    if( dataSet.GetNumReceivers() != 2 )
+    {
+        SOFA_THROW( "two receivers are required" );
+    }
+
+    const unsigned long M = dataSet.GetNumMeasurements();
+    const unsigned long N = dataSet.GetNumDataSamples();
+
+    const std::vector< double > &delays = dataSet.GetDataDelay();
+
+    std::size_t length = N;
+
+    for( std::size_t i = 0; i < M * 2; i++ )
+    {
+        length = std::max( length, sofa::dsp::FractionalDelayLine::GetDelayedLength( N, delays[i] ) );
+    }
+
+    std::vector< double > h( M * 2 * length, 0.0 );
+
+    /// fractional delays are kept (windowed sinc interpolation), so that the ITD is not quantized
+    for( std::size_t i = 0; i < M * 2; i++ )
+    {
+        sofa::dsp::FractionalDelayLine::ApplyDelay( &h[ i * length ], length, &dataSet.GetDataIR()[ i * N ], N, delays[i] );
+    }
+
+    filters.Prepare( &h[0], M * 2, length, blockSize );
+
+    std::vector< double > directions( dataSet.GetSourceCartesianPositions() );
+    for( unsigned long m = 0; m < M; m++ )
+    {
+        sofa::Geometry::Normalize( &directions[ 3 * m ] );
+    }
+    index.Build( directions );
+
+    numMeasurements = M;
+    filterLength    = static_cast< unsigned int >( length );
+    samplingRate    = dataSet.GetSamplingRate();
+}
+
+unsigned int HRTFBank::GetBlockSize() const
+{
+    return blockSize;
+}
+
+unsigned int HRTFBank::GetNumPartitions() const
+{
+    return filters.GetNumPartitions();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Length of the filters (Data.IR plus the largest delay and the taps of
+ *                  the fractional delay interpolator)
+ *
+ */
+/************************************************************************************/
+unsigned int HRTFBank::GetFilterLength() const
+{
+    return filterLength;
+}
+
+unsigned long HRTFBank::GetNumMeasurements() const
+{
+    return numMeasurements;
+}
+
+double HRTFBank::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+const PartitionedFilterBank & HRTFBank::GetFilters() const
+{
+    return filters;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the measurement whose direction is the closest to a given one
+ *  @param[in]      direction : cartesian direction (SOFA frame)
+ *
+ */
+/************************************************************************************/
+unsigned long HRTFBank::FindMeasurement(const double direction[3]) const
+{
+    double d[3] = { direction[0], direction[1], direction[2] };
+    sofa::Geometry::Normalize( d );
+
+    return index.FindNearest( d );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      bank_ : the HRTFs
+ *  @param[in]      maxNumSources_ : largest number of sources per call to Process
+ *
+ */
+/************************************************************************************/
+MultiSourceRenderer::MultiSourceRenderer(const std::shared_ptr< const sofa::dsp::HRTFBank > &bank_,
+                                         const unsigned int maxNumSources_)
+: bank( bank_ )
+, blockSize( ( bank_ != nullptr ) ? bank_->GetBlockSize() : 0 )
+, maxNumSources( maxNumSources_ )
+, numActiveSources( 0 )
+, measurements( maxNumSources_ )
+, current( maxNumSources_, 0 )
+, fft( 2 * std::max( 1u, blockSize ) )
+, position( 0 )
+{
+    if( bank == nullptr || maxNumSources == 0 )
+    {
+        SOFA_THROW( "invalid renderer configuration" );
+    }
+
+    const unsigned int B = blockSize;
+    const unsigned int P = bank->GetNumPartitions();
+    const unsigned int K = bank->GetFilters().GetNumBins();
+    const std::size_t S  = maxNumSources;
+
+    for( std::size_t s = 0; s < S; s++ )
+    {
+        measurements[s].store( 0 );
+    }
+
+    frames.assign( S * 2 * B, 0.0f );
+    spectraRe.assign( S * P * K, 0.0f );
+    spectraIm.assign( S * P * K, 0.0f );
+
+    accumulatorRe.assign( MultiSourceRendererLocal::kNumAccumulators * 2 * K, 0.0f );
+    accumulatorIm.assign( MultiSourceRendererLocal::kNumAccumulators * 2 * K, 0.0f );
+    output.assign( 2 * B, 0.0f );
+    previous.assign( B, 0.0f );
+    next.assign( B, 0.0f );
+
+    fadeIn.resize( B );
+    for( unsigned int i = 0; i < B; i++ )
+    {
+        fadeIn[i] = static_cast< float >( i + 1 ) / static_cast< float >( B );
+    }
+}
+
+unsigned int MultiSourceRenderer::GetBlockSize() const
+{
+    return blockSize;
+}
+
+unsigned int MultiSourceRenderer::GetMaxNumSources() const
+{
+    return maxNumSources;
+}
+
+const HRTFBank & MultiSourceRenderer::GetBank() const
+{
+    return *bank;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Selects the HRTFs of a source, from the next block on (thread-safe)
+ *  @param[in]      source : index of the source
+ *  @param[in]      measurement : index of the measurement
+ *
+ */
+/************************************************************************************/
+void MultiSourceRenderer::SetMeasurement(const unsigned int source,
+                                         const unsigned long measurement)
+{
+    SOFA_ASSERT( source < maxNumSources && measurement < bank->GetNumMeasurements() );
+
+    if( source < maxNumSources )
+    {
+        measurements[ source ].store( std::min( measurement, bank->GetNumMeasurements() - 1 ) );
+    }
+}
+
+unsigned long MultiSourceRenderer::GetMeasurement(const unsigned int source) const
+{
+    SOFA_ASSERT( source < maxNumSources );
+
+    return measurements[ source ].load();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Clears the state of the convolution of all the sources
+ *
+ */
+/************************************************************************************/
+void MultiSourceRenderer::Reset()
+{
+    std::fill( frames.begin(), frames.end(), 0.0f );
+    std::fill( spectraRe.begin(), spectraRe.end(), 0.0f );
+    std::fill( spectraIm.begin(), spectraIm.end(), 0.0f );
+    position = 0;
+
+    for( std::size_t s = 0; s < maxNumSources; s++ )
+    {
+        current[s] = measurements[s].load();
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Clears the input history of a source
+ *
+ */
+/************************************************************************************/
+void MultiSourceRenderer::clearSource(const unsigned int source)
+{
+    const unsigned int B = blockSize;
+    const std::size_t PK = static_cast< std::size_t >( bank->GetNumPartitions() ) * bank->GetFilters().GetNumBins();
+
+    std::fill( frames.begin() + source * 2 * B, frames.begin() + ( source + 1 ) * 2 * B, 0.0f );
+    std::fill( spectraRe.begin() + source * PK, spectraRe.begin() + ( source + 1 ) * PK, 0.0f );
+    std::fill( spectraIm.begin() + source * PK, spectraIm.begin() + ( source + 1 ) * PK, 0.0f );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Renders one block of all the sources
+ *  @param[out]     left : numSamples samples
+ *  @param[out]     right : numSamples samples
+ *  @param[in]      inputs : one buffer of numSamples samples per source
+ *  @param[in]      numSources : number of sources, at most the maximum number of sources
+ *  @param[in]      numSamples : shall be equal to the block size
+ *  @return         false if numSamples or numSources is out of range (nothing is done)
+ *
+ *  @details        The sources from numSources on are silent : their history is cleared
+ */
+/************************************************************************************/
+bool MultiSourceRenderer::Process(float *left,
+                                  float *right,
+                                  const float *const *inputs,
+                                  const unsigned int numSources,
+                                  const unsigned int numSamples)
+{
+    if( numSamples != blockSize || numSources > maxNumSources )
+    {
+        SOFA_ASSERT( false );
+        return false;
+    }
+
+    using namespace MultiSourceRendererLocal;
+
+    const unsigned int B = blockSize;
+    const unsigned int P = bank->GetNumPartitions();
+    const unsigned int K = bank->GetFilters().GetNumBins();
+
+    const sofa::dsp::PartitionedFilterBank &filters = bank->GetFilters();
+
+    for( unsigned int s = numSources; s < numActiveSources; s++ )
+    {
+        clearSource( s );
+    }
+
+    numActiveSources = numSources;
+
+    position = ( position + 1 ) % P;
+
+    std::fill( accumulatorRe.begin(), accumulatorRe.end(), 0.0f );
+    std::fill( accumulatorIm.begin(), accumulatorIm.end(), 0.0f );
+
+    bool transition = false;
+
+    //==============================================================================
+    for( unsigned int s = 0; s < numSources; s++ )
+    {
+        /// slide the input frame of the source and transform it
+        float *frame = &frames[ static_cast< std::size_t >( s ) * 2 * B ];
+
+        std::copy( frame + B, frame + 2 * B, frame );
+        std::copy( inputs[s], inputs[s] + B, frame + B );
+
+        float *re = &spectraRe[ static_cast< std::size_t >( s ) * P * K ];
+        float *im = &spectraIm[ static_cast< std::size_t >( s ) * P * K ];
+
+        fft.Forward( re + position * K, im + position * K, frame );
+
+        const unsigned long target  = measurements[s].load();
+        const bool changed          = ( target != current[s] );
+
+        transition = ( transition == true || changed == true );
+
+        for( unsigned int r = 0; r < 2; r++ )
+        {
+            float *steadyRe     = &accumulatorRe[ ( ( changed == true ? kNext : kSteady ) * 2 + r ) * K ];
+            float *steadyIm     = &accumulatorIm[ ( ( changed == true ? kNext : kSteady ) * 2 + r ) * K ];
+            float *previousRe   = &accumulatorRe[ ( kPrevious * 2 + r ) * K ];
+            float *previousIm   = &accumulatorIm[ ( kPrevious * 2 + r ) * K ];
+
+            /// partition p is applied to the frame received p blocks ago
+            for( unsigned int p = 0; p < P; p++ )
+            {
+                const unsigned int slot = ( position + P - p ) % P;
+
+                sofa::Simd::ComplexMultiplyAccumulate( steadyRe, steadyIm,
+                                                       re + slot * K, im + slot * K,
+                                                       filters.GetRe( target * 2 + r, p ),
+                                                       filters.GetIm( target * 2 + r, p ),
+                                                       K );
+
+                if( changed == true )
+                {
+                    sofa::Simd::ComplexMultiplyAccumulate( previousRe, previousIm,
+                                                           re + slot * K, im + slot * K,
+                                                           filters.GetRe( current[s] * 2 + r, p ),
+                                                           filters.GetIm( current[s] * 2 + r, p ),
+                                                           K );
+                }
+            }
+        }
+
+        current[s] = target;
+    }
+
+    //==============================================================================
+    float *outputs[2] = { left, right };
+
+    for( unsigned int r = 0; r < 2; r++ )
+    {
+        inverse( outputs[r], &accumulatorRe[ ( kSteady * 2 + r ) * K ], &accumulatorIm[ ( kSteady * 2 + r ) * K ] );
+
+        if( transition == true )
+        {
+            inverse( &previous[0], &accumulatorRe[ ( kPrevious * 2 + r ) * K ], &accumulatorIm[ ( kPrevious * 2 + r ) * K ] );
+            inverse( &next[0], &accumulatorRe[ ( kNext * 2 + r ) * K ], &accumulatorIm[ ( kNext * 2 + r ) * K ] );
+
+            sofa::Simd::Crossfade( &previous[0], &previous[0], &next[0], &fadeIn[0], B );
+            sofa::Simd::MultiplyAccumulate( outputs[r], &previous[0], 1.0f, B );
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Inverse transform of an accumulator
+ *  @param[out]     y : B samples
+ *
+ */
+/************************************************************************************/
+void MultiSourceRenderer::inverse(float *y,
+                                  const float *re,
+                                  const float *im)
+{
+    fft.Inverse( &output[0], re, im );
+
+    /// overlap-save : the first half is aliased
+    std::copy( output.begin() + blockSize, output.end(), y );
+}
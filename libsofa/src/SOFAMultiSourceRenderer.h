@@ -0,0 +1,199 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAMultiSourceRenderer.h
+ *   @brief      Frequency-domain rendering of many sources with a shared HRTF bank
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_MULTI_SOURCE_RENDERER_H__
+#define _SOFA_MULTI_SOURCE_RENDERER_H__
+
+#include "../src/SOFASimpleFreeFieldHRIR.h"
+#include "../src/SOFAFIRDataSet.h"
+#include "../src/SOFAPartitionedFilterBank.h"
+#include "../src/SOFASpatialIndex.h"
+#include "../src/SOFAFFT.h"
+#include <atomic>
+#include <memory>
+
+namespace sofa
+{
+
+    namespace dsp
+    {
+
+        /************************************************************************************/
+        /*!
+         *  @class          HRTFBank
+         *  @brief          Frequency-domain partitions of all the HRIRs of a SimpleFreeFieldHRIR
+         *
+         *  @details        Built once from Data.IR, with Data.Delay included in the filters
+         *                  (fractional delays interpolated by FractionalDelayLine::ApplyDelay,
+         *                  so that the ITD is not quantized to the sample), and shared
+         *                  (read-only) by any number of renderers with the same block size.
+         */
+        /************************************************************************************/
+        class SOFA_API HRTFBank
+        {
+        public:
+            HRTFBank(const sofa::SimpleFreeFieldHRIR &file,
+                     const unsigned int blockSize);
+
+            HRTFBank(const sofa::FIRDataSet &dataSet,
+                     const unsigned int blockSize);
+            ~HRTFBank() {};
+
+            //==============================================================================
+            unsigned int GetBlockSize() const;
+            unsigned int GetNumPartitions() const;
+            unsigned int GetFilterLength() const;
+            unsigned long GetNumMeasurements() const;
+            double GetSamplingRate() const;
+
+            const sofa::dsp::PartitionedFilterBank & GetFilters() const;
+
+            unsigned long FindMeasurement(const double direction[3]) const;
+
+        private:
+            void init(const sofa::FIRDataSet &dataSet);
+
+        private:
+            const unsigned int blockSize;
+            unsigned long numMeasurements;
+            unsigned int filterLength;
+            double samplingRate;
+
+            sofa::dsp::PartitionedFilterBank filters;   ///< filter m * 2 + r
+            sofa::SpatialIndex index;                   ///< source directions
+
+        private:
+            /// avoid shallow and copy constructor
+            SOFA_AVOID_COPY_CONSTRUCTOR( HRTFBank );
+        };
+
+        /************************************************************************************/
+        /*!
+         *  @class          MultiSourceRenderer
+         *  @brief          Real-time binaural rendering of many sources with one HRTFBank
+         *
+         *  @details        Each source block is transformed once, and multiplied with the
+         *                  partitions of its HRTFs into one frequency-domain accumulator per
+         *                  ear (uniformly partitioned overlap-save) : S sources cost S forward
+         *                  FFTs plus 2 inverse FFTs per block, without latency.
+         *
+         *                  When the measurement of sources changes, these sources are
+         *                  accumulated separately with both their previous and their new HRTFs,
+         *                  and the two are crossfaded over the block (2 more inverse FFTs per
+         *                  ear, only during that block).
+         *                  SetMeasurement may be called from any thread.
+         *                  Process does not allocate, nor lock.
+         */
+        /************************************************************************************/
+        class SOFA_API MultiSourceRenderer
+        {
+        public:
+            MultiSourceRenderer(const std::shared_ptr< const sofa::dsp::HRTFBank > &bank,
+                                const unsigned int maxNumSources);
+            ~MultiSourceRenderer() {};
+
+            //==============================================================================
+            unsigned int GetBlockSize() const;
+            unsigned int GetMaxNumSources() const;
+
+            const sofa::dsp::HRTFBank & GetBank() const;
+
+            //==============================================================================
+            void SetMeasurement(const unsigned int source,
+                                const unsigned long measurement);
+
+            unsigned long GetMeasurement(const unsigned int source) const;
+
+            //==============================================================================
+            bool Process(float *left,
+                         float *right,
+                         const float *const *inputs,
+                         const unsigned int numSources,
+                         const unsigned int numSamples);
+
+            void Reset();
+
+        private:
+            void clearSource(const unsigned int source);
+
+            void inverse(float *y,
+                         const float *re,
+                         const float *im);
+
+        private:
+            const std::shared_ptr< const sofa::dsp::HRTFBank > bank;
+            const unsigned int blockSize;
+            const unsigned int maxNumSources;
+            unsigned int numActiveSources;              ///< sources processed in the last block
+
+            std::vector< std::atomic< unsigned long > > measurements;
+            std::vector< unsigned long > current;       ///< [ S ] measurements rendered in the last block
+
+            sofa::dsp::FFT fft;
+
+            std::vector< float > frames;                ///< [ S 2B ] last two input blocks of each source
+            std::vector< float > spectraRe;             ///< [ S P B+1 ] spectra of the last P frames
+            std::vector< float > spectraIm;
+            unsigned int position;                      ///< slot of the most recent frame
+
+            std::vector< float > accumulatorRe;         ///< [ 3 2 B+1 ] steady, previous and new HRTFs, per ear
+            std::vector< float > accumulatorIm;
+            std::vector< float > output;                ///< [ 2B ]
+            std::vector< float > previous;              ///< [ B ]
+            std::vector< float > next;                  ///< [ B ]
+            std::vector< float > fadeIn;                ///< [ B ] crossfade ramp
+
+        private:
+            /// avoid shallow and copy constructor
+            SOFA_AVOID_COPY_CONSTRUCTOR( MultiSourceRenderer );
+        };
+
+    }
+
+}
+
+#endif /* _SOFA_MULTI_SOURCE_RENDERER_H__ */
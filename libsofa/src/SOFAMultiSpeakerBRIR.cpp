@@ -310,6 +310,21 @@ bool MultiSpeakerBRIR::GetDataIR(std::vector< double > &values) const
     return sofa::File::getDataIR( values );
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values in single precision
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool MultiSpeakerBRIR::GetDataIR(std::vector< float > &values) const
+{
+    /// Data.IR is [ M R N E ]
+    
+    return sofa::File::getDataIR( values );
+}
+
 
 bool MultiSpeakerBRIR::GetDataDelay(double *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const
 {
@@ -319,3 +334,156 @@ bool MultiSpeakerBRIR::GetDataDelay(double *values, const unsigned long dim1, co
 }
 
  
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads the Data.IR values of a range of emitters, for one measurement
+ *  @param[out]     values : [ R numEmitters N ], resized if needed
+ *
+ */
+/************************************************************************************/
+template< typename T >
+bool MultiSpeakerBRIR::getDataIR(std::vector< T > &values,
+                                 const unsigned long measurement,
+                                 const unsigned long firstEmitter,
+                                 const unsigned long numEmitters) const
+{
+    /// Data.IR is [ M R E N ]
+    
+    const long M = GetNumMeasurements();
+    const long R = GetNumReceivers();
+    const long E = GetNumEmitters();
+    const long N = GetNumDataSamples();
+    
+    if( M <= 0 || R <= 0 || E <= 0 || N <= 0
+       || measurement >= static_cast< unsigned long >( M )
+       || firstEmitter + numEmitters > static_cast< unsigned long >( E )
+       || numEmitters == 0 )
+    {
+        return false;
+    }
+    
+    /// same shape checks as the reading of the whole variable
+    if( VariableHasDimensions( M, R, E, N, "Data.IR" ) == false )
+    {
+        SOFA_THROW( "invalid dimensions for 'Data.IR'" );
+        return false;
+    }
+    
+    std::vector< std::size_t > start( 4, 0 );
+    std::vector< std::size_t > count( 4, 0 );
+    
+    start[0] = measurement;
+    start[2] = firstEmitter;
+    
+    count[0] = 1;
+    count[1] = R;
+    count[2] = numEmitters;
+    count[3] = N;
+    
+    values.resize( R * numEmitters * N );
+    
+    return NetCDFFile::GetValues( &values[0], start, count, "Data.IR" );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values of one measurement
+ *  @param[in]      values : [ R E N ], the array is resized if needed
+ *  @param[in]      measurement : index of the measurement (listener orientation)
+ *  @return         true on success
+ *
+ *  @details        Only this measurement is read from the file
+ */
+/************************************************************************************/
+bool MultiSpeakerBRIR::GetDataIR(std::vector< double > &values,
+                                 const unsigned long measurement) const
+{
+    return getDataIR( values, measurement, 0, GetNumEmitters() );
+}
+
+bool MultiSpeakerBRIR::GetDataIR(std::vector< float > &values,
+                                 const unsigned long measurement) const
+{
+    return getDataIR( values, measurement, 0, GetNumEmitters() );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values of one measurement and one emitter
+ *  @param[in]      values : [ R N ], the array is resized if needed
+ *  @param[in]      measurement : index of the measurement (listener orientation)
+ *  @param[in]      emitter : index of the emitter (loudspeaker)
+ *  @return         true on success
+ *
+ *  @details        Only this slab is read from the file
+ */
+/************************************************************************************/
+bool MultiSpeakerBRIR::GetDataIR(std::vector< double > &values,
+                                 const unsigned long measurement,
+                                 const unsigned long emitter) const
+{
+    return getDataIR( values, measurement, emitter, 1 );
+}
+
+bool MultiSpeakerBRIR::GetDataIR(std::vector< float > &values,
+                                 const unsigned long measurement,
+                                 const unsigned long emitter) const
+{
+    return getDataIR( values, measurement, emitter, 1 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.Delay values of one measurement
+ *  @param[in]      values : [ R E ], the array is resized if needed
+ *  @param[in]      measurement : index of the measurement (listener orientation)
+ *  @return         true on success
+ *
+ *  @details        Data.Delay can be [ I R E ] or [ M R E ].
+ *                  An exception is thrown if Data.Delay is missing or has another shape
+ */
+/************************************************************************************/
+bool MultiSpeakerBRIR::GetDataDelay(std::vector< double > &values,
+                                    const unsigned long measurement) const
+{
+    const long M = GetNumMeasurements();
+    const long R = GetNumReceivers();
+    const long E = GetNumEmitters();
+    
+    if( M <= 0 || R <= 0 || E <= 0 || measurement >= static_cast< unsigned long >( M ) )
+    {
+        return false;
+    }
+    
+    if( HasVariable( "Data.Delay" ) == false )
+    {
+        SOFA_THROW( "missing Data.Delay variable" );
+        return false;
+    }
+    
+    std::vector< std::size_t > dims;
+    GetVariableDimensions( dims, "Data.Delay" );
+    
+    if( dims.size() != 3
+       || ( dims[0] != 1 && dims[0] != static_cast< std::size_t >( M ) )
+       || dims[1] != static_cast< std::size_t >( R )
+       || dims[2] != static_cast< std::size_t >( E ) )
+    {
+        SOFA_THROW( "invalid Data.Delay dimensions : [ I R E ] or [ M R E ] expected" );
+        return false;
+    }
+    
+    std::vector< std::size_t > start( 3, 0 );
+    std::vector< std::size_t > count( 3, 0 );
+    
+    start[0] = ( dims[0] == static_cast< std::size_t >( M ) ) ? measurement : 0;
+    
+    count[0] = 1;
+    count[1] = R;
+    count[2] = E;
+    
+    values.resize( R * E );
+    
+    return NetCDFFile::GetValues( &values[0], start, count, "Data.Delay" );
+}
@@ -82,13 +82,24 @@ namespace sofa
         
         //==============================================================================
         bool GetDataIR(std::vector< double > &values) const;
+        bool GetDataIR(std::vector< float > &values) const;
         bool GetDataIR(double *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3, const unsigned long dim4) const;
         bool GetDataDelay(double *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const;
         
+        //==============================================================================
+        bool GetDataIR(std::vector< double > &values, const unsigned long measurement) const;
+        bool GetDataIR(std::vector< float > &values, const unsigned long measurement) const;
+        bool GetDataIR(std::vector< double > &values, const unsigned long measurement, const unsigned long emitter) const;
+        bool GetDataIR(std::vector< float > &values, const unsigned long measurement, const unsigned long emitter) const;
+        bool GetDataDelay(std::vector< double > &values, const unsigned long measurement) const;
+        
     private:
         //==============================================================================
         bool checkGlobalAttributes() const;
         bool checkListenerVariables() const;
+        
+        template< typename T >
+        bool getDataIR(std::vector< T > &values, const unsigned long measurement, const unsigned long firstEmitter, const unsigned long numEmitters) const;
                 
     private:
         /// avoid shallow and copy constructor
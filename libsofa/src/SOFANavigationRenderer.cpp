@@ -0,0 +1,719 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFANavigationRenderer.cpp
+ *   @brief      Real-time rendering of room responses at any listener position
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFANavigationRenderer.h"
+#include "../src/SOFASimd.h"
+#include "../src/SOFAExceptions.h"
+#include <cmath>
+#include <algorithm>
+
+using namespace sofa;
+using namespace sofa::dsp;
+
+namespace NavigationRendererLocal
+{
+    const double kPi = 3.14159265358979323846;
+
+    /// onset : first sample within this level (in dB) of the peak
+    const double kOnsetThreshold = -20.0;
+
+    /// samples kept before the onset in the direct sound
+    const unsigned long kPreOnset = 8;
+
+    /// length of the direct sound after the onset, in seconds
+    const double kDirectDuration = 2.5e-3;
+
+    /// order of the windowed sinc interpolation of the arrival times
+    const unsigned int kInterpolationOrder = 16;
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Returns the index of the first sample within kOnsetThreshold of the
+     *                  peak of an IR
+     *
+     */
+    /************************************************************************************/
+    unsigned long findOnset(const double *ir,
+                            const unsigned long length)
+    {
+        double peak = 0.0;
+
+        for( unsigned long n = 0; n < length; n++ )
+        {
+            peak = std::max( peak, ir[n] * ir[n] );
+        }
+
+        const double threshold = peak * std::pow( 10.0, kOnsetThreshold / 10.0 );
+
+        for( unsigned long n = 0; n < length; n++ )
+        {
+            if( ir[n] * ir[n] >= threshold && peak > 0.0 )
+            {
+                return n;
+            }
+        }
+
+        return 0;
+    }
+}
+
+bool NavigationRenderer::Voice::IsActive() const
+{
+    return ( gain > 0.0 || target > 0.0 || remaining > 0 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      file : the BRIRs, Data.IR [ M R E N ], ListenerPosition [ M C ]
+ *  @param[in]      blockSize_ : number of samples per call to Process, a power of two
+ *  @param[in]      numNeighbours_ : number of measurements mixed
+ *  @param[in]      capacity_ : number of measurements whose convolvers are kept in memory
+ *  @param[in]      useWorkerThread : compute the tails in a background thread
+ *  @param[in]      maxPartitionSize_ : largest partition size of the convolvers
+ *
+ *  @details        The listener is at the position of the first measurement
+ */
+/************************************************************************************/
+NavigationRenderer::NavigationRenderer(const sofa::MultiSpeakerBRIR &file,
+                                       const unsigned int blockSize_,
+                                       const unsigned int numNeighbours_,
+                                       const unsigned long capacity_,
+                                       const bool useWorkerThread,
+                                       const unsigned int maxPartitionSize_)
+: blockSize( blockSize_ )
+, numNeighbours( numNeighbours_ )
+, capacity( capacity_ )
+, maxPartitionSize( maxPartitionSize_ )
+, numInputs( file.GetNumEmitters() )
+, numOutputs( file.GetNumReceivers() )
+, numDataSamples( file.GetNumDataSamples() )
+, samplingRate( 0.0 )
+, useCounter( 0 )
+{
+    /// only the slab of the measurements rendered is read
+    reader = [ &file ]( const unsigned long measurement,
+                        std::vector< double > &ir,
+                        std::vector< double > &delay )
+    {
+        return ( file.GetDataIR( ir, measurement ) == true
+                && file.GetDataDelay( delay, measurement ) == true );
+    };
+
+    if( file.GetSamplingRate( samplingRate ) == false )
+    {
+        SOFA_THROW( "cannot read the sampling rate" );
+    }
+
+    init( file, useWorkerThread );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      file : the DRIRs, Data.IR [ M R N ], ListenerPosition [ M C ]
+ *  @param[in]      blockSize_ : number of samples per call to Process, a power of two
+ *  @param[in]      numNeighbours_ : number of measurements mixed
+ *  @param[in]      capacity_ : number of measurements whose convolvers are kept in memory
+ *  @param[in]      useWorkerThread : compute the tails in a background thread
+ *  @param[in]      maxPartitionSize_ : largest partition size of the convolvers
+ *
+ *  @details        The listener is at the position of the first measurement
+ */
+/************************************************************************************/
+NavigationRenderer::NavigationRenderer(const sofa::SingleRoomDRIR &file,
+                                       const unsigned int blockSize_,
+                                       const unsigned int numNeighbours_,
+                                       const unsigned long capacity_,
+                                       const bool useWorkerThread,
+                                       const unsigned int maxPartitionSize_)
+: blockSize( blockSize_ )
+, numNeighbours( numNeighbours_ )
+, capacity( capacity_ )
+, maxPartitionSize( maxPartitionSize_ )
+, numInputs( 1 )
+, numOutputs( file.GetNumReceivers() )
+, numDataSamples( file.GetNumDataSamples() )
+, samplingRate( 0.0 )
+, useCounter( 0 )
+{
+    const unsigned long M = file.GetNumMeasurements();
+    const unsigned long R = numOutputs;
+    const unsigned long N = numDataSamples;
+
+    if( file.GetDataIR( dataIR ) == false
+       || file.GetDataDelay( dataDelay ) == false
+       || file.GetSamplingRate( samplingRate ) == false )
+    {
+        SOFA_THROW( "cannot read the DRIRs" );
+    }
+
+    if( dataIR.size() != M * R * N )
+    {
+        SOFA_THROW( "invalid Data.IR dimensions" );
+    }
+
+    if( dataDelay.size() != R && dataDelay.size() != M * R )
+    {
+        SOFA_THROW( "invalid Data.Delay dimensions" );
+    }
+
+    reader = [ this, R, N ]( const unsigned long measurement,
+                             std::vector< double > &ir,
+                             std::vector< double > &delay )
+    {
+        const std::size_t offset = ( dataDelay.size() == R ) ? 0 : measurement * R;
+
+        ir.assign( dataIR.begin() + measurement * R * N, dataIR.begin() + ( measurement + 1 ) * R * N );
+        delay.assign( dataDelay.begin() + offset, dataDelay.begin() + offset + R );
+
+        return true;
+    };
+
+    init( file, useWorkerThread );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class destructor
+ *
+ */
+/************************************************************************************/
+NavigationRenderer::~NavigationRenderer()
+{
+    /// the convolvers unregister from the worker
+    voices.clear();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Builds the position index and the delay line, and renders the first
+ *                  measurement
+ *
+ */
+/************************************************************************************/
+void NavigationRenderer::init(const sofa::File &file,
+                              const bool useWorkerThread)
+{
+    const unsigned long C = numOutputs * numInputs;
+
+    if( blockSize == 0 || numNeighbours == 0 || C == 0 || numDataSamples == 0 )
+    {
+        SOFA_THROW( "invalid parameters" );
+    }
+
+    index.Load( file );
+
+    /// bound of the arrival times of the direct sounds
+    std::vector< double > delays;
+
+    if( file.GetValues( delays, "Data.Delay" ) == false )
+    {
+        SOFA_THROW( "cannot read Data.Delay" );
+    }
+
+    double maxDelay = 0.0;
+
+    for( std::size_t i = 0; i < delays.size(); i++ )
+    {
+        maxDelay = std::max( maxDelay, delays[i] );
+    }
+
+    /// same interpolator as the reverberation (FractionalDelayLine::ApplyDelay), so that the
+    /// two parts stay complementary with fractional delays
+    delayLine.reset( new sofa::dsp::FractionalDelayLine( static_cast< unsigned int >( C ),
+                                                         maxDelay + numDataSamples + 1.0,
+                                                         blockSize,
+                                                         sofa::dsp::FractionalDelayLine::kWindowedSinc,
+                                                         NavigationRendererLocal::kInterpolationOrder ) );
+
+    if( useWorkerThread == true )
+    {
+        worker = std::make_shared< sofa::dsp::ConvolutionWorker >();
+    }
+
+    currentArrivals.assign( C, 0.0f );
+    targetArrivals.assign( C, 0.0f );
+
+    ramp.assign( blockSize, 0.0f );
+    scratch.assign( blockSize, 0.0f );
+    directInput.assign( blockSize, 0.0f );
+    reverbInput.assign( blockSize, 0.0f );
+    directSums.assign( C * blockSize, 0.0f );
+    delayed.assign( C * blockSize, 0.0f );
+
+    directPointers.resize( C );
+    delayedPointers.resize( C );
+
+    for( unsigned long c = 0; c < C; c++ )
+    {
+        directPointers[c]   = &directSums[ c * blockSize ];
+        delayedPointers[c]  = &delayed[ c * blockSize ];
+    }
+
+    update( index.GetPosition( 0 ) );
+
+    /// no fade in
+    for( std::map< unsigned long, Voice >::iterator it = voices.begin(); it != voices.end(); ++it )
+    {
+        it->second.gain = it->second.target;
+    }
+
+    currentArrivals = targetArrivals;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the convolvers of one measurement, created if needed
+ *
+ *  @details        Each IR is split at its onset into the direct sound (time-aligned,
+ *                  faded out) and the complementary part at its original time. Only the
+ *                  convolvers of this measurement are created.
+ */
+/************************************************************************************/
+NavigationRenderer::Voice & NavigationRenderer::acquire(const unsigned long measurement)
+{
+    std::map< unsigned long, Voice >::iterator it = voices.find( measurement );
+
+    if( it != voices.end() )
+    {
+        it->second.lastUse = ++useCounter;
+        return it->second;
+    }
+
+    const unsigned long C = numOutputs * numInputs;
+    const unsigned long N = numDataSamples;
+
+    std::vector< double > ir;
+    std::vector< double > delay;
+
+    if( reader( measurement, ir, delay ) == false
+       || ir.size() != C * N
+       || delay.size() != C )
+    {
+        SOFA_THROW( "cannot read the IRs of the measurement" );
+    }
+
+    const unsigned long directLength = NavigationRendererLocal::kPreOnset
+                                     + static_cast< unsigned long >( std::ceil( NavigationRendererLocal::kDirectDuration * samplingRate ) );
+
+    Voice &voice = voices[ measurement ];
+
+    voice.arrivals.resize( C );
+    voice.gain          = 0.0;
+    voice.target        = 0.0;
+    voice.remaining     = 0;
+    voice.tailLength    = 0;
+    voice.lastUse       = ++useCounter;
+
+    std::vector< double > direct;
+    std::vector< double > residual;
+    std::vector< double > reverb;
+
+    for( unsigned long c = 0; c < C; c++ )
+    {
+        const double *h = &ir[ c * N ];
+
+        const unsigned long onset = NavigationRendererLocal::findOnset( h, N );
+        const unsigned long start = ( onset > NavigationRendererLocal::kPreOnset ) ? onset - NavigationRendererLocal::kPreOnset : 0;
+        const unsigned long length = std::min( directLength, N - start );
+        const unsigned long fade = std::max< unsigned long >( 1, length / 4 );
+
+        direct.assign( length, 0.0 );
+        residual.assign( h, h + N );
+
+        for( unsigned long n = 0; n < length; n++ )
+        {
+            double window = 1.0;
+
+            if( n + fade >= length )
+            {
+                /// raised cosine fade out
+                const double x = static_cast< double >( n + fade - length + 1 ) / static_cast< double >( fade + 1 );
+                window = 0.5 * ( 1.0 + std::cos( NavigationRendererLocal::kPi * x ) );
+            }
+
+            direct[n] = window * h[ start + n ];
+            residual[ start + n ] = ( 1.0 - window ) * h[ start + n ];
+        }
+
+        /// the reverberation has the same fractional delay as the arrival of the direct sound
+        reverb.resize( sofa::dsp::FractionalDelayLine::GetDelayedLength( N, delay[c], sofa::dsp::FractionalDelayLine::kWindowedSinc,
+                                                                         NavigationRendererLocal::kInterpolationOrder ) );
+        sofa::dsp::FractionalDelayLine::ApplyDelay( &reverb[0], reverb.size(), &residual[0], N, delay[c],
+                                                    sofa::dsp::FractionalDelayLine::kWindowedSinc,
+                                                    NavigationRendererLocal::kInterpolationOrder );
+
+        voice.arrivals[c] = std::max( 0.0, delay[c] ) + static_cast< double >( start );
+        voice.tailLength = std::max( voice.tailLength, static_cast< unsigned long >( reverb.size() ) );
+
+        voice.direct.emplace_back( new sofa::dsp::NonUniformConvolver( &direct[0], direct.size(), blockSize, worker, maxPartitionSize ) );
+        voice.reverb.emplace_back( new sofa::dsp::NonUniformConvolver( &reverb[0], reverb.size(), blockSize, worker, maxPartitionSize ) );
+    }
+
+    return voice;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the target weights and arrival times for a listener position
+ *
+ */
+/************************************************************************************/
+void NavigationRenderer::update(const double position[3])
+{
+    std::vector< unsigned long > nearest;
+    std::vector< double > nearestWeights;
+
+    index.FindNearest( nearest, nearestWeights, position, numNeighbours );
+
+    for( std::map< unsigned long, Voice >::iterator it = voices.begin(); it != voices.end(); ++it )
+    {
+        Voice &voice = it->second;
+
+        if( voice.target > 0.0 )
+        {
+            /// ramp out over the next block, then let the filters ring out
+            voice.remaining = voice.tailLength + blockSize;
+        }
+
+        voice.target = 0.0;
+    }
+
+    std::fill( targetArrivals.begin(), targetArrivals.end(), 0.0f );
+
+    for( std::size_t i = 0; i < nearest.size(); i++ )
+    {
+        Voice &voice = acquire( nearest[i] );
+
+        voice.target = nearestWeights[i];
+
+        for( std::size_t c = 0; c < targetArrivals.size(); c++ )
+        {
+            targetArrivals[c] += static_cast< float >( nearestWeights[i] * voice.arrivals[c] );
+        }
+    }
+
+    neighbours.swap( nearest );
+    weights.swap( nearestWeights );
+
+    release();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Releases the least recently used measurements beyond the capacity
+ *                  (the measurements still rendered are kept)
+ *
+ */
+/************************************************************************************/
+void NavigationRenderer::release()
+{
+    while( voices.size() > capacity )
+    {
+        std::map< unsigned long, Voice >::iterator oldest = voices.end();
+
+        for( std::map< unsigned long, Voice >::iterator it = voices.begin(); it != voices.end(); ++it )
+        {
+            if( it->second.IsActive() == false
+               && ( oldest == voices.end() || it->second.lastUse < oldest->second.lastUse ) )
+            {
+                oldest = it;
+            }
+        }
+
+        if( oldest == voices.end() )
+        {
+            return;
+        }
+
+        voices.erase( oldest );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Moves the listener : the neighbouring measurements and their weights
+ *                  are reached at the end of the next block
+ *  @param[in]      position : x y z, in meters (SOFA frame)
+ *  @return         true on success
+ *
+ *  @details        The convolvers of the measurements not in memory are created here :
+ *                  this shall not be called concurrently with Process.
+ */
+/************************************************************************************/
+bool NavigationRenderer::SetListenerPosition(const double position[3])
+{
+    if( std::isfinite( position[0] ) == false
+       || std::isfinite( position[1] ) == false
+       || std::isfinite( position[2] ) == false )
+    {
+        SOFA_THROW( "invalid listener position" );
+        return false;
+    }
+
+    update( position );
+
+    return true;
+}
+
+const std::vector< unsigned long > & NavigationRenderer::GetNeighbours() const
+{
+    return neighbours;
+}
+
+const std::vector< double > & NavigationRenderer::GetWeights() const
+{
+    return weights;
+}
+
+unsigned int NavigationRenderer::GetBlockSize() const
+{
+    return blockSize;
+}
+
+unsigned long NavigationRenderer::GetNumInputs() const
+{
+    return numInputs;
+}
+
+unsigned long NavigationRenderer::GetNumOutputs() const
+{
+    return numOutputs;
+}
+
+unsigned long NavigationRenderer::GetNumDataSamples() const
+{
+    return numDataSamples;
+}
+
+double NavigationRenderer::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+unsigned long NavigationRenderer::GetNumResident() const
+{
+    return static_cast< unsigned long >( voices.size() );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Number of measurements processed : the neighbours, plus those
+ *                  fading out or ringing out
+ *
+ */
+/************************************************************************************/
+unsigned long NavigationRenderer::GetNumActive() const
+{
+    unsigned long count = 0;
+
+    for( std::map< unsigned long, Voice >::const_iterator it = voices.begin(); it != voices.end(); ++it )
+    {
+        if( it->second.IsActive() == true )
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+unsigned long NavigationRenderer::GetCapacity() const
+{
+    return capacity;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Total number of jobs that missed their deadline, over all the convolvers
+ *
+ */
+/************************************************************************************/
+unsigned long NavigationRenderer::GetNumLateJobs() const
+{
+    unsigned long count = 0;
+
+    for( std::map< unsigned long, Voice >::const_iterator it = voices.begin(); it != voices.end(); ++it )
+    {
+        for( std::size_t c = 0; c < it->second.direct.size(); c++ )
+        {
+            count += it->second.direct[c]->GetNumLateJobs();
+            count += it->second.reverb[c]->GetNumLateJobs();
+        }
+    }
+
+    return count;
+}
+
+const sofa::PositionIndex & NavigationRenderer::GetPositionIndex() const
+{
+    return index;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Processes one block
+ *  @param[out]     outputs : one buffer of numSamples samples per receiver
+ *  @param[in]      inputs : one buffer of numSamples samples per emitter
+ *  @param[in]      numSamples : shall be equal to the block size
+ *  @return         false if numSamples differs from the block size
+ *
+ */
+/************************************************************************************/
+bool NavigationRenderer::Process(float *const *outputs,
+                                 const float *const *inputs,
+                                 const unsigned int numSamples)
+{
+    if( numSamples != blockSize )
+    {
+        SOFA_ASSERT( false );
+        return false;
+    }
+
+    const unsigned long R = numOutputs;
+    const unsigned long E = numInputs;
+
+    for( unsigned int n = 0; n < numSamples; n++ )
+    {
+        ramp[n] = static_cast< float >( n + 1 ) / static_cast< float >( numSamples );
+    }
+
+    for( unsigned long r = 0; r < R; r++ )
+    {
+        std::fill( outputs[r], outputs[r] + numSamples, 0.0f );
+    }
+
+    std::fill( directSums.begin(), directSums.end(), 0.0f );
+
+    for( std::map< unsigned long, Voice >::iterator it = voices.begin(); it != voices.end(); ++it )
+    {
+        Voice &voice = it->second;
+
+        if( voice.IsActive() == false )
+        {
+            continue;
+        }
+
+        /// linear weights for the time-aligned direct sounds, sqrt for the reverberation
+        const float directFrom  = static_cast< float >( voice.gain );
+        const float directTo    = static_cast< float >( voice.target );
+        const float reverbFrom  = static_cast< float >( std::sqrt( voice.gain ) );
+        const float reverbTo    = static_cast< float >( std::sqrt( voice.target ) );
+
+        for( unsigned long e = 0; e < E; e++ )
+        {
+            const float *x = inputs[e];
+
+            for( unsigned int n = 0; n < numSamples; n++ )
+            {
+                directInput[n] = x[n] * ( directFrom + ramp[n] * ( directTo - directFrom ) );
+                reverbInput[n] = x[n] * ( reverbFrom + ramp[n] * ( reverbTo - reverbFrom ) );
+            }
+
+            for( unsigned long r = 0; r < R; r++ )
+            {
+                const std::size_t c = r * E + e;
+
+                voice.direct[c]->Process( &scratch[0], &directInput[0], numSamples );
+                sofa::Simd::MultiplyAccumulate( &directSums[ c * numSamples ], &scratch[0], 1.0f, numSamples );
+
+                voice.reverb[c]->Process( &scratch[0], &reverbInput[0], numSamples );
+                sofa::Simd::MultiplyAccumulate( outputs[r], &scratch[0], 1.0f, numSamples );
+            }
+        }
+
+        voice.gain = voice.target;
+
+        if( voice.target <= 0.0 )
+        {
+            voice.remaining = ( voice.remaining > numSamples ) ? voice.remaining - numSamples : 0;
+        }
+    }
+
+    delayLine->Process( &delayedPointers[0], &directPointers[0], numSamples, &currentArrivals[0], &targetArrivals[0] );
+
+    currentArrivals = targetArrivals;
+
+    for( unsigned long r = 0; r < R; r++ )
+    {
+        for( unsigned long e = 0; e < E; e++ )
+        {
+            sofa::Simd::MultiplyAccumulate( outputs[r], &delayed[ ( r * E + e ) * numSamples ], 1.0f, numSamples );
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Clears the state of all the convolutions ; the measurements that are
+ *                  not neighbours stop being processed
+ *
+ */
+/************************************************************************************/
+void NavigationRenderer::Reset()
+{
+    for( std::map< unsigned long, Voice >::iterator it = voices.begin(); it != voices.end(); ++it )
+    {
+        Voice &voice = it->second;
+
+        for( std::size_t c = 0; c < voice.direct.size(); c++ )
+        {
+            voice.direct[c]->Reset();
+            voice.reverb[c]->Reset();
+        }
+
+        voice.gain      = voice.target;
+        voice.remaining = 0;
+    }
+
+    delayLine->Reset();
+
+    currentArrivals = targetArrivals;
+}
@@ -0,0 +1,219 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFANavigationRenderer.h
+ *   @brief      Real-time rendering of room responses at any listener position
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_NAVIGATION_RENDERER_H__
+#define _SOFA_NAVIGATION_RENDERER_H__
+
+#include "../src/SOFAMultiSpeakerBRIR.h"
+#include "../src/SOFASingleRoomDRIR.h"
+#include "../src/SOFAPositionIndex.h"
+#include "../src/SOFANonUniformConvolver.h"
+#include "../src/SOFAFractionalDelayLine.h"
+#include <map>
+#include <functional>
+
+namespace sofa
+{
+
+    namespace dsp
+    {
+
+        /************************************************************************************/
+        /*!
+         *  @class          NavigationRenderer
+         *  @brief          Real-time rendering of a MultiSpeakerBRIR or SingleRoomDRIR file
+         *                  measured at several listener positions, at any listener position
+         *                  (walk through the room)
+         *
+         *  @details        The measurements closest to the listener position (PositionIndex)
+         *                  are mixed with inverse squared distance weights w. Each IR is split
+         *                  at its onset into :
+         *                  - the direct sound (a few milliseconds from the onset), time-aligned :
+         *                    the direct sounds of the neighbours are summed with the weights w,
+         *                    then delayed by the interpolated arrival time (fractional delay line,
+         *                    Data.Delay included), so that they do not comb ;
+         *                  - the rest of the IR (reverberation) at its original time, summed with
+         *                    the weights sqrt( w ) (incoherent sum, constant energy).
+         *                  The two parts are complementary : at a measured position the IR is
+         *                  rendered as is. Fractional delays are kept in both parts, with the
+         *                  same windowed sinc interpolation (delay line for the direct sound,
+         *                  FractionalDelayLine::ApplyDelay for the reverberation).
+         *                  An arrival shorter than half the interpolator (15 samples) truncates
+         *                  the causal delay line, and is then only rendered approximately.
+         *
+         *                  The weights are applied to the inputs of the convolutions and ramped
+         *                  over one block when the listener moves : a measurement that is no
+         *                  longer a neighbour lets its reverberation ring out, then stops being
+         *                  processed. The convolvers of the least recently used measurements
+         *                  are released beyond the capacity.
+         *                  A MultiSpeakerBRIR is read one measurement at a time (the file shall
+         *                  outlive the renderer) ; the DRIRs of a SingleRoomDRIR are read once.
+         */
+        /************************************************************************************/
+        class SOFA_API NavigationRenderer
+        {
+        public:
+            NavigationRenderer(const sofa::MultiSpeakerBRIR &file,
+                               const unsigned int blockSize,
+                               const unsigned int numNeighbours = 3,
+                               const unsigned long capacity = 8,
+                               const bool useWorkerThread = true,
+                               const unsigned int maxPartitionSize = 16384);
+
+            NavigationRenderer(const sofa::SingleRoomDRIR &file,
+                               const unsigned int blockSize,
+                               const unsigned int numNeighbours = 3,
+                               const unsigned long capacity = 8,
+                               const bool useWorkerThread = true,
+                               const unsigned int maxPartitionSize = 16384);
+
+            ~NavigationRenderer();
+
+            //==============================================================================
+            bool SetListenerPosition(const double position[3]);
+
+            const std::vector< unsigned long > & GetNeighbours() const;
+            const std::vector< double > & GetWeights() const;
+
+            //==============================================================================
+            unsigned int GetBlockSize() const;
+            unsigned long GetNumInputs() const;
+            unsigned long GetNumOutputs() const;
+            unsigned long GetNumDataSamples() const;
+            double GetSamplingRate() const;
+
+            unsigned long GetNumResident() const;
+            unsigned long GetNumActive() const;
+            unsigned long GetCapacity() const;
+            unsigned long GetNumLateJobs() const;
+
+            const sofa::PositionIndex & GetPositionIndex() const;
+
+            //==============================================================================
+            bool Process(float *const *outputs,
+                         const float *const *inputs,
+                         const unsigned int numSamples);
+
+            void Reset();
+
+        private:
+            /// reads the IRs [ R E N ] and Data.Delay [ R E ] of one measurement
+            typedef std::function< bool( const unsigned long measurement,
+                                         std::vector< double > &dataIR,
+                                         std::vector< double > &dataDelay ) > Reader;
+
+            struct Voice
+            {
+                std::vector< std::unique_ptr< sofa::dsp::NonUniformConvolver > > direct;   ///< [ R E ] time-aligned
+                std::vector< std::unique_ptr< sofa::dsp::NonUniformConvolver > > reverb;   ///< [ R E ]
+                std::vector< double > arrivals;         ///< [ R E ] arrival of the direct sound, in samples
+
+                double gain;                            ///< weight at the end of the last block
+                double target;                          ///< weight at the end of the next block
+                unsigned long remaining;                ///< samples left to ring out once out of the mix
+                unsigned long tailLength;               ///< longest filter, in samples
+                unsigned long lastUse;
+
+                bool IsActive() const;
+            };
+
+            void init(const sofa::File &file,
+                      const bool useWorkerThread);
+
+            Voice & acquire(const unsigned long measurement);
+            void update(const double position[3]);
+            void release();
+
+        private:
+            const unsigned int blockSize;
+            const unsigned int numNeighbours;
+            const unsigned long capacity;
+            const unsigned int maxPartitionSize;
+
+            unsigned long numInputs;
+            unsigned long numOutputs;
+            unsigned long numDataSamples;
+            double samplingRate;
+
+            Reader reader;
+            std::vector< double > dataIR;               ///< SingleRoomDRIR only : [ M R N ]
+            std::vector< double > dataDelay;            ///< SingleRoomDRIR only : [ R ] or [ M R ]
+
+            sofa::PositionIndex index;
+
+            /// shall be destroyed after the convolvers
+            std::shared_ptr< sofa::dsp::ConvolutionWorker > worker;
+
+            std::map< unsigned long, Voice > voices;    ///< convolvers in memory, by measurement
+            unsigned long useCounter;
+
+            std::vector< unsigned long > neighbours;
+            std::vector< double > weights;
+
+            std::unique_ptr< sofa::dsp::FractionalDelayLine > delayLine;    ///< [ R E ] direct sounds
+            std::vector< float > currentArrivals;       ///< [ R E ]
+            std::vector< float > targetArrivals;        ///< [ R E ]
+
+            std::vector< float > ramp;                  ///< [ B ]
+            std::vector< float > scratch;               ///< [ B ]
+            std::vector< float > directInput;           ///< [ B ] input weighted for the direct sound
+            std::vector< float > reverbInput;           ///< [ B ] input weighted for the reverberation
+            std::vector< float > directSums;            ///< [ R E B ]
+            std::vector< float > delayed;               ///< [ R E B ]
+            std::vector< const float * > directPointers;
+            std::vector< float * > delayedPointers;
+
+        private:
+            /// avoid shallow and copy constructor
+            SOFA_AVOID_COPY_CONSTRUCTOR( NavigationRenderer );
+        };
+
+    }
+
+}
+
+#endif /* _SOFA_NAVIGATION_RENDERER_H__ */
@@ -50,6 +50,7 @@ http://www.sofaconventions.org
 #include "../src/SOFANcUtils.h"
 #include "../src/SOFAUtils.h"
 #include "../src/SOFAString.h"
+#include <algorithm>
 
 using namespace sofa;
 
@@ -929,9 +930,9 @@ bool NetCDFFile::IsAttributeInt64(const std::string &attributeName) const
 
 /************************************************************************************/
 /*!
- *  @brief          Reads values of variable stored as a 2-dimensional array of double
+ *  @brief          Reads values of variable stored as a 2-dimensional array of double (or float)
  *                  Returns true if everything goes well, false otherwise (not a valid variable,
- *                  not a double variable, not the proper dimensions)
+ *                  not a floating-point variable, not the proper dimensions)
  *  @param[out]     values :
  *  @param[in]      variableName : the named variable to query
  *  @param[in]      dim1 : first dimension of the array
@@ -951,7 +952,7 @@ bool NetCDFFile::GetValues(double *values,
         return false;
     }
     
-    if( sofa::NcUtils::IsDouble( var ) == false )
+    if( sofa::NcUtils::IsFloatingPoint( var ) == false )
     {
         return false;
     }
@@ -969,9 +970,9 @@ bool NetCDFFile::GetValues(double *values,
 
 /************************************************************************************/
 /*!
- *  @brief          Reads values of variable stored as a 3-dimensional array of double
+ *  @brief          Reads values of variable stored as a 3-dimensional array of double (or float)
  *                  Returns true if everything goes well, false otherwise (not a valid variable,
- *                  not a double variable, not the proper dimensions)
+ *                  not a floating-point variable, not the proper dimensions)
  *  @param[out]     values :
  *  @param[in]      variableName : the named variable to query
  *  @param[in]      dim1 : first dimension of the array
@@ -993,7 +994,7 @@ bool NetCDFFile::GetValues(double *values,
         return false;
     }
     
-    if( sofa::NcUtils::IsDouble( var ) == false )
+    if( sofa::NcUtils::IsFloatingPoint( var ) == false )
     {
         return false;
     }
@@ -1010,9 +1011,9 @@ bool NetCDFFile::GetValues(double *values,
 
 /************************************************************************************/
 /*!
- *  @brief          Reads values of variable stored as a 3-dimensional array of double
+ *  @brief          Reads values of variable stored as a 3-dimensional array of double (or float)
  *                  Returns true if everything goes well, false otherwise (not a valid variable,
- *                  not a double variable, not the proper dimensions)
+ *                  not a floating-point variable, not the proper dimensions)
  *  @param[out]     values :
  *  @param[in]      variableName : the named variable to query
  *  @param[in]      dim1 : first dimension of the array
@@ -1036,7 +1037,7 @@ bool NetCDFFile::GetValues(double *values,
         return false;
     }
     
-    if( sofa::NcUtils::IsDouble( var ) == false )
+    if( sofa::NcUtils::IsFloatingPoint( var ) == false )
     {
         return false;
     }
@@ -1054,9 +1055,9 @@ bool NetCDFFile::GetValues(double *values,
 
 /************************************************************************************/
 /*!
- *  @brief          Reads values of named variable stored as a N-dimensional array of double
+ *  @brief          Reads values of named variable stored as a N-dimensional array of double (or float)
  *                  Returns true if everything goes well, false otherwise (not a valid variable,
- *                  not a double variable, not the proper dimensions)
+ *                  not a floating-point variable, not the proper dimensions)
  *  @param[out]     values :
  *  @param[in]      variableName : the named variable to query
  *
@@ -1072,7 +1073,7 @@ bool NetCDFFile::GetValues(std::vector< double > &values,
         return false;
     }
     
-    if( sofa::NcUtils::IsDouble( var ) == false )
+    if( sofa::NcUtils::IsFloatingPoint( var ) == false )
     {
         return false;
     }
@@ -1100,3 +1101,176 @@ bool NetCDFFile::GetValues(std::vector< double > &values,
     return true;
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Checks that a hyperslab lies within the dimensions of a named variable
+ *                  (same rank, and start + count within each dimension)
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *  @param[in]      variableName : the named variable to query
+ *
+ */
+/************************************************************************************/
+bool NetCDFFile::checkHyperslab(const std::vector< std::size_t > &start,
+                                const std::vector< std::size_t > &count,
+                                const std::string &variableName) const
+{
+    std::vector< std::size_t > dims;
+    GetVariableDimensions( dims, variableName );
+    
+    if( dims.size() == 0 || start.size() != dims.size() || count.size() != dims.size() )
+    {
+        return false;
+    }
+    
+    for( std::size_t i = 0; i < dims.size(); i++ )
+    {
+        if( start[i] > dims[i] || count[i] > dims[i] - start[i] )
+        {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads a hyperslab of a named variable stored as a N-dimensional array of double
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a floating-point variable, hyperslab out of the dimensions)
+ *  @param[out]     values : the array must be allocated large enough (product of count)
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *  @param[in]      variableName : the named variable to query
+ *
+ */
+/************************************************************************************/
+bool NetCDFFile::GetValues(double *values,
+                           const std::vector< std::size_t > &start,
+                           const std::vector< std::size_t > &count,
+                           const std::string &variableName) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
+    
+    if( sofa::NcUtils::IsValid( var ) == false )
+    {
+        return false;
+    }
+    
+    if( sofa::NcUtils::IsFloatingPoint( var ) == false )
+    {
+        return false;
+    }
+    
+    if( checkHyperslab( start, count, variableName ) == false )
+    {
+        return false;
+    }
+    
+    if( std::find( count.begin(), count.end(), 0 ) != count.end() )
+    {
+        /// empty hyperslab : nothing to read
+        return true;
+    }
+    
+    var.getVar( start, count, values );
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads values of named variable stored as a N-dimensional array of double or float,
+ *                  into single precision
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a floating-point variable, not the proper dimensions)
+ *  @param[out]     values :
+ *  @param[in]      variableName : the named variable to query
+ *
+ */
+/************************************************************************************/
+bool NetCDFFile::GetValues(std::vector< float > &values,
+                           const std::string &variableName) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
+    
+    if( sofa::NcUtils::IsValid( var ) == false )
+    {
+        return false;
+    }
+    
+    if( sofa::NcUtils::IsFloatingPoint( var ) == false )
+    {
+        return false;
+    }
+    
+    std::vector< std::size_t > dims;
+    GetVariableDimensions( dims, variableName );
+    
+    if( dims.size() == 0 )
+    {
+        return false;
+    }
+    
+    std::size_t totalSize = dims[0];
+    for( std::size_t i = 1; i < dims.size(); i++ )
+    {
+        totalSize *= dims[i];
+    }
+    
+    values.resize( totalSize );
+    
+    SOFA_ASSERT( totalSize > 0 );
+    
+    var.getVar( &values[0] );
+    
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads a hyperslab of a named variable stored as a N-dimensional array of double
+ *                  or float, into single precision
+ *                  Returns true if everything goes well, false otherwise (not a valid variable,
+ *                  not a floating-point variable, hyperslab out of the dimensions)
+ *  @param[out]     values : the array must be allocated large enough (product of count)
+ *  @param[in]      start : index of the first element along each dimension
+ *  @param[in]      count : number of elements along each dimension
+ *  @param[in]      variableName : the named variable to query
+ *
+ */
+/************************************************************************************/
+bool NetCDFFile::GetValues(float *values,
+                           const std::vector< std::size_t > &start,
+                           const std::vector< std::size_t > &count,
+                           const std::string &variableName) const
+{
+    const netCDF::NcVar var = NetCDFFile::getVariable( variableName );
+    
+    if( sofa::NcUtils::IsValid( var ) == false )
+    {
+        return false;
+    }
+    
+    if( sofa::NcUtils::IsFloatingPoint( var ) == false )
+    {
+        return false;
+    }
+    
+    if( checkHyperslab( start, count, variableName ) == false )
+    {
+        return false;
+    }
+    
+    if( std::find( count.begin(), count.end(), 0 ) != count.end() )
+    {
+        /// empty hyperslab : nothing to read
+        return true;
+    }
+    
+    var.getVar( start, count, values );
+    
+    return true;
+}
+
@@ -180,6 +180,19 @@ namespace sofa
         bool GetValues(std::vector< double > &values,
                        const std::string &variableName) const;
         
+        bool GetValues(double *values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count,
+                       const std::string &variableName) const;
+        
+        bool GetValues(std::vector< float > &values,
+                       const std::string &variableName) const;
+        
+        bool GetValues(float *values,
+                       const std::vector< std::size_t > &start,
+                       const std::vector< std::size_t > &count,
+                       const std::string &variableName) const;
+        
     protected:
         //==============================================================================
         netCDF::NcGroupAtt getAttribute(const std::string &attributeName) const;
@@ -188,6 +201,10 @@ namespace sofa
         
         netCDF::NcVar getVariable(const std::string &variableName) const;
         
+        bool checkHyperslab(const std::vector< std::size_t > &start,
+                            const std::vector< std::size_t > &count,
+                            const std::string &variableName) const;
+        
 
     protected:
         netCDF::NcFile file;
@@ -116,6 +116,20 @@ namespace sofa
             return CheckType( ncStuff, netCDF::NcType::nc_DOUBLE );
         }
         
+        /************************************************************************************/
+        /*!
+         *  @brief          Returns true if a NcVar or NcAtt is of type nc_DOUBLE or nc_FLOAT
+         *                  (data variables may be stored in single precision)
+         *  @param[in]      ncStuff : the stuff to query
+         *
+         */
+        /************************************************************************************/
+        template< typename NetCDFType >
+        bool IsFloatingPoint(const NetCDFType & ncStuff)
+        {
+            return ( IsDouble( ncStuff ) == true || IsFloat( ncStuff ) == true );
+        }
+        
         /************************************************************************************/
         /*!
          *  @brief          Returns true if a NcVar or NcAtt is of type nc_BYTE
@@ -0,0 +1,645 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFANonUniformConvolver.cpp
+ *   @brief      Non-uniform partitioned convolution
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFANonUniformConvolver.h"
+#include "../src/SOFAPartitionedFilterBank.h"
+#include "../src/SOFAFFT.h"
+#include "../src/SOFASimd.h"
+#include "../src/SOFAExceptions.h"
+#include <algorithm>
+#include <chrono>
+
+using namespace sofa;
+using namespace sofa::dsp;
+
+namespace NonUniformConvolverLocal
+{
+    /// ratio between the partition sizes of two consecutive segments
+    const unsigned int kGrowthFactor = 4;
+
+    /// the worker wakes up at least this often, in case a notification was missed
+    const std::chrono::microseconds kPollingPeriod( 500 );
+
+    /// jobs of one segment in flight
+    const unsigned int kNumSlots = 3;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          One uniformly partitioned part of the filter
+ *
+ *  @details        Job j convolves the input samples [ jS (j+1)S [ and produces the output
+ *                  samples [ jS+O (j+1)S+O [, with O >= 2S. Job j+2 is submitted in the callback
+ *                  reading the last block of job j, hence three slots.
+ */
+/************************************************************************************/
+struct NonUniformConvolver::Segment
+{
+    unsigned int size;                          ///< partition size S
+    std::size_t offset;                         ///< first tap O
+    bool synchronous;                           ///< computed in the audio thread
+
+    sofa::dsp::PartitionedFilterBank filter;
+    std::unique_ptr< sofa::dsp::FFT > fft;
+
+    std::vector< float > current;               ///< [ S ] input being collected
+    std::vector< float > previous;              ///< [ S ] previous input block
+    unsigned int fill;
+
+    std::vector< float > frames[ NonUniformConvolverLocal::kNumSlots ];     ///< [ 2S ] input of the jobs
+    std::vector< float > outputs[ NonUniformConvolverLocal::kNumSlots ];    ///< [ S ] output of the jobs
+
+    std::vector< float > spectraRe;             ///< [ P S+1 ] spectra of the last P frames
+    std::vector< float > spectraIm;
+    unsigned int position;
+
+    std::vector< float > accumulatorRe;         ///< [ S+1 ]
+    std::vector< float > accumulatorIm;
+    std::vector< float > time;                  ///< [ 2S ]
+
+    std::atomic< long long > numSubmitted;
+    std::atomic< long long > numProcessed;
+    long long lastMissed;                       ///< last job counted as late, or -1
+
+    Segment()
+    : size( 0 )
+    , offset( 0 )
+    , synchronous( true )
+    , fill( 0 )
+    , position( 0 )
+    , numSubmitted( 0 )
+    , numProcessed( 0 )
+    , lastMissed( -1 )
+    {
+    }
+
+    void clear()
+    {
+        std::fill( current.begin(), current.end(), 0.0f );
+        std::fill( previous.begin(), previous.end(), 0.0f );
+        std::fill( spectraRe.begin(), spectraRe.end(), 0.0f );
+        std::fill( spectraIm.begin(), spectraIm.end(), 0.0f );
+
+        fill        = 0;
+        position    = 0;
+        lastMissed  = -1;
+
+        numSubmitted.store( 0 );
+        numProcessed.store( 0 );
+    }
+};
+
+//==============================================================================
+// ConvolutionWorker
+//==============================================================================
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor : starts the thread
+ *
+ */
+/************************************************************************************/
+ConvolutionWorker::ConvolutionWorker()
+: active( nullptr )
+, running( true )
+{
+    thread = std::thread( &ConvolutionWorker::run, this );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class destructor : stops the thread
+ *
+ */
+/************************************************************************************/
+ConvolutionWorker::~ConvolutionWorker()
+{
+    running.store( false );
+    condition.notify_all();
+
+    if( thread.joinable() == true )
+    {
+        thread.join();
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Adds a convolver to the ones served by the thread
+ *
+ */
+/************************************************************************************/
+void ConvolutionWorker::Register(sofa::dsp::NonUniformConvolver *convolver)
+{
+    std::lock_guard< std::mutex > lock( mutex );
+
+    convolvers.push_back( convolver );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Removes a convolver ; waits for its running job, if any
+ *
+ */
+/************************************************************************************/
+void ConvolutionWorker::Unregister(sofa::dsp::NonUniformConvolver *convolver)
+{
+    std::unique_lock< std::mutex > lock( mutex );
+
+    convolvers.erase( std::remove( convolvers.begin(), convolvers.end(), convolver ), convolvers.end() );
+
+    idle.wait( lock, [this, convolver]() { return active != convolver; } );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Wakes the thread up (does not block)
+ *
+ */
+/************************************************************************************/
+void ConvolutionWorker::Notify()
+{
+    condition.notify_one();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Thread loop : runs the pending job with the earliest deadline
+ *
+ *  @details        The job is chosen under the lock and run without it
+ */
+/************************************************************************************/
+void ConvolutionWorker::run()
+{
+    std::unique_lock< std::mutex > lock( mutex );
+
+    while( running.load() == true )
+    {
+        sofa::dsp::NonUniformConvolver *best = nullptr;
+        std::size_t bestSegment = 0;
+        long long bestDeadline  = 0;
+
+        for( std::size_t i = 0; i < convolvers.size(); i++ )
+        {
+            long long deadline  = 0;
+            std::size_t segment = 0;
+
+            if( convolvers[i]->getPendingJob( deadline, segment ) == true )
+            {
+                if( best == nullptr || deadline < bestDeadline )
+                {
+                    best            = convolvers[i];
+                    bestSegment     = segment;
+                    bestDeadline    = deadline;
+                }
+            }
+        }
+
+        if( best != nullptr )
+        {
+            active = best;
+            lock.unlock();
+
+            best->runJob( bestSegment );
+
+            lock.lock();
+            active = nullptr;
+            idle.notify_all();
+        }
+        else
+        {
+            condition.wait_for( lock, NonUniformConvolverLocal::kPollingPeriod );
+        }
+    }
+}
+
+//==============================================================================
+// NonUniformConvolver
+//==============================================================================
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      filter : the FIR filter
+ *  @param[in]      filterLength_ : number of taps
+ *  @param[in]      blockSize_ : number of samples per call to Process, a power of two
+ *  @param[in]      worker_ : thread computing the tail ; if null, everything is computed
+ *                  in the audio thread
+ *  @param[in]      maxPartitionSize : largest partition size (a power of two)
+ *
+ */
+/************************************************************************************/
+NonUniformConvolver::NonUniformConvolver(const double *filter,
+                                         const std::size_t filterLength_,
+                                         const unsigned int blockSize_,
+                                         const std::shared_ptr< sofa::dsp::ConvolutionWorker > &worker_,
+                                         const unsigned int maxPartitionSize)
+: blockSize( blockSize_ )
+, filterLength( filterLength_ )
+, worker( worker_ )
+, clock( 0 )
+, numLateJobs( 0 )
+{
+    if( sofa::dsp::FFT::IsPowerOfTwo( blockSize ) == false || blockSize < 2 )
+    {
+        SOFA_THROW( "the block size shall be a power of two" );
+    }
+
+    if( filterLength == 0 )
+    {
+        SOFA_THROW( "empty filter" );
+    }
+
+    const unsigned int maxSize = std::max( blockSize, sofa::dsp::FFT::NextPowerOfTwo( maxPartitionSize ) );
+
+    //==============================================================================
+    /// head : partitions of one block up to twice the next partition size
+    std::size_t offset = 0;
+    unsigned int size  = blockSize;
+
+    while( offset < filterLength )
+    {
+        const unsigned int nextSize = std::min( size * NonUniformConvolverLocal::kGrowthFactor, maxSize );
+
+        /// the next segment starts at twice its partition size, unless the size stopped growing
+        std::size_t end = ( nextSize > size ) ? 2 * static_cast< std::size_t >( nextSize ) : filterLength;
+
+        if( end <= offset )
+        {
+            end = filterLength;
+        }
+
+        end = std::min( end, filterLength );
+
+        std::unique_ptr< Segment > segment( new Segment() );
+
+        segment->size           = size;
+        segment->offset         = offset;
+        segment->synchronous    = ( offset == 0 || worker == nullptr );
+
+        segment->filter.Prepare( filter + offset, 1, end - offset, size );
+        segment->fft.reset( new sofa::dsp::FFT( 2 * size ) );
+
+        const std::size_t P = segment->filter.GetNumPartitions();
+        const std::size_t K = segment->filter.GetNumBins();
+
+        segment->current.assign( size, 0.0f );
+        segment->previous.assign( size, 0.0f );
+        for( unsigned int slot = 0; slot < NonUniformConvolverLocal::kNumSlots; slot++ )
+        {
+            segment->frames[ slot ].assign( 2 * size, 0.0f );
+            segment->outputs[ slot ].assign( size, 0.0f );
+        }
+        segment->spectraRe.assign( P * K, 0.0f );
+        segment->spectraIm.assign( P * K, 0.0f );
+        segment->accumulatorRe.assign( K, 0.0f );
+        segment->accumulatorIm.assign( K, 0.0f );
+        segment->time.assign( 2 * size, 0.0f );
+
+        segments.push_back( std::move( segment ) );
+
+        offset  = end;
+        size    = nextSize;
+    }
+
+    if( worker != nullptr )
+    {
+        worker->Register( this );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class destructor
+ *
+ */
+/************************************************************************************/
+NonUniformConvolver::~NonUniformConvolver()
+{
+    if( worker != nullptr )
+    {
+        worker->Unregister( this );
+    }
+}
+
+unsigned int NonUniformConvolver::GetBlockSize() const
+{
+    return blockSize;
+}
+
+std::size_t NonUniformConvolver::GetFilterLength() const
+{
+    return filterLength;
+}
+
+unsigned int NonUniformConvolver::GetNumSegments() const
+{
+    return static_cast< unsigned int >( segments.size() );
+}
+
+unsigned int NonUniformConvolver::GetPartitionSize(const unsigned int segment) const
+{
+    SOFA_ASSERT( segment < segments.size() );
+
+    return segments[ segment ]->size;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Index of the first tap of a segment
+ *
+ */
+/************************************************************************************/
+std::size_t NonUniformConvolver::GetSegmentOffset(const unsigned int segment) const
+{
+    SOFA_ASSERT( segment < segments.size() );
+
+    return segments[ segment ]->offset;
+}
+
+unsigned int NonUniformConvolver::GetNumPartitions(const unsigned int segment) const
+{
+    SOFA_ASSERT( segment < segments.size() );
+
+    return segments[ segment ]->filter.GetNumPartitions();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Number of jobs the worker did not complete before their deadline
+ *                  (the last completed job of the segment was output instead)
+ *
+ */
+/************************************************************************************/
+unsigned long NonUniformConvolver::GetNumLateJobs() const
+{
+    return numLateJobs.load();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the pending job of the worker segments with the earliest deadline
+ *
+ */
+/************************************************************************************/
+bool NonUniformConvolver::getPendingJob(long long &deadline, std::size_t &segment) const
+{
+    bool found = false;
+
+    for( std::size_t s = 0; s < segments.size(); s++ )
+    {
+        const Segment &seg = *segments[s];
+
+        if( seg.synchronous == true )
+        {
+            continue;
+        }
+
+        const long long job = seg.numProcessed.load( std::memory_order_relaxed );
+
+        if( job < seg.numSubmitted.load( std::memory_order_acquire ) )
+        {
+            const long long jobDeadline = job * seg.size + static_cast< long long >( seg.offset );
+
+            if( found == false || jobDeadline < deadline )
+            {
+                deadline    = jobDeadline;
+                segment     = s;
+                found       = true;
+            }
+        }
+    }
+
+    return found;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the next job of a segment
+ *
+ */
+/************************************************************************************/
+void NonUniformConvolver::runJob(const std::size_t segment)
+{
+    Segment &seg = *segments[ segment ];
+
+    const long long job     = seg.numProcessed.load( std::memory_order_relaxed );
+    const unsigned int slot = static_cast< unsigned int >( job % NonUniformConvolverLocal::kNumSlots );
+
+    const unsigned int S = seg.size;
+    const unsigned int P = seg.filter.GetNumPartitions();
+    const unsigned int K = seg.filter.GetNumBins();
+
+    seg.position = ( seg.position + 1 ) % P;
+
+    seg.fft->Forward( &seg.spectraRe[ seg.position * K ], &seg.spectraIm[ seg.position * K ], &seg.frames[ slot ][0] );
+
+    std::fill( seg.accumulatorRe.begin(), seg.accumulatorRe.end(), 0.0f );
+    std::fill( seg.accumulatorIm.begin(), seg.accumulatorIm.end(), 0.0f );
+
+    for( unsigned int p = 0; p < P; p++ )
+    {
+        const unsigned int index = ( seg.position + P - p ) % P;
+
+        sofa::Simd::ComplexMultiplyAccumulate( &seg.accumulatorRe[0],
+                                               &seg.accumulatorIm[0],
+                                               &seg.spectraRe[ index * K ],
+                                               &seg.spectraIm[ index * K ],
+                                               seg.filter.GetRe( 0, p ),
+                                               seg.filter.GetIm( 0, p ),
+                                               K );
+    }
+
+    seg.fft->Inverse( &seg.time[0], &seg.accumulatorRe[0], &seg.accumulatorIm[0] );
+
+    std::copy( seg.time.begin() + S, seg.time.end(), seg.outputs[ slot ].begin() );
+
+    seg.numProcessed.store( job + 1, std::memory_order_release );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Processes one block
+ *  @param[out]     output : numSamples samples
+ *  @param[in]      input : numSamples samples
+ *  @param[in]      numSamples : shall be equal to the block size
+ *  @return         false if numSamples differs from the block size (nothing is done)
+ *
+ */
+/************************************************************************************/
+bool NonUniformConvolver::Process(float *output,
+                                  const float *input,
+                                  const unsigned int numSamples)
+{
+    if( numSamples != blockSize )
+    {
+        SOFA_ASSERT( false );
+        return false;
+    }
+
+    const unsigned int B = blockSize;
+    bool submitted = false;
+
+    //==============================================================================
+    /// collect the input ; submit the segments whose block is complete
+    for( std::size_t s = 0; s < segments.size(); s++ )
+    {
+        Segment &seg = *segments[s];
+
+        std::copy( input, input + B, seg.current.begin() + seg.fill );
+        seg.fill += B;
+
+        if( seg.fill < seg.size )
+        {
+            continue;
+        }
+
+        const long long job     = seg.numSubmitted.load( std::memory_order_relaxed );
+        std::vector< float > &frame = seg.frames[ job % NonUniformConvolverLocal::kNumSlots ];
+
+        /// the slot is still used by a late job : this job will be computed on stale input
+        if( job - seg.numProcessed.load( std::memory_order_acquire ) < NonUniformConvolverLocal::kNumSlots )
+        {
+            std::copy( seg.previous.begin(), seg.previous.end(), frame.begin() );
+            std::copy( seg.current.begin(), seg.current.end(), frame.begin() + seg.size );
+        }
+
+        seg.previous.swap( seg.current );
+        seg.fill = 0;
+
+        seg.numSubmitted.store( job + 1, std::memory_order_release );
+
+        if( seg.synchronous == true )
+        {
+            runJob( s );
+        }
+        else
+        {
+            submitted = true;
+        }
+    }
+
+    if( submitted == true )
+    {
+        worker->Notify();
+    }
+
+    //==============================================================================
+    /// sum the outputs available for this block
+    std::fill( output, output + B, 0.0f );
+
+    for( std::size_t s = 0; s < segments.size(); s++ )
+    {
+        Segment &seg = *segments[s];
+
+        const long long relative = clock - static_cast< long long >( seg.offset );
+
+        if( relative < 0 )
+        {
+            continue;
+        }
+
+        long long job                   = relative / seg.size;
+        const unsigned int position     = static_cast< unsigned int >( relative % seg.size );
+
+        const long long numProcessed = seg.numProcessed.load( std::memory_order_acquire );
+
+        /// missed deadline : do not wait, output the last completed job again
+        if( numProcessed <= job )
+        {
+            if( seg.lastMissed != job )
+            {
+                seg.lastMissed = job;
+                numLateJobs++;
+            }
+
+            worker->Notify();
+
+            if( numProcessed == 0 )
+            {
+                continue;
+            }
+
+            job = numProcessed - 1;
+        }
+
+        sofa::Simd::MultiplyAccumulate( output, &seg.outputs[ job % NonUniformConvolverLocal::kNumSlots ][ position ], 1.0f, B );
+    }
+
+    clock += B;
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Clears the state of the convolution
+ *
+ *  @details        Shall not be called concurrently with Process
+ */
+/************************************************************************************/
+void NonUniformConvolver::Reset()
+{
+    /// let the worker finish the submitted jobs
+    for( std::size_t s = 0; s < segments.size(); s++ )
+    {
+        Segment &seg = *segments[s];
+
+        while( seg.numProcessed.load( std::memory_order_acquire ) < seg.numSubmitted.load( std::memory_order_acquire ) )
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    for( std::size_t s = 0; s < segments.size(); s++ )
+    {
+        segments[s]->clear();
+    }
+
+    clock = 0;
+    numLateJobs.store( 0 );
+}
@@ -0,0 +1,185 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFANonUniformConvolver.h
+ *   @brief      Non-uniform partitioned convolution
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_NON_UNIFORM_CONVOLVER_H__
+#define _SOFA_NON_UNIFORM_CONVOLVER_H__
+
+#include "../src/SOFAPlatform.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace sofa
+{
+
+    namespace dsp
+    {
+
+        class NonUniformConvolver;
+
+        /************************************************************************************/
+        /*!
+         *  @class          ConvolutionWorker
+         *  @brief          Background thread computing the tail partitions of NonUniformConvolver
+         *
+         *  @details        Pending jobs are run earliest deadline first. A deadline is the
+         *                  sample index at which the result is needed, so one worker shall
+         *                  be shared by convolvers processed in lockstep (e.g. all the
+         *                  channels of a renderer). The audio thread never takes a lock :
+         *                  it only publishes jobs and wakes the worker up. The lock of the
+         *                  worker protects the list of convolvers only : it is released while
+         *                  a job runs, and Unregister waits for the job of its convolver.
+         */
+        /************************************************************************************/
+        class SOFA_API ConvolutionWorker
+        {
+        public:
+            ConvolutionWorker();
+            ~ConvolutionWorker();
+
+            void Register(sofa::dsp::NonUniformConvolver *convolver);
+            void Unregister(sofa::dsp::NonUniformConvolver *convolver);
+
+            void Notify();
+
+        private:
+            void run();
+
+        private:
+            std::vector< sofa::dsp::NonUniformConvolver * > convolvers;
+
+            std::mutex mutex;
+            std::condition_variable condition;
+            std::condition_variable idle;                   ///< signaled when a job ends
+            sofa::dsp::NonUniformConvolver *active;         ///< convolver whose job is running
+            std::atomic< bool > running;
+            std::thread thread;
+
+        private:
+            /// avoid shallow and copy constructor
+            SOFA_AVOID_COPY_CONSTRUCTOR( ConvolutionWorker );
+        };
+
+        /************************************************************************************/
+        /*!
+         *  @class          NonUniformConvolver
+         *  @brief          Zero-latency convolution with long FIR filters
+         *
+         *  @details        The filter is split in segments of growing partition size : the head
+         *                  uses partitions of one block and is computed in the audio thread, so
+         *                  that the output of a block includes the response to that same block.
+         *                  Each following segment uses partitions 4 times larger and starts at
+         *                  twice its partition size, which leaves one partition of time to
+         *                  compute it on the ConvolutionWorker. The partition size stops growing
+         *                  at maxPartitionSize.
+         *
+         *                  Without worker, all the segments are computed in the audio thread,
+         *                  when their input is complete (same output, irregular load).
+         *                  Process does not allocate, nor lock, nor wait : when the worker
+         *                  misses a deadline, the segment outputs its last completed job
+         *                  again and the miss is counted (GetNumLateJobs).
+         */
+        /************************************************************************************/
+        class SOFA_API NonUniformConvolver
+        {
+        public:
+            NonUniformConvolver(const double *filter,
+                                const std::size_t filterLength,
+                                const unsigned int blockSize,
+                                const std::shared_ptr< sofa::dsp::ConvolutionWorker > &worker = std::shared_ptr< sofa::dsp::ConvolutionWorker >(),
+                                const unsigned int maxPartitionSize = 16384);
+            ~NonUniformConvolver();
+
+            //==============================================================================
+            unsigned int GetBlockSize() const;
+            std::size_t GetFilterLength() const;
+
+            unsigned int GetNumSegments() const;
+            unsigned int GetPartitionSize(const unsigned int segment) const;
+            std::size_t GetSegmentOffset(const unsigned int segment) const;
+            unsigned int GetNumPartitions(const unsigned int segment) const;
+
+            unsigned long GetNumLateJobs() const;
+
+            //==============================================================================
+            bool Process(float *output,
+                         const float *input,
+                         const unsigned int numSamples);
+
+            void Reset();
+
+        private:
+            friend class sofa::dsp::ConvolutionWorker;
+
+            struct Segment;
+
+            bool getPendingJob(long long &deadline, std::size_t &segment) const;
+            void runJob(const std::size_t segment);
+
+        private:
+            const unsigned int blockSize;
+            const std::size_t filterLength;
+
+            std::vector< std::unique_ptr< Segment > > segments;
+
+            std::shared_ptr< sofa::dsp::ConvolutionWorker > worker;
+
+            long long clock;                            ///< index of the next input sample
+            std::atomic< unsigned long > numLateJobs;
+
+        private:
+            /// avoid shallow and copy constructor
+            SOFA_AVOID_COPY_CONSTRUCTOR( NonUniformConvolver );
+        };
+
+    }
+
+}
+
+#endif /* _SOFA_NON_UNIFORM_CONVOLVER_H__ */
@@ -0,0 +1,89 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAParallel.cpp
+ *   @brief      Parallel loops
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAParallel.h"
+#include <atomic>
+
+using namespace sofa;
+
+namespace ParallelLocal
+{
+    /// 0 means 'use the number of hardware threads'
+    std::atomic< unsigned int > requestedNumThreads( 0 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the number of threads used by the parallel loops
+ *
+ */
+/************************************************************************************/
+unsigned int sofa::Parallel::GetNumThreads()
+{
+    const unsigned int requested = ParallelLocal::requestedNumThreads.load();
+
+    if( requested > 0 )
+    {
+        return requested;
+    }
+
+    const unsigned int hardware = std::thread::hardware_concurrency();
+
+    return ( hardware > 0 ) ? hardware : 1;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the number of threads used by the parallel loops
+ *  @param[in]      numThreads : 0 restores the default (number of hardware threads)
+ *
+ */
+/************************************************************************************/
+void sofa::Parallel::SetNumThreads(const unsigned int numThreads)
+{
+    ParallelLocal::requestedNumThreads.store( numThreads );
+}
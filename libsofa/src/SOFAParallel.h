@@ -0,0 +1,162 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAParallel.h
+ *   @brief      Parallel loops
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_PARALLEL_H__
+#define _SOFA_PARALLEL_H__
+
+#include "../src/SOFAPlatform.h"
+#include <thread>
+#include <exception>
+
+namespace sofa
+{
+
+    namespace Parallel
+    {
+
+        /************************************************************************************/
+        /*!
+         *  @brief          Returns the number of threads used by the parallel loops
+         *
+         *  @details        Defaults to the number of hardware threads
+         */
+        /************************************************************************************/
+        SOFA_API_FUNC unsigned int GetNumThreads();
+
+        /************************************************************************************/
+        /*!
+         *  @brief          Sets the number of threads used by the parallel loops
+         *  @param[in]      numThreads : 0 restores the default (number of hardware threads),
+         *                  1 runs everything on the calling thread
+         *
+         */
+        /************************************************************************************/
+        SOFA_API_FUNC void SetNumThreads(const unsigned int numThreads);
+
+        /************************************************************************************/
+        /*!
+         *  @brief          Runs function( first, last ) over contiguous chunks of [begin end[
+         *  @param[in]      begin : first index
+         *  @param[in]      end : one past the last index
+         *  @param[in]      function : callable taking ( std::size_t first, std::size_t last )
+         *
+         *  @details        The range is split in at most GetNumThreads() chunks, the last one
+         *                  being processed by the calling thread. The call returns once all the
+         *                  chunks are done. An exception thrown by one of the chunks is
+         *                  rethrown in the calling thread.
+         */
+        /************************************************************************************/
+        template< typename Function >
+        void For(const std::size_t begin, const std::size_t end, Function function)
+        {
+            if( end <= begin )
+            {
+                return;
+            }
+
+            const std::size_t count         = end - begin;
+            const std::size_t numChunks     = ( count < GetNumThreads() ) ? count : GetNumThreads();
+
+            if( numChunks <= 1 )
+            {
+                function( begin, end );
+                return;
+            }
+
+            std::vector< std::thread > threads;
+            std::vector< std::exception_ptr > errors( numChunks );
+
+            threads.reserve( numChunks - 1 );
+
+            for( std::size_t c = 0; c < numChunks; c++ )
+            {
+                const std::size_t first = begin + ( count * c ) / numChunks;
+                const std::size_t last  = begin + ( count * ( c + 1 ) ) / numChunks;
+
+                std::exception_ptr &error = errors[c];
+
+                auto chunk = [ &function, &error, first, last ]()
+                {
+                    try
+                    {
+                        function( first, last );
+                    }
+                    catch( ... )
+                    {
+                        error = std::current_exception();
+                    }
+                };
+
+                if( c + 1 < numChunks )
+                {
+                    threads.push_back( std::thread( chunk ) );
+                }
+                else
+                {
+                    chunk();
+                }
+            }
+
+            for( std::size_t i = 0; i < threads.size(); i++ )
+            {
+                threads[i].join();
+            }
+
+            for( std::size_t c = 0; c < numChunks; c++ )
+            {
+                if( errors[c] )
+                {
+                    std::rethrow_exception( errors[c] );
+                }
+            }
+        }
+
+    }
+
+}
+
+#endif /* _SOFA_PARALLEL_H__ */
@@ -0,0 +1,189 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAPartitionedFilterBank.cpp
+ *   @brief      Frequency-domain partitions of FIR filters
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAPartitionedFilterBank.h"
+#include "../src/SOFAFFT.h"
+#include "../src/SOFAParallel.h"
+#include "../src/SOFAExceptions.h"
+#include <algorithm>
+
+using namespace sofa;
+using namespace sofa::dsp;
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+PartitionedFilterBank::PartitionedFilterBank()
+: numFilters( 0 )
+, blockSize( 0 )
+, numPartitions( 0 )
+, numBins( 0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the partitions of all the filters
+ *  @param[in]      filters : [ numFilters filterLength ]
+ *  @param[in]      numFilters_ : number of filters
+ *  @param[in]      filterLength : number of taps of each filter
+ *  @param[in]      blockSize_ : partition size B, a power of two
+ *
+ *  @details        The filters are processed in parallel
+ */
+/************************************************************************************/
+void PartitionedFilterBank::Prepare(const double *filters,
+                                    const std::size_t numFilters_,
+                                    const std::size_t filterLength,
+                                    const unsigned int blockSize_)
+{
+    if( sofa::dsp::FFT::IsPowerOfTwo( blockSize_ ) == false || blockSize_ < 2 )
+    {
+        SOFA_THROW( "the block size shall be a power of two" );
+        return;
+    }
+
+    if( numFilters_ == 0 || filterLength == 0 )
+    {
+        SOFA_THROW( "no filter" );
+        return;
+    }
+
+    numFilters      = numFilters_;
+    blockSize       = blockSize_;
+    numPartitions   = static_cast< unsigned int >( ( filterLength + blockSize - 1 ) / blockSize );
+    numBins         = blockSize + 1;
+
+    const std::size_t filterSize = static_cast< std::size_t >( numPartitions ) * numBins;
+
+    re.assign( numFilters * filterSize, 0.0f );
+    im.assign( numFilters * filterSize, 0.0f );
+
+    sofa::Parallel::For( 0, numFilters, [ this, filters, filterLength, filterSize ]( const std::size_t first, const std::size_t last )
+    {
+        sofa::dsp::FFT fft( 2 * blockSize );
+
+        std::vector< float > frame( 2 * blockSize );
+
+        for( std::size_t f = first; f < last; f++ )
+        {
+            const double *h = filters + f * filterLength;
+
+            for( unsigned int p = 0; p < numPartitions; p++ )
+            {
+                const std::size_t begin = static_cast< std::size_t >( p ) * blockSize;
+                const std::size_t end   = std::min( filterLength, begin + blockSize );
+
+                std::fill( frame.begin(), frame.end(), 0.0f );
+
+                for( std::size_t n = begin; n < end; n++ )
+                {
+                    frame[ n - begin ] = static_cast< float >( h[n] );
+                }
+
+                const std::size_t offset = f * filterSize + static_cast< std::size_t >( p ) * numBins;
+
+                fft.Forward( &re[ offset ], &im[ offset ], &frame[0] );
+            }
+        }
+    } );
+}
+
+std::size_t PartitionedFilterBank::GetNumFilters() const
+{
+    return numFilters;
+}
+
+unsigned int PartitionedFilterBank::GetBlockSize() const
+{
+    return blockSize;
+}
+
+unsigned int PartitionedFilterBank::GetNumPartitions() const
+{
+    return numPartitions;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Number of bins of each partition, B+1
+ *
+ */
+/************************************************************************************/
+unsigned int PartitionedFilterBank::GetNumBins() const
+{
+    return numBins;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Real parts of the spectrum of one partition of one filter
+ *
+ */
+/************************************************************************************/
+const float * PartitionedFilterBank::GetRe(const std::size_t filter, const unsigned int partition) const
+{
+    SOFA_ASSERT( filter < numFilters && partition < numPartitions );
+
+    return &re[ ( filter * numPartitions + partition ) * numBins ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Imaginary parts of the spectrum of one partition of one filter
+ *
+ */
+/************************************************************************************/
+const float * PartitionedFilterBank::GetIm(const std::size_t filter, const unsigned int partition) const
+{
+    SOFA_ASSERT( filter < numFilters && partition < numPartitions );
+
+    return &im[ ( filter * numPartitions + partition ) * numBins ];
+}
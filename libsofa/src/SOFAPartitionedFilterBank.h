@@ -0,0 +1,108 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAPartitionedFilterBank.h
+ *   @brief      Frequency-domain partitions of FIR filters
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_PARTITIONED_FILTER_BANK_H__
+#define _SOFA_PARTITIONED_FILTER_BANK_H__
+
+#include "../src/SOFAPlatform.h"
+
+namespace sofa
+{
+
+    namespace dsp
+    {
+
+        /************************************************************************************/
+        /*!
+         *  @class          PartitionedFilterBank
+         *  @brief          Frequency-domain partitions of a set of FIR filters
+         *
+         *  @details        Each filter is cut in partitions of B samples ; each partition is
+         *                  zero-padded to 2B samples and transformed, as required by uniformly
+         *                  partitioned overlap-save convolution. The spectra (B+1 bins) are
+         *                  stored in split format, contiguously for each filter.
+         */
+        /************************************************************************************/
+        class SOFA_API PartitionedFilterBank
+        {
+        public:
+            PartitionedFilterBank();
+            ~PartitionedFilterBank() {};
+
+            void Prepare(const double *filters,
+                         const std::size_t numFilters,
+                         const std::size_t filterLength,
+                         const unsigned int blockSize);
+
+            //==============================================================================
+            std::size_t GetNumFilters() const;
+            unsigned int GetBlockSize() const;
+            unsigned int GetNumPartitions() const;
+            unsigned int GetNumBins() const;
+
+            const float * GetRe(const std::size_t filter, const unsigned int partition) const;
+            const float * GetIm(const std::size_t filter, const unsigned int partition) const;
+
+        private:
+            std::size_t numFilters;
+            unsigned int blockSize;
+            unsigned int numPartitions;
+            unsigned int numBins;
+
+            std::vector< float > re;        ///< [ F P B+1 ]
+            std::vector< float > im;        ///< [ F P B+1 ]
+
+        private:
+            /// avoid shallow and copy constructor
+            SOFA_AVOID_COPY_CONSTRUCTOR( PartitionedFilterBank );
+        };
+
+    }
+
+}
+
+#endif /* _SOFA_PARTITIONED_FILTER_BANK_H__ */
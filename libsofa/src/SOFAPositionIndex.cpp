@@ -0,0 +1,223 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAPositionIndex.cpp
+ *   @brief      Index of the listener positions of a set of measurements
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAPositionIndex.h"
+#include "../src/SOFAGeometry.h"
+#include "../src/SOFAExceptions.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+namespace PositionIndexLocal
+{
+    /// a position closer than this (in meters) to a measured one selects it alone
+    const double kCoincidenceThreshold = 1e-9;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+PositionIndex::PositionIndex()
+: numMeasurements( 0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Reads the ListenerPosition variable of a file and builds the index
+ *  @param[in]      file : ListenerPosition is [ I C ] or [ M C ]
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool PositionIndex::Load(const sofa::File &file)
+{
+    const long M = file.GetNumMeasurements();
+
+    sofa::Coordinates::Type coordinates;
+    sofa::Units::Type units;
+
+    std::vector< double > values;
+
+    if( M <= 0
+       || file.GetListenerPosition( coordinates, units ) == false
+       || file.GetListenerPosition( values ) == false )
+    {
+        SOFA_THROW( "invalid 'ListenerPosition' variable" );
+        return false;
+    }
+
+    if( values.size() == 3 )
+    {
+        /// [ I C ] : the same position for all the measurements
+        std::vector< double > expanded( 3 * M );
+        for( long m = 0; m < M; m++ )
+        {
+            std::copy( values.begin(), values.end(), &expanded[ 3 * m ] );
+        }
+        values.swap( expanded );
+    }
+    else if( values.size() != static_cast< std::size_t >( 3 * M ) )
+    {
+        SOFA_THROW( "invalid 'ListenerPosition' dimensions" );
+        return false;
+    }
+
+    std::vector< double > points;
+    sofa::Geometry::ToCartesian( points, values, coordinates );
+
+    index.Build( points );
+
+    positions.swap( points );
+    numMeasurements = static_cast< unsigned long >( M );
+
+    return true;
+}
+
+unsigned long PositionIndex::GetNumMeasurements() const
+{
+    return numMeasurements;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the listener position of one measurement, in cartesian
+ *                  coordinates
+ *
+ */
+/************************************************************************************/
+const double * PositionIndex::GetPosition(const unsigned long measurement) const
+{
+    SOFA_ASSERT( measurement < numMeasurements );
+
+    return &positions[ 3 * measurement ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the measurement whose listener position is the closest to a
+ *                  given position
+ *  @param[in]      position : x y z, in meters (SOFA frame)
+ *
+ */
+/************************************************************************************/
+unsigned long PositionIndex::FindNearest(const double position[3]) const
+{
+    SOFA_ASSERT( numMeasurements > 0 );
+
+    return index.FindNearest( position );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the measurements whose listener positions are the closest to
+ *                  a given position, with inverse squared distance weights
+ *  @param[out]     measurements : closest first
+ *  @param[out]     weights : sum to 1
+ *  @param[in]      position : x y z, in meters (SOFA frame)
+ *  @param[in]      numNeighbours : number of measurements to look for
+ *
+ */
+/************************************************************************************/
+void PositionIndex::FindNearest(std::vector< unsigned long > &measurements,
+                                std::vector< double > &weights,
+                                const double position[3],
+                                const unsigned long numNeighbours) const
+{
+    std::vector< double > distances;
+    index.FindNearest( measurements, distances, position, numNeighbours );
+
+    weights.resize( measurements.size() );
+
+    if( measurements.empty() == true )
+    {
+        return;
+    }
+
+    if( distances[0] < PositionIndexLocal::kCoincidenceThreshold )
+    {
+        measurements.resize( 1 );
+        weights.assign( 1, 1.0 );
+        return;
+    }
+
+    double sum = 0.0;
+
+    for( std::size_t i = 0; i < measurements.size(); i++ )
+    {
+        weights[i] = 1.0 / ( distances[i] * distances[i] );
+        sum += weights[i];
+    }
+
+    for( std::size_t i = 0; i < weights.size(); i++ )
+    {
+        weights[i] /= sum;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the distance (in meters) between the listener position of a
+ *                  measurement and a given position
+ *
+ */
+/************************************************************************************/
+double PositionIndex::GetDistance(const unsigned long measurement,
+                                  const double position[3]) const
+{
+    const double *p = GetPosition( measurement );
+
+    const double dx = p[0] - position[0];
+    const double dy = p[1] - position[1];
+    const double dz = p[2] - position[2];
+
+    return std::sqrt( dx * dx + dy * dy + dz * dz );
+}
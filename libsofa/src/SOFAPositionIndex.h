@@ -0,0 +1,106 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAPositionIndex.h
+ *   @brief      Index of the listener positions of a set of measurements
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_POSITION_INDEX_H__
+#define _SOFA_POSITION_INDEX_H__
+
+#include "../src/SOFAFile.h"
+#include "../src/SOFASpatialIndex.h"
+
+namespace sofa
+{
+
+    /************************************************************************************/
+    /*!
+     *  @class          PositionIndex
+     *  @brief          Maps a listener position to the nearest measured listener positions
+     *
+     *  @details        The ListenerPosition of each measurement ([ I C ] or [ M C ], cartesian
+     *                  or spherical) is stored in a k-d tree, in meters. The neighbours of a
+     *                  position are given with inverse squared distance weights, so that the
+     *                  responses of a room measured at several listener positions can be
+     *                  interpolated anywhere in between.
+     */
+    /************************************************************************************/
+    class SOFA_API PositionIndex
+    {
+    public:
+        PositionIndex();
+        ~PositionIndex() {};
+
+        bool Load(const sofa::File &file);
+
+        //==============================================================================
+        unsigned long GetNumMeasurements() const;
+
+        const double * GetPosition(const unsigned long measurement) const;
+
+        //==============================================================================
+        unsigned long FindNearest(const double position[3]) const;
+
+        void FindNearest(std::vector< unsigned long > &measurements,
+                         std::vector< double > &weights,
+                         const double position[3],
+                         const unsigned long numNeighbours) const;
+
+        double GetDistance(const unsigned long measurement,
+                           const double position[3]) const;
+
+    private:
+        unsigned long numMeasurements;
+
+        std::vector< double > positions;            ///< [ M 3 ] cartesian, in meters
+        sofa::SpatialIndex index;
+
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( PositionIndex );
+    };
+
+}
+
+#endif /* _SOFA_POSITION_INDEX_H__ */
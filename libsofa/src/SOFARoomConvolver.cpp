@@ -0,0 +1,426 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFARoomConvolver.cpp
+ *   @brief      Real-time rendering of room impulse responses
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFARoomConvolver.h"
+#include "../src/SOFAFractionalDelayLine.h"
+#include "../src/SOFASimd.h"
+#include "../src/SOFAExceptions.h"
+#include <cmath>
+#include <algorithm>
+
+using namespace sofa;
+using namespace sofa::dsp;
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      file : the BRIRs, Data.IR [ M R E N ]
+ *  @param[in]      measurement : index of the measurement to render
+ *  @param[in]      blockSize_ : number of samples per call to Process, a power of two
+ *  @param[in]      useWorkerThread : compute the tails in a background thread
+ *  @param[in]      maxPartitionSize : largest partition size of the convolvers
+ *
+ */
+/************************************************************************************/
+RoomConvolver::RoomConvolver(const sofa::MultiSpeakerBRIR &file,
+                             const unsigned long measurement,
+                             const unsigned int blockSize_,
+                             const bool useWorkerThread,
+                             const unsigned int maxPartitionSize)
+: blockSize( blockSize_ )
+, numInputs( 0 )
+, numOutputs( 0 )
+, numDataSamples( 0 )
+, samplingRate( 0.0 )
+, historyPosition( 0 )
+, tailOffset( 0 )
+{
+    std::vector< double > dataIR;
+    std::vector< double > dataDelay;
+
+    if( measurement >= static_cast< unsigned long >( file.GetNumMeasurements() ) )
+    {
+        SOFA_THROW( "invalid measurement" );
+    }
+
+    /// only the slab of this measurement is read
+    if( file.GetDataIR( dataIR, measurement ) == false
+       || file.GetDataDelay( dataDelay, measurement ) == false
+       || file.GetSamplingRate( samplingRate ) == false )
+    {
+        SOFA_THROW( "cannot read the BRIRs" );
+    }
+
+    numOutputs      = file.GetNumReceivers();
+    numInputs       = file.GetNumEmitters();
+    numDataSamples  = file.GetNumDataSamples();
+
+    init( dataIR, dataDelay, 0, 1, useWorkerThread, maxPartitionSize );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      file : the DRIRs, Data.IR [ M R N ]
+ *  @param[in]      measurement : index of the measurement to render
+ *  @param[in]      blockSize_ : number of samples per call to Process, a power of two
+ *  @param[in]      useWorkerThread : compute the tails in a background thread
+ *  @param[in]      maxPartitionSize : largest partition size of the convolvers
+ *
+ */
+/************************************************************************************/
+RoomConvolver::RoomConvolver(const sofa::SingleRoomDRIR &file,
+                             const unsigned long measurement,
+                             const unsigned int blockSize_,
+                             const bool useWorkerThread,
+                             const unsigned int maxPartitionSize)
+: blockSize( blockSize_ )
+, numInputs( 0 )
+, numOutputs( 0 )
+, numDataSamples( 0 )
+, samplingRate( 0.0 )
+, historyPosition( 0 )
+, tailOffset( 0 )
+{
+    std::vector< double > dataIR;
+    std::vector< double > dataDelay;
+
+    if( measurement >= static_cast< unsigned long >( file.GetNumMeasurements() ) )
+    {
+        SOFA_THROW( "invalid measurement" );
+    }
+
+    /// only the slab of this measurement is read
+    if( file.GetDataIR( dataIR, measurement ) == false
+       || file.GetDataDelay( dataDelay, measurement ) == false
+       || file.GetSamplingRate( samplingRate ) == false )
+    {
+        SOFA_THROW( "cannot read the DRIRs" );
+    }
+
+    numOutputs      = file.GetNumReceivers();
+    numInputs       = 1;
+    numDataSamples  = file.GetNumDataSamples();
+
+    init( dataIR, dataDelay, 0, 1, useWorkerThread, maxPartitionSize );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      decomposition : the early parts of the IRs [ M R E ] and the tails [ R ]
+ *  @param[in]      measurement : index of the measurement to render
+ *  @param[in]      blockSize_ : number of samples per call to Process, a power of two
+ *  @param[in]      useWorkerThread : compute the tails in a background thread
+ *  @param[in]      maxPartitionSize : largest partition size of the convolvers
+ *
+ */
+/************************************************************************************/
+RoomConvolver::RoomConvolver(const sofa::EarlyLateDecomposition &decomposition,
+                             const unsigned long measurement,
+                             const unsigned int blockSize_,
+                             const bool useWorkerThread,
+                             const unsigned int maxPartitionSize)
+: blockSize( blockSize_ )
+, numInputs( decomposition.GetNumEmitters() )
+, numOutputs( decomposition.GetNumReceivers() )
+, numDataSamples( decomposition.GetNumDataSamples() )
+, samplingRate( decomposition.GetSamplingRate() )
+, historyPosition( 0 )
+, tailOffset( 0 )
+{
+    if( measurement >= decomposition.GetNumMeasurements() )
+    {
+        SOFA_THROW( "invalid measurement" );
+    }
+
+    if( useWorkerThread == true )
+    {
+        worker = std::make_shared< sofa::dsp::ConvolutionWorker >();
+    }
+
+    for( unsigned long r = 0; r < numOutputs; r++ )
+    {
+        for( unsigned long e = 0; e < numInputs; e++ )
+        {
+            convolvers.emplace_back( new sofa::dsp::NonUniformConvolver( decomposition.GetEarly( measurement, r, e ),
+                                                                        decomposition.GetEarlyLength(),
+                                                                        blockSize, worker, maxPartitionSize ) );
+        }
+    }
+
+    const unsigned long length = decomposition.GetTailLength();
+
+    if( length > 0 )
+    {
+        /// the tails are not padded : their input is delayed by the tail offset
+        tailOffset = decomposition.GetTailOffset();
+
+        for( unsigned long r = 0; r < numOutputs; r++ )
+        {
+            tails.emplace_back( new sofa::dsp::NonUniformConvolver( decomposition.GetTail( r ), length, blockSize, worker, maxPartitionSize ) );
+        }
+    }
+
+    scratch.assign( blockSize, 0.0f );
+    sum.assign( blockSize, 0.0f );
+    history.assign( tailOffset + blockSize, 0.0f );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class destructor
+ *
+ */
+/************************************************************************************/
+RoomConvolver::~RoomConvolver()
+{
+    /// the convolvers unregister from the worker
+    convolvers.clear();
+    tails.clear();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Creates the convolvers of one measurement
+ *  @param[in]      dataIR : [ M R E N ]
+ *  @param[in]      dataDelay : [ R E ] or [ M R E ]
+ *
+ */
+/************************************************************************************/
+void RoomConvolver::init(const std::vector< double > &dataIR,
+                         const std::vector< double > &dataDelay,
+                         const unsigned long measurement,
+                         const unsigned long numMeasurements,
+                         const bool useWorkerThread,
+                         const unsigned int maxPartitionSize)
+{
+    const unsigned long R = numOutputs;
+    const unsigned long E = numInputs;
+    const unsigned long N = numDataSamples;
+
+    if( measurement >= numMeasurements )
+    {
+        SOFA_THROW( "invalid measurement" );
+    }
+
+    if( dataIR.size() != numMeasurements * R * E * N )
+    {
+        SOFA_THROW( "invalid Data.IR dimensions" );
+    }
+
+    const bool delayVaries = ( dataDelay.size() == numMeasurements * R * E );
+
+    if( delayVaries == false && dataDelay.size() != R * E )
+    {
+        SOFA_THROW( "invalid Data.Delay dimensions" );
+    }
+
+    if( useWorkerThread == true )
+    {
+        worker = std::make_shared< sofa::dsp::ConvolutionWorker >();
+    }
+
+    std::vector< double > filter;
+
+    for( unsigned long r = 0; r < R; r++ )
+    {
+        for( unsigned long e = 0; e < E; e++ )
+        {
+            const std::size_t channel = r * E + e;
+            const double delay = dataDelay[ ( delayVaries == true ) ? measurement * R * E + channel : channel ];
+
+            filter.resize( sofa::dsp::FractionalDelayLine::GetDelayedLength( N, delay ) );
+
+            sofa::dsp::FractionalDelayLine::ApplyDelay( &filter[0], filter.size(), &dataIR[ ( measurement * R * E + channel ) * N ], N, delay );
+
+            convolvers.emplace_back( new sofa::dsp::NonUniformConvolver( &filter[0], filter.size(), blockSize, worker, maxPartitionSize ) );
+        }
+    }
+
+    scratch.assign( blockSize, 0.0f );
+}
+
+unsigned int RoomConvolver::GetBlockSize() const
+{
+    return blockSize;
+}
+
+unsigned long RoomConvolver::GetNumInputs() const
+{
+    return numInputs;
+}
+
+unsigned long RoomConvolver::GetNumOutputs() const
+{
+    return numOutputs;
+}
+
+unsigned long RoomConvolver::GetNumDataSamples() const
+{
+    return numDataSamples;
+}
+
+double RoomConvolver::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Total number of jobs that missed their deadline, over all the convolvers
+ *
+ */
+/************************************************************************************/
+unsigned long RoomConvolver::GetNumLateJobs() const
+{
+    unsigned long count = 0;
+
+    for( std::size_t i = 0; i < convolvers.size(); i++ )
+    {
+        count += convolvers[i]->GetNumLateJobs();
+    }
+
+    for( std::size_t i = 0; i < tails.size(); i++ )
+    {
+        count += tails[i]->GetNumLateJobs();
+    }
+
+    return count;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Processes one block
+ *  @param[out]     outputs : one buffer of numSamples samples per receiver
+ *  @param[in]      inputs : one buffer of numSamples samples per emitter
+ *  @param[in]      numSamples : shall be equal to the block size
+ *  @return         false if numSamples differs from the block size
+ *
+ */
+/************************************************************************************/
+bool RoomConvolver::Process(float *const *outputs,
+                            const float *const *inputs,
+                            const unsigned int numSamples)
+{
+    if( numSamples != blockSize )
+    {
+        SOFA_ASSERT( false );
+        return false;
+    }
+
+    for( unsigned long r = 0; r < numOutputs; r++ )
+    {
+        std::fill( outputs[r], outputs[r] + numSamples, 0.0f );
+
+        for( unsigned long e = 0; e < numInputs; e++ )
+        {
+            convolvers[ r * numInputs + e ]->Process( &scratch[0], inputs[e], numSamples );
+
+            sofa::Simd::MultiplyAccumulate( outputs[r], &scratch[0], 1.0f, numSamples );
+        }
+    }
+
+    if( tails.empty() == false )
+    {
+        /// the late reverberation is shared by all the inputs
+        std::fill( sum.begin(), sum.end(), 0.0f );
+
+        for( unsigned long e = 0; e < numInputs; e++ )
+        {
+            sofa::Simd::MultiplyAccumulate( &sum[0], inputs[e], 1.0f, numSamples );
+        }
+
+        if( tailOffset > 0 )
+        {
+            const std::size_t D = history.size();
+
+            for( unsigned int n = 0; n < numSamples; n++ )
+            {
+                history[ ( historyPosition + n ) % D ] = sum[n];
+            }
+
+            for( unsigned int n = 0; n < numSamples; n++ )
+            {
+                sum[n] = history[ ( historyPosition + n + D - tailOffset ) % D ];
+            }
+
+            historyPosition = ( historyPosition + numSamples ) % D;
+        }
+
+        for( unsigned long r = 0; r < numOutputs; r++ )
+        {
+            tails[r]->Process( &scratch[0], &sum[0], numSamples );
+
+            sofa::Simd::MultiplyAccumulate( outputs[r], &scratch[0], 1.0f, numSamples );
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Clears the state of all the convolutions
+ *
+ */
+/************************************************************************************/
+void RoomConvolver::Reset()
+{
+    for( std::size_t i = 0; i < convolvers.size(); i++ )
+    {
+        convolvers[i]->Reset();
+    }
+
+    for( std::size_t i = 0; i < tails.size(); i++ )
+    {
+        tails[i]->Reset();
+    }
+
+    std::fill( history.begin(), history.end(), 0.0f );
+    historyPosition = 0;
+}
@@ -0,0 +1,158 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFARoomConvolver.h
+ *   @brief      Real-time rendering of room impulse responses
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_ROOM_CONVOLVER_H__
+#define _SOFA_ROOM_CONVOLVER_H__
+
+#include "../src/SOFAMultiSpeakerBRIR.h"
+#include "../src/SOFASingleRoomDRIR.h"
+#include "../src/SOFAEarlyLateDecomposition.h"
+#include "../src/SOFANonUniformConvolver.h"
+
+namespace sofa
+{
+
+    namespace dsp
+    {
+
+        /************************************************************************************/
+        /*!
+         *  @class          RoomConvolver
+         *  @brief          Real-time rendering of a measurement of a MultiSpeakerBRIR or
+         *                  SingleRoomDRIR file
+         *
+         *  @details        Each emitter (loudspeaker) of a MultiSpeakerBRIR is an input, and
+         *                  each receiver is an output : output r = sum over e of
+         *                  input e * IR[ m r e ]. A SingleRoomDRIR has a single input.
+         *
+         *                  Each IR is rendered by a NonUniformConvolver (zero latency); the tails
+         *                  of all the IRs are computed by one shared ConvolutionWorker.
+         *                  Data.Delay is included in the filters, fractional delays being
+         *                  interpolated (FractionalDelayLine::ApplyDelay).
+         *
+         *                  Built from an EarlyLateDecomposition, only the early parts are rendered
+         *                  per emitter, and the late reverberation of each receiver is rendered
+         *                  once, for the sum of the inputs delayed by the tail offset (so that the
+         *                  tail convolvers do not process the leading zeros).
+         */
+        /************************************************************************************/
+        class SOFA_API RoomConvolver
+        {
+        public:
+            RoomConvolver(const sofa::MultiSpeakerBRIR &file,
+                          const unsigned long measurement,
+                          const unsigned int blockSize,
+                          const bool useWorkerThread = true,
+                          const unsigned int maxPartitionSize = 16384);
+
+            RoomConvolver(const sofa::SingleRoomDRIR &file,
+                          const unsigned long measurement,
+                          const unsigned int blockSize,
+                          const bool useWorkerThread = true,
+                          const unsigned int maxPartitionSize = 16384);
+
+            RoomConvolver(const sofa::EarlyLateDecomposition &decomposition,
+                          const unsigned long measurement,
+                          const unsigned int blockSize,
+                          const bool useWorkerThread = true,
+                          const unsigned int maxPartitionSize = 16384);
+
+            ~RoomConvolver();
+
+            //==============================================================================
+            unsigned int GetBlockSize() const;
+            unsigned long GetNumInputs() const;
+            unsigned long GetNumOutputs() const;
+            unsigned long GetNumDataSamples() const;
+            double GetSamplingRate() const;
+
+            unsigned long GetNumLateJobs() const;
+
+            //==============================================================================
+            bool Process(float *const *outputs,
+                         const float *const *inputs,
+                         const unsigned int numSamples);
+
+            void Reset();
+
+        private:
+            void init(const std::vector< double > &dataIR,
+                      const std::vector< double > &dataDelay,
+                      const unsigned long measurement,
+                      const unsigned long numMeasurements,
+                      const bool useWorkerThread,
+                      const unsigned int maxPartitionSize);
+
+        private:
+            const unsigned int blockSize;
+            unsigned long numInputs;
+            unsigned long numOutputs;
+            unsigned long numDataSamples;
+            double samplingRate;
+
+            /// shall be destroyed after the convolvers
+            std::shared_ptr< sofa::dsp::ConvolutionWorker > worker;
+
+            std::vector< std::unique_ptr< sofa::dsp::NonUniformConvolver > > convolvers;   ///< [ R E ]
+            std::vector< std::unique_ptr< sofa::dsp::NonUniformConvolver > > tails;        ///< [ R ] shared late reverberation
+
+            std::vector< float > scratch;               ///< [ B ]
+            std::vector< float > sum;                   ///< [ B ] sum of the inputs, fed to the tails
+            std::vector< float > history;               ///< [ offset+B ] circular buffer delaying the sum by the tail offset
+            std::size_t historyPosition;
+            unsigned long tailOffset;                   ///< in samples
+
+        private:
+            /// avoid shallow and copy constructor
+            SOFA_AVOID_COPY_CONSTRUCTOR( RoomConvolver );
+        };
+
+    }
+
+}
+
+#endif /* _SOFA_ROOM_CONVOLVER_H__ */
@@ -0,0 +1,1070 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFASOSConverter.cpp
+ *   @brief      Conversion between FIR data sets and second-order sections
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFASOSConverter.h"
+#include "../src/SOFAMinimumPhase.h"
+#include "../src/SOFALinearAlgebra.h"
+#include "../src/SOFAFileWriter.h"
+#include "../src/SOFAFFT.h"
+#include "../src/SOFAParallel.h"
+#include "../src/SOFADate.h"
+#include "../src/SOFAExceptions.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+using namespace sofa;
+
+namespace SOSConverterLocal
+{
+    typedef std::complex< double > Complex;
+
+    /// coefficients of a section : b0 b1 b2 a0 a1 a2
+    const unsigned int kNumCoefficients = 6;
+
+    /// poles are kept inside this radius
+    const double kMaxPoleRadius = 0.9995;
+
+    /// magnitudes are floored to this fraction of the peak of the target in the
+    /// spectral error (-80 dB), so that deep notches do not dominate
+    const double kErrorFloor = 1e-4;
+
+    /// relative ridge added to the normal equations
+    const double kRegularization = 1e-12;
+
+    /// Durand-Kerner iterations stop when the relative steps fall below this tolerance
+    /// (tighter tolerances are not reached in double precision for the higher orders)
+    const double kRootTolerance = 1e-12;
+
+    const unsigned int kMaxRootIterations = 500;
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Work buffers of one thread
+     *
+     */
+    /************************************************************************************/
+    struct Workspace
+    {
+        sofa::dsp::FFT fft;
+
+        std::vector< float > time;          ///< [ F ]
+        std::vector< float > re;            ///< [ F/2+1 ]
+        std::vector< float > im;
+        std::vector< double > target;       ///< [ F/2+1 ] magnitude of the IR
+        std::vector< double > numerator;    ///< [ F/2+1 ] magnitude of B
+
+        std::vector< double > hf;           ///< [ N ] prefiltered IR
+        std::vector< double > xf;           ///< [ N ] prefiltered impulse
+        std::vector< double > system;       ///< [ N ( 2P+2 ) ] least-squares system
+        std::vector< double > gram;         ///< [ ( 2P+2 )^2 ]
+        std::vector< double > solution;     ///< [ 2P+1 ]
+
+        Workspace(const unsigned int fftSize,
+                  const unsigned long N,
+                  const unsigned int P)
+        : fft( fftSize )
+        , time( fftSize )
+        , re( fftSize / 2 + 1 )
+        , im( fftSize / 2 + 1 )
+        , target( fftSize / 2 + 1 )
+        , numerator( fftSize / 2 + 1 )
+        , hf( N )
+        , xf( N )
+        , system( N * ( 2 * P + 2 ) )
+        , gram( ( 2 * P + 2 ) * ( 2 * P + 2 ) )
+        , solution( 2 * P + 1 )
+        {
+        }
+    };
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Roots of c[0] x^P + c[1] x^(P-1) + ... + c[P] (Durand-Kerner)
+     *
+     */
+    /************************************************************************************/
+    void FindRoots(std::vector< Complex > &roots,
+                   const double *c,
+                   const unsigned int P)
+    {
+        roots.resize( P );
+
+        if( P == 0 )
+        {
+            return;
+        }
+
+        std::vector< double > monic( P + 1 );
+        for( unsigned int i = 0; i <= P; i++ )
+        {
+            monic[i] = c[i] / c[0];
+        }
+
+        const Complex seed( 0.4, 0.9 );
+
+        Complex z( 1.0, 0.0 );
+        for( unsigned int k = 0; k < P; k++ )
+        {
+            roots[k] = z;
+            z *= seed;
+        }
+
+        for( unsigned int iteration = 0; iteration < kMaxRootIterations; iteration++ )
+        {
+            double largestStep = 0.0;
+
+            for( unsigned int k = 0; k < P; k++ )
+            {
+                Complex value( 1.0, 0.0 );
+                for( unsigned int i = 1; i <= P; i++ )
+                {
+                    value = value * roots[k] + monic[i];
+                }
+
+                Complex denominator( 1.0, 0.0 );
+                for( unsigned int j = 0; j < P; j++ )
+                {
+                    if( j != k )
+                    {
+                        denominator *= ( roots[k] - roots[j] );
+                    }
+                }
+
+                if( std::abs( denominator ) == 0.0 )
+                {
+                    denominator = Complex( 1e-12, 0.0 );
+                }
+
+                const Complex step = value / denominator;
+                roots[k] -= step;
+
+                largestStep = std::max( largestStep, std::abs( step ) / std::max( 1.0, std::abs( roots[k] ) ) );
+            }
+
+            if( largestStep < kRootTolerance )
+            {
+                break;
+            }
+        }
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Polynomial 1 + c[1] x^-1 + ... + c[P] x^-P with given roots
+     *
+     */
+    /************************************************************************************/
+    void Expand(double *c,
+                const std::vector< Complex > &roots)
+    {
+        const std::size_t P = roots.size();
+
+        std::vector< Complex > polynomial( P + 1, Complex( 0.0, 0.0 ) );
+        polynomial[0] = 1.0;
+
+        for( std::size_t k = 0; k < P; k++ )
+        {
+            for( std::size_t i = k + 1; i > 0; i-- )
+            {
+                polynomial[i] -= roots[k] * polynomial[ i - 1 ];
+            }
+        }
+
+        for( std::size_t i = 0; i <= P; i++ )
+        {
+            c[i] = polynomial[i].real();
+        }
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Reflects the roots of a monic denominator inside the unit circle
+     *
+     */
+    /************************************************************************************/
+    void Stabilize(double *a,
+                   const unsigned int P)
+    {
+        std::vector< Complex > roots;
+        FindRoots( roots, a, P );
+
+        bool changed = false;
+
+        for( unsigned int k = 0; k < P; k++ )
+        {
+            double radius = std::abs( roots[k] );
+
+            if( radius > 1.0 )
+            {
+                roots[k] = 1.0 / std::conj( roots[k] );
+                radius   = 1.0 / radius;
+                changed  = true;
+            }
+
+            if( radius > kMaxPoleRadius )
+            {
+                roots[k] *= kMaxPoleRadius / radius;
+                changed   = true;
+            }
+        }
+
+        if( changed == true )
+        {
+            Expand( a, roots );
+        }
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          y = x / A, on N samples
+     *
+     */
+    /************************************************************************************/
+    void FilterAllPole(double *y,
+                       const double *x,
+                       const unsigned long N,
+                       const double *a,
+                       const unsigned int P)
+    {
+        for( unsigned long n = 0; n < N; n++ )
+        {
+            double value = x[n];
+
+            const unsigned int K = static_cast< unsigned int >( std::min( static_cast< unsigned long >( P ), n ) );
+            for( unsigned int k = 1; k <= K; k++ )
+            {
+                value -= a[k] * y[ n - k ];
+            }
+
+            y[n] = value;
+        }
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Solves the least-squares problem || system x - target ||, the target
+     *                  being the last column of the system
+     *  @return         false if the normal equations cannot be solved
+     *
+     */
+    /************************************************************************************/
+    bool SolveLeastSquares(double *x,
+                           const unsigned long N,
+                           const std::size_t numUnknowns,
+                           Workspace &w)
+    {
+        const std::size_t C = numUnknowns + 1;
+
+        sofa::LinearAlgebra::Gram( &w.gram[0], &w.system[0], N, C );
+
+        /// A^T A in the first numUnknowns rows / columns, A^T y in the last column
+        std::vector< double > normal( numUnknowns * numUnknowns );
+
+        double trace = 0.0;
+        for( std::size_t i = 0; i < numUnknowns; i++ )
+        {
+            for( std::size_t j = 0; j < numUnknowns; j++ )
+            {
+                normal[ i * numUnknowns + j ] = w.gram[ i * C + j ];
+            }
+            x[i]   = w.gram[ i * C + numUnknowns ];
+            trace += w.gram[ i * C + i ];
+        }
+
+        const double ridge = kRegularization * trace / numUnknowns + 1e-300;
+        for( std::size_t i = 0; i < numUnknowns; i++ )
+        {
+            normal[ i * numUnknowns + i ] += ridge;
+        }
+
+        return sofa::LinearAlgebra::CholeskySolve( &normal[0], x, numUnknowns, 1 );
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Numerator minimizing the output error || h - B / A ||, A being fixed
+     *
+     */
+    /************************************************************************************/
+    bool SolveNumerator(double *b,
+                        const double *h,
+                        const unsigned long N,
+                        const double *a,
+                        const unsigned int P,
+                        Workspace &w)
+    {
+        std::vector< double > impulse( N, 0.0 );
+        impulse[0] = 1.0;
+
+        FilterAllPole( &w.xf[0], &impulse[0], N, a, P );
+
+        const std::size_t C = P + 2;
+
+        for( unsigned long n = 0; n < N; n++ )
+        {
+            double *row = &w.system[ n * C ];
+
+            for( unsigned int k = 0; k <= P; k++ )
+            {
+                row[k] = ( n >= k ) ? w.xf[ n - k ] : 0.0;
+            }
+            row[ P + 1 ] = h[n];
+        }
+
+        return SolveLeastSquares( b, N, P + 1, w );
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Magnitude response of a polynomial in x^-1 on the FFT bins
+     *
+     */
+    /************************************************************************************/
+    void Magnitude(double *magnitude,
+                   const double *c,
+                   const unsigned int length,
+                   Workspace &w)
+    {
+        std::fill( w.time.begin(), w.time.end(), 0.0f );
+        for( unsigned int i = 0; i < length; i++ )
+        {
+            w.time[i] = static_cast< float >( c[i] );
+        }
+
+        w.fft.Forward( &w.re[0], &w.im[0], &w.time[0] );
+
+        const unsigned int K = w.fft.GetNumBins();
+        for( unsigned int k = 0; k < K; k++ )
+        {
+            magnitude[k] = std::hypot( static_cast< double >( w.re[k] ), static_cast< double >( w.im[k] ) );
+        }
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Log-spectral distance between B / A and the target magnitude, in dB
+     *
+     */
+    /************************************************************************************/
+    double SpectralError(const double *b,
+                         const double *a,
+                         const unsigned int P,
+                         Workspace &w)
+    {
+        const unsigned int K = w.fft.GetNumBins();
+
+        Magnitude( &w.numerator[0], b, P + 1, w );
+
+        std::vector< double > denominator( K );
+        Magnitude( &denominator[0], a, P + 1, w );
+
+        const double floor = *std::max_element( w.target.begin(), w.target.end() ) * kErrorFloor;
+
+        if( floor <= 0.0 )
+        {
+            return 0.0;
+        }
+
+        double sum = 0.0;
+        for( unsigned int k = 0; k < K; k++ )
+        {
+            const double model  = ( denominator[k] > 0.0 ) ? w.numerator[k] / denominator[k] : 0.0;
+            const double error  = 20.0 * std::log10( std::max( model, floor ) / std::max( w.target[k], floor ) );
+
+            sum += error * error;
+        }
+
+        return std::sqrt( sum / K );
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Groups roots by (conjugate) pairs into quadratics 1 + c1 x^-1 + c2 x^-2
+     *
+     */
+    /************************************************************************************/
+    void PairRoots(std::vector< double > &quadratics,
+                   std::vector< Complex > roots)
+    {
+        quadratics.clear();
+
+        while( roots.empty() == false )
+        {
+            /// the most complex root first, with its closest conjugate
+            std::size_t i = 0;
+            for( std::size_t k = 1; k < roots.size(); k++ )
+            {
+                if( std::fabs( roots[k].imag() ) > std::fabs( roots[i].imag() ) )
+                {
+                    i = k;
+                }
+            }
+
+            const Complex first = roots[i];
+            roots.erase( roots.begin() + i );
+
+            if( roots.empty() == true )
+            {
+                quadratics.push_back( -first.real() );
+                quadratics.push_back( 0.0 );
+                break;
+            }
+
+            std::size_t j = 0;
+            for( std::size_t k = 1; k < roots.size(); k++ )
+            {
+                if( std::abs( roots[k] - std::conj( first ) ) < std::abs( roots[j] - std::conj( first ) ) )
+                {
+                    j = k;
+                }
+            }
+
+            const Complex second = roots[j];
+            roots.erase( roots.begin() + j );
+
+            quadratics.push_back( -( first + second ).real() );
+            quadratics.push_back( ( first * second ).real() );
+        }
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Factors B / A into Q sections
+     *  @param[out]     sections : Q sections of ( b0 b1 b2 a0 a1 a2 )
+     *
+     */
+    /************************************************************************************/
+    void Factor(double *sections,
+                const double *b,
+                const double *a,
+                const unsigned int Q)
+    {
+        const unsigned int P = 2 * Q;
+
+        std::vector< Complex > poles;
+        FindRoots( poles, a, P );
+
+        /// zeros reflected inside the unit circle : |1 - z x^-1| = |z| |1 - x^-1 / conj( z )|
+        double gain = b[0];
+
+        std::vector< Complex > zeros;
+        if( b[0] != 0.0 )
+        {
+            FindRoots( zeros, b, P );
+
+            for( unsigned int k = 0; k < P; k++ )
+            {
+                const double radius = std::abs( zeros[k] );
+
+                if( radius > 1.0 )
+                {
+                    zeros[k] = 1.0 / std::conj( zeros[k] );
+                    gain    *= radius;
+                }
+            }
+        }
+        else
+        {
+            zeros.assign( P, Complex( 0.0, 0.0 ) );
+        }
+
+        std::vector< double > denominators;
+        std::vector< double > numerators;
+        PairRoots( denominators, poles );
+        PairRoots( numerators, zeros );
+
+        /// the most resonant poles first, each with the closest zeros
+        std::vector< unsigned int > order( Q );
+        for( unsigned int q = 0; q < Q; q++ )
+        {
+            order[q] = q;
+        }
+        std::sort( order.begin(), order.end(), [ & ]( const unsigned int i, const unsigned int j )
+        {
+            return std::fabs( denominators[ 2 * i + 1 ] ) > std::fabs( denominators[ 2 * j + 1 ] );
+        } );
+
+        std::vector< bool > used( Q, false );
+
+        for( unsigned int q = 0; q < Q; q++ )
+        {
+            const double *den = &denominators[ 2 * order[q] ];
+
+            unsigned int best = Q;
+            double distance   = 0.0;
+
+            for( unsigned int z = 0; z < Q; z++ )
+            {
+                if( used[z] == true )
+                {
+                    continue;
+                }
+
+                const double d = std::fabs( numerators[ 2 * z ] - den[0] ) + std::fabs( numerators[ 2 * z + 1 ] - den[1] );
+
+                if( best == Q || d < distance )
+                {
+                    best     = z;
+                    distance = d;
+                }
+            }
+
+            used[ best ] = true;
+
+            const double g  = ( q == 0 ) ? gain : 1.0;
+            double *section = &sections[ q * kNumCoefficients ];
+
+            section[0] = g;
+            section[1] = g * numerators[ 2 * best ];
+            section[2] = g * numerators[ 2 * best + 1 ];
+            section[3] = 1.0;
+            section[4] = den[0];
+            section[5] = den[1];
+        }
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Fits Q sections to one IR (Steiglitz-McBride)
+     *  @return         the log-spectral distance, in dB
+     *
+     */
+    /************************************************************************************/
+    double FitSections(double *sections,
+                       const double *h,
+                       const unsigned long N,
+                       const unsigned int Q,
+                       const unsigned int numIterations,
+                       Workspace &w)
+    {
+        const unsigned int P = 2 * Q;
+
+        Magnitude( &w.target[0], h, static_cast< unsigned int >( N ), w );
+
+        std::vector< double > a( P + 1, 0.0 );
+        std::vector< double > b( P + 1, 0.0 );
+        a[0] = 1.0;
+
+        std::vector< double > bestA( a );
+        std::vector< double > bestB( P + 1, 0.0 );
+        bestB[0] = h[0];
+        double bestError = SpectralError( &bestB[0], &bestA[0], P, w );
+
+        std::vector< double > impulse( N, 0.0 );
+        impulse[0] = 1.0;
+
+        const std::size_t C = 2 * P + 2;
+
+        for( unsigned int iteration = 0; iteration < std::max( 1u, numIterations ); iteration++ )
+        {
+            /// prefiltering by the previous denominator (the first pass is Prony's equation error)
+            FilterAllPole( &w.hf[0], h, N, &a[0], P );
+            FilterAllPole( &w.xf[0], &impulse[0], N, &a[0], P );
+
+            /// hf[n] = - sum a_k hf[n-k] + sum b_k xf[n-k]
+            for( unsigned long n = 0; n < N; n++ )
+            {
+                double *row = &w.system[ n * C ];
+
+                for( unsigned int k = 1; k <= P; k++ )
+                {
+                    row[ k - 1 ] = ( n >= k ) ? -w.hf[ n - k ] : 0.0;
+                }
+                for( unsigned int k = 0; k <= P; k++ )
+                {
+                    row[ P + k ] = ( n >= k ) ? w.xf[ n - k ] : 0.0;
+                }
+                row[ 2 * P + 1 ] = w.hf[n];
+            }
+
+            if( SolveLeastSquares( &w.solution[0], N, 2 * P + 1, w ) == false )
+            {
+                break;
+            }
+
+            for( unsigned int k = 1; k <= P; k++ )
+            {
+                a[k] = w.solution[ k - 1 ];
+            }
+
+            Stabilize( &a[0], P );
+
+            if( SolveNumerator( &b[0], h, N, &a[0], P, w ) == false )
+            {
+                break;
+            }
+
+            const double error = SpectralError( &b[0], &a[0], P, w );
+
+            if( error < bestError )
+            {
+                bestError = error;
+                bestA     = a;
+                bestB     = b;
+            }
+        }
+
+        Factor( sections, &bestB[0], &bestA[0], Q );
+
+        return bestError;
+    }
+}
+
+using namespace SOSConverterLocal;
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+SOSConverter::SOSConverter()
+: numMeasurements( 0 )
+, numReceivers( 0 )
+, numSections( 0 )
+, samplingRate( 0.0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Fits second-order sections to all the IRs of a data set
+ *  @param[in]      dataSet : the IRs and their delays
+ *  @param[in]      numSections_ : number of sections per IR (order 2 * numSections_)
+ *  @param[in]      numIterations : number of Steiglitz-McBride iterations
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SOSConverter::Fit(const sofa::FIRDataSet &dataSet,
+                       const unsigned int numSections_,
+                       const unsigned int numIterations)
+{
+    const unsigned long M = dataSet.GetNumMeasurements();
+    const unsigned long R = dataSet.GetNumReceivers();
+    const unsigned long N = dataSet.GetNumDataSamples();
+    const unsigned int Q  = numSections_;
+
+    if( M == 0 || R == 0 || N == 0 )
+    {
+        SOFA_THROW( "empty data set" );
+        return false;
+    }
+
+    if( Q == 0 || 4 * Q + 1 > N )
+    {
+        SOFA_THROW( "invalid number of sections" );
+        return false;
+    }
+
+    //==============================================================================
+    /// minimum-phase filters plus delays
+    sofa::MinimumPhaseDecomposition decomposition;
+
+    if( decomposition.Compute( dataSet ) == false )
+    {
+        return false;
+    }
+
+    const unsigned long L = decomposition.GetNumDataSamples();
+
+    const unsigned int fftSize = sofa::dsp::FFT::NextPowerOfTwo( static_cast< unsigned int >( std::max( 4 * L, 512ul ) ) );
+
+    std::vector< double > newSections( M * R * Q * kNumCoefficients );
+    std::vector< double > newErrors( M * R );
+
+    sofa::Parallel::For( 0, M * R, [ & ]( const std::size_t first, const std::size_t last )
+    {
+        Workspace workspace( fftSize, L, 2 * Q );
+
+        for( std::size_t i = first; i < last; i++ )
+        {
+            newErrors[i] = FitSections( &newSections[ i * Q * kNumCoefficients ],
+                                        decomposition.GetIR( static_cast< unsigned long >( i / R ), static_cast< unsigned long >( i % R ) ),
+                                        L,
+                                        Q,
+                                        numIterations,
+                                        workspace );
+        }
+    } );
+
+    //==============================================================================
+    numMeasurements = M;
+    numReceivers    = R;
+    numSections     = Q;
+    samplingRate    = dataSet.GetSamplingRate();
+
+    sections.swap( newSections );
+    errors.swap( newErrors );
+
+    delay.resize( M * R );
+    for( unsigned long m = 0; m < M; m++ )
+    {
+        for( unsigned long r = 0; r < R; r++ )
+        {
+            delay[ m * R + r ] = decomposition.GetDelay( m, r );
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes the sections to a new SimpleFreeFieldSOS file
+ *  @param[in]      path : destination
+ *  @param[in]      sourceFile : the file the data set was loaded from
+ *  @param[in]      dataSet : the data set that was fitted
+ *  @return         true on success
+ *
+ *  @details        The metadata of the source file are kept ; Data.IR is replaced by
+ *                  Data.SOS (stored with the same precision), and the convention attributes
+ *                  are updated.
+ */
+/************************************************************************************/
+bool SOSConverter::Write(const std::string &path,
+                         const sofa::File &sourceFile,
+                         const sofa::FIRDataSet &dataSet) const
+{
+    if( sections.empty() == true
+       || dataSet.GetNumMeasurements() != numMeasurements
+       || dataSet.GetNumReceivers() != numReceivers )
+    {
+        return false;
+    }
+
+    std::vector< std::string > dims;
+
+    sofa::FileWriter writer( sourceFile );
+
+    writer.SetDimension( "N", numSections * kNumCoefficients );
+    writer.SetMeasurementOrigins( dataSet.GetOriginalIndices() );
+
+    writer.RemoveVariable( "Data.IR" );
+
+    dims.push_back( "M" );
+    dims.push_back( "R" );
+    writer.SetVariable( "Data.Delay", dims, delay );
+
+    dims.push_back( "N" );
+    writer.SetVariable( "Data.SOS", dims, sections );
+
+    /// single-precision source files give single-precision sections
+    if( sourceFile.HasVariableType( netCDF::NcType::nc_FLOAT, "Data.IR" ) == true )
+    {
+        writer.SetFloatStorage( "Data.SOS" );
+    }
+
+    writer.SetAttribute( sofa::Attributes::GetName( sofa::Attributes::kSOFAConventions ), "SimpleFreeFieldSOS" );
+    writer.SetAttribute( sofa::Attributes::GetName( sofa::Attributes::kSOFAConventionsVersion ), sofa::SimpleFreeFieldSOS::GetConventionVersion() );
+    writer.SetAttribute( sofa::Attributes::GetName( sofa::Attributes::kDataType ), "SOS" );
+    writer.SetAttribute( sofa::Attributes::GetName( sofa::Attributes::kDateModified ), sofa::Date::GetCurrentDate().ToISO8601() );
+
+    return writer.Write( path );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Loads the sections of a SimpleFreeFieldSOS file
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SOSConverter::Load(const sofa::SimpleFreeFieldSOS &file)
+{
+    const long M = file.GetNumMeasurements();
+    const long R = file.GetNumReceivers();
+    const long N = file.GetNumDataSamples();
+
+    if( M <= 0 || R <= 0 || N <= 0 || N % kNumCoefficients != 0 )
+    {
+        SOFA_THROW( "invalid SOFA dimensions" );
+        return false;
+    }
+
+    double fs = 0.0;
+
+    if( file.GetSamplingRate( fs ) == false )
+    {
+        SOFA_THROW( "invalid 'Data.SamplingRate' variable" );
+        return false;
+    }
+
+    std::vector< double > newSections;
+
+    if( file.GetDataSOS( newSections ) == false )
+    {
+        SOFA_THROW( "invalid 'Data.SOS' variable" );
+        return false;
+    }
+
+    std::vector< double > newDelay;
+
+    if( file.GetDataDelay( newDelay ) == false )
+    {
+        SOFA_THROW( "invalid 'Data.Delay' variable" );
+        return false;
+    }
+
+    if( newDelay.size() == static_cast< std::size_t >( R ) )
+    {
+        std::vector< double > expanded( M * R );
+        for( long m = 0; m < M; m++ )
+        {
+            std::copy( newDelay.begin(), newDelay.end(), expanded.begin() + m * R );
+        }
+        newDelay.swap( expanded );
+    }
+    else if( newDelay.size() != static_cast< std::size_t >( M * R ) )
+    {
+        SOFA_THROW( "invalid 'Data.Delay' variable" );
+        return false;
+    }
+
+    //==============================================================================
+    numMeasurements = static_cast< unsigned long >( M );
+    numReceivers    = static_cast< unsigned long >( R );
+    numSections     = static_cast< unsigned int >( N / kNumCoefficients );
+    samplingRate    = fs;
+
+    sections.swap( newSections );
+    delay.swap( newDelay );
+    errors.assign( M * R, 0.0 );
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Renders the impulse responses of all the sections into a data set
+ *  @param[out]     dataSet : Data.IR is the rendered IRs, Data.Delay the delays of the
+ *                  sections, SourcePosition is read from the file
+ *  @param[in]      file : the file whose measurements correspond to the sections (in the
+ *                  same order, i.e. loaded, or fitted to a data set in its original order)
+ *  @param[in]      length : length of the IRs
+ *  @param[in]      ordering : optional reordering of the measurements
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SOSConverter::Render(sofa::FIRDataSet &dataSet,
+                          const sofa::File &file,
+                          const unsigned long length,
+                          const sofa::FIRDataSet::Ordering &ordering) const
+{
+    if( sections.empty() == true || length == 0
+       || file.GetNumMeasurements() != static_cast< long >( numMeasurements )
+       || file.GetNumReceivers() != static_cast< long >( numReceivers ) )
+    {
+        return false;
+    }
+
+    const unsigned long M = numMeasurements;
+    const unsigned long R = numReceivers;
+
+    std::vector< double > ir( M * R * length );
+
+    sofa::Parallel::For( 0, M * R, [ & ]( const std::size_t first, const std::size_t last )
+    {
+        for( std::size_t i = first; i < last; i++ )
+        {
+            Render( &ir[ i * length ], static_cast< unsigned long >( i / R ), static_cast< unsigned long >( i % R ), length );
+        }
+    } );
+
+    if( dataSet.Load( file, ir, length, samplingRate ) == false
+       || dataSet.SetDataDelay( delay ) == false )
+    {
+        return false;
+    }
+
+    dataSet.Reorder( ordering );
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Renders the impulse response of the sections of one measurement
+ *  @param[out]     output : length samples
+ *
+ *  @details        Data.Delay is not applied
+ */
+/************************************************************************************/
+void SOSConverter::Render(double *output,
+                          const unsigned long measurement,
+                          const unsigned long receiver,
+                          const unsigned long length) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers );
+
+    std::fill( output, output + length, 0.0 );
+
+    if( length == 0 )
+    {
+        return;
+    }
+
+    output[0] = 1.0;
+
+    const double *section = GetSections( measurement, receiver );
+
+    /// transposed direct form II, one section after the other
+    for( unsigned int q = 0; q < numSections; q++, section += kNumCoefficients )
+    {
+        const double a0 = section[3];
+
+        if( a0 == 0.0 )
+        {
+            std::fill( output, output + length, 0.0 );
+            return;
+        }
+
+        const double b0 = section[0] / a0;
+        const double b1 = section[1] / a0;
+        const double b2 = section[2] / a0;
+        const double a1 = section[4] / a0;
+        const double a2 = section[5] / a0;
+
+        double s1 = 0.0;
+        double s2 = 0.0;
+
+        for( unsigned long n = 0; n < length; n++ )
+        {
+            const double x = output[n];
+            const double y = b0 * x + s1;
+
+            s1 = b1 * x - a1 * y + s2;
+            s2 = b2 * x - a2 * y;
+
+            output[n] = y;
+        }
+    }
+}
+
+unsigned long SOSConverter::GetNumMeasurements() const
+{
+    return numMeasurements;
+}
+
+unsigned long SOSConverter::GetNumReceivers() const
+{
+    return numReceivers;
+}
+
+unsigned int SOSConverter::GetNumSections() const
+{
+    return numSections;
+}
+
+double SOSConverter::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sections of a measurement and receiver
+ *  @return         Q sections of ( b0 b1 b2 a0 a1 a2 )
+ *
+ */
+/************************************************************************************/
+const double * SOSConverter::GetSections(const unsigned long measurement, const unsigned long receiver) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers );
+
+    return &sections[ ( static_cast< std::size_t >( measurement ) * numReceivers + receiver ) * numSections * kNumCoefficients ];
+}
+
+const std::vector< double > & SOSConverter::GetDataSOS() const
+{
+    return sections;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Delay to apply after the sections, in samples
+ *
+ */
+/************************************************************************************/
+double SOSConverter::GetDelay(const unsigned long measurement, const unsigned long receiver) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers );
+
+    return delay[ static_cast< std::size_t >( measurement ) * numReceivers + receiver ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Log-spectral distance between the sections and the fitted IR, in dB
+ *                  (0 if the sections were loaded from a file)
+ *
+ */
+/************************************************************************************/
+double SOSConverter::GetSpectralError(const unsigned long measurement, const unsigned long receiver) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers );
+
+    return errors[ static_cast< std::size_t >( measurement ) * numReceivers + receiver ];
+}
+
+double SOSConverter::GetMaxSpectralError() const
+{
+    return ( errors.empty() == true ) ? 0.0 : *std::max_element( errors.begin(), errors.end() );
+}
+
+double SOSConverter::GetMeanSpectralError() const
+{
+    double sum = 0.0;
+    for( std::size_t i = 0; i < errors.size(); i++ )
+    {
+        sum += errors[i];
+    }
+
+    return ( errors.empty() == true ) ? 0.0 : sum / errors.size();
+}
@@ -0,0 +1,136 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFASOSConverter.h
+ *   @brief      Conversion between FIR data sets and second-order sections
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_SOS_CONVERTER_H__
+#define _SOFA_SOS_CONVERTER_H__
+
+#include "../src/SOFAFIRDataSet.h"
+#include "../src/SOFASimpleFreeFieldSOS.h"
+
+namespace sofa
+{
+
+    /************************************************************************************/
+    /*!
+     *  @class          SOSConverter
+     *  @brief          Conversion between FIR data sets and second-order sections
+     *
+     *  @details        Fit : the IRs are decomposed into minimum-phase filters plus delays
+     *                  (MinimumPhaseDecomposition), and each minimum-phase filter is fitted by
+     *                  a pole/zero model of order 2Q (Steiglitz-McBride iterations). The poles
+     *                  and zeros are reflected inside the unit circle (the magnitude is kept),
+     *                  and paired into Q sections, the most resonant poles first. The fit is
+     *                  evaluated by the log-spectral distance to the original IR.
+     *
+     *                  Render : the impulse responses of the sections, e.g. those of a
+     *                  SimpleFreeFieldSOS file, are computed (double precision).
+     *
+     *                  The M x R filters are processed in parallel (sofa::Parallel). The
+     *                  sections can be written to a new SimpleFreeFieldSOS file.
+     */
+    /************************************************************************************/
+    class SOFA_API SOSConverter
+    {
+    public:
+        SOSConverter();
+        ~SOSConverter() {};
+
+        //==============================================================================
+        bool Fit(const sofa::FIRDataSet &dataSet,
+                 const unsigned int numSections,
+                 const unsigned int numIterations = 8);
+
+        bool Write(const std::string &path,
+                   const sofa::File &sourceFile,
+                   const sofa::FIRDataSet &dataSet) const;
+
+        //==============================================================================
+        bool Load(const sofa::SimpleFreeFieldSOS &file);
+
+        bool Render(sofa::FIRDataSet &dataSet,
+                    const sofa::File &file,
+                    const unsigned long length,
+                    const sofa::FIRDataSet::Ordering &ordering = sofa::FIRDataSet::kOriginalOrder) const;
+
+        void Render(double *output,
+                    const unsigned long measurement,
+                    const unsigned long receiver,
+                    const unsigned long length) const;
+
+        //==============================================================================
+        unsigned long GetNumMeasurements() const;
+        unsigned long GetNumReceivers() const;
+        unsigned int GetNumSections() const;
+        double GetSamplingRate() const;
+
+        const double * GetSections(const unsigned long measurement, const unsigned long receiver) const;
+        const std::vector< double > & GetDataSOS() const;
+
+        double GetDelay(const unsigned long measurement, const unsigned long receiver) const;
+
+        double GetSpectralError(const unsigned long measurement, const unsigned long receiver) const;
+        double GetMaxSpectralError() const;
+        double GetMeanSpectralError() const;
+
+    private:
+        unsigned long numMeasurements;
+        unsigned long numReceivers;
+        unsigned int numSections;
+        double samplingRate;
+
+        std::vector< double > sections;             ///< [ M R Q 6 ] ( b0 b1 b2 a0 a1 a2 )
+        std::vector< double > delay;                ///< [ M R ] in samples
+        std::vector< double > errors;               ///< [ M R ] log-spectral distance, in dB
+
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( SOSConverter );
+    };
+
+}
+
+#endif /* _SOFA_SOS_CONVERTER_H__ */
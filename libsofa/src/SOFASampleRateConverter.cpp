@@ -0,0 +1,635 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFASampleRateConverter.cpp
+ *   @brief      Sample-rate conversion of FIR data sets
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFASampleRateConverter.h"
+#include "../src/SOFAHash.h"
+#include "../src/SOFACache.h"
+#include "../src/SOFAParallel.h"
+#include "../src/SOFAExceptions.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+
+using namespace sofa;
+
+namespace SampleRateConverterLocal
+{
+    /// converted IRs of the 16 most recently used data sets and parameters
+    sofa::Cache< void > cache;
+
+    std::string cacheDirectory;
+    std::mutex directoryMutex;
+
+    /// largest number of phases of the polyphase kernel
+    const unsigned long long kMaxPhases = 4096;
+
+    /// shape of the Kaiser window (about 90 dB of stopband attenuation)
+    const double kKaiserBeta = 8.6;
+
+    const char * const kCacheHeader     = "libsofa-src";
+    const unsigned int kCacheVersion    = 1;
+    const char * const kCacheExtension  = ".srcache";
+
+    const double kPi = 3.14159265358979323846;
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Modified Bessel function of the first kind, order 0 (power series)
+     *
+     */
+    /************************************************************************************/
+    double BesselI0(const double x)
+    {
+        const double y = 0.25 * x * x;
+
+        double term = 1.0;
+        double sum  = 1.0;
+
+        for( unsigned int k = 1; k < 64 && term > 1e-17 * sum; k++ )
+        {
+            term *= y / static_cast< double >( k * k );
+            sum  += term;
+        }
+
+        return sum;
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Returns true if x is a positive integer that fits in 32 bits
+     *
+     */
+    /************************************************************************************/
+    bool IsInteger(const double x)
+    {
+        return ( x >= 1.0 && x < 4294967296.0 && x == std::floor( x ) );
+    }
+
+    unsigned long long GreatestCommonDivisor(unsigned long long a,
+                                             unsigned long long b)
+    {
+        while( b != 0 )
+        {
+            const unsigned long long r = a % b;
+            a = b;
+            b = r;
+        }
+
+        return a;
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Polyphase windowed-sinc kernel
+     *
+     *  @details        Output sample j is at time t = j * sourceRate / targetRate of the input;
+     *                  with base = floor( t ) and phase p = ( t - base ) * P,
+     *                  y[j] = sum_m table[ p T + m ] x[ base - T/2 + 1 + m ]
+     */
+    /************************************************************************************/
+    struct Kernel
+    {
+        unsigned long long numPhases;   ///< P
+        unsigned long long numerator;   ///< exact : t = j * numerator / P
+        double ratio;                   ///< sourceRate / targetRate
+        bool exact;
+
+        unsigned int numTaps;           ///< T
+        std::vector< double > table;    ///< [ P T ]
+
+        Kernel(const double sourceRate,
+               const double targetRate,
+               const unsigned int numZeroCrossings,
+               const double rolloff)
+        : numPhases( kMaxPhases )
+        , numerator( 0 )
+        , ratio( sourceRate / targetRate )
+        , exact( false )
+        , numTaps( 0 )
+        {
+            if( IsInteger( sourceRate ) == true && IsInteger( targetRate ) == true )
+            {
+                const unsigned long long S = static_cast< unsigned long long >( sourceRate );
+                const unsigned long long D = static_cast< unsigned long long >( targetRate );
+                const unsigned long long g = GreatestCommonDivisor( S, D );
+
+                if( D / g <= kMaxPhases )
+                {
+                    exact       = true;
+                    numPhases   = D / g;
+                    numerator   = S / g;
+                }
+            }
+
+            /// cutoff, relative to the Nyquist frequency of the input
+            const double cutoff     = rolloff * std::min( 1.0, targetRate / sourceRate );
+            const double radius     = static_cast< double >( numZeroCrossings ) / cutoff;
+            const unsigned int half = static_cast< unsigned int >( std::ceil( radius ) );
+            const double gain       = ratio * cutoff;
+            const double norm       = 1.0 / BesselI0( kKaiserBeta );
+
+            numTaps = 2 * half;
+
+            table.resize( numPhases * numTaps );
+
+            for( unsigned long long p = 0; p < numPhases; p++ )
+            {
+                const double phase = static_cast< double >( p ) / static_cast< double >( numPhases );
+
+                for( unsigned int m = 0; m < numTaps; m++ )
+                {
+                    const double t = phase + static_cast< double >( half ) - 1.0 - static_cast< double >( m );
+                    const double u = t / radius;
+
+                    double h = 0.0;
+
+                    if( std::abs( u ) < 1.0 )
+                    {
+                        const double x      = kPi * cutoff * t;
+                        const double sinc   = ( x == 0.0 ) ? 1.0 : std::sin( x ) / x;
+                        const double window = BesselI0( kKaiserBeta * std::sqrt( 1.0 - u * u ) ) * norm;
+
+                        h = gain * sinc * window;
+                    }
+
+                    table[ p * numTaps + m ] = h;
+                }
+            }
+        }
+
+        /// input sample and phase of output sample j
+        void Locate(unsigned long &base,
+                    unsigned long long &phase,
+                    const unsigned long j) const
+        {
+            if( exact == true )
+            {
+                const unsigned long long position = static_cast< unsigned long long >( j ) * numerator;
+
+                base    = static_cast< unsigned long >( position / numPhases );
+                phase   = position % numPhases;
+            }
+            else
+            {
+                const double position   = static_cast< double >( j ) * ratio;
+                const double integer    = std::floor( position );
+
+                base    = static_cast< unsigned long >( integer );
+                phase   = static_cast< unsigned long long >( std::floor( ( position - integer ) * static_cast< double >( numPhases ) + 0.5 ) );
+
+                if( phase == numPhases )
+                {
+                    base++;
+                    phase = 0;
+                }
+            }
+        }
+
+        /// x : N samples ; padded : N + T samples of work buffer ; y : length samples
+        void Process(double *y,
+                     const unsigned long length,
+                     const double *x,
+                     const unsigned long N,
+                     std::vector< double > &padded) const
+        {
+            const unsigned int T    = numTaps;
+            const unsigned int half = T / 2;
+
+            std::fill( padded.begin(), padded.end(), 0.0 );
+            std::copy( x, x + N, padded.begin() + half );
+
+            for( unsigned long j = 0; j < length; j++ )
+            {
+                unsigned long base;
+                unsigned long long phase;
+
+                Locate( base, phase, j );
+
+                /// padded[ base + 1 + m ] is x[ base - half + 1 + m ]
+                const double *input = &padded[ base + 1 ];
+                const double *h     = &table[ phase * T ];
+
+                double sum = 0.0;
+
+                for( unsigned int m = 0; m < T; m++ )
+                {
+                    sum += h[m] * input[m];
+                }
+
+                y[j] = sum;
+            }
+        }
+    };
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Path of the cache file of a key (empty if there is no cache directory)
+     *
+     */
+    /************************************************************************************/
+    std::string GetCachePath(const unsigned long long key)
+    {
+        std::lock_guard< std::mutex > lock( directoryMutex );
+
+        if( cacheDirectory.empty() == true )
+        {
+            return "";
+        }
+
+        char name[32];
+        std::snprintf( name, sizeof( name ), "%016llx", key );
+
+        const char last = cacheDirectory[ cacheDirectory.size() - 1 ];
+        const bool separator = ( last == '/' || last == '\\' );
+
+        return cacheDirectory + ( separator == true ? "" : "/" ) + name + kCacheExtension;
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Reads converted IRs from the disk cache
+     *  @return         false if the file does not exist or does not match
+     *
+     */
+    /************************************************************************************/
+    bool ReadCacheFile(std::vector< double > &ir,
+                       const std::string &path,
+                       const unsigned long long key,
+                       const unsigned long long numFilters,
+                       const unsigned long long length)
+    {
+        std::ifstream file( path.c_str(), std::ios::binary );
+
+        if( file.is_open() == false )
+        {
+            return false;
+        }
+
+        std::string header;
+        unsigned int version = 0;
+
+        file >> header >> version;
+        file.get();
+
+        if( file.good() == false || header != kCacheHeader || version != kCacheVersion )
+        {
+            return false;
+        }
+
+        unsigned long long dimensions[3] = { 0, 0, 0 };
+        file.read( reinterpret_cast< char * >( dimensions ), sizeof( dimensions ) );
+
+        if( file.good() == false || dimensions[0] != key || dimensions[1] != numFilters || dimensions[2] != length )
+        {
+            return false;
+        }
+
+        ir.resize( numFilters * length );
+        file.read( reinterpret_cast< char * >( &ir[0] ), ir.size() * sizeof( double ) );
+
+        return file.good();
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Writes converted IRs to the disk cache (through a temporary file,
+     *                  so that a concurrent reader never sees a partial file)
+     *
+     */
+    /************************************************************************************/
+    bool WriteCacheFile(const std::vector< double > &ir,
+                        const std::string &path,
+                        const unsigned long long key,
+                        const unsigned long long numFilters,
+                        const unsigned long long length)
+    {
+        const std::string temporary = path + ".tmp";
+
+        {
+            std::ofstream file( temporary.c_str(), std::ios::binary );
+
+            if( file.is_open() == false )
+            {
+                return false;
+            }
+
+            file << kCacheHeader << " " << kCacheVersion << "\n";
+
+            const unsigned long long dimensions[3] = { key, numFilters, length };
+            file.write( reinterpret_cast< const char * >( dimensions ), sizeof( dimensions ) );
+            file.write( reinterpret_cast< const char * >( &ir[0] ), ir.size() * sizeof( double ) );
+
+            if( file.good() == false )
+            {
+                file.close();
+                std::remove( temporary.c_str() );
+                return false;
+            }
+        }
+
+        std::remove( path.c_str() );
+
+        return ( std::rename( temporary.c_str(), path.c_str() ) == 0 );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+SampleRateConverter::SampleRateConverter()
+: numMeasurements( 0 )
+, numReceivers( 0 )
+, numDataSamples( 0 )
+, samplingRate( 0.0 )
+, fromDiskCache( false )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Converts all the IRs of a data set
+ *  @param[in]      dataSet : the IRs, their delays and sampling rate
+ *  @param[in]      targetSamplingRate : in Hertz
+ *  @param[in]      numZeroCrossings : half-length of the kernel, in zero crossings of the sinc
+ *  @param[in]      rolloff : cutoff of the lowpass, relative to the lower Nyquist frequency
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SampleRateConverter::Compute(const sofa::FIRDataSet &dataSet,
+                                  const double targetSamplingRate,
+                                  const unsigned int numZeroCrossings,
+                                  const double rolloff)
+{
+    const unsigned long M = dataSet.GetNumMeasurements();
+    const unsigned long R = dataSet.GetNumReceivers();
+    const unsigned long N = dataSet.GetNumDataSamples();
+
+    const double sourceSamplingRate = dataSet.GetSamplingRate();
+
+    if( M == 0 || R == 0 || N == 0 )
+    {
+        SOFA_THROW( "empty data set" );
+        return false;
+    }
+
+    if( ( sourceSamplingRate > 0.0 ) == false || ( targetSamplingRate > 0.0 ) == false
+       || numZeroCrossings == 0 || ( rolloff > 0.0 && rolloff <= 1.0 ) == false )
+    {
+        SOFA_THROW( "invalid sample rate conversion parameters" );
+        return false;
+    }
+
+    const double ratio      = targetSamplingRate / sourceSamplingRate;
+    const unsigned long L   = std::max( 1ul, static_cast< unsigned long >( std::ceil( static_cast< double >( N ) * ratio - 1e-9 ) ) );
+
+    //==============================================================================
+    sofa::Hash hash;
+    hash.Add( dataSet.GetDataIR() );
+    hash.Add( static_cast< unsigned long long >( N ) );
+    hash.Add( sourceSamplingRate );
+    hash.Add( targetSamplingRate );
+    hash.Add( static_cast< unsigned long long >( numZeroCrossings ) );
+    hash.Add( rolloff );
+    hash.Add( SampleRateConverterLocal::kKaiserBeta );
+    hash.Add( static_cast< unsigned long long >( SampleRateConverterLocal::kCacheVersion ) );
+
+    const unsigned long long key = hash.GetValue();
+
+    /// checked on each hit of the cache
+    std::vector< double > signature( 8 );
+    signature[0] = static_cast< double >( M );
+    signature[1] = static_cast< double >( R );
+    signature[2] = static_cast< double >( N );
+    signature[3] = static_cast< double >( L );
+    signature[4] = sourceSamplingRate;
+    signature[5] = targetSamplingRate;
+    signature[6] = static_cast< double >( numZeroCrossings );
+    signature[7] = rolloff;
+
+    std::shared_ptr< const Result > cached = std::static_pointer_cast< const Result >( SampleRateConverterLocal::cache.Find( key, signature ) );
+
+    fromDiskCache = false;
+
+    if( cached == nullptr )
+    {
+        const std::string path = SampleRateConverterLocal::GetCachePath( key );
+
+        std::shared_ptr< Result > computed( new Result() );
+
+        if( path.empty() == false
+           && SampleRateConverterLocal::ReadCacheFile( computed->ir, path, key, M * R, L ) == true )
+        {
+            fromDiskCache = true;
+        }
+        else
+        {
+            const SampleRateConverterLocal::Kernel kernel( sourceSamplingRate, targetSamplingRate, numZeroCrossings, rolloff );
+
+            computed->ir.resize( M * R * L );
+
+            sofa::Parallel::For( 0, M * R, [ & ]( const std::size_t first, const std::size_t last )
+            {
+                std::vector< double > padded( N + kernel.numTaps );
+
+                for( std::size_t i = first; i < last; i++ )
+                {
+                    kernel.Process( &computed->ir[ i * L ], L, &dataSet.GetDataIR()[ i * N ], N, padded );
+                }
+            } );
+
+            if( path.empty() == false )
+            {
+                /// a cache that cannot be written is not an error
+                SampleRateConverterLocal::WriteCacheFile( computed->ir, path, key, M * R, L );
+            }
+        }
+
+        SampleRateConverterLocal::cache.Insert( key, signature, computed );
+
+        cached = computed;
+    }
+
+    //==============================================================================
+    numMeasurements = M;
+    numReceivers    = R;
+    numDataSamples  = L;
+    samplingRate    = targetSamplingRate;
+    result          = cached;
+
+    delay.resize( M * R );
+    for( std::size_t i = 0; i < M * R; i++ )
+    {
+        delay[i] = dataSet.GetDataDelay()[i] * ratio;
+    }
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Replaces Data.IR, Data.Delay and the sampling rate of a data set by the
+ *                  converted ones
+ *  @param[in]      dataSet : the data set that was converted (same measurements)
+ *  @return         false if the dimensions do not match
+ *
+ */
+/************************************************************************************/
+bool SampleRateConverter::Apply(sofa::FIRDataSet &dataSet) const
+{
+    if( result == nullptr
+       || dataSet.GetNumMeasurements() != numMeasurements
+       || dataSet.GetNumReceivers() != numReceivers )
+    {
+        return false;
+    }
+
+    return ( dataSet.SetDataIR( result->ir, numDataSamples ) == true
+            && dataSet.SetDataDelay( delay ) == true
+            && dataSet.SetSamplingRate( samplingRate ) == true );
+}
+
+unsigned long SampleRateConverter::GetNumMeasurements() const
+{
+    return numMeasurements;
+}
+
+unsigned long SampleRateConverter::GetNumReceivers() const
+{
+    return numReceivers;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Length of the converted IRs
+ *
+ */
+/************************************************************************************/
+unsigned long SampleRateConverter::GetNumDataSamples() const
+{
+    return numDataSamples;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Target sampling rate, in Hertz
+ *
+ */
+/************************************************************************************/
+double SampleRateConverter::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+const double * SampleRateConverter::GetIR(const unsigned long measurement, const unsigned long receiver) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers );
+
+    return &result->ir[ ( static_cast< std::size_t >( measurement ) * numReceivers + receiver ) * numDataSamples ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Data.Delay at the target sampling rate, in samples
+ *
+ */
+/************************************************************************************/
+double SampleRateConverter::GetDelay(const unsigned long measurement, const unsigned long receiver) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers );
+
+    return delay[ static_cast< std::size_t >( measurement ) * numReceivers + receiver ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if the last call to Compute read the IRs from the disk cache
+ *
+ */
+/************************************************************************************/
+bool SampleRateConverter::IsFromDiskCache() const
+{
+    return fromDiskCache;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Sets the directory of the disk cache
+ *  @param[in]      directory : an existing directory ; empty disables the disk cache
+ *                  (default)
+ *
+ */
+/************************************************************************************/
+void SampleRateConverter::SetCacheDirectory(const std::string &directory)
+{
+    std::lock_guard< std::mutex > lock( SampleRateConverterLocal::directoryMutex );
+
+    SampleRateConverterLocal::cacheDirectory = directory;
+}
+
+std::string SampleRateConverter::GetCacheDirectory()
+{
+    std::lock_guard< std::mutex > lock( SampleRateConverterLocal::directoryMutex );
+
+    return SampleRateConverterLocal::cacheDirectory;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Releases the converted IRs kept in memory (the disk cache is unchanged)
+ *
+ */
+/************************************************************************************/
+void SampleRateConverter::ClearCache()
+{
+    SampleRateConverterLocal::cache.Clear();
+}
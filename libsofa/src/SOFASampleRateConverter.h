@@ -0,0 +1,133 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFASampleRateConverter.h
+ *   @brief      Sample-rate conversion of FIR data sets
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_SAMPLE_RATE_CONVERTER_H__
+#define _SOFA_SAMPLE_RATE_CONVERTER_H__
+
+#include "../src/SOFAFIRDataSet.h"
+#include <memory>
+#include <string>
+
+namespace sofa
+{
+
+    /************************************************************************************/
+    /*!
+     *  @class          SampleRateConverter
+     *  @brief          Conversion of the IRs of a FIR data set to another sampling rate
+     *
+     *  @details        Data.IR is resampled with a polyphase Kaiser-windowed sinc kernel
+     *                  (lowpass at the lower of the two Nyquist frequencies), and Data.Delay
+     *                  is scaled by the ratio of the rates. The IRs are scaled by the inverse
+     *                  ratio, so that the frequency responses are preserved.
+     *
+     *                  When both rates are integers, the kernel has one phase per output sample
+     *                  of a period (e.g. 160 from 44.1 kHz to 48 kHz); otherwise the output
+     *                  times are rounded to 1/4096 of a sample.
+     *
+     *                  The IRs are processed in parallel (sofa::Parallel). The results of the
+     *                  16 most recently used data sets and parameters are kept in memory, and
+     *                  also written to disk if a cache directory is set, so that the conversion
+     *                  of a given set is computed once per deployment.
+     */
+    /************************************************************************************/
+    class SOFA_API SampleRateConverter
+    {
+    public:
+        SampleRateConverter();
+        ~SampleRateConverter() {};
+
+        bool Compute(const sofa::FIRDataSet &dataSet,
+                     const double targetSamplingRate,
+                     const unsigned int numZeroCrossings = 32,
+                     const double rolloff = 0.95);
+
+        bool Apply(sofa::FIRDataSet &dataSet) const;
+
+        //==============================================================================
+        unsigned long GetNumMeasurements() const;
+        unsigned long GetNumReceivers() const;
+        unsigned long GetNumDataSamples() const;
+
+        double GetSamplingRate() const;
+
+        const double * GetIR(const unsigned long measurement, const unsigned long receiver) const;
+
+        double GetDelay(const unsigned long measurement, const unsigned long receiver) const;
+
+        bool IsFromDiskCache() const;
+
+        //==============================================================================
+        static void SetCacheDirectory(const std::string &directory);
+        static std::string GetCacheDirectory();
+
+        static void ClearCache();
+
+    private:
+        struct Result
+        {
+            std::vector< double > ir;               ///< [ M R N' ]
+        };
+
+    private:
+        unsigned long numMeasurements;
+        unsigned long numReceivers;
+        unsigned long numDataSamples;
+        double samplingRate;
+        bool fromDiskCache;
+
+        std::shared_ptr< const Result > result;
+        std::vector< double > delay;                ///< [ M R ] Data.Delay, scaled
+
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( SampleRateConverter );
+    };
+
+}
+
+#endif /* _SOFA_SAMPLE_RATE_CONVERTER_H__ */
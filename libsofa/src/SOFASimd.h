@@ -0,0 +1,341 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFASimd.h
+ *   @brief      SIMD kernels for signal processing
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_SIMD_H__
+#define _SOFA_SIMD_H__
+
+#include "../src/SOFAPlatform.h"
+
+#if defined( __AVX__ )
+    #define SOFA_SIMD_AVX 1
+    #include <immintrin.h>
+    #if defined( __AVX512F__ )
+        #define SOFA_SIMD_AVX512 1
+    #endif
+#elif defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+    #define SOFA_SIMD_SSE 1
+    #include <emmintrin.h>
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+    #define SOFA_SIMD_NEON 1
+    #include <arm_neon.h>
+#endif
+
+namespace sofa
+{
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Vectorized kernels used by the signal processing classes
+     *
+     *  @details        The instruction set is selected at compile time (AVX, SSE2 or NEON,
+     *                  with a scalar fallback ; AVX-512 for the portable Vector kernels).
+     *                  Pointers do not need to be aligned.
+     *                  Complex data are in split format (separate real and imaginary arrays).
+     */
+    /************************************************************************************/
+    namespace Simd
+    {
+
+        /************************************************************************************/
+        /*!
+         *  @brief          Returns the name of the instruction set in use
+         *
+         */
+        /************************************************************************************/
+        inline const char * GetInstructionSet()
+        {
+        #if defined( SOFA_SIMD_AVX512 )
+            return "AVX-512";
+        #elif defined( SOFA_SIMD_AVX )
+            return "AVX";
+        #elif defined( SOFA_SIMD_SSE )
+            return "SSE2";
+        #elif defined( SOFA_SIMD_NEON )
+            return "NEON";
+        #else
+            return "scalar";
+        #endif
+        }
+
+        //==============================================================================
+        /// portable vector of floats, for the kernels written once for all the instruction sets
+    #if defined( SOFA_SIMD_AVX512 )
+        typedef __m512 Vector;
+        const std::size_t kVectorSize = 16;
+
+        inline Vector Load(const float *x)                      { return _mm512_loadu_ps( x ); }
+        inline void Store(float *y, const Vector x)             { _mm512_storeu_ps( y, x ); }
+        inline Vector Set(const float x)                        { return _mm512_set1_ps( x ); }
+        inline Vector Add(const Vector a, const Vector b)       { return _mm512_add_ps( a, b ); }
+        inline Vector Sub(const Vector a, const Vector b)       { return _mm512_sub_ps( a, b ); }
+        inline Vector Mul(const Vector a, const Vector b)       { return _mm512_mul_ps( a, b ); }
+        inline Vector MultiplyAdd(const Vector c, const Vector a, const Vector b)   { return _mm512_fmadd_ps( a, b, c ); }
+        inline Vector Div(const Vector a, const Vector b)       { return _mm512_div_ps( a, b ); }
+        inline Vector Max(const Vector a, const Vector b)       { return _mm512_maskz_max_ps( 0xFFFF, a, b ); }
+    #elif defined( SOFA_SIMD_AVX )
+        typedef __m256 Vector;
+        const std::size_t kVectorSize = 8;
+
+        inline Vector Load(const float *x)                      { return _mm256_loadu_ps( x ); }
+        inline void Store(float *y, const Vector x)             { _mm256_storeu_ps( y, x ); }
+        inline Vector Set(const float x)                        { return _mm256_set1_ps( x ); }
+        inline Vector Add(const Vector a, const Vector b)       { return _mm256_add_ps( a, b ); }
+        inline Vector Sub(const Vector a, const Vector b)       { return _mm256_sub_ps( a, b ); }
+        inline Vector Mul(const Vector a, const Vector b)       { return _mm256_mul_ps( a, b ); }
+    #if defined( __FMA__ )
+        inline Vector MultiplyAdd(const Vector c, const Vector a, const Vector b)   { return _mm256_fmadd_ps( a, b, c ); }
+    #else
+        inline Vector MultiplyAdd(const Vector c, const Vector a, const Vector b)   { return _mm256_add_ps( c, _mm256_mul_ps( a, b ) ); }
+    #endif
+        inline Vector Div(const Vector a, const Vector b)       { return _mm256_div_ps( a, b ); }
+        inline Vector Max(const Vector a, const Vector b)       { return _mm256_max_ps( a, b ); }
+    #elif defined( SOFA_SIMD_SSE )
+        typedef __m128 Vector;
+        const std::size_t kVectorSize = 4;
+
+        inline Vector Load(const float *x)                      { return _mm_loadu_ps( x ); }
+        inline void Store(float *y, const Vector x)             { _mm_storeu_ps( y, x ); }
+        inline Vector Set(const float x)                        { return _mm_set1_ps( x ); }
+        inline Vector Add(const Vector a, const Vector b)       { return _mm_add_ps( a, b ); }
+        inline Vector Sub(const Vector a, const Vector b)       { return _mm_sub_ps( a, b ); }
+        inline Vector Mul(const Vector a, const Vector b)       { return _mm_mul_ps( a, b ); }
+        inline Vector MultiplyAdd(const Vector c, const Vector a, const Vector b)   { return _mm_add_ps( c, _mm_mul_ps( a, b ) ); }
+        inline Vector Div(const Vector a, const Vector b)       { return _mm_div_ps( a, b ); }
+        inline Vector Max(const Vector a, const Vector b)       { return _mm_max_ps( a, b ); }
+    #elif defined( SOFA_SIMD_NEON )
+        typedef float32x4_t Vector;
+        const std::size_t kVectorSize = 4;
+
+        inline Vector Load(const float *x)                      { return vld1q_f32( x ); }
+        inline void Store(float *y, const Vector x)             { vst1q_f32( y, x ); }
+        inline Vector Set(const float x)                        { return vdupq_n_f32( x ); }
+        inline Vector Add(const Vector a, const Vector b)       { return vaddq_f32( a, b ); }
+        inline Vector Sub(const Vector a, const Vector b)       { return vsubq_f32( a, b ); }
+        inline Vector Mul(const Vector a, const Vector b)       { return vmulq_f32( a, b ); }
+        inline Vector MultiplyAdd(const Vector c, const Vector a, const Vector b)   { return vmlaq_f32( c, a, b ); }
+        inline Vector Max(const Vector a, const Vector b)       { return vmaxq_f32( a, b ); }
+    #if defined( __aarch64__ )
+        inline Vector Div(const Vector a, const Vector b)       { return vdivq_f32( a, b ); }
+    #else
+        /// reciprocal estimate refined by two Newton-Raphson steps
+        inline Vector Div(const Vector a, const Vector b)
+        {
+            float32x4_t r = vrecpeq_f32( b );
+            r = vmulq_f32( r, vrecpsq_f32( b, r ) );
+            r = vmulq_f32( r, vrecpsq_f32( b, r ) );
+            return vmulq_f32( a, r );
+        }
+    #endif
+    #else
+        typedef float Vector;
+        const std::size_t kVectorSize = 1;
+
+        inline Vector Load(const float *x)                      { return *x; }
+        inline void Store(float *y, const Vector x)             { *y = x; }
+        inline Vector Set(const float x)                        { return x; }
+        inline Vector Add(const Vector a, const Vector b)       { return a + b; }
+        inline Vector Sub(const Vector a, const Vector b)       { return a - b; }
+        inline Vector Mul(const Vector a, const Vector b)       { return a * b; }
+        inline Vector MultiplyAdd(const Vector c, const Vector a, const Vector b)   { return c + a * b; }
+        inline Vector Div(const Vector a, const Vector b)       { return a / b; }
+        inline Vector Max(const Vector a, const Vector b)       { return ( a > b ) ? a : b; }
+    #endif
+
+        /************************************************************************************/
+        /*!
+         *  @brief          acc += a * b, for complex vectors in split format
+         *
+         */
+        /************************************************************************************/
+        inline void ComplexMultiplyAccumulate(float *accRe,
+                                              float *accIm,
+                                              const float *aRe,
+                                              const float *aIm,
+                                              const float *bRe,
+                                              const float *bIm,
+                                              const std::size_t size)
+        {
+            std::size_t i = 0;
+
+        #if defined( SOFA_SIMD_AVX )
+            for( ; i + 8 <= size; i += 8 )
+            {
+                const __m256 ar = _mm256_loadu_ps( aRe + i );
+                const __m256 ai = _mm256_loadu_ps( aIm + i );
+                const __m256 br = _mm256_loadu_ps( bRe + i );
+                const __m256 bi = _mm256_loadu_ps( bIm + i );
+
+                __m256 re = _mm256_loadu_ps( accRe + i );
+                __m256 im = _mm256_loadu_ps( accIm + i );
+
+            #if defined( __FMA__ )
+                re = _mm256_fmadd_ps( ar, br, re );
+                re = _mm256_fnmadd_ps( ai, bi, re );
+                im = _mm256_fmadd_ps( ar, bi, im );
+                im = _mm256_fmadd_ps( ai, br, im );
+            #else
+                re = _mm256_add_ps( re, _mm256_sub_ps( _mm256_mul_ps( ar, br ), _mm256_mul_ps( ai, bi ) ) );
+                im = _mm256_add_ps( im, _mm256_add_ps( _mm256_mul_ps( ar, bi ), _mm256_mul_ps( ai, br ) ) );
+            #endif
+
+                _mm256_storeu_ps( accRe + i, re );
+                _mm256_storeu_ps( accIm + i, im );
+            }
+        #elif defined( SOFA_SIMD_SSE )
+            for( ; i + 4 <= size; i += 4 )
+            {
+                const __m128 ar = _mm_loadu_ps( aRe + i );
+                const __m128 ai = _mm_loadu_ps( aIm + i );
+                const __m128 br = _mm_loadu_ps( bRe + i );
+                const __m128 bi = _mm_loadu_ps( bIm + i );
+
+                const __m128 re = _mm_add_ps( _mm_loadu_ps( accRe + i ), _mm_sub_ps( _mm_mul_ps( ar, br ), _mm_mul_ps( ai, bi ) ) );
+                const __m128 im = _mm_add_ps( _mm_loadu_ps( accIm + i ), _mm_add_ps( _mm_mul_ps( ar, bi ), _mm_mul_ps( ai, br ) ) );
+
+                _mm_storeu_ps( accRe + i, re );
+                _mm_storeu_ps( accIm + i, im );
+            }
+        #elif defined( SOFA_SIMD_NEON )
+            for( ; i + 4 <= size; i += 4 )
+            {
+                const float32x4_t ar = vld1q_f32( aRe + i );
+                const float32x4_t ai = vld1q_f32( aIm + i );
+                const float32x4_t br = vld1q_f32( bRe + i );
+                const float32x4_t bi = vld1q_f32( bIm + i );
+
+                float32x4_t re = vld1q_f32( accRe + i );
+                float32x4_t im = vld1q_f32( accIm + i );
+
+                re = vmlaq_f32( re, ar, br );
+                re = vmlsq_f32( re, ai, bi );
+                im = vmlaq_f32( im, ar, bi );
+                im = vmlaq_f32( im, ai, br );
+
+                vst1q_f32( accRe + i, re );
+                vst1q_f32( accIm + i, im );
+            }
+        #endif
+
+            for( ; i < size; i++ )
+            {
+                accRe[i] += aRe[i] * bRe[i] - aIm[i] * bIm[i];
+                accIm[i] += aRe[i] * bIm[i] + aIm[i] * bRe[i];
+            }
+        }
+
+        /************************************************************************************/
+        /*!
+         *  @brief          y += gain * x
+         *
+         */
+        /************************************************************************************/
+        inline void MultiplyAccumulate(float *y,
+                                       const float *x,
+                                       const float gain,
+                                       const std::size_t size)
+        {
+            std::size_t i = 0;
+
+        #if defined( SOFA_SIMD_AVX )
+            const __m256 g = _mm256_set1_ps( gain );
+            for( ; i + 8 <= size; i += 8 )
+            {
+                _mm256_storeu_ps( y + i, _mm256_add_ps( _mm256_loadu_ps( y + i ), _mm256_mul_ps( g, _mm256_loadu_ps( x + i ) ) ) );
+            }
+        #elif defined( SOFA_SIMD_SSE )
+            const __m128 g = _mm_set1_ps( gain );
+            for( ; i + 4 <= size; i += 4 )
+            {
+                _mm_storeu_ps( y + i, _mm_add_ps( _mm_loadu_ps( y + i ), _mm_mul_ps( g, _mm_loadu_ps( x + i ) ) ) );
+            }
+        #elif defined( SOFA_SIMD_NEON )
+            const float32x4_t g = vdupq_n_f32( gain );
+            for( ; i + 4 <= size; i += 4 )
+            {
+                vst1q_f32( y + i, vmlaq_f32( vld1q_f32( y + i ), g, vld1q_f32( x + i ) ) );
+            }
+        #endif
+
+            for( ; i < size; i++ )
+            {
+                y[i] += gain * x[i];
+            }
+        }
+
+        /************************************************************************************/
+        /*!
+         *  @brief          y = from + ramp * ( to - from ), e.g. to crossfade two filter outputs
+         *
+         *  @details        y may be the same buffer as from or to
+         */
+        /************************************************************************************/
+        inline void Crossfade(float *y,
+                              const float *from,
+                              const float *to,
+                              const float *ramp,
+                              const std::size_t size)
+        {
+            std::size_t i = 0;
+
+            for( ; i + kVectorSize <= size; i += kVectorSize )
+            {
+                const Vector a = Load( from + i );
+
+                Store( y + i, MultiplyAdd( a, Load( ramp + i ), Sub( Load( to + i ), a ) ) );
+            }
+
+            for( ; i < size; i++ )
+            {
+                y[i] = from[i] + ramp[i] * ( to[i] - from[i] );
+            }
+        }
+
+    }
+
+}
+
+#endif /* _SOFA_SIMD_H__ */
@@ -82,6 +82,7 @@ namespace sofa
         
         //==============================================================================
         bool GetDataIR(std::vector< double > &values) const;
+        bool GetDataIR(std::vector< float > &values) const;
         bool GetDataIR(double *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const;
         
         //==============================================================================
@@ -326,6 +326,21 @@ bool SimpleFreeFieldSOS::GetDataSOS(std::vector< double > &values) const
     return GetDataSOS( &values[0], M, R, N );
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.SOS values in single precision
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleFreeFieldSOS::GetDataSOS(std::vector< float > &values) const
+{
+    /// Data.SOS is [ M R N ]
+    
+    return NetCDFFile::GetValues( values, "Data.SOS" );
+}
+
 /************************************************************************************/
 /*!
  *  @brief          Retrieves the Data.Delay values
@@ -82,6 +82,7 @@ namespace sofa
         
         //==============================================================================
         bool GetDataSOS(std::vector< double > &values) const;
+        bool GetDataSOS(std::vector< float > &values) const;
         bool GetDataSOS(double *values, const unsigned long dim1, const unsigned long dim2, const unsigned long dim3) const;
         
         //==============================================================================
@@ -306,6 +306,21 @@ bool SimpleHeadphoneIR::GetDataIR(std::vector< double > &values) const
     return sofa::File::getDataIR( values );
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values in single precision
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SimpleHeadphoneIR::GetDataIR(std::vector< float > &values) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values );
+}
+
 /************************************************************************************/
 /*!
  *  @brief          Retrieves the Data.Delay values
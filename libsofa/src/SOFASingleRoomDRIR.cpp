@@ -304,6 +304,21 @@ bool SingleRoomDRIR::GetDataIR(std::vector< double > &values) const
     return sofa::File::getDataIR( values );
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values in single precision
+ *  @param[in]      values : the array is resized if needed
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SingleRoomDRIR::GetDataIR(std::vector< float > &values) const
+{
+    /// Data.IR is [ M R N ]
+    
+    return sofa::File::getDataIR( values );
+}
+
 /************************************************************************************/
 /*!
  *  @brief          Retrieves the Data.Delay values
@@ -326,3 +341,120 @@ bool SingleRoomDRIR::GetDataDelay(double *values, const unsigned long dim1, cons
     return sofa::File::getDataDelay( values, dim1, dim2 );
 }
 
+/************************************************************************************/
+/*!
+ *  @brief          Reads the Data.IR values of one measurement
+ *  @param[out]     values : [ R N ], resized if needed
+ *
+ */
+/************************************************************************************/
+template< typename T >
+bool SingleRoomDRIR::getDataIR(std::vector< T > &values,
+                               const unsigned long measurement) const
+{
+    /// Data.IR is [ M R N ]
+    
+    const long M = GetNumMeasurements();
+    const long R = GetNumReceivers();
+    const long N = GetNumDataSamples();
+    
+    if( M <= 0 || R <= 0 || N <= 0 || measurement >= static_cast< unsigned long >( M ) )
+    {
+        return false;
+    }
+    
+    /// same shape checks as the reading of the whole variable
+    if( VariableHasDimensions( M, R, N, "Data.IR" ) == false )
+    {
+        SOFA_THROW( "invalid dimensions for 'Data.IR'" );
+        return false;
+    }
+    
+    std::vector< std::size_t > start( 3, 0 );
+    std::vector< std::size_t > count( 3, 0 );
+    
+    start[0] = measurement;
+    
+    count[0] = 1;
+    count[1] = R;
+    count[2] = N;
+    
+    values.resize( R * N );
+    
+    return NetCDFFile::GetValues( &values[0], start, count, "Data.IR" );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.IR values of one measurement
+ *  @param[in]      values : [ R N ], the array is resized if needed
+ *  @param[in]      measurement : index of the measurement
+ *  @return         true on success
+ *
+ *  @details        Only this measurement is read from the file
+ */
+/************************************************************************************/
+bool SingleRoomDRIR::GetDataIR(std::vector< double > &values,
+                               const unsigned long measurement) const
+{
+    return getDataIR( values, measurement );
+}
+
+bool SingleRoomDRIR::GetDataIR(std::vector< float > &values,
+                               const unsigned long measurement) const
+{
+    return getDataIR( values, measurement );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Retrieves the Data.Delay values of one measurement
+ *  @param[in]      values : [ R ], the array is resized if needed
+ *  @param[in]      measurement : index of the measurement
+ *  @return         true on success
+ *
+ *  @details        Data.Delay can be [ I R ] or [ M R ].
+ *                  An exception is thrown if Data.Delay is missing or has another shape
+ */
+/************************************************************************************/
+bool SingleRoomDRIR::GetDataDelay(std::vector< double > &values,
+                                  const unsigned long measurement) const
+{
+    const long M = GetNumMeasurements();
+    const long R = GetNumReceivers();
+    
+    if( M <= 0 || R <= 0 || measurement >= static_cast< unsigned long >( M ) )
+    {
+        return false;
+    }
+    
+    if( HasVariable( "Data.Delay" ) == false )
+    {
+        SOFA_THROW( "missing Data.Delay variable" );
+        return false;
+    }
+    
+    std::vector< std::size_t > dims;
+    GetVariableDimensions( dims, "Data.Delay" );
+    
+    if( dims.size() != 2
+       || ( dims[0] != 1 && dims[0] != static_cast< std::size_t >( M ) )
+       || dims[1] != static_cast< std::size_t >( R ) )
+    {
+        SOFA_THROW( "invalid Data.Delay dimensions : [ I R ] or [ M R ] expected" );
+        return false;
+    }
+    
+    std::vector< std::size_t > start( 2, 0 );
+    std::vector< std::size_t > count( 2, 0 );
+    
+    start[0] = ( dims[0] == static_cast< std::size_t >( M ) ) ? measurement : 0;
+    
+    count[0] = 1;
+    count[1] = R;
+    
+    values.resize( R );
+    
+    return NetCDFFile::GetValues( &values[0], start, count, "Data.Delay" );
+}
+
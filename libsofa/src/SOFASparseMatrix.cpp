@@ -0,0 +1,206 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFASparseMatrix.cpp
+ *   @brief      Sparse matrix in compressed row storage
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFASparseMatrix.h"
+#include "../src/SOFAParallel.h"
+#include "../src/SOFAExceptions.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      numColumns_ : number of columns
+ *
+ */
+/************************************************************************************/
+SparseMatrix::SparseMatrix(const std::size_t numColumns_)
+{
+    Clear( numColumns_ );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Removes all the rows
+ *  @param[in]      numColumns_ : new number of columns
+ *
+ */
+/************************************************************************************/
+void SparseMatrix::Clear(const std::size_t numColumns_)
+{
+    numColumns = numColumns_;
+
+    rowOffsets.assign( 1, 0 );
+    columns.clear();
+    values.clear();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Appends a row
+ *  @param[in]      columns_ : column of each non-zero entry
+ *  @param[in]      values_ : value of each non-zero entry
+ *
+ */
+/************************************************************************************/
+void SparseMatrix::AddRow(const std::vector< unsigned long > &columns_,
+                          const std::vector< double > &values_)
+{
+    SOFA_ASSERT( columns_.size() == values_.size() );
+
+    for( std::size_t i = 0; i < columns_.size(); i++ )
+    {
+        SOFA_ASSERT( columns_[i] < numColumns );
+
+        if( values_[i] != 0.0 )
+        {
+            columns.push_back( columns_[i] );
+            values.push_back( values_[i] );
+        }
+    }
+
+    rowOffsets.push_back( columns.size() );
+}
+
+std::size_t SparseMatrix::GetNumRows() const
+{
+    return rowOffsets.size() - 1;
+}
+
+std::size_t SparseMatrix::GetNumColumns() const
+{
+    return numColumns;
+}
+
+std::size_t SparseMatrix::GetNumNonZeros() const
+{
+    return values.size();
+}
+
+std::size_t SparseMatrix::GetRowSize(const std::size_t row) const
+{
+    SOFA_ASSERT( row < GetNumRows() );
+
+    return rowOffsets[ row + 1 ] - rowOffsets[ row ];
+}
+
+const unsigned long * SparseMatrix::GetRowColumns(const std::size_t row) const
+{
+    SOFA_ASSERT( row < GetNumRows() );
+
+    return columns.data() + rowOffsets[ row ];
+}
+
+const double * SparseMatrix::GetRowValues(const std::size_t row) const
+{
+    SOFA_ASSERT( row < GetNumRows() );
+
+    return values.data() + rowOffsets[ row ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the column of the entry with the largest magnitude in a row
+ *
+ */
+/************************************************************************************/
+unsigned long SparseMatrix::GetLargestEntry(const std::size_t row) const
+{
+    SOFA_ASSERT( row < GetNumRows() );
+
+    unsigned long column = 0;
+    double largest = -1.0;
+
+    for( std::size_t i = rowOffsets[ row ]; i < rowOffsets[ row + 1 ]; i++ )
+    {
+        if( std::fabs( values[i] ) > largest )
+        {
+            largest = std::fabs( values[i] );
+            column  = columns[i];
+        }
+    }
+
+    return column;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Multiplies a block matrix : output[ i ] = sum_j M[ i j ] input[ j ]
+ *  @param[out]     output : [ rows blockSize ]
+ *  @param[in]      input : [ columns blockSize ]
+ *  @param[in]      blockSize : number of values per row of input / output
+ *
+ *  @details        The rows are split across the threads of sofa::Parallel
+ */
+/************************************************************************************/
+void SparseMatrix::Apply(double *output,
+                         const double *input,
+                         const std::size_t blockSize) const
+{
+    sofa::Parallel::For( 0, GetNumRows(), [ this, output, input, blockSize ]( const std::size_t first, const std::size_t last )
+    {
+        for( std::size_t row = first; row < last; row++ )
+        {
+            double *y = output + row * blockSize;
+
+            std::fill( y, y + blockSize, 0.0 );
+
+            for( std::size_t i = rowOffsets[ row ]; i < rowOffsets[ row + 1 ]; i++ )
+            {
+                const double w  = values[i];
+                const double *x = input + static_cast< std::size_t >( columns[i] ) * blockSize;
+
+                for( std::size_t n = 0; n < blockSize; n++ )
+                {
+                    y[n] += w * x[n];
+                }
+            }
+        }
+    } );
+}
@@ -0,0 +1,102 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFASparseMatrix.h
+ *   @brief      Sparse matrix in compressed row storage
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_SPARSE_MATRIX_H__
+#define _SOFA_SPARSE_MATRIX_H__
+
+#include "../src/SOFAPlatform.h"
+
+namespace sofa
+{
+
+    /************************************************************************************/
+    /*!
+     *  @class          SparseMatrix
+     *  @brief          Sparse matrix in compressed row storage, built row by row
+     *
+     *  @details        Used to hold interpolation weights : each row gives the weights
+     *                  of the source measurements that contribute to one output
+     */
+    /************************************************************************************/
+    class SOFA_API SparseMatrix
+    {
+    public:
+        SparseMatrix(const std::size_t numColumns = 0);
+        ~SparseMatrix() {};
+
+        void Clear(const std::size_t numColumns);
+
+        void AddRow(const std::vector< unsigned long > &columns,
+                    const std::vector< double > &values);
+
+        //==============================================================================
+        std::size_t GetNumRows() const;
+        std::size_t GetNumColumns() const;
+        std::size_t GetNumNonZeros() const;
+
+        std::size_t GetRowSize(const std::size_t row) const;
+        const unsigned long * GetRowColumns(const std::size_t row) const;
+        const double * GetRowValues(const std::size_t row) const;
+
+        unsigned long GetLargestEntry(const std::size_t row) const;
+
+        //==============================================================================
+        void Apply(double *output,
+                   const double *input,
+                   const std::size_t blockSize) const;
+
+    private:
+        std::size_t numColumns;
+
+        std::vector< std::size_t > rowOffsets;      ///< [ rows + 1 ]
+        std::vector< unsigned long > columns;       ///< [ non zeros ]
+        std::vector< double > values;               ///< [ non zeros ]
+    };
+
+}
+
+#endif /* _SOFA_SPARSE_MATRIX_H__ */
@@ -0,0 +1,298 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFASpatialIndex.cpp
+ *   @brief      k-d tree over 3D points
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFASpatialIndex.h"
+#include "../src/SOFAExceptions.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+namespace SpatialIndexLocal
+{
+    inline double squaredDistance(const double *a, const double *b)
+    {
+        const double dx = a[0] - b[0];
+        const double dy = a[1] - b[1];
+        const double dz = a[2] - b[2];
+
+        return dx * dx + dy * dy + dz * dz;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+SpatialIndex::SpatialIndex()
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Builds the tree
+ *  @param[in]      points_ : [ P 3 ] cartesian coordinates
+ *
+ */
+/************************************************************************************/
+void SpatialIndex::Build(const std::vector< double > &points_)
+{
+    SOFA_ASSERT( points_.size() % 3 == 0 );
+
+    points = points_;
+
+    const std::size_t numPoints = points.size() / 3;
+
+    indices.resize( numPoints );
+    axes.assign( numPoints, 0 );
+
+    for( std::size_t i = 0; i < numPoints; i++ )
+    {
+        indices[i] = static_cast< unsigned long >( i );
+    }
+
+    build( 0, numPoints );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Splits [begin end[ at its median, along the axis of largest extent
+ *
+ */
+/************************************************************************************/
+void SpatialIndex::build(const std::size_t begin, const std::size_t end)
+{
+    if( end - begin <= 1 )
+    {
+        return;
+    }
+
+    double lower[3] = {  HUGE_VAL,  HUGE_VAL,  HUGE_VAL };
+    double upper[3] = { -HUGE_VAL, -HUGE_VAL, -HUGE_VAL };
+
+    for( std::size_t i = begin; i < end; i++ )
+    {
+        const double *p = &points[ 3 * indices[i] ];
+
+        for( unsigned int j = 0; j < 3; j++ )
+        {
+            lower[j] = std::min( lower[j], p[j] );
+            upper[j] = std::max( upper[j], p[j] );
+        }
+    }
+
+    unsigned char axis = 0;
+    for( unsigned char j = 1; j < 3; j++ )
+    {
+        if( upper[j] - lower[j] > upper[axis] - lower[axis] )
+        {
+            axis = j;
+        }
+    }
+
+    const std::size_t middle = begin + ( end - begin ) / 2;
+
+    const std::vector< double > &p = points;
+
+    std::nth_element( indices.begin() + begin,
+                      indices.begin() + middle,
+                      indices.begin() + end,
+                      [ &p, axis ]( const unsigned long a, const unsigned long b )
+                      {
+                          return p[ 3 * a + axis ] < p[ 3 * b + axis ];
+                      } );
+
+    axes[ middle ] = axis;
+
+    build( begin, middle );
+    build( middle + 1, end );
+}
+
+unsigned long SpatialIndex::GetNumPoints() const
+{
+    return static_cast< unsigned long >( indices.size() );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the coordinates of one point
+ *
+ */
+/************************************************************************************/
+const double * SpatialIndex::GetPoint(const unsigned long index) const
+{
+    SOFA_ASSERT( index < GetNumPoints() );
+
+    return &points[ 3 * static_cast< std::size_t >( index ) ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the index of the point closest to a given position
+ *
+ */
+/************************************************************************************/
+unsigned long SpatialIndex::FindNearest(const double point[3]) const
+{
+    std::vector< unsigned long > nearest;
+    std::vector< double > distances;
+
+    FindNearest( nearest, distances, point, 1 );
+
+    SOFA_ASSERT( nearest.size() == 1 );
+
+    return nearest[0];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Finds the points closest to a given position
+ *  @param[out]     nearest : indices of the points, closest first
+ *  @param[out]     distances : the corresponding euclidean distances
+ *  @param[in]      point : cartesian coordinates
+ *  @param[in]      numNeighbours : number of points to look for
+ *
+ */
+/************************************************************************************/
+void SpatialIndex::FindNearest(std::vector< unsigned long > &nearest,
+                               std::vector< double > &distances,
+                               const double point[3],
+                               const unsigned long numNeighbours) const
+{
+    nearest.clear();
+    distances.clear();
+
+    if( indices.empty() == true || numNeighbours == 0 )
+    {
+        return;
+    }
+
+    const std::size_t k = std::min< std::size_t >( numNeighbours, indices.size() );
+
+    /// max-heap on the squared distance
+    std::vector< std::pair< double, unsigned long > > heap;
+    heap.reserve( k + 1 );
+
+    search( heap, point, k, 0, indices.size() );
+
+    std::sort_heap( heap.begin(), heap.end() );
+
+    nearest.resize( heap.size() );
+    distances.resize( heap.size() );
+
+    for( std::size_t i = 0; i < heap.size(); i++ )
+    {
+        nearest[i]   = heap[i].second;
+        distances[i] = std::sqrt( heap[i].first );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Recursive k nearest neighbours search in [begin end[
+ *
+ */
+/************************************************************************************/
+void SpatialIndex::search(std::vector< std::pair< double, unsigned long > > &heap,
+                          const double point[3],
+                          const std::size_t numNeighbours,
+                          const std::size_t begin,
+                          const std::size_t end) const
+{
+    if( begin >= end )
+    {
+        return;
+    }
+
+    const std::size_t middle    = begin + ( end - begin ) / 2;
+    const unsigned long index   = indices[ middle ];
+    const double *p             = &points[ 3 * index ];
+
+    const double distance = SpatialIndexLocal::squaredDistance( p, point );
+
+    if( heap.size() < numNeighbours )
+    {
+        heap.push_back( std::make_pair( distance, index ) );
+        std::push_heap( heap.begin(), heap.end() );
+    }
+    else if( distance < heap.front().first )
+    {
+        std::pop_heap( heap.begin(), heap.end() );
+        heap.back() = std::make_pair( distance, index );
+        std::push_heap( heap.begin(), heap.end() );
+    }
+
+    if( end - begin == 1 )
+    {
+        return;
+    }
+
+    const unsigned char axis    = axes[ middle ];
+    const double offset         = point[ axis ] - p[ axis ];
+
+    /// visit the half containing the point first
+    if( offset < 0.0 )
+    {
+        search( heap, point, numNeighbours, begin, middle );
+
+        if( heap.size() < numNeighbours || offset * offset < heap.front().first )
+        {
+            search( heap, point, numNeighbours, middle + 1, end );
+        }
+    }
+    else
+    {
+        search( heap, point, numNeighbours, middle + 1, end );
+
+        if( heap.size() < numNeighbours || offset * offset < heap.front().first )
+        {
+            search( heap, point, numNeighbours, begin, middle );
+        }
+    }
+}
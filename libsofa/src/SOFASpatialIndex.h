@@ -0,0 +1,104 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFASpatialIndex.h
+ *   @brief      k-d tree over 3D points
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_SPATIAL_INDEX_H__
+#define _SOFA_SPATIAL_INDEX_H__
+
+#include "../src/SOFAPlatform.h"
+
+namespace sofa
+{
+
+    /************************************************************************************/
+    /*!
+     *  @class          SpatialIndex
+     *  @brief          k-d tree over a set of 3D points
+     *
+     *  @details        The tree is balanced and stored implicitly in a permutation of the
+     *                  points, so building it only allocates two arrays. Queries are
+     *                  thread-safe once the tree has been built.
+     */
+    /************************************************************************************/
+    class SOFA_API SpatialIndex
+    {
+    public:
+        SpatialIndex();
+        ~SpatialIndex() {};
+
+        void Build(const std::vector< double > &points);
+
+        //==============================================================================
+        unsigned long GetNumPoints() const;
+
+        const double * GetPoint(const unsigned long index) const;
+
+        //==============================================================================
+        unsigned long FindNearest(const double point[3]) const;
+
+        void FindNearest(std::vector< unsigned long > &indices,
+                         std::vector< double > &distances,
+                         const double point[3],
+                         const unsigned long numNeighbours) const;
+
+    private:
+        void build(const std::size_t begin, const std::size_t end);
+
+        void search(std::vector< std::pair< double, unsigned long > > &heap,
+                    const double point[3],
+                    const std::size_t numNeighbours,
+                    const std::size_t begin,
+                    const std::size_t end) const;
+
+    private:
+        std::vector< double > points;               ///< [ P 3 ]
+        std::vector< unsigned long > indices;       ///< points, in tree order
+        std::vector< unsigned char > axes;          ///< splitting axis of each node
+    };
+
+}
+
+#endif /* _SOFA_SPATIAL_INDEX_H__ */
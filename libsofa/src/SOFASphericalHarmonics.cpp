@@ -0,0 +1,562 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFASphericalHarmonics.cpp
+ *   @brief      Spherical-harmonic decomposition of FIR data sets
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFASphericalHarmonics.h"
+#include "../src/SOFAGeometry.h"
+#include "../src/SOFALinearAlgebra.h"
+#include "../src/SOFAExceptions.h"
+#include "../src/SOFAHash.h"
+#include "../src/SOFACache.h"
+#include <cmath>
+
+using namespace sofa;
+
+namespace SphericalHarmonicsLocal
+{
+    const double kPi = 3.14159265358979323846;
+
+    typedef std::shared_ptr< const std::vector< double > > Matrix;
+
+    /// fitting matrices of the 16 most recently used (grid, order, regularization)
+    sofa::Cache< std::vector< double > > cache;
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Evaluates the harmonics at a set of directions
+     *  @param[out]     basis : [ M K ]
+     *  @param[out]     signature : order, regularization, number of directions and
+     *                  normalized directions, checked on each hit of the cache
+     *  @param[in]      directions : [ M 3 ] cartesian directions (normalized here)
+     *  @return         the key of the corresponding fitting matrix in the cache
+     *
+     */
+    /************************************************************************************/
+    inline unsigned long long computeBasis(std::vector< double > &basis,
+                                           std::vector< double > &signature,
+                                           const std::vector< double > &directions,
+                                           const unsigned int order,
+                                           const double regularization)
+    {
+        const std::size_t M = directions.size() / 3;
+        const std::size_t K = sofa::SphericalHarmonics::GetNumCoefficients( order );
+
+        basis.resize( M * K );
+
+        signature.resize( 3 + 3 * M );
+        signature[0] = static_cast< double >( order );
+        signature[1] = regularization;
+        signature[2] = static_cast< double >( M );
+
+        sofa::Hash hash;
+
+        for( std::size_t m = 0; m < M; m++ )
+        {
+            double direction[3];
+
+            direction[0] = directions[ 3 * m     ];
+            direction[1] = directions[ 3 * m + 1 ];
+            direction[2] = directions[ 3 * m + 2 ];
+
+            sofa::Geometry::Normalize( direction );
+
+            sofa::SphericalHarmonics::Evaluate( &basis[ m * K ], order, direction );
+
+            hash.Add( direction[0] );
+            hash.Add( direction[1] );
+            hash.Add( direction[2] );
+
+            signature[ 3 + 3 * m     ] = direction[0];
+            signature[ 3 + 3 * m + 1 ] = direction[1];
+            signature[ 3 + 3 * m + 2 ] = direction[2];
+        }
+
+        hash.Add( static_cast< unsigned long long >( order ) );
+        hash.Add( regularization );
+
+        return hash.GetValue();
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Evaluates the real spherical harmonics up to a given order
+ *  @param[out]     values : (order+1)^2 values, in ACN order (index n^2 + n + m)
+ *  @param[in]      order : maximum order
+ *  @param[in]      direction : unit vector (SOFA cartesian frame)
+ *
+ *  @details        The associated Legendre functions are computed with the recurrences
+ *                  of the fully normalized functions, which remain stable at high orders
+ */
+/************************************************************************************/
+void sofa::SphericalHarmonics::Evaluate(double *values,
+                                        const unsigned int order,
+                                        const double direction[3])
+{
+    const double x = direction[0];
+    const double y = direction[1];
+    const double z = direction[2];
+
+    const double sinTheta   = sqrt( x * x + y * y );
+    const double cosTheta   = z;
+    const double phi        = ( sinTheta > 0.0 ) ? atan2( y, x ) : 0.0;
+
+    const int L = static_cast< int >( order );
+
+    /// p( n, m ) = sqrt( (2n+1)/(4pi) (n-m)!/(n+m)! ) P_n^m( cos theta ), for m >= 0
+    std::vector< double > p( ( L + 1 ) * ( L + 1 ), 0.0 );
+
+    #define SOFA_SH_P( n, m ) p[ ( n ) * ( L + 1 ) + ( m ) ]
+
+    SOFA_SH_P( 0, 0 ) = sqrt( 1.0 / ( 4.0 * SphericalHarmonicsLocal::kPi ) );
+
+    for( int m = 1; m <= L; m++ )
+    {
+        SOFA_SH_P( m, m ) = sqrt( ( 2.0 * m + 1.0 ) / ( 2.0 * m ) ) * sinTheta * SOFA_SH_P( m - 1, m - 1 );
+    }
+
+    for( int m = 0; m < L; m++ )
+    {
+        SOFA_SH_P( m + 1, m ) = sqrt( 2.0 * m + 3.0 ) * cosTheta * SOFA_SH_P( m, m );
+    }
+
+    for( int m = 0; m <= L; m++ )
+    {
+        for( int n = m + 2; n <= L; n++ )
+        {
+            const double a = sqrt( ( 4.0 * n * n - 1.0 ) / ( static_cast< double >( n * n - m * m ) ) );
+            const double b = sqrt( ( ( n - 1.0 ) * ( n - 1.0 ) - m * m ) / ( 4.0 * ( n - 1.0 ) * ( n - 1.0 ) - 1.0 ) );
+
+            SOFA_SH_P( n, m ) = a * ( cosTheta * SOFA_SH_P( n - 1, m ) - b * SOFA_SH_P( n - 2, m ) );
+        }
+    }
+
+    const double sqrt2 = sqrt( 2.0 );
+
+    for( int n = 0; n <= L; n++ )
+    {
+        values[ n * n + n ] = SOFA_SH_P( n, 0 );
+
+        for( int m = 1; m <= n; m++ )
+        {
+            const double pnm = sqrt2 * SOFA_SH_P( n, m );
+
+            values[ n * n + n + m ] = pnm * cos( m * phi );
+            values[ n * n + n - m ] = pnm * sin( m * phi );
+        }
+    }
+
+    #undef SOFA_SH_P
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+SphericalHarmonicDecomposition::SphericalHarmonicDecomposition()
+: order( 0 )
+, numReceivers( 0 )
+, numDataSamples( 0 )
+, samplingRate( 0.0 )
+, fitError( 0.0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the decomposition of a SimpleFreeFieldHRIR file
+ *  @param[in]      file : the file to decompose
+ *  @param[in]      order_ : maximum spherical-harmonic order
+ *  @param[in]      regularization : Tikhonov weight, relative to the mean energy of the basis
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool SphericalHarmonicDecomposition::Compute(const sofa::SimpleFreeFieldHRIR &file,
+                                             const unsigned int order_,
+                                             const double regularization)
+{
+    sofa::FIRDataSet dataSet;
+
+    if( dataSet.Load( file ) == false )
+    {
+        return false;
+    }
+
+    return Compute( dataSet, order_, regularization );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the decomposition of a FIR data set
+ *  @param[in]      dataSet : the measurements to decompose
+ *  @param[in]      order_ : maximum spherical-harmonic order
+ *  @param[in]      regularization : Tikhonov weight, relative to the mean energy of the basis
+ *  @return         true on success
+ *
+ *  @details        The coefficients C minimize |Y C - D|^2 + lambda |W C|^2, where D holds
+ *                  the measurements, Y the harmonics at the source directions and W grows
+ *                  with the order as 1 + n(n+1), so that high orders are damped first
+ *                  when the grid does not support them (e.g. holes below the listener).
+ */
+/************************************************************************************/
+bool SphericalHarmonicDecomposition::Compute(const sofa::FIRDataSet &dataSet,
+                                             const unsigned int order_,
+                                             const double regularization)
+{
+    const std::size_t M = dataSet.GetNumMeasurements();
+    const std::size_t R = dataSet.GetNumReceivers();
+    const std::size_t N = dataSet.GetNumDataSamples();
+    const std::size_t K = sofa::SphericalHarmonics::GetNumCoefficients( order_ );
+
+    if( M == 0 || R == 0 || N == 0 )
+    {
+        SOFA_THROW( "empty data set" );
+        return false;
+    }
+
+    if( regularization < 0.0 )
+    {
+        SOFA_THROW( "invalid regularization" );
+        return false;
+    }
+
+    //==============================================================================
+    /// harmonics at the source directions, [ M K ]
+    std::vector< double > basis;
+    std::vector< double > signature;
+
+    const unsigned long long key = SphericalHarmonicsLocal::computeBasis( basis, signature, dataSet.GetSourceCartesianPositions(), order_, regularization );
+
+    const Matrix fitMatrix = getFitMatrix( basis, M, order_, regularization, key, signature );
+
+    //==============================================================================
+    /// C = P D, with D = Data.IR seen as [ M (R N) ]
+    std::vector< double > newCoefficients( K * R * N );
+    std::vector< double > newDelayCoefficients( K * R );
+
+    sofa::LinearAlgebra::Gemm( &newCoefficients[0], &( *fitMatrix )[0], &dataSet.GetDataIR()[0], K, M, R * N );
+    sofa::LinearAlgebra::Gemm( &newDelayCoefficients[0], &( *fitMatrix )[0], &dataSet.GetDataDelay()[0], K, M, R );
+
+    //==============================================================================
+    /// relative energy of the residual over the measurement grid
+    {
+        std::vector< double > reconstruction( M * R * N );
+
+        sofa::LinearAlgebra::Gemm( &reconstruction[0], &basis[0], &newCoefficients[0], M, K, R * N );
+
+        const std::vector< double > &ir = dataSet.GetDataIR();
+
+        double errorEnergy  = 0.0;
+        double signalEnergy = 0.0;
+
+        for( std::size_t i = 0; i < ir.size(); i++ )
+        {
+            const double diff = reconstruction[i] - ir[i];
+            errorEnergy  += diff * diff;
+            signalEnergy += ir[i] * ir[i];
+        }
+
+        fitError = ( signalEnergy > 0.0 ) ? errorEnergy / signalEnergy : 0.0;
+    }
+
+    order           = order_;
+    numReceivers    = static_cast< unsigned long >( R );
+    numDataSamples  = static_cast< unsigned long >( N );
+    samplingRate    = dataSet.GetSamplingRate();
+
+    coefficients.swap( newCoefficients );
+    delayCoefficients.swap( newDelayCoefficients );
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the fitting matrix P = ( Y^T Y + lambda W )^-1 Y^T, [ K M ]
+ *
+ *  @details        The matrix is computed once per (grid, order, regularization)
+ *                  and kept in a cache shared by all the decompositions, which holds
+ *                  the 16 most recently used matrices
+ */
+/************************************************************************************/
+SphericalHarmonicDecomposition::Matrix SphericalHarmonicDecomposition::getFitMatrix(const std::vector< double > &basis,
+                                                                                  const std::size_t numDirections,
+                                                                                  const unsigned int order_,
+                                                                                  const double regularization,
+                                                                                  const unsigned long long key,
+                                                                                  const std::vector< double > &signature)
+{
+    const Matrix cached = SphericalHarmonicsLocal::cache.Find( key, signature );
+
+    if( cached != nullptr )
+    {
+        return cached;
+    }
+
+    const std::size_t M = numDirections;
+    const std::size_t K = sofa::SphericalHarmonics::GetNumCoefficients( order_ );
+
+    /// A = Y^T Y + lambda W
+    std::vector< double > A( K * K );
+    sofa::LinearAlgebra::Gram( &A[0], &basis[0], M, K );
+
+    double trace = 0.0;
+    for( std::size_t k = 0; k < K; k++ )
+    {
+        trace += A[ k * K + k ];
+    }
+
+    const double lambda = regularization * trace / static_cast< double >( K );
+
+    for( unsigned int n = 0; n <= order_; n++ )
+    {
+        const double weight = lambda * ( 1.0 + n * ( n + 1.0 ) );
+
+        for( unsigned int k = n * n; k < ( n + 1 ) * ( n + 1 ); k++ )
+        {
+            A[ k * K + k ] += weight;
+        }
+    }
+
+    /// B = Y^T
+    std::shared_ptr< std::vector< double > > P = std::make_shared< std::vector< double > >( K * M );
+
+    for( std::size_t m = 0; m < M; m++ )
+    {
+        for( std::size_t k = 0; k < K; k++ )
+        {
+            ( *P )[ k * M + m ] = basis[ m * K + k ];
+        }
+    }
+
+    if( sofa::LinearAlgebra::CholeskySolve( &A[0], &( *P )[0], K, M ) == false )
+    {
+        SOFA_THROW( "the spherical-harmonic order is too high for this grid (increase the regularization)" );
+    }
+
+    const Matrix result = P;
+
+    SphericalHarmonicsLocal::cache.Insert( key, signature, result );
+
+    return result;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the (cached) fitting matrix of a grid, [ K M ]
+ *  @param[in]      directions : [ M 3 ] cartesian directions
+ *  @param[in]      order_ : maximum spherical-harmonic order
+ *  @param[in]      regularization : Tikhonov weight, relative to the mean energy of the basis
+ *
+ *  @details        The coefficients of any data defined over the grid are obtained by
+ *                  multiplying it by this matrix
+ */
+/************************************************************************************/
+SphericalHarmonicDecomposition::Matrix SphericalHarmonicDecomposition::GetFitMatrix(const std::vector< double > &directions,
+                                                                                  const unsigned int order_,
+                                                                                  const double regularization)
+{
+    SOFA_ASSERT( directions.size() % 3 == 0 );
+
+    if( regularization < 0.0 )
+    {
+        SOFA_THROW( "invalid regularization" );
+    }
+
+    std::vector< double > basis;
+    std::vector< double > signature;
+
+    const unsigned long long key = SphericalHarmonicsLocal::computeBasis( basis, signature, directions, order_, regularization );
+
+    return getFitMatrix( basis, directions.size() / 3, order_, regularization, key, signature );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Frees all the cached fitting matrices
+ *
+ */
+/************************************************************************************/
+void SphericalHarmonicDecomposition::ClearCache()
+{
+    SphericalHarmonicsLocal::cache.Clear();
+}
+
+unsigned int SphericalHarmonicDecomposition::GetOrder() const
+{
+    return order;
+}
+
+unsigned int SphericalHarmonicDecomposition::GetNumCoefficients() const
+{
+    return sofa::SphericalHarmonics::GetNumCoefficients( order );
+}
+
+unsigned long SphericalHarmonicDecomposition::GetNumReceivers() const
+{
+    return numReceivers;
+}
+
+unsigned long SphericalHarmonicDecomposition::GetNumDataSamples() const
+{
+    return numDataSamples;
+}
+
+double SphericalHarmonicDecomposition::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Relative energy of the residual of the fit over the measurement grid
+ *
+ */
+/************************************************************************************/
+double SphericalHarmonicDecomposition::GetFitError() const
+{
+    return fitError;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the coefficients, [ K R N ]
+ *
+ */
+/************************************************************************************/
+const std::vector< double > & SphericalHarmonicDecomposition::GetCoefficients() const
+{
+    return coefficients;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the N samples of one coefficient for one receiver
+ *
+ */
+/************************************************************************************/
+const double * SphericalHarmonicDecomposition::GetCoefficients(const unsigned int coefficient, const unsigned long receiver) const
+{
+    SOFA_ASSERT( coefficient < GetNumCoefficients() && receiver < numReceivers );
+
+    return &coefficients[ ( static_cast< std::size_t >( coefficient ) * numReceivers + receiver ) * numDataSamples ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the coefficients of Data.Delay, [ K R ]
+ *
+ */
+/************************************************************************************/
+const std::vector< double > & SphericalHarmonicDecomposition::GetDelayCoefficients() const
+{
+    return delayCoefficients;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Evaluates the impulse response at an arbitrary direction
+ *  @param[out]     ir : N samples
+ *  @param[in]      direction : unit vector (SOFA cartesian frame)
+ *  @param[in]      receiver : receiver index
+ *
+ */
+/************************************************************************************/
+void SphericalHarmonicDecomposition::Evaluate(double *ir,
+                                              const double direction[3],
+                                              const unsigned long receiver) const
+{
+    SOFA_ASSERT( receiver < numReceivers );
+
+    const unsigned int K = GetNumCoefficients();
+
+    std::vector< double > y( K );
+    sofa::SphericalHarmonics::Evaluate( &y[0], order, direction );
+
+    std::fill( ir, ir + numDataSamples, 0.0 );
+
+    for( unsigned int k = 0; k < K; k++ )
+    {
+        const double *c = GetCoefficients( k, receiver );
+        const double yk = y[k];
+
+        for( unsigned long n = 0; n < numDataSamples; n++ )
+        {
+            ir[n] += yk * c[n];
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Evaluates Data.Delay at an arbitrary direction
+ *  @param[in]      direction : unit vector (SOFA cartesian frame)
+ *  @param[in]      receiver : receiver index
+ *
+ */
+/************************************************************************************/
+double SphericalHarmonicDecomposition::EvaluateDelay(const double direction[3],
+                                                     const unsigned long receiver) const
+{
+    SOFA_ASSERT( receiver < numReceivers );
+
+    const unsigned int K = GetNumCoefficients();
+
+    std::vector< double > y( K );
+    sofa::SphericalHarmonics::Evaluate( &y[0], order, direction );
+
+    double value = 0.0;
+
+    for( unsigned int k = 0; k < K; k++ )
+    {
+        value += y[k] * delayCoefficients[ static_cast< std::size_t >( k ) * numReceivers + receiver ];
+    }
+
+    return value;
+}
@@ -0,0 +1,177 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFASphericalHarmonics.h
+ *   @brief      Spherical-harmonic decomposition of FIR data sets
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_SPHERICAL_HARMONICS_H__
+#define _SOFA_SPHERICAL_HARMONICS_H__
+
+#include "../src/SOFAFIRDataSet.h"
+#include "../src/SOFASimpleFreeFieldHRIR.h"
+#include <memory>
+
+namespace sofa
+{
+
+    namespace SphericalHarmonics
+    {
+
+        /************************************************************************************/
+        /*!
+         *  @brief          Number of spherical harmonics up to a given order, i.e. (order+1)^2
+         *
+         */
+        /************************************************************************************/
+        inline unsigned int GetNumCoefficients(const unsigned int order)
+        {
+            return ( order + 1 ) * ( order + 1 );
+        }
+
+        /************************************************************************************/
+        /*!
+         *  @brief          Evaluates the real spherical harmonics up to a given order
+         *  @param[out]     values : (order+1)^2 values, in ACN order (index n^2 + n + m)
+         *  @param[in]      order : maximum order
+         *  @param[in]      direction : unit vector (SOFA cartesian frame)
+         *
+         *  @details        The harmonics are orthonormal on the sphere (N3D),
+         *                  without the Condon-Shortley phase
+         */
+        /************************************************************************************/
+        SOFA_API_FUNC void Evaluate(double *values,
+                                    const unsigned int order,
+                                    const double direction[3]);
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @class          SphericalHarmonicDecomposition
+     *  @brief          Spherical-harmonic representation of a FIR data set
+     *
+     *  @details        Computes the spherical-harmonic coefficients of Data.IR and Data.Delay
+     *                  up to a given order, by regularized least squares over the source
+     *                  directions. The fitting matrix only depends on the grid, the order and
+     *                  the regularization, so it is computed once and shared through a cache
+     *                  (bounded to the 16 most recently used grids).
+     *
+     *                  The fit is done on the time samples : since the DFT is linear, the DFT
+     *                  of the coefficient responses gives the same per-frequency coefficients
+     *                  as a fit of the transfer functions, bin by bin.
+     *                  The responses can then be evaluated at any direction.
+     */
+    /************************************************************************************/
+    class SOFA_API SphericalHarmonicDecomposition
+    {
+    public:
+        SphericalHarmonicDecomposition();
+        ~SphericalHarmonicDecomposition() {};
+
+        bool Compute(const sofa::SimpleFreeFieldHRIR &file,
+                     const unsigned int order,
+                     const double regularization = 1e-3);
+
+        bool Compute(const sofa::FIRDataSet &dataSet,
+                     const unsigned int order,
+                     const double regularization = 1e-3);
+
+        //==============================================================================
+        unsigned int GetOrder() const;
+        unsigned int GetNumCoefficients() const;
+        unsigned long GetNumReceivers() const;
+        unsigned long GetNumDataSamples() const;
+        double GetSamplingRate() const;
+
+        double GetFitError() const;
+
+        //==============================================================================
+        const std::vector< double > & GetCoefficients() const;
+        const double * GetCoefficients(const unsigned int coefficient, const unsigned long receiver) const;
+
+        const std::vector< double > & GetDelayCoefficients() const;
+
+        //==============================================================================
+        void Evaluate(double *ir,
+                      const double direction[3],
+                      const unsigned long receiver) const;
+
+        double EvaluateDelay(const double direction[3],
+                             const unsigned long receiver) const;
+
+        //==============================================================================
+        typedef std::shared_ptr< const std::vector< double > > Matrix;
+
+        static Matrix GetFitMatrix(const std::vector< double > &directions,
+                                   const unsigned int order,
+                                   const double regularization = 1e-3);
+
+        static void ClearCache();
+
+    private:
+
+        static Matrix getFitMatrix(const std::vector< double > &basis,
+                                   const std::size_t numDirections,
+                                   const unsigned int order,
+                                   const double regularization,
+                                   const unsigned long long key,
+                                   const std::vector< double > &signature);
+
+    private:
+        unsigned int order;
+        unsigned long numReceivers;
+        unsigned long numDataSamples;
+        double samplingRate;
+        double fitError;
+
+        std::vector< double > coefficients;         ///< [ K R N ]
+        std::vector< double > delayCoefficients;    ///< [ K R ]
+
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( SphericalHarmonicDecomposition );
+    };
+
+}
+
+#endif /* _SOFA_SPHERICAL_HARMONICS_H__ */
@@ -0,0 +1,573 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFASphericalTriangulation.cpp
+ *   @brief      Triangulation of a set of directions
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFASphericalTriangulation.h"
+#include "../src/SOFAGeometry.h"
+#include "../src/SOFAExceptions.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <set>
+
+using namespace sofa;
+
+namespace SphericalTriangulationLocal
+{
+    /// amplitude of the jitter applied to the unit vectors while building the hull
+    const double kJitter = 1e-9;
+
+    /// a point is above a face if its distance to the plane exceeds this
+    const double kVisibilityThreshold = 1e-13;
+
+    /// tolerance for a direction lying on an edge
+    const double kInsideThreshold = 1e-10;
+
+    /// directions closer than this are considered equal
+    const double kDuplicateThreshold = 1e-9;
+
+    struct Face
+    {
+        unsigned long v[3];
+        double normal[3];
+        double offset;
+        bool alive;
+    };
+
+    inline void cross(double result[3], const double a[3], const double b[3])
+    {
+        result[0] = a[1] * b[2] - a[2] * b[1];
+        result[1] = a[2] * b[0] - a[0] * b[2];
+        result[2] = a[0] * b[1] - a[1] * b[0];
+    }
+
+    inline double dot(const double a[3], const double b[3])
+    {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    /// (a x b) . c
+    inline double triple(const double a[3], const double b[3], const double c[3])
+    {
+        double ab[3];
+        cross( ab, a, b );
+        return dot( ab, c );
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Creates the face (a b c), oriented away from 'inside'
+     *
+     */
+    /************************************************************************************/
+    inline Face makeFace(const std::vector< double > &p,
+                         unsigned long a,
+                         unsigned long b,
+                         unsigned long c,
+                         const double inside[3])
+    {
+        double ab[3];
+        double ac[3];
+
+        for( unsigned int i = 0; i < 3; i++ )
+        {
+            ab[i] = p[ 3 * b + i ] - p[ 3 * a + i ];
+            ac[i] = p[ 3 * c + i ] - p[ 3 * a + i ];
+        }
+
+        Face face;
+        cross( face.normal, ab, ac );
+        sofa::Geometry::Normalize( face.normal );
+
+        face.offset = dot( face.normal, &p[ 3 * a ] );
+
+        if( dot( face.normal, inside ) > face.offset )
+        {
+            std::swap( b, c );
+            for( unsigned int i = 0; i < 3; i++ )
+            {
+                face.normal[i] = -face.normal[i];
+            }
+            face.offset = -face.offset;
+        }
+
+        face.v[0]   = a;
+        face.v[1]   = b;
+        face.v[2]   = c;
+        face.alive  = true;
+
+        return face;
+    }
+
+    inline double distanceToPlane(const Face &face, const double *point)
+    {
+        return dot( face.normal, point ) - face.offset;
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Incremental convex hull of a set of points
+     *  @param[out]     triangles : [ T 3 ] indices of the faces, oriented outwards
+     *  @param[in]      p : [ P 3 ] coordinates
+     *  @param[in]      candidates : indices of the points to consider
+     *  @return         false if the points do not span a volume
+     *
+     */
+    /************************************************************************************/
+    bool convexHull(std::vector< unsigned long > &triangles,
+                    const std::vector< double > &p,
+                    const std::vector< unsigned long > &candidates)
+    {
+        triangles.clear();
+
+        if( candidates.size() < 4 )
+        {
+            return false;
+        }
+
+        const double *p0 = &p[ 3 * candidates[0] ];
+
+        /// initial tetrahedron : farthest point, farthest from the line, farthest from the plane
+        unsigned long i1 = candidates[0];
+        double best = 0.0;
+        for( std::size_t i = 1; i < candidates.size(); i++ )
+        {
+            const double *q = &p[ 3 * candidates[i] ];
+            const double d  = ( q[0] - p0[0] ) * ( q[0] - p0[0] ) + ( q[1] - p0[1] ) * ( q[1] - p0[1] ) + ( q[2] - p0[2] ) * ( q[2] - p0[2] );
+            if( d > best )
+            {
+                best = d;
+                i1 = candidates[i];
+            }
+        }
+
+        double axis[3] = { p[ 3 * i1 ] - p0[0], p[ 3 * i1 + 1 ] - p0[1], p[ 3 * i1 + 2 ] - p0[2] };
+        if( sofa::Geometry::Normalize( axis ) <= 0.0 )
+        {
+            return false;
+        }
+
+        unsigned long i2 = candidates[0];
+        best = 0.0;
+        for( std::size_t i = 1; i < candidates.size(); i++ )
+        {
+            const double *q = &p[ 3 * candidates[i] ];
+            const double v[3] = { q[0] - p0[0], q[1] - p0[1], q[2] - p0[2] };
+            double c[3];
+            cross( c, v, axis );
+            const double d = dot( c, c );
+            if( d > best )
+            {
+                best = d;
+                i2 = candidates[i];
+            }
+        }
+
+        if( best <= 0.0 )
+        {
+            return false;
+        }
+
+        const double v2[3] = { p[ 3 * i2 ] - p0[0], p[ 3 * i2 + 1 ] - p0[1], p[ 3 * i2 + 2 ] - p0[2] };
+        double planeNormal[3];
+        cross( planeNormal, axis, v2 );
+        sofa::Geometry::Normalize( planeNormal );
+
+        unsigned long i3 = candidates[0];
+        best = 0.0;
+        for( std::size_t i = 1; i < candidates.size(); i++ )
+        {
+            const double *q = &p[ 3 * candidates[i] ];
+            const double v[3] = { q[0] - p0[0], q[1] - p0[1], q[2] - p0[2] };
+            const double d = std::fabs( dot( v, planeNormal ) );
+            if( d > best )
+            {
+                best = d;
+                i3 = candidates[i];
+            }
+        }
+
+        if( best <= kVisibilityThreshold * 1e3 )
+        {
+            /// all the points are (almost) coplanar
+            return false;
+        }
+
+        const unsigned long i0 = candidates[0];
+
+        double inside[3];
+        for( unsigned int i = 0; i < 3; i++ )
+        {
+            inside[i] = 0.25 * ( p[ 3 * i0 + i ] + p[ 3 * i1 + i ] + p[ 3 * i2 + i ] + p[ 3 * i3 + i ] );
+        }
+
+        std::vector< Face > faces;
+        faces.push_back( makeFace( p, i0, i1, i2, inside ) );
+        faces.push_back( makeFace( p, i0, i1, i3, inside ) );
+        faces.push_back( makeFace( p, i0, i2, i3, inside ) );
+        faces.push_back( makeFace( p, i1, i2, i3, inside ) );
+
+        std::size_t numAlive = 4;
+
+        std::vector< std::size_t > visible;
+        std::set< std::pair< unsigned long, unsigned long > > edges;
+
+        for( std::size_t c = 0; c < candidates.size(); c++ )
+        {
+            const unsigned long index = candidates[c];
+
+            if( index == i0 || index == i1 || index == i2 || index == i3 )
+            {
+                continue;
+            }
+
+            const double *q = &p[ 3 * index ];
+
+            visible.clear();
+            for( std::size_t f = 0; f < faces.size(); f++ )
+            {
+                if( faces[f].alive == true && distanceToPlane( faces[f], q ) > kVisibilityThreshold )
+                {
+                    visible.push_back( f );
+                }
+            }
+
+            if( visible.empty() == true )
+            {
+                /// inside the current hull
+                continue;
+            }
+
+            /// the horizon is made of the edges of the visible faces that are not shared by two visible faces
+            edges.clear();
+            for( std::size_t i = 0; i < visible.size(); i++ )
+            {
+                const Face &face = faces[ visible[i] ];
+
+                for( unsigned int e = 0; e < 3; e++ )
+                {
+                    edges.insert( std::make_pair( face.v[e], face.v[ ( e + 1 ) % 3 ] ) );
+                }
+            }
+
+            for( std::size_t i = 0; i < visible.size(); i++ )
+            {
+                faces[ visible[i] ].alive = false;
+            }
+            numAlive -= visible.size();
+
+            for( std::set< std::pair< unsigned long, unsigned long > >::const_iterator it = edges.begin();
+                 it != edges.end();
+                 ++it )
+            {
+                if( edges.find( std::make_pair( it->second, it->first ) ) == edges.end() )
+                {
+                    faces.push_back( makeFace( p, it->first, it->second, index, inside ) );
+                    numAlive++;
+                }
+            }
+
+            /// compact the list of faces from time to time
+            if( faces.size() > 2 * numAlive + 64 )
+            {
+                faces.erase( std::remove_if( faces.begin(), faces.end(), []( const Face &face ) { return face.alive == false; } ),
+                             faces.end() );
+            }
+        }
+
+        for( std::size_t f = 0; f < faces.size(); f++ )
+        {
+            if( faces[f].alive == true )
+            {
+                triangles.push_back( faces[f].v[0] );
+                triangles.push_back( faces[f].v[1] );
+                triangles.push_back( faces[f].v[2] );
+            }
+        }
+
+        return true;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+SphericalTriangulation::SphericalTriangulation()
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Triangulates a set of directions
+ *  @param[in]      directions : [ P 3 ] cartesian directions (normalized internally)
+ *  @return         false if the directions do not span a volume (e.g. a single ring)
+ *
+ */
+/************************************************************************************/
+bool SphericalTriangulation::Compute(const std::vector< double > &directions)
+{
+    SOFA_ASSERT( directions.size() % 3 == 0 );
+
+    const std::size_t numPoints = directions.size() / 3;
+
+    points = directions;
+    triangles.clear();
+    vertexTriangles.clear();
+
+    for( std::size_t i = 0; i < numPoints; i++ )
+    {
+        if( sofa::Geometry::Normalize( &points[ 3 * i ] ) <= 0.0 )
+        {
+            SOFA_THROW( "null direction" );
+            return false;
+        }
+    }
+
+    index.Build( points );
+
+    /// merge duplicated directions
+    duplicates.resize( numPoints );
+    std::vector< unsigned long > unique;
+    unique.reserve( numPoints );
+
+    std::vector< unsigned long > neighbours;
+    std::vector< double > distances;
+
+    for( std::size_t i = 0; i < numPoints; i++ )
+    {
+        duplicates[i] = static_cast< unsigned long >( i );
+
+        index.FindNearest( neighbours, distances, &points[ 3 * i ], 8 );
+
+        for( std::size_t j = 0; j < neighbours.size(); j++ )
+        {
+            if( distances[j] < SphericalTriangulationLocal::kDuplicateThreshold && neighbours[j] < i )
+            {
+                duplicates[i] = std::min( duplicates[i], duplicates[ neighbours[j] ] );
+            }
+        }
+
+        if( duplicates[i] == i )
+        {
+            unique.push_back( static_cast< unsigned long >( i ) );
+        }
+    }
+
+    /// the hull is computed on jittered points, with a fixed seed for reproducibility
+    std::vector< double > jittered( points );
+    {
+        std::mt19937 generator( 12345 );
+        std::uniform_real_distribution< double > distribution( -SphericalTriangulationLocal::kJitter, SphericalTriangulationLocal::kJitter );
+
+        for( std::size_t i = 0; i < jittered.size(); i++ )
+        {
+            jittered[i] += distribution( generator );
+        }
+    }
+
+    std::vector< unsigned long > hull;
+
+    if( SphericalTriangulationLocal::convexHull( hull, jittered, unique ) == false )
+    {
+        return false;
+    }
+
+    /// only keep the faces that face the center
+    for( std::size_t t = 0; t < hull.size() / 3; t++ )
+    {
+        const double *a = &points[ 3 * hull[ 3 * t     ] ];
+        const double *b = &points[ 3 * hull[ 3 * t + 1 ] ];
+        const double *c = &points[ 3 * hull[ 3 * t + 2 ] ];
+
+        if( SphericalTriangulationLocal::triple( a, b, c ) > SphericalTriangulationLocal::kInsideThreshold )
+        {
+            triangles.push_back( hull[ 3 * t     ] );
+            triangles.push_back( hull[ 3 * t + 1 ] );
+            triangles.push_back( hull[ 3 * t + 2 ] );
+        }
+    }
+
+    vertexTriangles.resize( numPoints );
+
+    for( std::size_t t = 0; t < triangles.size() / 3; t++ )
+    {
+        for( unsigned int j = 0; j < 3; j++ )
+        {
+            vertexTriangles[ triangles[ 3 * t + j ] ].push_back( static_cast< unsigned long >( t ) );
+        }
+    }
+
+    return ( triangles.empty() == false );
+}
+
+unsigned long SphericalTriangulation::GetNumPoints() const
+{
+    return static_cast< unsigned long >( points.size() / 3 );
+}
+
+unsigned long SphericalTriangulation::GetNumTriangles() const
+{
+    return static_cast< unsigned long >( triangles.size() / 3 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the three vertices of a triangle
+ *
+ */
+/************************************************************************************/
+const unsigned long * SphericalTriangulation::GetTriangle(const unsigned long triangle) const
+{
+    SOFA_ASSERT( triangle < GetNumTriangles() );
+
+    return &triangles[ 3 * static_cast< std::size_t >( triangle ) ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Computes the barycentric weights of a direction in a triangle
+ *  @return         false if the direction does not project inside the triangle
+ *
+ */
+/************************************************************************************/
+bool SphericalTriangulation::computeWeights(double weights[3],
+                                            const unsigned long triangle,
+                                            const double direction[3]) const
+{
+    const double *a = &points[ 3 * triangles[ 3 * triangle     ] ];
+    const double *b = &points[ 3 * triangles[ 3 * triangle + 1 ] ];
+    const double *c = &points[ 3 * triangles[ 3 * triangle + 2 ] ];
+
+    /// weights of the intersection of the ray with the plane of the triangle
+    weights[0] = SphericalTriangulationLocal::triple( b, c, direction );
+    weights[1] = SphericalTriangulationLocal::triple( c, a, direction );
+    weights[2] = SphericalTriangulationLocal::triple( a, b, direction );
+
+    const double threshold = -SphericalTriangulationLocal::kInsideThreshold;
+
+    if( weights[0] < threshold || weights[1] < threshold || weights[2] < threshold )
+    {
+        return false;
+    }
+
+    for( unsigned int j = 0; j < 3; j++ )
+    {
+        weights[j] = std::max( 0.0, weights[j] );
+    }
+
+    const double sum = weights[0] + weights[1] + weights[2];
+
+    if( sum <= 0.0 )
+    {
+        return false;
+    }
+
+    for( unsigned int j = 0; j < 3; j++ )
+    {
+        weights[j] /= sum;
+    }
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Finds the triangle containing a direction
+ *  @param[out]     vertices : indices of the three points
+ *  @param[out]     weights : barycentric weights (positive, summing to 1)
+ *  @param[in]      direction : cartesian direction (normalized internally)
+ *  @return         false if the direction is not covered by the triangulation
+ *
+ */
+/************************************************************************************/
+bool SphericalTriangulation::Locate(unsigned long vertices[3],
+                                    double weights[3],
+                                    const double direction[3]) const
+{
+    if( triangles.empty() == true )
+    {
+        return false;
+    }
+
+    double d[3] = { direction[0], direction[1], direction[2] };
+    if( sofa::Geometry::Normalize( d ) <= 0.0 )
+    {
+        return false;
+    }
+
+    /// the triangle is most often around the nearest point
+    const unsigned long nearest = duplicates[ index.FindNearest( d ) ];
+
+    const std::vector< unsigned long > &candidates = vertexTriangles[ nearest ];
+
+    for( std::size_t i = 0; i < candidates.size(); i++ )
+    {
+        if( computeWeights( weights, candidates[i], d ) == true )
+        {
+            vertices[0] = triangles[ 3 * candidates[i]     ];
+            vertices[1] = triangles[ 3 * candidates[i] + 1 ];
+            vertices[2] = triangles[ 3 * candidates[i] + 2 ];
+            return true;
+        }
+    }
+
+    for( unsigned long t = 0; t < GetNumTriangles(); t++ )
+    {
+        if( computeWeights( weights, t, d ) == true )
+        {
+            vertices[0] = triangles[ 3 * t     ];
+            vertices[1] = triangles[ 3 * t + 1 ];
+            vertices[2] = triangles[ 3 * t + 2 ];
+            return true;
+        }
+    }
+
+    return false;
+}
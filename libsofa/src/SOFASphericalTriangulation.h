@@ -0,0 +1,111 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFASphericalTriangulation.h
+ *   @brief      Triangulation of a set of directions
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_SPHERICAL_TRIANGULATION_H__
+#define _SOFA_SPHERICAL_TRIANGULATION_H__
+
+#include "../src/SOFASpatialIndex.h"
+
+namespace sofa
+{
+
+    /************************************************************************************/
+    /*!
+     *  @class          SphericalTriangulation
+     *  @brief          Triangulation of a set of directions, for barycentric interpolation
+     *
+     *  @details        The triangles are the faces of the convex hull of the directions
+     *                  (which, for points on the sphere, is the spherical Delaunay
+     *                  triangulation). The points are slightly jittered while building the
+     *                  hull, so that the many coplanar points of regular grids
+     *                  (e.g. rings of constant elevation) do not produce degenerate faces.
+     *
+     *                  Faces that do not face the center (e.g. the flat cap closing a grid
+     *                  without low elevations) are dropped : directions in such holes are
+     *                  not covered by any triangle.
+     */
+    /************************************************************************************/
+    class SOFA_API SphericalTriangulation
+    {
+    public:
+        SphericalTriangulation();
+        ~SphericalTriangulation() {};
+
+        bool Compute(const std::vector< double > &directions);
+
+        //==============================================================================
+        unsigned long GetNumPoints() const;
+        unsigned long GetNumTriangles() const;
+
+        const unsigned long * GetTriangle(const unsigned long triangle) const;
+
+        //==============================================================================
+        bool Locate(unsigned long vertices[3],
+                    double weights[3],
+                    const double direction[3]) const;
+
+    private:
+        bool computeWeights(double weights[3],
+                            const unsigned long triangle,
+                            const double direction[3]) const;
+
+    private:
+        std::vector< double > points;                               ///< [ P 3 ], unit vectors
+        std::vector< unsigned long > triangles;                     ///< [ T 3 ], counterclockwise seen from outside
+        std::vector< std::vector< unsigned long > > vertexTriangles;///< triangles around each point
+        std::vector< unsigned long > duplicates;                    ///< first occurrence of each point
+
+        sofa::SpatialIndex index;
+
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( SphericalTriangulation );
+    };
+
+}
+
+#endif /* _SOFA_SPHERICAL_TRIANGULATION_H__ */
@@ -0,0 +1,347 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFASymmetricFIRDataSet.cpp
+ *   @brief      Binaural FIR data set exploiting the left/right symmetry
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFASymmetricFIRDataSet.h"
+#include "../src/SOFASpatialIndex.h"
+#include "../src/SOFAExceptions.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+const unsigned long SymmetricFIRDataSet::kNoMirror = static_cast< unsigned long >( -1 );
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+SymmetricFIRDataSet::SymmetricFIRDataSet()
+: numMeasurements( 0 )
+, numDataSamples( 0 )
+, samplingRate( 0.0 )
+, numPaired( 0 )
+, symmetryError( 0.0 )
+, maxSymmetryError( 0.0 )
+, maxDelayError( 0.0 )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Pairs the mirrored measurements and measures the asymmetry
+ *  @param[in]      dataSet : binaural data set (R = 2)
+ *  @param[in]      angularTolerance : maximum angle (in degree) between a mirrored
+ *                  source position and its match
+ *  @return         true on success
+ *
+ *  @details        The stored data are released
+ */
+/************************************************************************************/
+bool SymmetricFIRDataSet::Analyze(const sofa::FIRDataSet &dataSet,
+                                  const double angularTolerance)
+{
+    const unsigned long M = dataSet.GetNumMeasurements();
+    const unsigned long N = dataSet.GetNumDataSamples();
+
+    if( M == 0 || dataSet.GetNumReceivers() != 2 )
+    {
+        SOFA_THROW( "a binaural data set is required" );
+        return false;
+    }
+
+    const std::vector< double > &positions = dataSet.GetSourceCartesianPositions();
+
+    sofa::SpatialIndex index;
+    index.Build( positions );
+
+    const double halfAngle = 0.5 * angularTolerance * 3.14159265358979323846 / 180.0;
+
+    mirrors.assign( M, kNoMirror );
+    numPaired = 0;
+
+    double errorEnergy  = 0.0;
+    double signalEnergy = 0.0;
+
+    maxSymmetryError    = 0.0;
+    maxDelayError       = 0.0;
+
+    for( unsigned long m = 0; m < M; m++ )
+    {
+        const double *p = &positions[ 3 * m ];
+        const double mirrored[3] = { p[0], -p[1], p[2] };
+
+        const double radius     = std::sqrt( p[0] * p[0] + p[1] * p[1] + p[2] * p[2] );
+        const double threshold  = 2.0 * radius * std::sin( halfAngle ) + 1e-9 * radius;
+
+        const unsigned long match = index.FindNearest( mirrored );
+        const double *q = &positions[ 3 * match ];
+
+        const double distance = std::sqrt( ( q[0] - mirrored[0] ) * ( q[0] - mirrored[0] )
+                                         + ( q[1] - mirrored[1] ) * ( q[1] - mirrored[1] )
+                                         + ( q[2] - mirrored[2] ) * ( q[2] - mirrored[2] ) );
+
+        if( distance > threshold )
+        {
+            continue;
+        }
+
+        mirrors[m] = match;
+        numPaired++;
+
+        /// right ear of m versus left ear of its mirror
+        const double *right = dataSet.GetIR( m, 1 );
+        const double *left  = dataSet.GetIR( match, 0 );
+
+        double e = 0.0;
+        double s = 0.0;
+
+        for( unsigned long n = 0; n < N; n++ )
+        {
+            const double diff = right[n] - left[n];
+            e += diff * diff;
+            s += right[n] * right[n];
+        }
+
+        errorEnergy  += e;
+        signalEnergy += s;
+
+        if( s > 0.0 )
+        {
+            maxSymmetryError = std::max( maxSymmetryError, e / s );
+        }
+
+        maxDelayError = std::max( maxDelayError, std::fabs( dataSet.GetDelay( m, 1 ) - dataSet.GetDelay( match, 0 ) ) );
+    }
+
+    symmetryError   = ( signalEnergy > 0.0 ) ? errorEnergy / signalEnergy : 0.0;
+
+    numMeasurements = M;
+    numDataSamples  = N;
+    samplingRate    = dataSet.GetSamplingRate();
+
+    rows.clear();
+    ir.clear();
+    delay.clear();
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Analyzes the data set and, if it is symmetric enough, stores it
+ *  @param[in]      dataSet : binaural data set (R = 2)
+ *  @param[in]      maxError : maximum relative energy of the prediction error of the
+ *                  right ear, for the whole set (see GetSymmetryError)
+ *  @param[in]      angularTolerance : see Analyze
+ *  @return         false if the data set is not symmetric enough (nothing is stored)
+ *
+ */
+/************************************************************************************/
+bool SymmetricFIRDataSet::Compute(const sofa::FIRDataSet &dataSet,
+                                  const double maxError,
+                                  const double angularTolerance)
+{
+    if( Analyze( dataSet, angularTolerance ) == false )
+    {
+        return false;
+    }
+
+    if( symmetryError > maxError )
+    {
+        return false;
+    }
+
+    const unsigned long M = numMeasurements;
+    const unsigned long N = numDataSamples;
+
+    /// left ears first, then the right ears that have no mirror
+    const std::size_t numRows = M + ( M - numPaired );
+
+    rows.resize( 2 * M );
+    ir.resize( numRows * N );
+    delay.resize( numRows );
+
+    std::size_t extra = M;
+
+    for( unsigned long m = 0; m < M; m++ )
+    {
+        std::copy( dataSet.GetIR( m, 0 ), dataSet.GetIR( m, 0 ) + N, &ir[ m * N ] );
+        delay[m] = dataSet.GetDelay( m, 0 );
+
+        rows[ 2 * m ] = m;
+
+        if( mirrors[m] != kNoMirror )
+        {
+            rows[ 2 * m + 1 ] = mirrors[m];
+        }
+        else
+        {
+            std::copy( dataSet.GetIR( m, 1 ), dataSet.GetIR( m, 1 ) + N, &ir[ extra * N ] );
+            delay[ extra ] = dataSet.GetDelay( m, 1 );
+
+            rows[ 2 * m + 1 ] = static_cast< unsigned long >( extra );
+            extra++;
+        }
+    }
+
+    SOFA_ASSERT( extra == numRows );
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the mirrored measurement, or kNoMirror
+ *
+ */
+/************************************************************************************/
+unsigned long SymmetricFIRDataSet::GetMirror(const unsigned long measurement) const
+{
+    SOFA_ASSERT( measurement < mirrors.size() );
+
+    return mirrors[ measurement ];
+}
+
+unsigned long SymmetricFIRDataSet::GetNumPairedMeasurements() const
+{
+    return numPaired;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Relative energy of the error made when predicting the right ear from
+ *                  the left ear of the mirrored measurement, over all the paired measurements
+ *
+ */
+/************************************************************************************/
+double SymmetricFIRDataSet::GetSymmetryError() const
+{
+    return symmetryError;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Same as GetSymmetryError, for the worst measurement
+ *
+ */
+/************************************************************************************/
+double SymmetricFIRDataSet::GetMaxSymmetryError() const
+{
+    return maxSymmetryError;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Largest difference of Data.Delay between mirrored ears, in samples
+ *
+ */
+/************************************************************************************/
+double SymmetricFIRDataSet::GetMaxDelayError() const
+{
+    return maxDelayError;
+}
+
+unsigned long SymmetricFIRDataSet::GetNumMeasurements() const
+{
+    return numMeasurements;
+}
+
+unsigned long SymmetricFIRDataSet::GetNumReceivers() const
+{
+    return 2;
+}
+
+unsigned long SymmetricFIRDataSet::GetNumDataSamples() const
+{
+    return numDataSamples;
+}
+
+double SymmetricFIRDataSet::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the N samples of an impulse response
+ *
+ */
+/************************************************************************************/
+const double * SymmetricFIRDataSet::GetIR(const unsigned long measurement, const unsigned long receiver) const
+{
+    SOFA_ASSERT( rows.empty() == false );
+    SOFA_ASSERT( measurement < numMeasurements && receiver < 2 );
+
+    return &ir[ static_cast< std::size_t >( rows[ 2 * measurement + receiver ] ) * numDataSamples ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the delay of an impulse response, in samples
+ *
+ */
+/************************************************************************************/
+double SymmetricFIRDataSet::GetDelay(const unsigned long measurement, const unsigned long receiver) const
+{
+    SOFA_ASSERT( rows.empty() == false );
+    SOFA_ASSERT( measurement < numMeasurements && receiver < 2 );
+
+    return delay[ rows[ 2 * measurement + receiver ] ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Number of impulse responses actually stored (2 M without symmetry)
+ *
+ */
+/************************************************************************************/
+std::size_t SymmetricFIRDataSet::GetNumStoredResponses() const
+{
+    return delay.size();
+}
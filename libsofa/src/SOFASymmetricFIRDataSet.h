@@ -0,0 +1,131 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFASymmetricFIRDataSet.h
+ *   @brief      Binaural FIR data set exploiting the left/right symmetry
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_SYMMETRIC_FIR_DATA_SET_H__
+#define _SOFA_SYMMETRIC_FIR_DATA_SET_H__
+
+#include "../src/SOFAFIRDataSet.h"
+
+namespace sofa
+{
+
+    /************************************************************************************/
+    /*!
+     *  @class          SymmetricFIRDataSet
+     *  @brief          Binaural FIR data set stored with one ear per left/right pair
+     *
+     *  @details        For a head symmetric with respect to the median plane, the right ear
+     *                  response of a source at (x, y, z) is the left ear response of the
+     *                  source at (x, -y, z). The analysis pairs each measurement with its
+     *                  mirror and measures how far the data set is from this symmetry.
+     *
+     *                  When the error is small enough, only the left ear is stored; the
+     *                  right ear is read from the mirrored measurement. Measurements without
+     *                  a mirror keep both ears. This about halves the memory of the IRs.
+     *
+     *                  Receiver 0 is the left ear, as in SimpleFreeFieldHRIR.
+     */
+    /************************************************************************************/
+    class SOFA_API SymmetricFIRDataSet
+    {
+    public:
+        static const unsigned long kNoMirror;
+
+    public:
+        SymmetricFIRDataSet();
+        ~SymmetricFIRDataSet() {};
+
+        bool Analyze(const sofa::FIRDataSet &dataSet,
+                     const double angularTolerance = 1.0);
+
+        bool Compute(const sofa::FIRDataSet &dataSet,
+                     const double maxError,
+                     const double angularTolerance = 1.0);
+
+        //==============================================================================
+        unsigned long GetMirror(const unsigned long measurement) const;
+        unsigned long GetNumPairedMeasurements() const;
+
+        double GetSymmetryError() const;
+        double GetMaxSymmetryError() const;
+        double GetMaxDelayError() const;
+
+        //==============================================================================
+        unsigned long GetNumMeasurements() const;
+        unsigned long GetNumReceivers() const;
+        unsigned long GetNumDataSamples() const;
+        double GetSamplingRate() const;
+
+        const double * GetIR(const unsigned long measurement, const unsigned long receiver) const;
+        double GetDelay(const unsigned long measurement, const unsigned long receiver) const;
+
+        std::size_t GetNumStoredResponses() const;
+
+    private:
+        unsigned long numMeasurements;
+        unsigned long numDataSamples;
+        double samplingRate;
+
+        std::vector< unsigned long > mirrors;       ///< mirrored measurement, or kNoMirror
+        unsigned long numPaired;
+
+        double symmetryError;                       ///< relative energy of the right ear prediction error
+        double maxSymmetryError;                    ///< worst measurement
+        double maxDelayError;                       ///< in samples
+
+        std::vector< unsigned long > rows;          ///< [ M 2 ] row of each (measurement, ear) in the store
+        std::vector< double > ir;                   ///< [ rows N ]
+        std::vector< double > delay;                ///< [ rows ]
+
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( SymmetricFIRDataSet );
+    };
+
+}
+
+#endif /* _SOFA_SYMMETRIC_FIR_DATA_SET_H__ */
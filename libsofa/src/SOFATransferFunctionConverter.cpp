@@ -0,0 +1,410 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFATransferFunctionConverter.cpp
+ *   @brief      Conversion of transfer functions into impulse responses
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFATransferFunctionConverter.h"
+#include "../src/SOFAFFT.h"
+#include "../src/SOFAMinimumPhase.h"
+#include "../src/SOFAParallel.h"
+#include "../src/SOFAExceptions.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+
+namespace TransferFunctionConverterLocal
+{
+    /// number of measurements read from the file at once
+    const unsigned long kNumMeasurementsPerRead = 256;
+
+    /// the FFT size is this factor times the IR length (or the length of the file grid),
+    /// rounded to a power of two, to limit the time aliasing
+    const unsigned int kOversampling = 4;
+
+    const double kPi = 3.14159265358979323846;
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Work buffers of one thread
+     *
+     */
+    /************************************************************************************/
+    struct Workspace
+    {
+        sofa::dsp::FFT fft;
+
+        std::vector< float > time;          ///< [ F ]
+        std::vector< float > re;            ///< [ F/2+1 ]
+        std::vector< float > im;
+        std::vector< double > magnitude;    ///< [ F/2+1 ]
+
+        Workspace(const unsigned int fftSize)
+        : fft( fftSize )
+        , time( fftSize )
+        , re( fftSize / 2 + 1 )
+        , im( fftSize / 2 + 1 )
+        , magnitude( fftSize / 2 + 1 )
+        {
+        }
+    };
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Interpolates the magnitude of a transfer function onto the FFT bins
+     *  @param[out]     magnitude : K values
+     *  @param[in]      tf : N interleaved complex values
+     *  @param[in]      frequencies : N increasing frequencies, in hertz
+     *  @param[in]      binWidth : frequency of bin k is k * binWidth
+     *
+     *  @details        Linear interpolation ; the values at the first and last frequencies
+     *                  are held beyond the range of the file
+     */
+    /************************************************************************************/
+    void Interpolate(double *magnitude,
+                     const unsigned int K,
+                     const double *tf,
+                     const std::vector< double > &frequencies,
+                     const double binWidth)
+    {
+        const std::size_t N = frequencies.size();
+
+        std::size_t j = 0;
+
+        for( unsigned int k = 0; k < K; k++ )
+        {
+            const double f = k * binWidth;
+
+            while( j + 1 < N && frequencies[ j + 1 ] <= f )
+            {
+                j++;
+            }
+
+            const double m0 = std::hypot( tf[ 2 * j ], tf[ 2 * j + 1 ] );
+
+            if( j + 1 >= N || f <= frequencies[j] )
+            {
+                magnitude[k] = m0;
+            }
+            else
+            {
+                const double m1 = std::hypot( tf[ 2 * j + 2 ], tf[ 2 * j + 3 ] );
+                const double t  = ( f - frequencies[j] ) / ( frequencies[ j + 1 ] - frequencies[j] );
+
+                magnitude[k] = m0 + t * ( m1 - m0 );
+            }
+        }
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Synthesizes the minimum-phase IR of a magnitude response
+     *  @param[out]     output : length samples
+     *
+     */
+    /************************************************************************************/
+    void MinimumPhase(double *output,
+                      const unsigned long length,
+                      Workspace &w)
+    {
+        if( sofa::MinimumPhaseDecomposition::MinimumPhaseSpectrum( &w.re[0], &w.im[0], &w.magnitude[0], w.fft, &w.time[0] ) == false )
+        {
+            std::fill( output, output + length, 0.0 );
+            return;
+        }
+
+        w.fft.Inverse( &w.time[0], &w.re[0], &w.im[0] );
+
+        for( unsigned long n = 0; n < length; n++ )
+        {
+            output[n] = w.time[n];
+        }
+    }
+
+    /************************************************************************************/
+    /*!
+     *  @brief          Synthesizes the linear-phase IR of a magnitude response
+     *  @param[out]     output : length samples, centered at length / 2
+     *  @param[in]      window : length samples
+     *
+     */
+    /************************************************************************************/
+    void LinearPhase(double *output,
+                     const unsigned long length,
+                     const double *window,
+                     Workspace &w)
+    {
+        const unsigned int F = w.fft.GetSize();
+        const unsigned int K = w.fft.GetNumBins();
+
+        for( unsigned int k = 0; k < K; k++ )
+        {
+            w.re[k] = static_cast< float >( w.magnitude[k] );
+            w.im[k] = 0.0f;
+        }
+
+        /// zero-phase response, symmetric around 0
+        w.fft.Inverse( &w.time[0], &w.re[0], &w.im[0] );
+
+        const unsigned long center = length / 2;
+
+        for( unsigned long n = 0; n < length; n++ )
+        {
+            output[n] = w.time[ ( n + F - center ) % F ] * window[n];
+        }
+    }
+}
+
+using namespace TransferFunctionConverterLocal;
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *
+ */
+/************************************************************************************/
+TransferFunctionConverter::TransferFunctionConverter()
+: numMeasurements( 0 )
+, numReceivers( 0 )
+, numDataSamples( 0 )
+, samplingRate( 0.0 )
+, phase( sofa::TransferFunctionConverter::kMinimumPhase )
+{
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Converts all the transfer functions of a file
+ *  @param[in]      file : the transfer functions
+ *  @param[in]      length : length of the IRs
+ *  @param[in]      samplingRate_ : sampling rate of the IRs, in hertz (0 : twice the highest
+ *                  frequency of N)
+ *  @param[in]      phase_ : phase of the IRs
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+bool TransferFunctionConverter::Compute(const sofa::GeneralTF &file,
+                                        const unsigned long length,
+                                        const double samplingRate_,
+                                        const sofa::TransferFunctionConverter::Phase phase_)
+{
+    const long M = file.GetNumMeasurements();
+    const long R = file.GetNumReceivers();
+    const long N = file.GetNumDataSamples();
+    const unsigned long L = length;
+
+    if( M <= 0 || R <= 0 || N <= 0 || L == 0 )
+    {
+        SOFA_THROW( "invalid SOFA dimensions" );
+        return false;
+    }
+
+    if( phase_ != kMinimumPhase && phase_ != kLinearPhase )
+    {
+        SOFA_THROW( "invalid phase" );
+        return false;
+    }
+
+    //==============================================================================
+    /// frequencies of the transfer functions
+    std::vector< double > frequencies;
+
+    if( file.GetFrequencies( frequencies ) == false || frequencies.size() != static_cast< std::size_t >( N ) )
+    {
+        SOFA_THROW( "invalid 'N' variable" );
+        return false;
+    }
+
+    for( std::size_t j = 0; j < frequencies.size(); j++ )
+    {
+        if( frequencies[j] < 0.0 || ( j > 0 && frequencies[j] <= frequencies[ j - 1 ] ) )
+        {
+            SOFA_THROW( "the frequencies of 'N' shall be positive and increasing" );
+            return false;
+        }
+    }
+
+    const double fs = ( samplingRate_ > 0.0 ) ? samplingRate_ : 2.0 * frequencies.back();
+
+    if( fs <= 0.0 )
+    {
+        SOFA_THROW( "invalid sampling rate" );
+        return false;
+    }
+
+    const unsigned long gridLength  = 2 * static_cast< unsigned long >( N );
+    const unsigned int fftSize      = sofa::dsp::FFT::NextPowerOfTwo( static_cast< unsigned int >( std::max( L, gridLength ) * kOversampling ) );
+    const double binWidth           = fs / fftSize;
+
+    /// Hann window centered at L / 2, for the linear-phase IRs
+    std::vector< double > window( L, 1.0 );
+
+    if( phase_ == kLinearPhase && L > 1 )
+    {
+        const double halfWidth = static_cast< double >( L / 2 );
+
+        for( unsigned long n = 0; n < L; n++ )
+        {
+            const double x = ( static_cast< double >( n ) - halfWidth ) / std::max( 1.0, halfWidth );
+
+            window[n] = 0.5 + 0.5 * std::cos( kPi * std::min( 1.0, std::fabs( x ) ) );
+        }
+    }
+
+    //==============================================================================
+    std::vector< double > newIR( static_cast< std::size_t >( M ) * R * L );
+    std::vector< double > tf;
+
+    for( unsigned long first = 0; first < static_cast< unsigned long >( M ); first += kNumMeasurementsPerRead )
+    {
+        const unsigned long count = std::min( kNumMeasurementsPerRead, static_cast< unsigned long >( M ) - first );
+
+        if( file.GetDataTF( tf, first, count ) == false )
+        {
+            SOFA_THROW( "invalid 'Data.Real' or 'Data.Imag' variable" );
+            return false;
+        }
+
+        sofa::Parallel::For( 0, count * R, [ & ]( const std::size_t begin, const std::size_t end )
+        {
+            Workspace workspace( fftSize );
+
+            for( std::size_t i = begin; i < end; i++ )
+            {
+                Interpolate( &workspace.magnitude[0], workspace.fft.GetNumBins(), &tf[ i * N * 2 ], frequencies, binWidth );
+
+                double *output = &newIR[ ( first * R + i ) * L ];
+
+                if( phase_ == kMinimumPhase )
+                {
+                    MinimumPhase( output, L, workspace );
+                }
+                else
+                {
+                    LinearPhase( output, L, &window[0], workspace );
+                }
+            }
+        } );
+    }
+
+    //==============================================================================
+    numMeasurements = static_cast< unsigned long >( M );
+    numReceivers    = static_cast< unsigned long >( R );
+    numDataSamples  = L;
+    samplingRate    = fs;
+    phase           = phase_;
+
+    ir.swap( newIR );
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Loads the converted IRs into a data set
+ *  @param[out]     dataSet : Data.IR is the converted IRs, SourcePosition is read from the file
+ *  @param[in]      file : the file that was converted
+ *  @param[in]      ordering : optional reordering of the measurements
+ *  @return         false if the dimensions do not match
+ *
+ */
+/************************************************************************************/
+bool TransferFunctionConverter::Apply(sofa::FIRDataSet &dataSet,
+                                      const sofa::GeneralTF &file,
+                                      const sofa::FIRDataSet::Ordering &ordering) const
+{
+    if( ir.empty() == true
+       || file.GetNumMeasurements() != static_cast< long >( numMeasurements )
+       || file.GetNumReceivers() != static_cast< long >( numReceivers ) )
+    {
+        return false;
+    }
+
+    return dataSet.Load( file, ir, numDataSamples, samplingRate, ordering );
+}
+
+unsigned long TransferFunctionConverter::GetNumMeasurements() const
+{
+    return numMeasurements;
+}
+
+unsigned long TransferFunctionConverter::GetNumReceivers() const
+{
+    return numReceivers;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Length of the IRs
+ *
+ */
+/************************************************************************************/
+unsigned long TransferFunctionConverter::GetNumDataSamples() const
+{
+    return numDataSamples;
+}
+
+double TransferFunctionConverter::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+sofa::TransferFunctionConverter::Phase TransferFunctionConverter::GetPhase() const
+{
+    return phase;
+}
+
+const double * TransferFunctionConverter::GetIR(const unsigned long measurement, const unsigned long receiver) const
+{
+    SOFA_ASSERT( measurement < numMeasurements && receiver < numReceivers );
+
+    return &ir[ ( static_cast< std::size_t >( measurement ) * numReceivers + receiver ) * numDataSamples ];
+}
+
+const std::vector< double > & TransferFunctionConverter::GetDataIR() const
+{
+    return ir;
+}
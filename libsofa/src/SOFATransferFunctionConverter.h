@@ -0,0 +1,122 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFATransferFunctionConverter.h
+ *   @brief      Conversion of transfer functions into impulse responses
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_TRANSFER_FUNCTION_CONVERTER_H__
+#define _SOFA_TRANSFER_FUNCTION_CONVERTER_H__
+
+#include "../src/SOFAGeneralTF.h"
+#include "../src/SOFAFIRDataSet.h"
+
+namespace sofa
+{
+
+    /************************************************************************************/
+    /*!
+     *  @class          TransferFunctionConverter
+     *  @brief          Conversion of the transfer functions of a GeneralTF file into IRs
+     *
+     *  @details        The magnitudes of Data.Real / Data.Imag are interpolated linearly onto
+     *                  the uniform grid of an FFT (the frequencies of N may be non-uniform,
+     *                  e.g. logarithmically spaced), and each IR is synthesized with either a
+     *                  minimum phase (folding of the real cepstrum) or a linear phase (the
+     *                  zero-phase response, delayed by half the length and Hann-windowed).
+     *
+     *                  The measurements are read from the file by chunks and converted in
+     *                  parallel (sofa::Parallel). The result can be loaded into a FIRDataSet,
+     *                  which then feeds the convolvers like any FIR measurement.
+     */
+    /************************************************************************************/
+    class SOFA_API TransferFunctionConverter
+    {
+    public:
+        enum Phase
+        {
+            kMinimumPhase           = 0,    ///< minimum-phase IRs, starting at the first sample
+            kLinearPhase            = 1,    ///< symmetric IRs, centered at half the length
+            kNumPhases              = 2
+        };
+
+    public:
+        TransferFunctionConverter();
+        ~TransferFunctionConverter() {};
+
+        bool Compute(const sofa::GeneralTF &file,
+                     const unsigned long length,
+                     const double samplingRate = 0.0,
+                     const sofa::TransferFunctionConverter::Phase phase = sofa::TransferFunctionConverter::kMinimumPhase);
+
+        bool Apply(sofa::FIRDataSet &dataSet,
+                   const sofa::GeneralTF &file,
+                   const sofa::FIRDataSet::Ordering &ordering = sofa::FIRDataSet::kOriginalOrder) const;
+
+        //==============================================================================
+        unsigned long GetNumMeasurements() const;
+        unsigned long GetNumReceivers() const;
+        unsigned long GetNumDataSamples() const;
+        double GetSamplingRate() const;
+        sofa::TransferFunctionConverter::Phase GetPhase() const;
+
+        const double * GetIR(const unsigned long measurement, const unsigned long receiver) const;
+        const std::vector< double > & GetDataIR() const;
+
+    private:
+        unsigned long numMeasurements;
+        unsigned long numReceivers;
+        unsigned long numDataSamples;
+        double samplingRate;
+        sofa::TransferFunctionConverter::Phase phase;
+
+        std::vector< double > ir;                       ///< [ M R N ]
+
+    private:
+        /// avoid shallow and copy constructor
+        SOFA_AVOID_COPY_CONSTRUCTOR( TransferFunctionConverter );
+    };
+
+}
+
+#endif /* _SOFA_TRANSFER_FUNCTION_CONVERTER_H__ */
@@ -0,0 +1,623 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAVirtualLoudspeakerRenderer.cpp
+ *   @brief      Binaural rendering of a multichannel bed over virtual loudspeakers
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFAVirtualLoudspeakerRenderer.h"
+#include "../src/SOFAFractionalDelayLine.h"
+#include "../src/SOFAGeometry.h"
+#include "../src/SOFASimd.h"
+#include "../src/SOFAExceptions.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace sofa;
+using namespace sofa::dsp;
+
+namespace VirtualLoudspeakerRendererLocal
+{
+    /************************************************************************************/
+    /*!
+     *  @brief          Reads a position [ I C ] or [ M C ] of one measurement, in cartesian
+     *                  coordinates
+     *
+     */
+    /************************************************************************************/
+    inline bool getPosition(double position[3],
+                            const sofa::File &file,
+                            const std::string &variableName,
+                            const sofa::Coordinates::Type &coordinates,
+                            const unsigned long measurement)
+    {
+        std::vector< double > values;
+
+        if( file.GetValues( values, variableName ) == false )
+        {
+            return false;
+        }
+
+        const std::size_t row = ( values.size() == 3 ) ? 0 : measurement;
+
+        if( 3 * row + 3 > values.size() )
+        {
+            return false;
+        }
+
+        const std::vector< double > point( values.begin() + 3 * row, values.begin() + 3 * row + 3 );
+
+        std::vector< double > cartesian;
+        sofa::Geometry::ToCartesian( cartesian, point, coordinates );
+
+        std::copy( cartesian.begin(), cartesian.end(), position );
+
+        return true;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the directions of the channels of a standard layout
+ *  @param[out]     directions : [ K 2 ] azimuth and elevation (degree, SOFA convention)
+ *  @param[in]      layout : the layout
+ *
+ *  @details        The LFE channel has the direction of the center channel
+ */
+/************************************************************************************/
+void VirtualLoudspeakerRenderer::GetLayoutDirections(std::vector< double > &directions,
+                                                     const Layout &layout)
+{
+    /// L R C LFE Ls Rs Lrs Rrs Ltf Rtf Ltr Rtr
+    const double kDirections[ 12 ][ 2 ] =
+    {
+        {  30.0,  0.0 },
+        { 330.0,  0.0 },
+        {   0.0,  0.0 },
+        {   0.0,  0.0 },
+        { 110.0,  0.0 },
+        { 250.0,  0.0 },
+        { 150.0,  0.0 },
+        { 210.0,  0.0 },
+        {  45.0, 45.0 },
+        { 315.0, 45.0 },
+        { 135.0, 45.0 },
+        { 225.0, 45.0 },
+    };
+
+    std::size_t numChannels = 2;
+
+    switch( layout )
+    {
+        case kStereo        : numChannels = 2;  break;
+        case kSurround51    : numChannels = 6;  break;
+        case kSurround71    : numChannels = 8;  break;
+        case kSurround714   : numChannels = 12; break;
+    }
+
+    directions.resize( 2 * numChannels );
+
+    for( std::size_t k = 0; k < numChannels; k++ )
+    {
+        directions[ 2 * k + 0 ] = kDirections[k][0];
+        directions[ 2 * k + 1 ] = kDirections[k][1];
+    }
+
+    if( layout == kSurround71 || layout == kSurround714 )
+    {
+        /// in 7.1, the surround channels are at the sides
+        directions[ 2 * 4 ] = 90.0;
+        directions[ 2 * 5 ] = 270.0;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Class constructor
+ *  @param[in]      file : the BRIRs, Data.IR [ M R E N ] with two receivers
+ *  @param[in]      measurement : index of the measurement (listener orientation) to render
+ *  @param[in]      blockSize_ : number of samples per call to Process, a power of two
+ *
+ *  @details        Only the BRIRs of this measurement are read. Each emitter is fed by the
+ *                  channel with the same index.
+ */
+/************************************************************************************/
+VirtualLoudspeakerRenderer::VirtualLoudspeakerRenderer(const sofa::MultiSpeakerBRIR &file,
+                                                       const unsigned long measurement,
+                                                       const unsigned int blockSize_)
+: blockSize( blockSize_ )
+, numEmitters( 0 )
+, filterLength( 0 )
+, samplingRate( 0.0 )
+, fft( 2 * std::max( 1u, blockSize_ ) )
+, position( 0 )
+{
+    using namespace VirtualLoudspeakerRendererLocal;
+
+    if( file.GetNumReceivers() != 2 )
+    {
+        SOFA_THROW( "two receivers are required" );
+    }
+
+    if( measurement >= static_cast< unsigned long >( file.GetNumMeasurements() ) )
+    {
+        SOFA_THROW( "invalid measurement" );
+    }
+
+    std::vector< double > dataIR;
+    std::vector< double > dataDelay;
+
+    if( file.GetDataIR( dataIR, measurement ) == false
+       || file.GetDataDelay( dataDelay, measurement ) == false
+       || file.GetSamplingRate( samplingRate ) == false )
+    {
+        SOFA_THROW( "cannot read the BRIRs" );
+    }
+
+    const unsigned long E = static_cast< unsigned long >( file.GetNumEmitters() );
+    const unsigned long N = static_cast< unsigned long >( file.GetNumDataSamples() );
+
+    //==============================================================================
+    /// filters : Data.IR [ R E N ] delayed by Data.Delay [ R E ], stored as [ E R ]
+    std::size_t length = N;
+
+    for( std::size_t i = 0; i < 2 * E; i++ )
+    {
+        length = std::max( length, sofa::dsp::FractionalDelayLine::GetDelayedLength( N, dataDelay[i] ) );
+    }
+
+    std::vector< double > h( 2 * E * length, 0.0 );
+
+    for( unsigned long r = 0; r < 2; r++ )
+    {
+        for( unsigned long e = 0; e < E; e++ )
+        {
+            sofa::dsp::FractionalDelayLine::ApplyDelay( &h[ ( e * 2 + r ) * length ], length,
+                                                        &dataIR[ ( r * E + e ) * N ], N,
+                                                        dataDelay[ r * E + e ] );
+        }
+    }
+
+    filters.Prepare( &h[0], 2 * E, length, blockSize );
+
+    //==============================================================================
+    /// directions of the emitters : SourcePosition + EmitterPosition - ListenerPosition
+    sofa::Coordinates::Type coordinates;
+    sofa::Units::Type units;
+
+    double listener[3];
+    double source[3];
+
+    std::vector< double > emitters;
+    std::vector< std::size_t > dims;
+
+    if( file.GetListenerPosition( coordinates, units ) == false
+       || getPosition( listener, file, "ListenerPosition", coordinates, measurement ) == false
+       || file.GetSourcePosition( coordinates, units ) == false
+       || getPosition( source, file, "SourcePosition", coordinates, measurement ) == false
+       || file.GetEmitterPosition( coordinates, units ) == false
+       || file.GetValues( emitters, "EmitterPosition" ) == false )
+    {
+        SOFA_THROW( "cannot read the positions" );
+    }
+
+    file.GetVariableDimensions( dims, "EmitterPosition" );
+
+    /// EmitterPosition is [ E C I ] or [ E C M ]
+    if( dims.size() != 3 || dims[0] != E || dims[1] != 3 || emitters.size() != E * 3 * dims[2] )
+    {
+        SOFA_THROW( "invalid 'EmitterPosition' dimensions" );
+    }
+
+    const std::size_t column = ( dims[2] == 1 ) ? 0 : measurement;
+
+    std::vector< double > points( 3 * E );
+
+    for( unsigned long e = 0; e < E; e++ )
+    {
+        for( std::size_t c = 0; c < 3; c++ )
+        {
+            points[ 3 * e + c ] = emitters[ ( e * 3 + c ) * dims[2] + column ];
+        }
+    }
+
+    sofa::Geometry::ToCartesian( emitterDirections, points, coordinates );
+
+    for( unsigned long e = 0; e < E; e++ )
+    {
+        for( std::size_t c = 0; c < 3; c++ )
+        {
+            emitterDirections[ 3 * e + c ] += source[c] - listener[c];
+        }
+
+        if( sofa::Geometry::Normalize( &emitterDirections[ 3 * e ] ) <= 0.0 )
+        {
+            SOFA_THROW( "an emitter is at the listener position" );
+        }
+    }
+
+    //==============================================================================
+    numEmitters  = E;
+    filterLength = static_cast< unsigned int >( length );
+
+    const unsigned int B = blockSize;
+    const unsigned int P = filters.GetNumPartitions();
+    const unsigned int K = filters.GetNumBins();
+
+    frames.assign( E * 2 * B, 0.0f );
+    spectraRe.assign( E * P * K, 0.0f );
+    spectraIm.assign( E * P * K, 0.0f );
+
+    accumulatorRe.assign( 2 * K, 0.0f );
+    accumulatorIm.assign( 2 * K, 0.0f );
+    output.assign( 2 * B, 0.0f );
+
+    channelEmitters.resize( E );
+    channelGains.assign( E, 1.0f );
+
+    for( unsigned long e = 0; e < E; e++ )
+    {
+        channelEmitters[e] = e;
+    }
+
+    updateEmitters();
+}
+
+unsigned int VirtualLoudspeakerRenderer::GetBlockSize() const
+{
+    return blockSize;
+}
+
+unsigned long VirtualLoudspeakerRenderer::GetNumEmitters() const
+{
+    return numEmitters;
+}
+
+unsigned int VirtualLoudspeakerRenderer::GetNumPartitions() const
+{
+    return filters.GetNumPartitions();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Length of the filters (Data.IR plus the largest delay)
+ *
+ */
+/************************************************************************************/
+unsigned int VirtualLoudspeakerRenderer::GetFilterLength() const
+{
+    return filterLength;
+}
+
+double VirtualLoudspeakerRenderer::GetSamplingRate() const
+{
+    return samplingRate;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the direction of an emitter seen from the listener (unit vector)
+ *
+ */
+/************************************************************************************/
+const double * VirtualLoudspeakerRenderer::GetEmitterDirection(const unsigned long emitter) const
+{
+    SOFA_ASSERT( emitter < numEmitters );
+
+    return &emitterDirections[ 3 * emitter ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns the emitter closest to a given direction
+ *  @param[in]      azimuth : degree, counterclockwise from the front
+ *  @param[in]      elevation : degree
+ *
+ */
+/************************************************************************************/
+unsigned long VirtualLoudspeakerRenderer::FindEmitter(const double azimuth,
+                                                      const double elevation) const
+{
+    const double spherical[3] = { azimuth, elevation, 1.0 };
+
+    double direction[3];
+    sofa::Geometry::SphericalToCartesian( direction, spherical );
+
+    unsigned long nearest = 0;
+    double minAngle       = HUGE_VAL;
+
+    for( unsigned long e = 0; e < numEmitters; e++ )
+    {
+        const double angle = sofa::Geometry::AngularDistance( &emitterDirections[ 3 * e ], direction );
+
+        if( angle < minAngle )
+        {
+            minAngle = angle;
+            nearest  = e;
+        }
+    }
+
+    return nearest;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Routes the channels of a standard layout to the closest emitters
+ *
+ */
+/************************************************************************************/
+bool VirtualLoudspeakerRenderer::SetChannelLayout(const Layout &layout)
+{
+    std::vector< double > directions;
+    GetLayoutDirections( directions, layout );
+
+    return SetChannelLayout( directions );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Routes each channel to the emitter closest to its direction
+ *  @param[in]      directions : [ K 2 ] azimuth and elevation of the channels (degree)
+ *  @return         false if the directions are empty
+ *
+ */
+/************************************************************************************/
+bool VirtualLoudspeakerRenderer::SetChannelLayout(const std::vector< double > &directions)
+{
+    if( directions.empty() == true || directions.size() % 2 != 0 )
+    {
+        return false;
+    }
+
+    const std::size_t K = directions.size() / 2;
+
+    channelEmitters.resize( K );
+    channelGains.assign( K, 1.0f );
+
+    for( std::size_t k = 0; k < K; k++ )
+    {
+        channelEmitters[k] = FindEmitter( directions[ 2 * k ], directions[ 2 * k + 1 ] );
+    }
+
+    updateEmitters();
+
+    return true;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Routes one channel to a given emitter
+ *  @param[in]      channel : index of the channel (the number of channels grows if needed)
+ *  @param[in]      emitter : index of the emitter
+ *  @param[in]      gain : linear gain of the channel
+ *
+ */
+/************************************************************************************/
+void VirtualLoudspeakerRenderer::SetChannelEmitter(const unsigned int channel,
+                                                   const unsigned long emitter,
+                                                   const float gain)
+{
+    SOFA_ASSERT( emitter < numEmitters );
+
+    if( emitter >= numEmitters )
+    {
+        return;
+    }
+
+    if( channel >= channelEmitters.size() )
+    {
+        /// the new channels in between are muted
+        channelEmitters.resize( channel + 1, 0 );
+        channelGains.resize( channel + 1, 0.0f );
+    }
+
+    channelEmitters[ channel ] = emitter;
+    channelGains[ channel ]    = gain;
+
+    updateEmitters();
+}
+
+unsigned int VirtualLoudspeakerRenderer::GetNumChannels() const
+{
+    return static_cast< unsigned int >( channelEmitters.size() );
+}
+
+unsigned long VirtualLoudspeakerRenderer::GetChannelEmitter(const unsigned int channel) const
+{
+    SOFA_ASSERT( channel < channelEmitters.size() );
+
+    return channelEmitters[ channel ];
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Number of emitters fed by at least one channel, i.e. the number of
+ *                  forward FFTs per block
+ *
+ */
+/************************************************************************************/
+unsigned long VirtualLoudspeakerRenderer::GetNumActiveEmitters() const
+{
+    return static_cast< unsigned long >( activeEmitters.size() );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Lists the emitters fed by the channels, and clears the history of
+ *                  the others
+ *
+ */
+/************************************************************************************/
+void VirtualLoudspeakerRenderer::updateEmitters()
+{
+    const unsigned int B  = blockSize;
+    const std::size_t PK  = static_cast< std::size_t >( filters.GetNumPartitions() ) * filters.GetNumBins();
+
+    std::vector< bool > active( numEmitters, false );
+
+    for( std::size_t k = 0; k < channelEmitters.size(); k++ )
+    {
+        if( channelGains[k] != 0.0f )
+        {
+            active[ channelEmitters[k] ] = true;
+        }
+    }
+
+    activeEmitters.clear();
+
+    for( unsigned long e = 0; e < numEmitters; e++ )
+    {
+        if( active[e] == true )
+        {
+            activeEmitters.push_back( e );
+        }
+        else
+        {
+            std::fill( frames.begin() + e * 2 * B, frames.begin() + ( e + 1 ) * 2 * B, 0.0f );
+            std::fill( spectraRe.begin() + e * PK, spectraRe.begin() + ( e + 1 ) * PK, 0.0f );
+            std::fill( spectraIm.begin() + e * PK, spectraIm.begin() + ( e + 1 ) * PK, 0.0f );
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Clears the state of the convolution
+ *
+ */
+/************************************************************************************/
+void VirtualLoudspeakerRenderer::Reset()
+{
+    std::fill( frames.begin(), frames.end(), 0.0f );
+    std::fill( spectraRe.begin(), spectraRe.end(), 0.0f );
+    std::fill( spectraIm.begin(), spectraIm.end(), 0.0f );
+    position = 0;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Renders one block of the bed
+ *  @param[out]     left : numSamples samples
+ *  @param[out]     right : numSamples samples
+ *  @param[in]      inputs : one buffer of numSamples samples per channel
+ *  @param[in]      numChannels : number of channels, at most GetNumChannels (the others are
+ *                  silent)
+ *  @param[in]      numSamples : shall be equal to the block size
+ *  @return         false if numSamples or numChannels is out of range (nothing is done)
+ *
+ */
+/************************************************************************************/
+bool VirtualLoudspeakerRenderer::Process(float *left,
+                                         float *right,
+                                         const float *const *inputs,
+                                         const unsigned int numChannels,
+                                         const unsigned int numSamples)
+{
+    if( numSamples != blockSize || numChannels > channelEmitters.size() )
+    {
+        SOFA_ASSERT( false );
+        return false;
+    }
+
+    const unsigned int B = blockSize;
+    const unsigned int P = filters.GetNumPartitions();
+    const unsigned int K = filters.GetNumBins();
+
+    position = ( position + 1 ) % P;
+
+    std::fill( accumulatorRe.begin(), accumulatorRe.end(), 0.0f );
+    std::fill( accumulatorIm.begin(), accumulatorIm.end(), 0.0f );
+
+    //==============================================================================
+    for( std::size_t i = 0; i < activeEmitters.size(); i++ )
+    {
+        const unsigned long e = activeEmitters[i];
+
+        /// slide the input frame of the emitter and mix its channels
+        float *frame = &frames[ e * 2 * B ];
+
+        std::copy( frame + B, frame + 2 * B, frame );
+        std::fill( frame + B, frame + 2 * B, 0.0f );
+
+        for( unsigned int k = 0; k < numChannels; k++ )
+        {
+            if( channelEmitters[k] == e && channelGains[k] != 0.0f )
+            {
+                sofa::Simd::MultiplyAccumulate( frame + B, inputs[k], channelGains[k], B );
+            }
+        }
+
+        float *re = &spectraRe[ e * P * K ];
+        float *im = &spectraIm[ e * P * K ];
+
+        fft.Forward( re + position * K, im + position * K, frame );
+
+        for( unsigned int r = 0; r < 2; r++ )
+        {
+            /// partition p is applied to the frame received p blocks ago
+            for( unsigned int p = 0; p < P; p++ )
+            {
+                const unsigned int slot = ( position + P - p ) % P;
+
+                sofa::Simd::ComplexMultiplyAccumulate( &accumulatorRe[ r * K ], &accumulatorIm[ r * K ],
+                                                       re + slot * K, im + slot * K,
+                                                       filters.GetRe( e * 2 + r, p ),
+                                                       filters.GetIm( e * 2 + r, p ),
+                                                       K );
+            }
+        }
+    }
+
+    //==============================================================================
+    float *outputs[2] = { left, right };
+
+    for( unsigned int r = 0; r < 2; r++ )
+    {
+        fft.Inverse( &output[0], &accumulatorRe[ r * K ], &accumulatorIm[ r * K ] );
+
+        /// overlap-save : the first half is aliased
+        std::copy( output.begin() + B, output.end(), outputs[r] );
+    }
+
+    return true;
+}
@@ -0,0 +1,173 @@
+/*
+Copyright (c) 2013--2017, UMR STMS 9912 - Ircam-Centre Pompidou / CNRS / UPMC
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+
+Spatial acoustic data file format - AES69-2015 - Standard for File Exchange - Spatial Acoustic Data File Format
+http://www.aes.org
+
+SOFA (Spatially Oriented Format for Acoustics)
+http://www.sofaconventions.org
+
+*/
+
+
+/************************************************************************************/
+/*!
+ *   @file       SOFAVirtualLoudspeakerRenderer.h
+ *   @brief      Binaural rendering of a multichannel bed over virtual loudspeakers
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#ifndef _SOFA_VIRTUAL_LOUDSPEAKER_RENDERER_H__
+#define _SOFA_VIRTUAL_LOUDSPEAKER_RENDERER_H__
+
+#include "../src/SOFAMultiSpeakerBRIR.h"
+#include "../src/SOFAPartitionedFilterBank.h"
+#include "../src/SOFAFFT.h"
+
+namespace sofa
+{
+
+    namespace dsp
+    {
+
+        /************************************************************************************/
+        /*!
+         *  @class          VirtualLoudspeakerRenderer
+         *  @brief          Binaural rendering of a multichannel bed over the loudspeakers
+         *                  (emitters) of one measurement of a MultiSpeakerBRIR
+         *
+         *  @details        Each channel is routed to an emitter, by default the one closest to
+         *                  its direction (EmitterPosition relative to the listener, in the frame
+         *                  of the room). The channels routed to the same emitter are mixed, and
+         *                  each emitter fed by at least one channel is transformed once and
+         *                  multiplied with the partitions of its two BRIRs into one
+         *                  frequency-domain accumulator per ear (uniformly partitioned
+         *                  overlap-save) : E emitters cost E forward FFTs plus 2 inverse FFTs
+         *                  per block, without latency.
+         *
+         *                  Data.Delay is included in the filters, fractional delays being
+         *                  interpolated (FractionalDelayLine::ApplyDelay).
+         *                  The routing shall not be changed while processing.
+         *                  Process does not allocate.
+         */
+        /************************************************************************************/
+        class SOFA_API VirtualLoudspeakerRenderer
+        {
+        public:
+            /// standard channel layouts (ITU-R BS.775 / BS.2051 channel order)
+            enum Layout
+            {
+                kStereo         = 0,    ///< L R
+                kSurround51,            ///< L R C LFE Ls Rs
+                kSurround71,            ///< L R C LFE Ls Rs Lrs Rrs
+                kSurround714            ///< L R C LFE Ls Rs Lrs Rrs Ltf Rtf Ltr Rtr
+            };
+
+            static void GetLayoutDirections(std::vector< double > &directions,
+                                            const Layout &layout);
+
+        public:
+            VirtualLoudspeakerRenderer(const sofa::MultiSpeakerBRIR &file,
+                                       const unsigned long measurement,
+                                       const unsigned int blockSize);
+            ~VirtualLoudspeakerRenderer() {};
+
+            //==============================================================================
+            unsigned int GetBlockSize() const;
+            unsigned long GetNumEmitters() const;
+            unsigned int GetNumPartitions() const;
+            unsigned int GetFilterLength() const;
+            double GetSamplingRate() const;
+
+            const double * GetEmitterDirection(const unsigned long emitter) const;
+
+            unsigned long FindEmitter(const double azimuth,
+                                      const double elevation) const;
+
+            //==============================================================================
+            bool SetChannelLayout(const Layout &layout);
+            bool SetChannelLayout(const std::vector< double > &directions);
+
+            void SetChannelEmitter(const unsigned int channel,
+                                   const unsigned long emitter,
+                                   const float gain = 1.0f);
+
+            unsigned int GetNumChannels() const;
+            unsigned long GetChannelEmitter(const unsigned int channel) const;
+            unsigned long GetNumActiveEmitters() const;
+
+            //==============================================================================
+            bool Process(float *left,
+                         float *right,
+                         const float *const *inputs,
+                         const unsigned int numChannels,
+                         const unsigned int numSamples);
+
+            void Reset();
+
+        private:
+            void updateEmitters();
+
+        private:
+            const unsigned int blockSize;
+            unsigned long numEmitters;
+            unsigned int filterLength;
+            double samplingRate;
+
+            std::vector< double > emitterDirections;    ///< [ E 3 ] unit vectors
+
+            sofa::dsp::PartitionedFilterBank filters;   ///< filter e * 2 + r
+
+            std::vector< unsigned long > channelEmitters;   ///< [ K ]
+            std::vector< float > channelGains;              ///< [ K ]
+            std::vector< unsigned long > activeEmitters;    ///< emitters fed by at least one channel
+
+            sofa::dsp::FFT fft;
+
+            std::vector< float > frames;                ///< [ E 2B ] last two input blocks of each emitter
+            std::vector< float > spectraRe;             ///< [ E P B+1 ] spectra of the last P frames
+            std::vector< float > spectraIm;
+            unsigned int position;                      ///< slot of the most recent frame
+
+            std::vector< float > accumulatorRe;         ///< [ 2 B+1 ] per ear
+            std::vector< float > accumulatorIm;
+            std::vector< float > output;                ///< [ 2B ]
+
+        private:
+            /// avoid shallow and copy constructor
+            SOFA_AVOID_COPY_CONSTRUCTOR( VirtualLoudspeakerRenderer );
+        };
+
+    }
+
+}
+
+#endif /* _SOFA_VIRTUAL_LOUDSPEAKER_RENDERER_H__ */
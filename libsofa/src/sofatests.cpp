@@ -0,0 +1,3574 @@
+/************************************************************************************/
+/*!
+ *   @file       sofatests.cpp
+ *   @brief      Numerical tests of the signal processing classes (sofa::dsp) against
+ *               reference implementations ; returns the number of failed tests
+ *
+ *   @date       18/10/2026
+ *
+ */
+/************************************************************************************/
+#include "../src/SOFA.h"
+#include "../src/SOFAString.h"
+#include "../src/SOFAExceptions.h"
+#include "ncDim.h"
+#include "ncVar.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <thread>
+
+static const double kPi = 3.14159265358979323846;
+
+/// SOFA file written by the tests (in the working directory), removed afterwards
+static const std::string kTemporaryFile = "sofatests.sofa";
+
+static unsigned int numFailures = 0;
+
+/************************************************************************************/
+/*!
+ *  @brief          Prints the result of one test, and counts the failures
+ *  @param[in]      name : name of the test
+ *  @param[in]      error : measured error
+ *  @param[in]      tolerance : largest error accepted
+ *
+ */
+/************************************************************************************/
+static void Report(const std::string &name,
+                   const double error,
+                   const double tolerance,
+                   std::ostream & output = std::cout)
+{
+    /// a NaN error fails
+    const bool passed = ( error <= tolerance );
+
+    if( passed == false )
+    {
+        numFailures++;
+    }
+
+    std::ostringstream value;
+    value << std::scientific << std::setprecision( 2 ) << error;
+
+    output << sofa::String::PadWith( name, 56 );
+    output << sofa::String::PadWith( value.str(), 16 );
+    output << ( ( passed == true ) ? "passed" : "FAILED" ) << std::endl;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Returns true if a function throws a sofa::Exception (expected errors
+ *                  are not logged)
+ *
+ */
+/************************************************************************************/
+static bool Throws(const std::function< void() > &function)
+{
+    const bool logged = sofa::Exception::IsLoggedToCerr();
+    sofa::Exception::LogToCerr( false );
+
+    bool thrown = false;
+
+    try
+    {
+        function();
+    }
+    catch( const sofa::Exception & )
+    {
+        thrown = true;
+    }
+
+    sofa::Exception::LogToCerr( logged );
+
+    return thrown;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Largest absolute difference between two arrays
+ *
+ */
+/************************************************************************************/
+template< typename T, typename U >
+static double MaxError(const T *a,
+                       const U *b,
+                       const std::size_t size)
+{
+    double error = 0.0;
+
+    for( std::size_t i = 0; i < size; i++ )
+    {
+        error = std::max( error, std::fabs( static_cast< double >( a[i] ) - static_cast< double >( b[i] ) ) );
+    }
+
+    return error;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Uniform white noise in [ -1 1 ]
+ *
+ */
+/************************************************************************************/
+template< typename T >
+static void Noise(std::vector< T > &values,
+                  const std::size_t size,
+                  const unsigned int seed)
+{
+    std::mt19937 generator( seed );
+    std::uniform_real_distribution< double > distribution( -1.0, 1.0 );
+
+    values.resize( size );
+
+    for( std::size_t i = 0; i < size; i++ )
+    {
+        values[i] = static_cast< T >( distribution( generator ) );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Forces the FFT kernel of all the sizes up to maxSize, through a
+ *                  wisdom file
+ *  @return         true on success
+ *
+ */
+/************************************************************************************/
+static bool ForceKernel(const sofa::dsp::FFT::Kernel kernel,
+                        const unsigned int maxSize)
+{
+    const std::string path = "sofatests.wisdom";
+
+    /// an empty wisdom gives the header of the file
+    sofa::dsp::FFT::ForgetWisdom();
+
+    if( sofa::dsp::FFT::SaveWisdom( path ) == false )
+    {
+        return false;
+    }
+
+    {
+        std::ofstream file( path.c_str(), std::ios::app );
+
+        for( unsigned int size = 4; size <= maxSize; size *= 2 )
+        {
+            file << size << " " << sofa::dsp::FFT::GetKernelName( kernel ) << std::endl;
+        }
+    }
+
+    const bool loaded = sofa::dsp::FFT::LoadWisdom( path );
+
+    std::remove( path.c_str() );
+
+    return loaded;
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          FFT : round trip, and comparison with a direct DFT (in double),
+ *                  for each kernel
+ *
+ */
+/************************************************************************************/
+static void TestFFT()
+{
+    const unsigned int kMaxSize = 4096;
+
+    for( int k = 0; k < sofa::dsp::FFT::kNumKernels; k++ )
+    {
+        const sofa::dsp::FFT::Kernel kernel = static_cast< sofa::dsp::FFT::Kernel >( k );
+        const std::string kernelName        = sofa::dsp::FFT::GetKernelName( kernel );
+
+        if( ForceKernel( kernel, kMaxSize ) == false )
+        {
+            Report( "FFT " + kernelName + " wisdom", 1.0, 0.0 );
+            continue;
+        }
+
+        double roundTripError = 0.0;
+        double referenceError = 0.0;
+
+        for( unsigned int N = 4; N <= kMaxSize; N *= 2 )
+        {
+            sofa::dsp::FFT fft( N );
+
+            const unsigned int K = fft.GetNumBins();
+
+            std::vector< float > input;
+            Noise( input, N, N );
+
+            std::vector< float > re( K );
+            std::vector< float > im( K );
+            std::vector< float > output( N );
+
+            fft.Forward( &re[0], &im[0], &input[0] );
+            fft.Inverse( &output[0], &re[0], &im[0] );
+
+            roundTripError = std::max( roundTripError, MaxError( &output[0], &input[0], N ) );
+
+            /// direct DFT ; the error is relative to sqrt( N ), the magnitude of the bins
+            if( N <= 1024 )
+            {
+                for( unsigned int b = 0; b < K; b++ )
+                {
+                    double sumRe = 0.0;
+                    double sumIm = 0.0;
+
+                    for( unsigned int n = 0; n < N; n++ )
+                    {
+                        const double phase = -2.0 * kPi * static_cast< double >( ( static_cast< unsigned long >( b ) * n ) % N ) / N;
+
+                        sumRe += input[n] * std::cos( phase );
+                        sumIm += input[n] * std::sin( phase );
+                    }
+
+                    const double error = std::max( std::fabs( re[b] - sumRe ), std::fabs( im[b] - sumIm ) );
+
+                    referenceError = std::max( referenceError, error / std::sqrt( static_cast< double >( N ) ) );
+                }
+            }
+
+            if( fft.GetKernel() != kernel )
+            {
+                Report( "FFT " + kernelName + " kernel of size " + std::to_string( N ), 1.0, 0.0 );
+            }
+        }
+
+        Report( "FFT " + kernelName + " round trip (4 to 4096)", roundTripError, 1e-5 );
+        Report( "FFT " + kernelName + " vs direct DFT (4 to 1024)", referenceError, 1e-5 );
+    }
+
+    sofa::dsp::FFT::ForgetWisdom();
+
+    /// the imaginary parts of the DC and Nyquist bins are ignored by Inverse
+    {
+        const unsigned int N = 256;
+
+        sofa::dsp::FFT fft( N );
+
+        std::vector< float > input;
+        Noise( input, N, 1 );
+
+        std::vector< float > re( N / 2 + 1 );
+        std::vector< float > im( N / 2 + 1 );
+        std::vector< float > output( N );
+
+        fft.Forward( &re[0], &im[0], &input[0] );
+
+        im[0]     = 10.0f;
+        im[N / 2] = -10.0f;
+
+        fft.Inverse( &output[0], &re[0], &im[0] );
+
+        Report( "FFT inverse ignores DC and Nyquist imaginary parts", MaxError( &output[0], &input[0], N ), 1e-5 );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Direct convolution (in double), output truncated to the input length
+ *
+ */
+/************************************************************************************/
+static void Convolve(std::vector< double > &output,
+                     const std::vector< float > &input,
+                     const std::vector< double > &filter)
+{
+    output.assign( input.size(), 0.0 );
+
+    for( std::size_t n = 0; n < input.size(); n++ )
+    {
+        const std::size_t numTaps = std::min( filter.size(), n + 1 );
+
+        double sum = 0.0;
+
+        for( std::size_t k = 0; k < numTaps; k++ )
+        {
+            sum += filter[k] * input[ n - k ];
+        }
+
+        output[n] = sum;
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes a SimpleFreeFieldHRIR file (replaced if it exists)
+ *  @param[in]      positions : [ M 3 ] spherical source positions
+ *  @param[in]      ir : [ M R N ], R = 2
+ *  @param[in]      delay : [ I R ] or [ M R ]
+ *
+ */
+/************************************************************************************/
+static void WriteSimpleFreeFieldHRIR(const std::string &path,
+                                     const std::vector< double > &positions,
+                                     const std::vector< double > &ir,
+                                     const std::vector< double > &delay,
+                                     const double samplingRate)
+{
+    const std::size_t M = positions.size() / 3;
+    const std::size_t R = 2;
+    const std::size_t N = ir.size() / ( M * R );
+
+    const netCDF::NcFile theFile( path, netCDF::NcFile::replace, netCDF::NcFile::nc4 );
+
+    sofa::Attributes attributes;
+    attributes.ResetToDefault();
+
+    attributes.Set( sofa::Attributes::kSOFAConventions, "SimpleFreeFieldHRIR" );
+    attributes.Set( sofa::Attributes::kDataType, "FIR" );
+    attributes.Set( sofa::Attributes::kRoomType, "free field" );
+
+    for( unsigned int k = 0; k < sofa::Attributes::kNumAttributes; k++ )
+    {
+        const sofa::Attributes::Type attType = static_cast< sofa::Attributes::Type >(k);
+
+        theFile.putAtt( sofa::Attributes::GetName( attType ), attributes.Get( attType ) );
+    }
+
+    theFile.putAtt( "DatabaseName", "sofatests" );
+
+    theFile.addDim( "C", 3 );
+    theFile.addDim( "I", 1 );
+    theFile.addDim( "M", M );
+    theFile.addDim( "R", R );
+    theFile.addDim( "E", 1 );
+    theFile.addDim( "N", N );
+
+    const auto addVariable = [ &theFile ](const std::string &name,
+                                          const std::vector< std::string > &dimNames,
+                                          const double *values,
+                                          const std::string &type,
+                                          const std::string &units)
+    {
+        const netCDF::NcVar var = theFile.addVar( name, "double", dimNames );
+
+        var.putVar( values );
+
+        if( type.empty() == false )
+        {
+            var.putAtt( "Type", type );
+            var.putAtt( "Units", units );
+        }
+    };
+
+    const double origin[3]      = { 0.0, 0.0, 0.0 };
+    const double up[3]          = { 0.0, 0.0, 1.0 };
+    const double view[3]        = { 1.0, 0.0, 0.0 };
+    const double receivers[6]   = { 0.0, 0.09, 0.0, 0.0, -0.09, 0.0 };
+
+    {
+        const netCDF::NcVar var = theFile.addVar( "Data.SamplingRate", "double", "I" );
+        var.putVar( &samplingRate );
+        var.putAtt( "Units", "hertz" );
+    }
+
+    addVariable( "Data.Delay", { ( delay.size() == R ) ? "I" : "M", "R" }, &delay[0], "", "" );
+    addVariable( "Data.IR", { "M", "R", "N" }, &ir[0], "", "" );
+    addVariable( "ListenerPosition", { "I", "C" }, origin, "cartesian", "meter" );
+    addVariable( "ListenerUp", { "I", "C" }, up, "", "" );
+    addVariable( "ListenerView", { "I", "C" }, view, "cartesian", "meter" );
+    addVariable( "ReceiverPosition", { "R", "C", "I" }, receivers, "cartesian", "meter" );
+    addVariable( "SourcePosition", { "M", "C" }, &positions[0], "spherical", "degree, degree, meter" );
+    addVariable( "SourceUp", { "I", "C" }, up, "", "" );
+    addVariable( "SourceView", { "I", "C" }, view, "cartesian", "meter" );
+    addVariable( "EmitterPosition", { "E", "C", "I" }, origin, "cartesian", "meter" );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          NonUniformConvolver : uniform head and non-uniform tail partitions,
+ *                  computed in the audio thread or by a worker, vs direct convolution
+ *
+ */
+/************************************************************************************/
+static void TestNonUniformConvolver()
+{
+    const unsigned int kBlockSize        = 64;
+    const unsigned int kMaxPartitionSize = 1024;
+    const std::size_t kFilterLength      = 12000;
+    const std::size_t kInputLength       = 16384;
+
+    /// exponentially decaying noise, like a room response
+    std::vector< double > filter;
+    Noise( filter, kFilterLength, 2 );
+
+    for( std::size_t k = 0; k < kFilterLength; k++ )
+    {
+        filter[k] *= std::exp( -3.0 * static_cast< double >( k ) / kFilterLength );
+    }
+
+    std::vector< float > input;
+    Noise( input, kInputLength, 3 );
+
+    std::vector< double > reference;
+    Convolve( reference, input, filter );
+
+    double peak = 0.0;
+    for( std::size_t n = 0; n < kInputLength; n++ )
+    {
+        peak = std::max( peak, std::fabs( reference[n] ) );
+    }
+
+    for( int threaded = 0; threaded < 2; threaded++ )
+    {
+        std::shared_ptr< sofa::dsp::ConvolutionWorker > worker;
+
+        if( threaded == 1 )
+        {
+            worker.reset( new sofa::dsp::ConvolutionWorker() );
+        }
+
+        sofa::dsp::NonUniformConvolver convolver( &filter[0], kFilterLength, kBlockSize, worker, kMaxPartitionSize );
+
+        std::vector< float > output( kInputLength );
+
+        /// Process does not wait for the worker : the blocks are paced as an audio callback at 48 kHz
+        const std::chrono::microseconds period( kBlockSize * 1000000 / 48000 );
+
+        for( std::size_t n = 0; n < kInputLength; n += kBlockSize )
+        {
+            convolver.Process( &output[n], &input[n], kBlockSize );
+
+            if( threaded == 1 )
+            {
+                std::this_thread::sleep_for( period );
+            }
+        }
+
+        const std::string name = ( threaded == 1 ) ? "with a worker" : "in the audio thread";
+
+        Report( "NonUniformConvolver " + name + " (" + std::to_string( convolver.GetNumSegments() ) + " segments)",
+                MaxError( &output[0], &reference[0], kInputLength ) / peak, 1e-5 );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          BinauralConvolver : uniformly partitioned and direct-form rendering of
+ *                  one measurement, with integer Data.Delay, vs direct convolution
+ *
+ */
+/************************************************************************************/
+static void TestBinauralConvolver()
+{
+    const unsigned int kBlockSize   = 128;
+    const std::size_t kInputLength  = 8192;
+    const std::size_t M             = 4;
+    const std::size_t N             = 700;
+    const std::size_t kMeasurement  = 2;
+
+    std::vector< double > positions( 3 * M );
+    for( std::size_t m = 0; m < M; m++ )
+    {
+        positions[ 3 * m ]      = 90.0 * m;
+        positions[ 3 * m + 1 ]  = 0.0;
+        positions[ 3 * m + 2 ]  = 1.2;
+    }
+
+    std::vector< double > ir;
+    Noise( ir, M * 2 * N, 4 );
+
+    std::vector< float > input;
+    Noise( input, kInputLength, 5 );
+
+    /// integer delays are exact ; fractional delays are compared with FractionalDelayLine::ApplyDelay
+    const std::vector< double > delays[2] = { { 3.0, 7.0 }, { 20.37, 26.81 } };
+
+    for( std::size_t d = 0; d < 2; d++ )
+    {
+        const std::vector< double > &delay = delays[d];
+
+        WriteSimpleFreeFieldHRIR( kTemporaryFile, positions, ir, delay, 48000.0 );
+
+        std::vector< double > reference[2];
+        double peak = 0.0;
+
+        for( std::size_t r = 0; r < 2; r++ )
+        {
+            const double *h = &ir[ ( kMeasurement * 2 + r ) * N ];
+
+            std::vector< double > filter( sofa::dsp::FractionalDelayLine::GetDelayedLength( N, delay[r] ) );
+            sofa::dsp::FractionalDelayLine::ApplyDelay( &filter[0], filter.size(), h, N, delay[r] );
+
+            Convolve( reference[r], input, filter );
+
+            for( std::size_t n = 0; n < kInputLength; n++ )
+            {
+                peak = std::max( peak, std::fabs( reference[r][n] ) );
+            }
+        }
+
+        {
+            const sofa::SimpleFreeFieldHRIR file( kTemporaryFile );
+
+            const sofa::dsp::BinauralConvolver::Method methods[2] = { sofa::dsp::BinauralConvolver::kPartitioned,
+                                                                      sofa::dsp::BinauralConvolver::kDirect };
+
+            for( int i = 0; i < 2; i++ )
+            {
+                sofa::dsp::BinauralConvolver convolver( file, kBlockSize, methods[i] );
+
+                convolver.SetMeasurement( kMeasurement );
+                convolver.Reset();
+
+                std::vector< float > left( kInputLength );
+                std::vector< float > right( kInputLength );
+
+                for( std::size_t n = 0; n < kInputLength; n += kBlockSize )
+                {
+                    convolver.Process( &left[n], &right[n], &input[n], kBlockSize );
+                }
+
+                const double error = std::max( MaxError( &left[0], &reference[0][0], kInputLength ),
+                                               MaxError( &right[0], &reference[1][0], kInputLength ) );
+
+                const std::string name = std::string( ( i == 0 ) ? "partitioned" : "direct form" )
+                                       + ( ( d == 0 ) ? ", integer delays" : ", fractional delays" );
+
+                Report( "BinauralConvolver " + name, error / peak, 1e-5 );
+            }
+        }
+    }
+
+    /// negative delays : all the delays are shifted by the same offset, the ITD is kept
+    {
+        WriteSimpleFreeFieldHRIR( kTemporaryFile, positions, ir, { -1.0, 2.0 }, 48000.0 );
+
+        const sofa::SimpleFreeFieldHRIR file( kTemporaryFile );
+        sofa::dsp::BinauralConvolver convolver( file, kBlockSize );
+
+        convolver.SetMeasurement( kMeasurement );
+        convolver.Reset();
+
+        std::vector< float > left( kInputLength );
+        std::vector< float > right( kInputLength );
+
+        for( std::size_t n = 0; n < kInputLength; n += kBlockSize )
+        {
+            convolver.Process( &left[n], &right[n], &input[n], kBlockSize );
+        }
+
+        /// same as the delays { 0, 3 }
+        double error = std::fabs( convolver.GetDelayOffset() - 1.0 );
+        double peak  = 0.0;
+
+        const std::size_t shifts[2] = { 0, 3 };
+
+        for( std::size_t r = 0; r < 2; r++ )
+        {
+            std::vector< double > filter( shifts[r], 0.0 );
+            filter.insert( filter.end(), ir.begin() + ( kMeasurement * 2 + r ) * N, ir.begin() + ( kMeasurement * 2 + r + 1 ) * N );
+
+            std::vector< double > reference;
+            Convolve( reference, input, filter );
+
+            for( std::size_t n = 0; n < kInputLength; n++ )
+            {
+                peak = std::max( peak, std::fabs( reference[n] ) );
+            }
+
+            error = std::max( error, MaxError( ( r == 0 ) ? &left[0] : &right[0], &reference[0], kInputLength ) / peak );
+        }
+
+        Report( "BinauralConvolver negative delays (common offset)", error, 1e-5 );
+    }
+
+    std::remove( kTemporaryFile.c_str() );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          MinimumPhaseDecomposition : delayed minimum-phase IRs give back the
+ *                  minimum-phase filters, and their delays
+ *
+ */
+/************************************************************************************/
+static void TestMinimumPhaseDecomposition()
+{
+    const std::size_t M = 2;
+    const std::size_t N = 256;
+
+    /// h[n] = a^n truncated to N - d samples (its zeros have radius a : minimum phase),
+    /// decaying slowly enough for the end of the filters to matter, delayed by d samples
+    const auto integerDelay = [ & ](const std::size_t i)
+    {
+        return 5 + 3 * i;
+    };
+
+    const auto filter = [ & ](const std::size_t i,
+                              const std::size_t n)
+    {
+        const double a = 0.98 + 0.005 * i;
+
+        return ( n + integerDelay( i ) < N ) ? std::pow( a, static_cast< double >( n ) ) : 0.0;
+    };
+
+    std::vector< double > ir( M * 2 * N, 0.0 );
+    for( std::size_t i = 0; i < M * 2; i++ )
+    {
+        for( std::size_t n = integerDelay( i ); n < N; n++ )
+        {
+            ir[ i * N + n ] = filter( i, n - integerDelay( i ) );
+        }
+    }
+
+    const std::vector< double > positions   = { 0.0, 0.0, 1.2, 90.0, 0.0, 1.2 };
+    const std::vector< double > delay       = { 0.25, 0.75 };
+
+    WriteSimpleFreeFieldHRIR( kTemporaryFile, positions, ir, delay, 48000.0 );
+
+    sofa::FIRDataSet dataSet;
+    {
+        const sofa::SimpleFreeFieldHRIR file( kTemporaryFile );
+        dataSet.Load( file );
+    }
+
+    std::remove( kTemporaryFile.c_str() );
+
+    /// full length (no fade), and truncated to 64 samples (faded over the last 8)
+    const std::size_t lengths[] = { N, 64 };
+
+    for( std::size_t l = 0; l < sizeof( lengths ) / sizeof( std::size_t ); l++ )
+    {
+        const std::size_t L = lengths[l];
+        const std::string name = "MinimumPhaseDecomposition to " + std::to_string( L ) + " samples";
+
+        sofa::MinimumPhaseDecomposition decomposition;
+
+        if( decomposition.Compute( dataSet, ( L == N ) ? 0 : L ) == false || decomposition.GetNumDataSamples() != L )
+        {
+            Report( name, 1.0, 0.0 );
+            continue;
+        }
+
+        /// the fade only applies to truncated filters
+        const std::size_t compared = ( L == N ) ? L : L - L / 8;
+
+        double error        = 0.0;
+        double delayError   = 0.0;
+
+        for( std::size_t m = 0; m < M; m++ )
+        {
+            for( std::size_t r = 0; r < 2; r++ )
+            {
+                const std::size_t i = m * 2 + r;
+                const double *h     = decomposition.GetIR( m, r );
+
+                for( std::size_t n = 0; n < compared; n++ )
+                {
+                    error = std::max( error, std::fabs( h[n] - filter( i, n ) ) );
+                }
+
+                const double expectedDelay = static_cast< double >( integerDelay( i ) ) + delay[r];
+
+                delayError = std::max( delayError, std::fabs( decomposition.GetDelay( m, r ) - expectedDelay ) );
+            }
+        }
+
+        Report( name, error, 1e-4 );
+        Report( name + " (delay)", delayError, 0.01 );
+    }
+
+    sofa::MinimumPhaseDecomposition::ClearCache();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          FIRDataSet : Morton and Hilbert reordering of a grid of measurements, each
+ *                  IR, delay and position being traced back to its index in the file
+ *
+ */
+/************************************************************************************/
+static void TestFIRDataSet()
+{
+    const std::size_t N = 8;
+
+    /// 12 azimuths x 3 elevations, the elevation varying fastest
+    std::vector< double > positions;
+    for( int azimuth = 0; azimuth < 360; azimuth += 30 )
+    {
+        for( int elevation = -30; elevation <= 30; elevation += 30 )
+        {
+            positions.push_back( azimuth );
+            positions.push_back( elevation );
+            positions.push_back( 1.2 );
+        }
+    }
+
+    const std::size_t M = positions.size() / 3;
+
+    /// every sample identifies its measurement, receiver and index
+    const auto value = [ & ](const std::size_t m,
+                             const std::size_t r,
+                             const std::size_t n)
+    {
+        return static_cast< double >( m * 100 + r * 10 + n );
+    };
+
+    std::vector< double > ir( M * 2 * N );
+    std::vector< double > delay( M * 2 );
+
+    for( std::size_t m = 0; m < M; m++ )
+    {
+        for( std::size_t r = 0; r < 2; r++ )
+        {
+            for( std::size_t n = 0; n < N; n++ )
+            {
+                ir[ ( m * 2 + r ) * N + n ] = value( m, r, n );
+            }
+
+            delay[ m * 2 + r ] = static_cast< double >( m ) + 0.5 * static_cast< double >( r );
+        }
+    }
+
+    WriteSimpleFreeFieldHRIR( kTemporaryFile, positions, ir, delay, 48000.0 );
+
+    const sofa::FIRDataSet::Ordering orderings[]   = { sofa::FIRDataSet::kMortonOrder, sofa::FIRDataSet::kHilbertOrder };
+    const std::string names[]                       = { "Morton", "Hilbert" };
+
+    for( std::size_t o = 0; o < 2; o++ )
+    {
+        sofa::FIRDataSet dataSet;
+        {
+            const sofa::SimpleFreeFieldHRIR file( kTemporaryFile );
+            dataSet.Load( file, orderings[o] );
+        }
+
+        /// Load and Reorder of a data set in the original order shall give the same result
+        sofa::FIRDataSet reordered;
+        {
+            const sofa::SimpleFreeFieldHRIR file( kTemporaryFile );
+            reordered.Load( file );
+        }
+        reordered.Reorder( orderings[o] );
+
+        double indexError   = ( dataSet.GetNumMeasurements() == M ) ? 0.0 : 1.0;
+        double dataError    = 0.0;
+        std::size_t moved   = 0;
+
+        std::vector< bool > seen( M, false );
+
+        for( std::size_t k = 0; k < M && indexError == 0.0; k++ )
+        {
+            const unsigned long m = dataSet.GetOriginalIndex( k );
+
+            if( m >= M || seen[m] == true || dataSet.GetMeasurementIndex( m ) != k || reordered.GetOriginalIndex( k ) != m )
+            {
+                indexError = 1.0;
+                break;
+            }
+
+            seen[m] = true;
+            moved  += ( m != k ) ? 1 : 0;
+
+            for( std::size_t r = 0; r < 2; r++ )
+            {
+                const double *h = dataSet.GetIR( k, r );
+                const double *g = reordered.GetIR( k, r );
+
+                for( std::size_t n = 0; n < N; n++ )
+                {
+                    dataError = std::max( dataError, std::fabs( h[n] - value( m, r, n ) ) );
+                    dataError = std::max( dataError, std::fabs( g[n] - value( m, r, n ) ) );
+                }
+
+                dataError = std::max( dataError, std::fabs( dataSet.GetDelay( k, r ) - delay[ m * 2 + r ] ) );
+                dataError = std::max( dataError, std::fabs( reordered.GetDelay( k, r ) - delay[ m * 2 + r ] ) );
+            }
+
+            for( std::size_t c = 0; c < 3; c++ )
+            {
+                dataError = std::max( dataError, std::fabs( dataSet.GetSourcePosition( k )[c] - positions[ m * 3 + c ] ) );
+            }
+        }
+
+        /// the grid is not already sorted along the curve
+        if( moved == 0 )
+        {
+            indexError = 1.0;
+        }
+
+        Report( "FIRDataSet " + names[o] + " order (indices)", indexError, 0.0 );
+        Report( "FIRDataSet " + names[o] + " order (IRs, delays, positions)", dataError, 0.0 );
+
+        /// back to the order of the file
+        dataSet.Reorder( sofa::FIRDataSet::kOriginalOrder );
+
+        double restoreError = 0.0;
+
+        for( std::size_t m = 0; m < M; m++ )
+        {
+            restoreError = std::max( restoreError, std::fabs( static_cast< double >( dataSet.GetOriginalIndex( m ) ) - static_cast< double >( m ) ) );
+            restoreError = std::max( restoreError, std::fabs( dataSet.GetIR( m, 1 )[ N - 1 ] - value( m, 1, N - 1 ) ) );
+        }
+
+        Report( "FIRDataSet " + names[o] + " order back to the original", restoreError, 0.0 );
+    }
+
+    std::remove( kTemporaryFile.c_str() );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Hyperslabs : Data.IR written in single precision by FileWriter, read back
+ *                  whole and by slabs in both precisions ; slabs out of the dimensions are
+ *                  rejected
+ *
+ */
+/************************************************************************************/
+static void TestHyperslabs()
+{
+    const std::size_t M = 4;
+    const std::size_t R = 2;
+    const std::size_t N = 16;
+
+    /// values exactly representable in single precision
+    std::vector< double > ir( M * R * N );
+    for( std::size_t i = 0; i < ir.size(); i++ )
+    {
+        ir[i] = static_cast< double >( i ) / 64.0 - 1.0;
+    }
+
+    const std::vector< double > positions   = { 0.0, 0.0, 1.2, 90.0, 0.0, 1.2, 180.0, 0.0, 1.2, 270.0, 0.0, 1.2 };
+    const std::vector< double > delay       = { 0.0, 0.0 };
+
+    WriteSimpleFreeFieldHRIR( kTemporaryFile, positions, ir, delay, 48000.0 );
+
+    const std::string floatFile = "sofatests_float.sofa";
+    bool written = false;
+    {
+        const sofa::SimpleFreeFieldHRIR file( kTemporaryFile );
+
+        sofa::FileWriter writer( file );
+        writer.SetFloatStorage( "Data.IR" );
+
+        written = writer.Write( floatFile );
+    }
+
+    std::remove( kTemporaryFile.c_str() );
+
+    if( written == false )
+    {
+        Report( "Hyperslab float storage", 1.0, 0.0 );
+        return;
+    }
+
+    {
+        const netCDF::NcFile theFile( floatFile, netCDF::NcFile::read );
+        const bool isFloat = ( theFile.getVar( "Data.IR" ).getType() == netCDF::ncFloat );
+
+        Report( "Hyperslab float storage", ( isFloat == true ) ? 0.0 : 1.0, 0.0 );
+    }
+
+    /// the file is closed before being removed
+    {
+        const sofa::SimpleFreeFieldHRIR file( floatFile );
+
+        //==============================================================================
+        /// whole variable
+        double wholeError = 0.0;
+        {
+            std::vector< double > values;
+            std::vector< float > floatValues;
+
+            if( file.GetValues( values, "Data.IR" ) == false || values.size() != ir.size()
+               || file.GetValues( floatValues, "Data.IR" ) == false || floatValues.size() != ir.size() )
+            {
+                wholeError = 1.0;
+            }
+            else
+            {
+                wholeError = std::max( MaxError( &values[0], &ir[0], ir.size() ), MaxError( &floatValues[0], &ir[0], ir.size() ) );
+            }
+        }
+
+        Report( "Hyperslab whole Data.IR (double and float)", wholeError, 0.0 );
+
+        //==============================================================================
+        /// measurements 1 and 2, second receiver, samples 4 to 11
+        double slabError = 0.0;
+        {
+            const std::vector< std::size_t > start = { 1, 1, 4 };
+            const std::vector< std::size_t > count = { 2, 1, 8 };
+
+            std::vector< double > values( 16, 0.0 );
+            std::vector< float > floatValues( 16, 0.0f );
+
+            if( file.GetValues( &values[0], start, count, "Data.IR" ) == false
+               || file.GetValues( &floatValues[0], start, count, "Data.IR" ) == false )
+            {
+                slabError = 1.0;
+            }
+
+            for( std::size_t m = 0; m < 2; m++ )
+            {
+                for( std::size_t n = 0; n < 8; n++ )
+                {
+                    const double expected = ir[ ( ( m + 1 ) * R + 1 ) * N + n + 4 ];
+
+                    slabError = std::max( slabError, std::fabs( values[ m * 8 + n ] - expected ) );
+                    slabError = std::max( slabError, std::fabs( floatValues[ m * 8 + n ] - expected ) );
+                }
+            }
+        }
+
+        Report( "Hyperslab partial Data.IR (double and float)", slabError, 0.0 );
+
+        //==============================================================================
+        /// slabs out of the dimensions, or of another rank
+        std::size_t numAccepted = 0;
+        {
+            const std::size_t huge = static_cast< std::size_t >( -1 );
+
+            const std::vector< std::vector< std::size_t > > starts = { { M, 0, 0 }, { 0, 0, 10 }, { M + 1, 0, 0 }, { 0, 1, 0 }, { 0, 0 } };
+            const std::vector< std::vector< std::size_t > > counts = { { 1, 1, 1 }, { 1, 1, 7 }, { 0, 0, 0 }, { 1, 1, huge }, { 1, 1 } };
+
+            std::vector< double > values( M * R * N );
+            std::vector< float > floatValues( M * R * N );
+
+            for( std::size_t i = 0; i < starts.size(); i++ )
+            {
+                numAccepted += ( file.GetValues( &values[0], starts[i], counts[i], "Data.IR" ) == true ) ? 1 : 0;
+                numAccepted += ( file.GetValues( &floatValues[0], starts[i], counts[i], "Data.IR" ) == true ) ? 1 : 0;
+            }
+
+            /// an empty slab at the end of the dimensions is valid
+            const std::vector< std::size_t > start = { M, R, N };
+            const std::vector< std::size_t > count = { 0, 0, 0 };
+
+            numAccepted += ( file.GetValues( &values[0], start, count, "Data.IR" ) == false ) ? 1 : 0;
+        }
+
+        Report( "Hyperslab out of the dimensions rejected", static_cast< double >( numAccepted ), 0.0 );
+    }
+
+    std::remove( floatFile.c_str() );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes a MultiSpeakerBRIR file (replaced if it exists), R = 2
+ *  @param[in]      ir : M R E N values, stored with the dimensions irDimensions
+ *  @param[in]      delayDimensions : dimensions of Data.Delay (filled with the index of
+ *                  each value) ; no Data.Delay if empty
+ *
+ *  @details        The listener and the source are at the origin, emitter e is in the
+ *                  horizontal plane at azimuth 360 e / E, 2 meters away
+ */
+/************************************************************************************/
+static void WriteMultiSpeakerBRIR(const std::string &path,
+                                  const std::size_t M,
+                                  const std::size_t E,
+                                  const std::vector< double > &ir,
+                                  const std::vector< std::string > &irDimensions,
+                                  const std::vector< std::string > &delayDimensions)
+{
+    const std::size_t R = 2;
+    const std::size_t N = ir.size() / ( M * R * E );
+
+    const netCDF::NcFile theFile( path, netCDF::NcFile::replace, netCDF::NcFile::nc4 );
+
+    sofa::Attributes attributes;
+    attributes.ResetToDefault();
+
+    attributes.Set( sofa::Attributes::kSOFAConventions, "MultiSpeakerBRIR" );
+    attributes.Set( sofa::Attributes::kSOFAConventionsVersion, "0.3" );
+    attributes.Set( sofa::Attributes::kDataType, "FIRE" );
+    attributes.Set( sofa::Attributes::kRoomType, "reverberant" );
+
+    for( unsigned int k = 0; k < sofa::Attributes::kNumAttributes; k++ )
+    {
+        const sofa::Attributes::Type attType = static_cast< sofa::Attributes::Type >(k);
+
+        theFile.putAtt( sofa::Attributes::GetName( attType ), attributes.Get( attType ) );
+    }
+
+    theFile.putAtt( "DatabaseName", "sofatests" );
+
+    theFile.addDim( "C", 3 );
+    theFile.addDim( "I", 1 );
+    theFile.addDim( "M", M );
+    theFile.addDim( "R", R );
+    theFile.addDim( "E", E );
+    theFile.addDim( "N", N );
+
+    {
+        const double samplingRate = 48000.0;
+
+        const netCDF::NcVar var = theFile.addVar( "Data.SamplingRate", "double", "I" );
+        var.putVar( &samplingRate );
+        var.putAtt( "Units", "hertz" );
+    }
+
+    if( delayDimensions.empty() == false )
+    {
+        std::size_t size = 1;
+        for( std::size_t i = 0; i < delayDimensions.size(); i++ )
+        {
+            size *= theFile.getDim( delayDimensions[i] ).getSize();
+        }
+
+        std::vector< double > delay( size );
+        for( std::size_t i = 0; i < size; i++ )
+        {
+            delay[i] = static_cast< double >( i );
+        }
+
+        theFile.addVar( "Data.Delay", "double", delayDimensions ).putVar( &delay[0] );
+    }
+
+    theFile.addVar( "Data.IR", "double", irDimensions ).putVar( &ir[0] );
+
+    std::vector< double > emitters( E * 3 );
+    for( std::size_t e = 0; e < E; e++ )
+    {
+        emitters[ 3 * e + 0 ] = 360.0 * e / E;
+        emitters[ 3 * e + 1 ] = 0.0;
+        emitters[ 3 * e + 2 ] = 2.0;
+    }
+
+    const auto addVariable = [ &theFile ](const std::string &name,
+                                          const std::vector< std::string > &dimNames,
+                                          const double *values,
+                                          const std::string &type,
+                                          const std::string &units)
+    {
+        const netCDF::NcVar var = theFile.addVar( name, "double", dimNames );
+
+        var.putVar( values );
+
+        if( type.empty() == false )
+        {
+            var.putAtt( "Type", type );
+            var.putAtt( "Units", units );
+        }
+    };
+
+    const double origin[3]      = { 0.0, 0.0, 0.0 };
+    const double up[3]          = { 0.0, 0.0, 1.0 };
+    const double view[3]        = { 1.0, 0.0, 0.0 };
+    const double receivers[6]   = { 0.0, 0.09, 0.0, 0.0, -0.09, 0.0 };
+
+    addVariable( "ListenerPosition", { "I", "C" }, origin, "cartesian", "meter" );
+    addVariable( "ListenerUp", { "I", "C" }, up, "", "" );
+    addVariable( "ListenerView", { "I", "C" }, view, "cartesian", "meter" );
+    addVariable( "ReceiverPosition", { "R", "C", "I" }, receivers, "cartesian", "meter" );
+    addVariable( "SourcePosition", { "I", "C" }, origin, "cartesian", "meter" );
+    addVariable( "SourceUp", { "I", "C" }, up, "", "" );
+    addVariable( "SourceView", { "I", "C" }, view, "cartesian", "meter" );
+    addVariable( "EmitterPosition", { "E", "C", "I" }, &emitters[0], "spherical", "degree, degree, meter" );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          MultiSpeakerBRIR : Data.IR slabs of one measurement and of one
+ *                  (measurement, emitter), Data.Delay of one measurement ; invalid shapes
+ *                  and missing Data.Delay throw
+ *
+ */
+/************************************************************************************/
+static void TestMultiSpeakerBRIR()
+{
+    const std::size_t M = 3;
+    const std::size_t R = 2;
+    const std::size_t E = 3;
+    const std::size_t N = 8;
+
+    std::vector< double > ir( M * R * E * N );
+    for( std::size_t i = 0; i < ir.size(); i++ )
+    {
+        ir[i] = static_cast< double >( i );
+    }
+
+    const std::vector< std::string > irDimensions = { "M", "R", "E", "N" };
+
+    //==============================================================================
+    /// slabs of a valid file, Data.Delay [ M R E ] and [ I R E ]
+    double slabError    = 0.0;
+    double delayError   = 0.0;
+
+    for( int varying = 1; varying >= 0; varying-- )
+    {
+        WriteMultiSpeakerBRIR( kTemporaryFile, M, E, ir, irDimensions,
+                               { ( varying == 1 ) ? "M" : "I", "R", "E" } );
+
+        const sofa::MultiSpeakerBRIR file( kTemporaryFile );
+
+        for( std::size_t m = 0; m < M; m++ )
+        {
+            std::vector< double > values;
+            std::vector< float > floatValues;
+
+            if( file.GetDataIR( values, m ) == false || values.size() != R * E * N
+               || file.GetDataIR( floatValues, m ) == false || floatValues.size() != R * E * N )
+            {
+                slabError = 1.0;
+                continue;
+            }
+
+            slabError = std::max( slabError, MaxError( &values[0], &ir[ m * R * E * N ], R * E * N ) );
+            slabError = std::max( slabError, MaxError( &floatValues[0], &ir[ m * R * E * N ], R * E * N ) );
+
+            for( std::size_t e = 0; e < E; e++ )
+            {
+                if( file.GetDataIR( values, m, e ) == false || values.size() != R * N )
+                {
+                    slabError = 1.0;
+                    continue;
+                }
+
+                for( std::size_t r = 0; r < R; r++ )
+                {
+                    slabError = std::max( slabError, MaxError( &values[ r * N ], &ir[ ( ( m * R + r ) * E + e ) * N ], N ) );
+                }
+            }
+
+            if( file.GetDataDelay( values, m ) == false || values.size() != R * E )
+            {
+                delayError = 1.0;
+                continue;
+            }
+
+            for( std::size_t i = 0; i < R * E; i++ )
+            {
+                const double expected = static_cast< double >( ( varying == 1 ) ? m * R * E + i : i );
+
+                delayError = std::max( delayError, std::fabs( values[i] - expected ) );
+            }
+        }
+
+        /// out of range
+        std::vector< double > values;
+        if( file.GetDataIR( values, M ) == true || file.GetDataIR( values, 0, E ) == true || file.GetDataDelay( values, M ) == true )
+        {
+            slabError = 1.0;
+        }
+    }
+
+    Report( "MultiSpeakerBRIR Data.IR slabs", slabError, 0.0 );
+    Report( "MultiSpeakerBRIR Data.Delay of one measurement", delayError, 0.0 );
+
+    //==============================================================================
+    /// errors : Data.IR [ M E R N ] (R differs from E), missing or malformed Data.Delay
+    std::size_t numMissed = 0;
+    {
+        std::vector< double > values;
+
+        WriteMultiSpeakerBRIR( kTemporaryFile, M, E, ir, { "M", "E", "R", "N" }, { "M", "R", "E" } );
+        {
+            const sofa::MultiSpeakerBRIR file( kTemporaryFile );
+
+            numMissed += ( Throws( [ & ]() { file.GetDataIR( values, 0 ); } ) == false ) ? 1 : 0;
+            numMissed += ( Throws( [ & ]() { file.GetDataIR( values, 0, 0 ); } ) == false ) ? 1 : 0;
+        }
+
+        WriteMultiSpeakerBRIR( kTemporaryFile, M, E, ir, irDimensions, {} );
+        {
+            const sofa::MultiSpeakerBRIR file( kTemporaryFile );
+
+            numMissed += ( Throws( [ & ]() { file.GetDataDelay( values, 0 ); } ) == false ) ? 1 : 0;
+        }
+
+        WriteMultiSpeakerBRIR( kTemporaryFile, M, E, ir, irDimensions, { "M", "R" } );
+        {
+            const sofa::MultiSpeakerBRIR file( kTemporaryFile );
+
+            numMissed += ( Throws( [ & ]() { file.GetDataDelay( values, 0 ); } ) == false ) ? 1 : 0;
+        }
+
+        WriteMultiSpeakerBRIR( kTemporaryFile, M, E, ir, irDimensions, { "M", "E", "R" } );
+        {
+            const sofa::MultiSpeakerBRIR file( kTemporaryFile );
+
+            numMissed += ( Throws( [ & ]() { file.GetDataDelay( values, 0 ); } ) == false ) ? 1 : 0;
+        }
+    }
+
+    Report( "MultiSpeakerBRIR invalid shapes throw", static_cast< double >( numMissed ), 0.0 );
+
+    std::remove( kTemporaryFile.c_str() );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          MultiRadiusInterpolator : IRs holding the direction and the radius of their
+ *                  measurement, on three shells of different grids. The barycentric weights
+ *                  of a triangle give a vector parallel to the source direction, and the
+ *                  radius is linear between the shells (clamped outside)
+ *
+ */
+/************************************************************************************/
+static void TestMultiRadiusInterpolator()
+{
+    const std::size_t N     = 4;
+    const double radii[3]   = { 0.5, 1.0, 2.0 };
+    const int steps[3]      = { 30, 45, 60 };
+
+    std::vector< double > positions;
+    for( std::size_t s = 0; s < 3; s++ )
+    {
+        positions.insert( positions.end(), { 0.0, 90.0, radii[s], 0.0, -90.0, radii[s] } );
+
+        for( int azimuth = 0; azimuth < 360; azimuth += steps[s] )
+        {
+            for( int elevation = -60; elevation <= 60; elevation += 30 )
+            {
+                positions.insert( positions.end(), { static_cast< double >( azimuth ), static_cast< double >( elevation ), radii[s] } );
+            }
+        }
+    }
+
+    const std::size_t M = positions.size() / 3;
+
+    /// [ x y z radius ] for the first receiver, twice that for the second ; the delay is 10 times the radius
+    std::vector< double > ir( M * 2 * N );
+    std::vector< double > delay( M * 2 );
+
+    for( std::size_t m = 0; m < M; m++ )
+    {
+        const double spherical[3] = { positions[ m * 3 ], positions[ m * 3 + 1 ], 1.0 };
+
+        double direction[3];
+        sofa::Geometry::SphericalToCartesian( direction, spherical );
+
+        for( std::size_t r = 0; r < 2; r++ )
+        {
+            double *h = &ir[ ( m * 2 + r ) * N ];
+
+            for( std::size_t c = 0; c < 3; c++ )
+            {
+                h[c] = ( r + 1 ) * direction[c];
+            }
+            h[3] = ( r + 1 ) * positions[ m * 3 + 2 ];
+
+            delay[ m * 2 + r ] = 10.0 * positions[ m * 3 + 2 ];
+        }
+    }
+
+    WriteSimpleFreeFieldHRIR( kTemporaryFile, positions, ir, delay, 48000.0 );
+
+    sofa::FIRDataSet dataSet;
+    {
+        const sofa::SimpleFreeFieldHRIR file( kTemporaryFile );
+        dataSet.Load( file );
+    }
+
+    std::remove( kTemporaryFile.c_str() );
+
+    sofa::MultiRadiusInterpolator interpolator;
+
+    if( interpolator.Prepare( dataSet ) == false || interpolator.GetNumShells() != 3 )
+    {
+        Report( "MultiRadiusInterpolator shells", 1.0, 0.0 );
+        return;
+    }
+
+    //==============================================================================
+    /// measured positions are reproduced
+    double exactError = 0.0;
+    {
+        std::vector< double > values( 2 * N );
+        double delays[2];
+
+        for( std::size_t m = 0; m < M; m++ )
+        {
+            interpolator.Interpolate( &values[0], delays, dataSet, dataSet.GetSourceCartesianPosition( m ) );
+
+            exactError = std::max( exactError, MaxError( &values[0], dataSet.GetIR( m, 0 ), 2 * N ) );
+            exactError = std::max( exactError, std::fabs( delays[1] - dataSet.GetDelay( m, 1 ) ) );
+        }
+    }
+
+    Report( "MultiRadiusInterpolator at the measured positions", exactError, 1e-9 );
+
+    //==============================================================================
+    /// directions between the measurements, at radii inside and outside of the shells
+    double directionError   = 0.0;
+    double radiusError      = 0.0;
+    {
+        std::mt19937 generator( 4 );
+        std::uniform_real_distribution< double > azimuths( 0.0, 360.0 );
+        std::uniform_real_distribution< double > elevations( -89.0, 89.0 );
+
+        const double distances[] = { 0.3, 0.75, 1.0, 1.6, 3.0 };
+
+        std::vector< double > values( 2 * N );
+        double delays[2];
+
+        for( std::size_t i = 0; i < 200; i++ )
+        {
+            const double distance   = distances[ i % 5 ];
+            const double spherical[3] = { azimuths( generator ), elevations( generator ), distance };
+
+            double position[3];
+            sofa::Geometry::SphericalToCartesian( position, spherical );
+
+            interpolator.Interpolate( &values[0], delays, dataSet, position );
+
+            double direction[3]     = { position[0], position[1], position[2] };
+            double interpolated[3]  = { values[0], values[1], values[2] };
+
+            sofa::Geometry::Normalize( direction );
+            sofa::Geometry::Normalize( interpolated );
+
+            directionError = std::max( directionError, MaxError( direction, interpolated, 3 ) );
+
+            const double expected = std::min( radii[2], std::max( radii[0], distance ) );
+
+            radiusError = std::max( radiusError, std::fabs( values[3] - expected ) );
+            radiusError = std::max( radiusError, std::fabs( values[ N + 3 ] - 2.0 * expected ) );
+            radiusError = std::max( radiusError, std::fabs( delays[0] - 10.0 * expected ) );
+        }
+    }
+
+    Report( "MultiRadiusInterpolator direction (barycentric)", directionError, 1e-9 );
+    Report( "MultiRadiusInterpolator radius and delay", radiusError, 1e-9 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          SymmetricFIRDataSet : the right ear of a source is exactly the left ear of
+ *                  its mirror (one measurement has no mirror) ; then one right ear is scaled
+ *                  by 1 + eps, whose relative error is eps^2 / ( 1 + eps )^2
+ *
+ */
+/************************************************************************************/
+static void TestSymmetricFIRDataSet()
+{
+    const std::size_t N = 16;
+
+    std::vector< double > positions;
+    for( int azimuth = 0; azimuth < 360; azimuth += 30 )
+    {
+        for( int elevation = -30; elevation <= 30; elevation += 30 )
+        {
+            positions.insert( positions.end(), { static_cast< double >( azimuth ), static_cast< double >( elevation ), 1.2 } );
+        }
+    }
+
+    /// no mirror
+    positions.insert( positions.end(), { 15.0, 45.0, 1.2 } );
+
+    const std::size_t M = positions.size() / 3;
+
+    /// left ear response of a source, the right ear being that of the mirrored source
+    const auto response = [ & ](const double azimuth,
+                                const double elevation,
+                                const std::size_t n)
+    {
+        const double a = azimuth * kPi / 180.0;
+        const double e = elevation * kPi / 180.0;
+
+        return std::cos( 0.3 * n * ( 1.0 + std::sin( a ) ) + e ) * std::exp( -0.1 * n );
+    };
+
+    const auto delayOf = [ & ](const double azimuth,
+                               const double elevation)
+    {
+        return 10.0 + 5.0 * std::sin( azimuth * kPi / 180.0 ) + 0.01 * elevation;
+    };
+
+    std::vector< double > ir( M * 2 * N );
+    std::vector< double > delay( M * 2 );
+
+    for( std::size_t m = 0; m < M; m++ )
+    {
+        const double azimuth    = positions[ m * 3 ];
+        const double elevation  = positions[ m * 3 + 1 ];
+
+        for( std::size_t n = 0; n < N; n++ )
+        {
+            ir[ ( m * 2 ) * N + n ]     = response( azimuth, elevation, n );
+            ir[ ( m * 2 + 1 ) * N + n ] = response( -azimuth, elevation, n );
+        }
+
+        delay[ m * 2 ]      = delayOf( azimuth, elevation );
+        delay[ m * 2 + 1 ]  = delayOf( -azimuth, elevation );
+    }
+
+    const double eps = 0.01;
+
+    for( int asymmetric = 0; asymmetric < 2; asymmetric++ )
+    {
+        if( asymmetric == 1 )
+        {
+            for( std::size_t n = 0; n < N; n++ )
+            {
+                ir[ ( 4 * 2 + 1 ) * N + n ] *= 1.0 + eps;
+            }
+        }
+
+        WriteSimpleFreeFieldHRIR( kTemporaryFile, positions, ir, delay, 48000.0 );
+
+        sofa::FIRDataSet dataSet;
+        {
+            const sofa::SimpleFreeFieldHRIR file( kTemporaryFile );
+            dataSet.Load( file, sofa::FIRDataSet::kHilbertOrder );
+        }
+
+        std::remove( kTemporaryFile.c_str() );
+
+        sofa::SymmetricFIRDataSet symmetric;
+
+        if( asymmetric == 1 )
+        {
+            symmetric.Analyze( dataSet );
+
+            const double expected = eps * eps / ( ( 1.0 + eps ) * ( 1.0 + eps ) );
+
+            Report( "SymmetricFIRDataSet error of a scaled ear", std::fabs( symmetric.GetMaxSymmetryError() - expected ) / expected, 1e-9 );
+            Report( "SymmetricFIRDataSet too asymmetric : not stored",
+                    ( symmetric.Compute( dataSet, 0.5 * symmetric.GetSymmetryError() ) == false ) ? 0.0 : 1.0, 0.0 );
+            continue;
+        }
+
+        const bool computed = symmetric.Compute( dataSet, 1e-12 );
+
+        /// the mirrors : ( azimuth, elevation ) and ( -azimuth, elevation ), both ways
+        double pairError = ( computed == true && symmetric.GetNumPairedMeasurements() == M - 1 ) ? 0.0 : 1.0;
+
+        for( std::size_t k = 0; k < M && pairError == 0.0; k++ )
+        {
+            const unsigned long mirror = symmetric.GetMirror( k );
+            const double *p = dataSet.GetSourcePosition( k );
+
+            if( mirror == sofa::SymmetricFIRDataSet::kNoMirror )
+            {
+                pairError = ( p[0] == 15.0 ) ? 0.0 : 1.0;
+                continue;
+            }
+
+            const double *q = dataSet.GetSourcePosition( mirror );
+
+            if( symmetric.GetMirror( mirror ) != k
+               || std::fmod( p[0] + q[0], 360.0 ) != 0.0
+               || p[1] != q[1] )
+            {
+                pairError = 1.0;
+            }
+        }
+
+        Report( "SymmetricFIRDataSet mirrored measurements", pairError, 0.0 );
+
+        double dataError = ( computed == true ) ? symmetric.GetSymmetryError() : 1.0;
+
+        for( std::size_t k = 0; k < M && computed == true; k++ )
+        {
+            for( std::size_t r = 0; r < 2; r++ )
+            {
+                dataError = std::max( dataError, MaxError( symmetric.GetIR( k, r ), dataSet.GetIR( k, r ), N ) );
+                dataError = std::max( dataError, std::fabs( symmetric.GetDelay( k, r ) - dataSet.GetDelay( k, r ) ) );
+            }
+        }
+
+        Report( "SymmetricFIRDataSet IRs and delays", dataError, 1e-12 );
+        Report( "SymmetricFIRDataSet stored responses ( M + 1 )",
+                std::fabs( static_cast< double >( symmetric.GetNumStoredResponses() ) - static_cast< double >( M + 1 ) ), 0.0 );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          DirectFilterBank : 1 to 5 channels, a filter length that is not a multiple
+ *                  of the vector size, blocks of varying sizes and a group changing every
+ *                  block, vs direct convolution in double
+ *
+ */
+/************************************************************************************/
+static void TestDirectFilterBank()
+{
+    const std::size_t G             = 3;
+    const unsigned int L            = 37;
+    const unsigned int kMaxBlock    = 64;
+    const unsigned int blockSizes[] = { 64, 1, 13, 7, 32, 50, 64, 3 };
+    const std::size_t kNumBlocks    = 40;
+
+    for( unsigned int C = 1; C <= 5; C += 2 )
+    {
+        std::vector< double > filters;
+        Noise( filters, G * C * L, 6 + C );
+
+        sofa::dsp::DirectFilterBank bank;
+        bank.Prepare( &filters[0], G, C, L, kMaxBlock );
+
+        std::vector< float > input;
+        Noise( input, kNumBlocks * kMaxBlock, 7 );
+
+        std::vector< std::vector< float > > outputs( C, std::vector< float >( input.size() ) );
+        std::vector< std::vector< float > > otherOutputs( C, std::vector< float >( input.size() ) );
+
+        /// group of each sample, and whether the next group was computed too
+        std::vector< std::size_t > groups( input.size() );
+        std::vector< bool > hasOther( input.size(), false );
+
+        std::size_t position = 0;
+
+        for( std::size_t b = 0; b < kNumBlocks; b++ )
+        {
+            const unsigned int size = blockSizes[ b % 8 ];
+            const std::size_t group = b % G;
+
+            std::vector< float * > out( C );
+            std::vector< float * > other( C );
+
+            for( unsigned int c = 0; c < C; c++ )
+            {
+                out[c]      = &outputs[c][ position ];
+                other[c]    = &otherOutputs[c][ position ];
+            }
+
+            /// every other block, the next group is computed as well
+            if( b % 2 == 0 )
+            {
+                bank.Process( &out[0], &input[ position ], size, group );
+            }
+            else
+            {
+                bank.Process( &out[0], &other[0], &input[ position ], size, group, ( group + 1 ) % G );
+            }
+
+            std::fill( groups.begin() + position, groups.begin() + position + size, group );
+            std::fill( hasOther.begin() + position, hasOther.begin() + position + size, ( b % 2 == 1 ) );
+
+            position += size;
+        }
+
+        double error    = 0.0;
+        double peak     = 0.0;
+
+        for( unsigned int c = 0; c < C; c++ )
+        {
+            for( std::size_t n = 0; n < position; n++ )
+            {
+                double y        = 0.0;
+                double yOther   = 0.0;
+
+                const double *h         = &filters[ ( groups[n] * C + c ) * L ];
+                const double *hOther    = &filters[ ( ( ( groups[n] + 1 ) % G ) * C + c ) * L ];
+
+                for( unsigned int k = 0; k < L && k <= n; k++ )
+                {
+                    y       += h[k] * input[ n - k ];
+                    yOther  += hOther[k] * input[ n - k ];
+                }
+
+                error = std::max( error, std::fabs( outputs[c][n] - y ) );
+                peak  = std::max( peak, std::fabs( y ) );
+
+                if( hasOther[n] == true )
+                {
+                    error = std::max( error, std::fabs( otherOutputs[c][n] - yOther ) );
+                }
+            }
+        }
+
+        Report( "DirectFilterBank " + std::to_string( C ) + " channel(s), varying blocks", error / peak, 1e-5 );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          ImpulseResponseTrimmer : exponential decays a^( n - d ) starting after d
+ *                  silent samples. The onset is d, and the end is where the remaining
+ *                  energy, a^2k / ( 1 - a^2 ) up to the truncation, exceeds the energy-loss
+ *                  bound for the last time
+ *
+ */
+/************************************************************************************/
+static void TestImpulseResponseTrimmer()
+{
+    const std::size_t M             = 2;
+    const std::size_t N             = 512;
+    const double kMaxEnergyLoss     = 1e-4;
+    const unsigned long kPreOnset   = 8;
+    const unsigned long kFadeOut    = 16;
+
+    const auto onsetOf = [ & ](const std::size_t i)
+    {
+        return 20 + 7 * i;
+    };
+
+    const auto decayOf = [ & ](const std::size_t i)
+    {
+        return 0.9 + 0.02 * i;
+    };
+
+    std::vector< double > ir( M * 2 * N, 0.0 );
+    for( std::size_t i = 0; i < M * 2; i++ )
+    {
+        for( std::size_t n = onsetOf( i ); n < N; n++ )
+        {
+            ir[ i * N + n ] = std::pow( decayOf( i ), static_cast< double >( n - onsetOf( i ) ) );
+        }
+    }
+
+    const std::vector< double > positions   = { 0.0, 0.0, 1.2, 90.0, 0.0, 1.2 };
+    const std::vector< double > delay       = { 0.5, 1.5 };
+
+    WriteSimpleFreeFieldHRIR( kTemporaryFile, positions, ir, delay, 48000.0 );
+
+    sofa::FIRDataSet dataSet;
+    {
+        const sofa::SimpleFreeFieldHRIR file( kTemporaryFile );
+        dataSet.Load( file );
+    }
+
+    std::remove( kTemporaryFile.c_str() );
+
+    sofa::ImpulseResponseTrimmer trimmer;
+
+    if( trimmer.Compute( dataSet, kMaxEnergyLoss, -20.0, kPreOnset, kFadeOut ) == false )
+    {
+        Report( "ImpulseResponseTrimmer", 1.0, 0.0 );
+        return;
+    }
+
+    const unsigned long L = trimmer.GetNumDataSamples();
+
+    double boundsError  = 0.0;
+    double dataError    = 0.0;
+
+    for( std::size_t m = 0; m < M; m++ )
+    {
+        for( std::size_t r = 0; r < 2; r++ )
+        {
+            const std::size_t i     = m * 2 + r;
+            const std::size_t d     = onsetOf( i );
+            const double a2         = decayOf( i ) * decayOf( i );
+            const std::size_t K     = N - d;
+
+            /// energy from sample d + k to the end
+            const auto remaining = [ & ](const std::size_t k)
+            {
+                return ( std::pow( a2, static_cast< double >( k ) ) - std::pow( a2, static_cast< double >( K ) ) ) / ( 1.0 - a2 );
+            };
+
+            /// nothing is lost before the onset : the whole bound is left for the tail
+            const double budget = kMaxEnergyLoss * remaining( 0 );
+
+            std::size_t k = 0;
+            while( k + 1 < K && remaining( k + 1 ) > budget )
+            {
+                k++;
+            }
+
+            const unsigned long expectedEnd = static_cast< unsigned long >( d + k + 1 );
+
+            boundsError = std::max( boundsError, std::fabs( static_cast< double >( trimmer.GetOnset( m, r ) ) - d ) );
+            boundsError = std::max( boundsError, std::fabs( static_cast< double >( trimmer.GetStart( m, r ) ) - ( d - kPreOnset ) ) );
+            boundsError = std::max( boundsError, std::fabs( static_cast< double >( trimmer.GetEnd( m, r ) ) - expectedEnd ) );
+
+            /// the samples between the fades are those of the IR, the delay compensates the removed samples
+            const double *y = trimmer.GetIR( m, r );
+
+            for( unsigned long n = kPreOnset; n + kFadeOut < L; n++ )
+            {
+                const double x = ( d - kPreOnset + n < N ) ? ir[ i * N + d - kPreOnset + n ] : 0.0;
+
+                dataError = std::max( dataError, std::fabs( y[n] - x ) );
+            }
+
+            for( unsigned long n = 0; n < kPreOnset; n++ )
+            {
+                dataError = std::max( dataError, std::fabs( y[n] ) );
+            }
+
+            dataError = std::max( dataError, std::fabs( trimmer.GetDelay( m, r ) - ( delay[r] + d - kPreOnset ) ) );
+        }
+    }
+
+    Report( "ImpulseResponseTrimmer onsets, starts and ends", boundsError, 0.0 );
+    Report( "ImpulseResponseTrimmer trimmed IRs and delays", dataError, 0.0 );
+    Report( "ImpulseResponseTrimmer energy loss within the bound",
+            ( trimmer.GetEnergyLoss() <= kMaxEnergyLoss && L < N ) ? 0.0 : 1.0, 0.0 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          MultiSourceRenderer : three sources on a HRTFBank with fractional delays,
+ *                  one of them moving to another measurement (linear crossfade over one
+ *                  block), vs the sum of direct convolutions
+ *
+ */
+/************************************************************************************/
+static void TestMultiSourceRenderer()
+{
+    const unsigned int kBlockSize   = 64;
+    const std::size_t kNumBlocks    = 40;
+    const std::size_t kSwitchBlock  = 20;
+    const std::size_t kInputLength  = kNumBlocks * kBlockSize;
+    const std::size_t M             = 4;
+    const std::size_t N             = 200;
+    const unsigned int S            = 3;
+
+    std::vector< double > positions;
+    for( std::size_t m = 0; m < M; m++ )
+    {
+        positions.insert( positions.end(), { 90.0 * m, 0.0, 1.2 } );
+    }
+
+    std::vector< double > ir;
+    Noise( ir, M * 2 * N, 8 );
+
+    std::vector< double > delay( M * 2 );
+    for( std::size_t m = 0; m < M; m++ )
+    {
+        delay[ m * 2 ]      = 3.3 + m;
+        delay[ m * 2 + 1 ]  = 5.7 + 2.0 * m;
+    }
+
+    WriteSimpleFreeFieldHRIR( kTemporaryFile, positions, ir, delay, 48000.0 );
+
+    sofa::FIRDataSet dataSet;
+    {
+        const sofa::SimpleFreeFieldHRIR file( kTemporaryFile );
+        dataSet.Load( file );
+    }
+
+    std::remove( kTemporaryFile.c_str() );
+
+    std::shared_ptr< const sofa::dsp::HRTFBank > bank( new sofa::dsp::HRTFBank( dataSet, kBlockSize ) );
+
+    double indexError = 0.0;
+    for( std::size_t m = 0; m < M; m++ )
+    {
+        indexError += ( bank->FindMeasurement( dataSet.GetSourceCartesianPosition( m ) ) == m ) ? 0.0 : 1.0;
+    }
+
+    Report( "HRTFBank nearest measurement", indexError, 0.0 );
+
+    //==============================================================================
+    /// source s renders measurement s ; source 1 moves to measurement 3
+    std::vector< float > inputs[ S ];
+    for( unsigned int s = 0; s < S; s++ )
+    {
+        Noise( inputs[s], kInputLength, 9 + s );
+    }
+
+    sofa::dsp::MultiSourceRenderer renderer( bank, S );
+
+    for( unsigned int s = 0; s < S; s++ )
+    {
+        renderer.SetMeasurement( s, s );
+    }
+    renderer.Reset();
+
+    std::vector< float > outputs[2] = { std::vector< float >( kInputLength ), std::vector< float >( kInputLength ) };
+
+    for( std::size_t b = 0; b < kNumBlocks; b++ )
+    {
+        if( b == kSwitchBlock )
+        {
+            renderer.SetMeasurement( 1, 3 );
+        }
+
+        const float *in[ S ];
+        for( unsigned int s = 0; s < S; s++ )
+        {
+            in[s] = &inputs[s][ b * kBlockSize ];
+        }
+
+        renderer.Process( &outputs[0][ b * kBlockSize ], &outputs[1][ b * kBlockSize ], in, S, kBlockSize );
+    }
+
+    //==============================================================================
+    double error    = 0.0;
+    double peak     = 0.0;
+
+    for( std::size_t r = 0; r < 2; r++ )
+    {
+        /// convolution of a source with the delayed HRIR of a measurement
+        const auto render = [ & ](std::vector< double > &output,
+                                  const unsigned int source,
+                                  const std::size_t m)
+        {
+            std::vector< double > filter( sofa::dsp::FractionalDelayLine::GetDelayedLength( N, delay[ m * 2 + r ] ) );
+            sofa::dsp::FractionalDelayLine::ApplyDelay( &filter[0], filter.size(), &ir[ ( m * 2 + r ) * N ], N, delay[ m * 2 + r ] );
+
+            Convolve( output, inputs[ source ], filter );
+        };
+
+        std::vector< double > y0, y1, y1Next, y2;
+        render( y0, 0, 0 );
+        render( y1, 1, 1 );
+        render( y1Next, 1, 3 );
+        render( y2, 2, 2 );
+
+        for( std::size_t n = 0; n < kInputLength; n++ )
+        {
+            const std::size_t b = n / kBlockSize;
+            const double fade   = static_cast< double >( n % kBlockSize + 1 ) / kBlockSize;
+
+            const double moving = ( b < kSwitchBlock ) ? y1[n]
+                                : ( b == kSwitchBlock ) ? y1[n] + fade * ( y1Next[n] - y1[n] )
+                                : y1Next[n];
+
+            const double expected = y0[n] + moving + y2[n];
+
+            error = std::max( error, std::fabs( outputs[r][n] - expected ) );
+            peak  = std::max( peak, std::fabs( expected ) );
+        }
+    }
+
+    Report( "MultiSourceRenderer vs direct convolution (moving)", error / peak, 1e-5 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          BiquadFilterBank : cascades of random stable sections on a partial SIMD
+ *                  group with varying block sizes, vs a double direct form I cascade ; then
+ *                  interpolated and immediate coefficient changes vs a double transposed
+ *                  direct form II with the same per-sample ramp
+ *
+ */
+/************************************************************************************/
+static void TestBiquadFilterBank()
+{
+    const unsigned int V            = 7;
+    const unsigned int Q            = 3;
+    const unsigned int kMaxBlock    = 128;
+    const unsigned int kBlockSizes[] = { 64, 17, 128, 1, 100 };
+    const std::size_t kNumBlocks    = 40;
+    const std::size_t kSwitchBlock  = 22;   ///< a 128-sample block
+    const unsigned int kRamped      = 2;    ///< voice changing with interpolation
+    const unsigned int kImmediate   = 5;    ///< voice changing without interpolation
+
+    std::mt19937 generator( 41 );
+    std::uniform_real_distribution< double > uniform( -1.0, 1.0 );
+
+    /// Q sections b0 b1 b2 a1 a2 with complex poles of radius < 0.95
+    const auto randomSections = [ & ]()
+    {
+        std::vector< double > sections( Q * 5 );
+        for( unsigned int q = 0; q < Q; q++ )
+        {
+            const double radius = 0.5 + 0.45 * std::fabs( uniform( generator ) );
+            const double angle  = kPi * std::fabs( uniform( generator ) );
+
+            sections[ q * 5 + 0 ] = uniform( generator );
+            sections[ q * 5 + 1 ] = uniform( generator );
+            sections[ q * 5 + 2 ] = uniform( generator );
+            sections[ q * 5 + 3 ] = -2.0 * radius * std::cos( angle );
+            sections[ q * 5 + 4 ] = radius * radius;
+        }
+        return sections;
+    };
+
+    const auto toFloat = [](const std::vector< double > &sections)
+    {
+        return std::vector< float >( sections.begin(), sections.end() );
+    };
+
+    std::vector< double > sections[ V ];
+    for( unsigned int v = 0; v < V; v++ )
+    {
+        sections[v] = randomSections();
+    }
+    const std::vector< double > rampedNext      = randomSections();
+    const std::vector< double > immediateNext   = randomSections();
+
+    std::size_t length = 0;
+    std::vector< std::size_t > starts;
+    for( std::size_t b = 0; b < kNumBlocks; b++ )
+    {
+        starts.push_back( length );
+        length += kBlockSizes[ b % 5 ];
+    }
+
+    std::vector< float > inputs[ V ];
+    std::vector< float > outputs[ V ];
+    for( unsigned int v = 0; v < V; v++ )
+    {
+        Noise( inputs[v], length, 41 + v );
+        outputs[v].resize( length );
+    }
+
+    //==============================================================================
+    sofa::dsp::BiquadFilterBank bank( V, Q, kMaxBlock );
+
+    for( unsigned int v = 0; v < V; v++ )
+    {
+        const std::vector< float > coefficients = toFloat( sections[v] );
+        bank.SetCoefficients( v, &coefficients[0] );
+    }
+
+    for( std::size_t b = 0; b < kNumBlocks; b++ )
+    {
+        if( b == kSwitchBlock )
+        {
+            const std::vector< float > ramped       = toFloat( rampedNext );
+            const std::vector< float > immediate    = toFloat( immediateNext );
+
+            bank.SetCoefficients( kRamped, &ramped[0], true );
+            bank.SetCoefficients( kImmediate, &immediate[0], false );
+        }
+
+        const float *in[ V ];
+        float *out[ V ];
+        for( unsigned int v = 0; v < V; v++ )
+        {
+            in[v]   = &inputs[v][ starts[b] ];
+            out[v]  = &outputs[v][ starts[b] ];
+        }
+
+        bank.Process( out, in, kBlockSizes[ b % 5 ] );
+    }
+
+    //==============================================================================
+    /// direct form I cascade with fixed coefficients
+    const auto directForm = [ & ](std::vector< double > &y,
+                                  const std::vector< float > &x,
+                                  const std::vector< double > &s)
+    {
+        y.assign( x.begin(), x.end() );
+
+        for( unsigned int q = 0; q < Q; q++ )
+        {
+            const double *c = &s[ q * 5 ];
+            double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0;
+
+            for( std::size_t n = 0; n < y.size(); n++ )
+            {
+                const double in     = y[n];
+                const double out    = c[0] * in + c[1] * x1 + c[2] * x2 - c[3] * y1 - c[4] * y2;
+
+                x2 = x1; x1 = in;
+                y2 = y1; y1 = out;
+                y[n] = out;
+            }
+        }
+    };
+
+    /// transposed direct form II cascade, coefficients going from 'before' to 'after'
+    /// over the switch block with the ramp (n+1)/numSamples (or at once)
+    const auto transposed = [ & ](std::vector< double > &y,
+                                  const std::vector< float > &x,
+                                  const std::vector< double > &before,
+                                  const std::vector< double > &after,
+                                  const bool interpolate)
+    {
+        y.assign( x.begin(), x.end() );
+
+        for( unsigned int q = 0; q < Q; q++ )
+        {
+            double s1 = 0.0, s2 = 0.0;
+
+            for( std::size_t b = 0; b < kNumBlocks; b++ )
+            {
+                const unsigned int size = kBlockSizes[ b % 5 ];
+
+                for( unsigned int n = 0; n < size; n++ )
+                {
+                    const double ramp = ( b < kSwitchBlock ) ? 0.0
+                                      : ( b > kSwitchBlock || interpolate == false ) ? 1.0
+                                      : static_cast< double >( n + 1 ) / size;
+
+                    double c[5];
+                    for( unsigned int i = 0; i < 5; i++ )
+                    {
+                        const double from   = static_cast< float >( before[ q * 5 + i ] );
+                        const double to     = static_cast< float >( after[ q * 5 + i ] );
+                        c[i] = from + ramp * ( to - from );
+                    }
+
+                    double &value   = y[ starts[b] + n ];
+                    const double in = value;
+
+                    value   = s1 + c[0] * in;
+                    s1      = s2 + c[1] * in - c[3] * value;
+                    s2      = c[2] * in - c[4] * value;
+                }
+            }
+        }
+    };
+
+    double fixedError   = 0.0;
+    double changeError  = 0.0;
+
+    for( unsigned int v = 0; v < V; v++ )
+    {
+        std::vector< double > expected;
+
+        if( v == kRamped || v == kImmediate )
+        {
+            transposed( expected, inputs[v], sections[v], ( v == kRamped ) ? rampedNext : immediateNext, v == kRamped );
+        }
+        else
+        {
+            directForm( expected, inputs[v], sections[v] );
+        }
+
+        double error    = 0.0;
+        double peak     = 0.0;
+        for( std::size_t n = 0; n < length; n++ )
+        {
+            error   = std::max( error, std::fabs( outputs[v][n] - expected[n] ) );
+            peak    = std::max( peak, std::fabs( expected[n] ) );
+        }
+
+        double &target = ( v == kRamped || v == kImmediate ) ? changeError : fixedError;
+        target = std::max( target, error / peak );
+    }
+
+    Report( "BiquadFilterBank vs direct form I cascade", fixedError, 1e-4 );
+    Report( "BiquadFilterBank interpolated and immediate changes", changeError, 1e-4 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes a GeneralTF file (replaced if it exists), R = 2
+ *  @param[in]      positions : [ M 3 ] spherical source positions
+ *  @param[in]      frequencies : [ N ] frequencies, in hertz
+ *  @param[in]      tf : [ M R N 2 ] interleaved real and imaginary parts
+ *
+ */
+/************************************************************************************/
+static void WriteGeneralTF(const std::string &path,
+                           const std::vector< double > &positions,
+                           const std::vector< double > &frequencies,
+                           const std::vector< double > &tf)
+{
+    const std::size_t M = positions.size() / 3;
+    const std::size_t R = 2;
+    const std::size_t N = frequencies.size();
+
+    const netCDF::NcFile theFile( path, netCDF::NcFile::replace, netCDF::NcFile::nc4 );
+
+    sofa::Attributes attributes;
+    attributes.ResetToDefault();
+
+    attributes.Set( sofa::Attributes::kSOFAConventions, "GeneralTF" );
+    attributes.Set( sofa::Attributes::kDataType, "TF" );
+    attributes.Set( sofa::Attributes::kRoomType, "free field" );
+
+    for( unsigned int k = 0; k < sofa::Attributes::kNumAttributes; k++ )
+    {
+        const sofa::Attributes::Type attType = static_cast< sofa::Attributes::Type >(k);
+
+        theFile.putAtt( sofa::Attributes::GetName( attType ), attributes.Get( attType ) );
+    }
+
+    theFile.addDim( "C", 3 );
+    theFile.addDim( "I", 1 );
+    theFile.addDim( "M", M );
+    theFile.addDim( "R", R );
+    theFile.addDim( "E", 1 );
+    theFile.addDim( "N", N );
+
+    const auto addVariable = [ &theFile ](const std::string &name,
+                                          const std::vector< std::string > &dimNames,
+                                          const double *values,
+                                          const std::string &type,
+                                          const std::string &units)
+    {
+        const netCDF::NcVar var = theFile.addVar( name, "double", dimNames );
+
+        var.putVar( values );
+
+        if( type.empty() == false )
+        {
+            var.putAtt( "Type", type );
+            var.putAtt( "Units", units );
+        }
+    };
+
+    {
+        const netCDF::NcVar var = theFile.addVar( "N", "double", "N" );
+        var.putVar( &frequencies[0] );
+        var.putAtt( "Units", "hertz" );
+        var.putAtt( "LongName", "frequency" );
+    }
+
+    std::vector< double > re( M * R * N );
+    std::vector< double > im( M * R * N );
+    for( std::size_t i = 0; i < M * R * N; i++ )
+    {
+        re[i] = tf[ 2 * i ];
+        im[i] = tf[ 2 * i + 1 ];
+    }
+
+    const double origin[3]      = { 0.0, 0.0, 0.0 };
+    const double up[3]          = { 0.0, 0.0, 1.0 };
+    const double view[3]        = { 1.0, 0.0, 0.0 };
+    const double receivers[6]   = { 0.0, 0.09, 0.0, 0.0, -0.09, 0.0 };
+
+    addVariable( "Data.Real", { "M", "R", "N" }, &re[0], "", "" );
+    addVariable( "Data.Imag", { "M", "R", "N" }, &im[0], "", "" );
+    addVariable( "ListenerPosition", { "I", "C" }, origin, "cartesian", "meter" );
+    addVariable( "ListenerUp", { "I", "C" }, up, "", "" );
+    addVariable( "ListenerView", { "I", "C" }, view, "cartesian", "meter" );
+    addVariable( "ReceiverPosition", { "R", "C", "I" }, receivers, "cartesian", "meter" );
+    addVariable( "SourcePosition", { "M", "C" }, &positions[0], "spherical", "degree, degree, meter" );
+    addVariable( "SourceUp", { "I", "C" }, up, "", "" );
+    addVariable( "SourceView", { "I", "C" }, view, "cartesian", "meter" );
+    addVariable( "EmitterPosition", { "E", "C", "I" }, origin, "cartesian", "meter" );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          MinimumPhaseSpectrum and TransferFunctionConverter : the magnitude of a
+ *                  maximum-phase FIR is turned into the spectrum of its minimum-phase mirror
+ *                  (same magnitude, zeros inside the unit circle) ; GeneralTF accessors, and
+ *                  the minimum- and linear-phase IRs of a file of such spectra
+ *
+ */
+/************************************************************************************/
+static void TestMinimumPhaseSpectrum()
+{
+    typedef std::complex< double > Complex;
+
+    /// minimum-phase FIR : zeros 0.5, -0.4 and 0.3 +/- 0.5j
+    std::vector< double > minimum = { 1.0 };
+    {
+        const std::vector< std::vector< double > > factors = { { 1.0, -0.5 }, { 1.0, 0.4 }, { 1.0, -0.6, 0.34 } };
+
+        for( std::size_t f = 0; f < factors.size(); f++ )
+        {
+            std::vector< double > product( minimum.size() + factors[f].size() - 1, 0.0 );
+
+            for( std::size_t i = 0; i < minimum.size(); i++ )
+            {
+                for( std::size_t j = 0; j < factors[f].size(); j++ )
+                {
+                    product[ i + j ] += minimum[i] * factors[f][j];
+                }
+            }
+
+            minimum.swap( product );
+        }
+    }
+
+    /// the time-reversed FIR has the inverse zeros, and the same magnitude
+    const std::vector< double > maximum( minimum.rbegin(), minimum.rend() );
+
+    const auto spectrum = [](const std::vector< double > &h,
+                             const double frequency)    ///< normalized, in cycles per sample
+    {
+        Complex sum = 0.0;
+        for( std::size_t n = 0; n < h.size(); n++ )
+        {
+            sum += h[n] * std::polar( 1.0, -2.0 * kPi * frequency * n );
+        }
+        return sum;
+    };
+
+    //==============================================================================
+    {
+        const unsigned int F = 256;
+
+        sofa::dsp::FFT fft( F );
+
+        const unsigned int K = fft.GetNumBins();
+
+        std::vector< double > magnitude( K );
+        for( unsigned int k = 0; k < K; k++ )
+        {
+            magnitude[k] = std::abs( spectrum( maximum, static_cast< double >( k ) / F ) );
+        }
+
+        std::vector< float > re( K );
+        std::vector< float > im( K );
+        std::vector< float > time( F );
+
+        sofa::MinimumPhaseDecomposition::MinimumPhaseSpectrum( &re[0], &im[0], &magnitude[0], fft, &time[0] );
+
+        double magnitudeError   = 0.0;
+        double spectrumError    = 0.0;
+
+        for( unsigned int k = 0; k < K; k++ )
+        {
+            const Complex value( re[k], im[k] );
+
+            magnitudeError  = std::max( magnitudeError, std::fabs( std::abs( value ) - magnitude[k] ) );
+            spectrumError   = std::max( spectrumError, std::abs( value - spectrum( minimum, static_cast< double >( k ) / F ) ) );
+        }
+
+        const double peak = *std::max_element( magnitude.begin(), magnitude.end() );
+
+        Report( "MinimumPhaseSpectrum magnitude preserved", magnitudeError / peak, 1e-5 );
+        Report( "MinimumPhaseSpectrum vs minimum-phase mirror", spectrumError / peak, 1e-5 );
+    }
+
+    //==============================================================================
+    /// measurement m, receiver r : ( 1 + m + 0.5 r ) times the maximum-phase FIR
+    const double fs             = 48000.0;
+    const std::size_t M         = 3;
+    const std::size_t N         = 257;
+    const unsigned long L       = 64;
+
+    std::vector< double > positions;
+    for( std::size_t m = 0; m < M; m++ )
+    {
+        positions.insert( positions.end(), { 120.0 * m, 0.0, 1.2 } );
+    }
+
+    std::vector< double > frequencies( N );
+    for( std::size_t j = 0; j < N; j++ )
+    {
+        frequencies[j] = 0.5 * fs * j / ( N - 1 );
+    }
+
+    const auto gain = [](const std::size_t i)
+    {
+        return 1.0 + static_cast< double >( i / 2 ) + 0.5 * static_cast< double >( i % 2 );
+    };
+
+    std::vector< double > tf( M * 2 * N * 2 );
+    for( std::size_t i = 0; i < M * 2; i++ )
+    {
+        for( std::size_t j = 0; j < N; j++ )
+        {
+            const Complex value = gain( i ) * spectrum( maximum, frequencies[j] / fs );
+
+            tf[ ( i * N + j ) * 2 ]      = value.real();
+            tf[ ( i * N + j ) * 2 + 1 ]  = value.imag();
+        }
+    }
+
+    WriteGeneralTF( kTemporaryFile, positions, frequencies, tf );
+
+    {
+        const sofa::GeneralTF file( kTemporaryFile );
+
+        std::vector< double > all, range, real, realRange, read;
+        const bool readOk = file.IsValid() == true
+                         && file.GetFrequencies( read ) == true && read == frequencies
+                         && file.GetDataTF( all ) == true && all == tf
+                         && file.GetDataTF( range, 1, 2 ) == true
+                         && std::equal( range.begin(), range.end(), tf.begin() + 2 * N * 2 ) == true
+                         && file.GetDataReal( real ) == true
+                         && file.GetDataReal( realRange, 2, 1 ) == true
+                         && std::equal( realRange.begin(), realRange.end(), real.begin() + 2 * 2 * N ) == true
+                         && file.GetDataTF( read, M - 1, 2 ) == false;
+
+        Report( "GeneralTF frequencies, data and ranges", ( readOk == true ) ? 0.0 : 1.0, 0.0 );
+
+        sofa::TransferFunctionConverter converter;
+
+        converter.Compute( file, L, fs, sofa::TransferFunctionConverter::kMinimumPhase );
+
+        double minimumError = 0.0;
+        for( std::size_t i = 0; i < M * 2; i++ )
+        {
+            const double *ir = converter.GetIR( i / 2, i % 2 );
+
+            for( unsigned long n = 0; n < L; n++ )
+            {
+                const double expected = ( n < minimum.size() ) ? gain( i ) * minimum[n] : 0.0;
+
+                minimumError = std::max( minimumError, std::fabs( ir[n] - expected ) / gain( i ) );
+            }
+        }
+
+        Report( "TransferFunctionConverter minimum-phase IRs", minimumError, 1e-4 );
+
+        sofa::FIRDataSet dataSet;
+        const bool applied = converter.Apply( dataSet, file );
+
+        double applyError = ( applied == true
+                             && dataSet.GetNumMeasurements() == M
+                             && dataSet.GetNumDataSamples() == L
+                             && dataSet.GetSamplingRate() == fs ) ? 0.0 : 1.0;
+
+        if( applyError == 0.0 )
+        {
+            applyError = MaxError( dataSet.GetIR( 2, 1 ), converter.GetIR( 2, 1 ), L );
+        }
+
+        Report( "TransferFunctionConverter loaded into a FIRDataSet", applyError, 0.0 );
+
+        /// linear phase : symmetric around L / 2, with the magnitude of the file
+        converter.Compute( file, L, fs, sofa::TransferFunctionConverter::kLinearPhase );
+
+        double symmetryError    = 0.0;
+        double dcError          = 0.0;
+        for( std::size_t i = 0; i < M * 2; i++ )
+        {
+            const double *ir = converter.GetIR( i / 2, i % 2 );
+
+            double sum = 0.0;
+            for( unsigned long n = 0; n < L; n++ )
+            {
+                sum += ir[n];
+            }
+
+            for( unsigned long j = 1; j < L / 2; j++ )
+            {
+                symmetryError = std::max( symmetryError, std::fabs( ir[ L / 2 + j ] - ir[ L / 2 - j ] ) );
+            }
+
+            dcError = std::max( dcError, std::fabs( sum - std::abs( tf[ i * N * 2 ] ) ) / gain( i ) );
+        }
+
+        Report( "TransferFunctionConverter linear-phase symmetry", symmetryError, 1e-6 );
+        Report( "TransferFunctionConverter linear-phase DC gain", dcError, 5e-3 );
+    }
+
+    std::remove( kTemporaryFile.c_str() );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          VirtualLoudspeakerRenderer : routing of a 5.1 bed to the closest of 8
+ *                  emitters on a circle, plus a channel routed by hand with a gain, vs the
+ *                  sum of direct convolutions with the delayed BRIRs of the measurement
+ *
+ */
+/************************************************************************************/
+static void TestVirtualLoudspeakerRenderer()
+{
+    typedef sofa::dsp::VirtualLoudspeakerRenderer Renderer;
+
+    const std::size_t M             = 2;
+    const std::size_t R             = 2;
+    const std::size_t E             = 8;
+    const std::size_t N             = 150;
+    const unsigned long kMeasurement = 1;
+    const unsigned int kBlockSize   = 64;
+    const std::size_t kNumBlocks    = 30;
+    const std::size_t kInputLength  = kNumBlocks * kBlockSize;
+
+    std::vector< double > ir;
+    Noise( ir, M * R * E * N, 46 );
+
+    /// Data.Delay [ M R E ] : delay of ( m, r, e ) is m R E + r E + e samples
+    WriteMultiSpeakerBRIR( kTemporaryFile, M, E, ir, { "M", "R", "E", "N" }, { "M", "R", "E" } );
+
+    const sofa::MultiSpeakerBRIR file( kTemporaryFile );
+
+    Renderer renderer( file, kMeasurement, kBlockSize );
+
+    //==============================================================================
+    /// 5.1 : L 30 -> 45, R 330 -> 315, C and LFE -> 0, Ls 110 -> 90, Rs 250 -> 270 ;
+    /// channel 6 is routed by hand to emitter 3 (135 degrees) with a gain of 0.5
+    const unsigned long expectedEmitters[] = { 1, 7, 0, 0, 2, 6, 3 };
+    const float kGain = 0.5f;
+
+    renderer.SetChannelLayout( Renderer::kSurround51 );
+    renderer.SetChannelEmitter( 6, 3, kGain );
+
+    const unsigned int K = renderer.GetNumChannels();
+
+    double routingError = ( K == 7 && renderer.GetNumActiveEmitters() == 6 && renderer.GetNumEmitters() == E ) ? 0.0 : 1.0;
+
+    for( unsigned int k = 0; k < std::min( K, 7u ); k++ )
+    {
+        routingError += ( renderer.GetChannelEmitter( k ) == expectedEmitters[k] ) ? 0.0 : 1.0;
+    }
+
+    for( std::size_t e = 0; e < E; e++ )
+    {
+        const double azimuth = 360.0 * e / E;
+
+        routingError += ( renderer.FindEmitter( azimuth + 10.0, 20.0 ) == e ) ? 0.0 : 1.0;
+        routingError += std::fabs( renderer.GetEmitterDirection( e )[0] - std::cos( azimuth * kPi / 180.0 ) );
+        routingError += std::fabs( renderer.GetEmitterDirection( e )[1] - std::sin( azimuth * kPi / 180.0 ) );
+    }
+
+    Report( "VirtualLoudspeakerRenderer routing to emitters", routingError, 1e-9 );
+
+    if( K != 7 )
+    {
+        std::remove( kTemporaryFile.c_str() );
+        return;
+    }
+
+    //==============================================================================
+    std::vector< float > inputs[7];
+    for( unsigned int k = 0; k < K; k++ )
+    {
+        Noise( inputs[k], kInputLength, 460 + k );
+    }
+
+    std::vector< float > outputs[2] = { std::vector< float >( kInputLength ), std::vector< float >( kInputLength ) };
+
+    renderer.Reset();
+
+    for( std::size_t b = 0; b < kNumBlocks; b++ )
+    {
+        const float *in[7];
+        for( unsigned int k = 0; k < K; k++ )
+        {
+            in[k] = &inputs[k][ b * kBlockSize ];
+        }
+
+        renderer.Process( &outputs[0][ b * kBlockSize ], &outputs[1][ b * kBlockSize ], in, K, kBlockSize );
+    }
+
+    double error    = 0.0;
+    double peak     = 0.0;
+
+    for( std::size_t r = 0; r < R; r++ )
+    {
+        std::vector< double > expected( kInputLength, 0.0 );
+
+        for( unsigned int k = 0; k < K; k++ )
+        {
+            const std::size_t e     = expectedEmitters[k];
+            const std::size_t i     = ( kMeasurement * R + r ) * E + e;
+            const double delay      = static_cast< double >( i );
+            const double gain       = ( k == 6 ) ? kGain : 1.0;
+
+            std::vector< double > filter( sofa::dsp::FractionalDelayLine::GetDelayedLength( N, delay ) );
+            sofa::dsp::FractionalDelayLine::ApplyDelay( &filter[0], filter.size(), &ir[ i * N ], N, delay );
+
+            std::vector< double > y;
+            Convolve( y, inputs[k], filter );
+
+            for( std::size_t n = 0; n < kInputLength; n++ )
+            {
+                expected[n] += gain * y[n];
+            }
+        }
+
+        for( std::size_t n = 0; n < kInputLength; n++ )
+        {
+            error = std::max( error, std::fabs( outputs[r][n] - expected[n] ) );
+            peak  = std::max( peak, std::fabs( expected[n] ) );
+        }
+    }
+
+    Report( "VirtualLoudspeakerRenderer vs direct convolution", error / peak, 1e-5 );
+
+    std::remove( kTemporaryFile.c_str() );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Writes a SingleRoomDRIR file (replaced if it exists)
+ *  @param[in]      receivers : [ R 3 ] cartesian receiver positions, relative to the listener
+ *  @param[in]      ir : [ M R N ]
+ *  @param[in]      delay : [ I R ] or [ M R ]
+ *  @param[in]      listeners : [ M 3 ] cartesian listener positions ; the origin if empty
+ *
+ */
+/************************************************************************************/
+static void WriteSingleRoomDRIR(const std::string &path,
+                                const std::vector< double > &receivers,
+                                const std::vector< double > &ir,
+                                const std::vector< double > &delay,
+                                const double samplingRate,
+                                const std::vector< double > &listeners = std::vector< double >())
+{
+    const std::size_t R = receivers.size() / 3;
+    const std::size_t M = ( listeners.empty() == false ) ? listeners.size() / 3
+                        : ( delay.size() == R ) ? 1 : delay.size() / R;
+    const std::size_t N = ir.size() / ( M * R );
+
+    const netCDF::NcFile theFile( path, netCDF::NcFile::replace, netCDF::NcFile::nc4 );
+
+    sofa::Attributes attributes;
+    attributes.ResetToDefault();
+
+    attributes.Set( sofa::Attributes::kSOFAConventions, "SingleRoomDRIR" );
+    attributes.Set( sofa::Attributes::kSOFAConventionsVersion, "0.2" );
+    attributes.Set( sofa::Attributes::kDataType, "FIR" );
+    attributes.Set( sofa::Attributes::kRoomType, "reverberant" );
+
+    for( unsigned int k = 0; k < sofa::Attributes::kNumAttributes; k++ )
+    {
+        const sofa::Attributes::Type attType = static_cast< sofa::Attributes::Type >(k);
+
+        theFile.putAtt( sofa::Attributes::GetName( attType ), attributes.Get( attType ) );
+    }
+
+    theFile.putAtt( "DatabaseName", "sofatests" );
+    theFile.putAtt( "RoomDescription", "sofatests" );
+
+    theFile.addDim( "C", 3 );
+    theFile.addDim( "I", 1 );
+    theFile.addDim( "M", M );
+    theFile.addDim( "R", R );
+    theFile.addDim( "E", 1 );
+    theFile.addDim( "N", N );
+
+    const auto addVariable = [ &theFile ](const std::string &name,
+                                          const std::vector< std::string > &dimNames,
+                                          const double *values,
+                                          const std::string &type,
+                                          const std::string &units)
+    {
+        const netCDF::NcVar var = theFile.addVar( name, "double", dimNames );
+
+        var.putVar( values );
+
+        if( type.empty() == false )
+        {
+            var.putAtt( "Type", type );
+            var.putAtt( "Units", units );
+        }
+    };
+
+    const double origin[3]      = { 0.0, 0.0, 0.0 };
+    const double up[3]          = { 0.0, 0.0, 1.0 };
+    const double view[3]        = { 1.0, 0.0, 0.0 };
+    const double source[3]      = { 2.0, 0.0, 0.0 };
+
+    {
+        const netCDF::NcVar var = theFile.addVar( "Data.SamplingRate", "double", "I" );
+        var.putVar( &samplingRate );
+        var.putAtt( "Units", "hertz" );
+    }
+
+    addVariable( "Data.Delay", { ( delay.size() == R ) ? "I" : "M", "R" }, &delay[0], "", "" );
+    addVariable( "Data.IR", { "M", "R", "N" }, &ir[0], "", "" );
+    addVariable( "ListenerPosition", { ( listeners.empty() == true ) ? "I" : "M", "C" },
+                 ( listeners.empty() == true ) ? origin : &listeners[0], "cartesian", "meter" );
+    addVariable( "ListenerUp", { "I", "C" }, up, "", "" );
+    addVariable( "ListenerView", { "I", "C" }, view, "cartesian", "meter" );
+    addVariable( "ReceiverPosition", { "R", "C", "I" }, &receivers[0], "cartesian", "meter" );
+    addVariable( "SourcePosition", { "I", "C" }, source, "cartesian", "meter" );
+    addVariable( "SourceUp", { "I", "C" }, up, "", "" );
+    addVariable( "SourceView", { "I", "C" }, view, "cartesian", "meter" );
+    addVariable( "EmitterPosition", { "E", "C", "I" }, origin, "cartesian", "meter" );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          ArrayBeamformer : six receivers on the axes, 2.5 samples from the center,
+ *                  the responses filling exactly one FFT period. A plane wave (Data.Delay)
+ *                  is realigned toward its direction ; noise DRIRs with fractional delays vs
+ *                  a direct DFT of the delay-and-sum, and closed forms of the DC and Nyquist
+ *                  bins (real spectrum : Nyquist is the real part of the steered bin)
+ *
+ */
+/************************************************************************************/
+static void TestArrayBeamformer()
+{
+    typedef std::complex< double > Complex;
+
+    const double fs             = 48000.0;
+    const double c              = 343.0;
+    const double a              = 2.5 * c / fs;     ///< latency ceil( 2.5 ) = 3
+    const std::size_t R         = 6;
+    const std::size_t M         = 2;
+    const std::size_t N         = 52;               ///< N + ceil( max delay ) + 2 latency = 64
+    const std::size_t F         = 64;
+    const std::size_t kLatency  = 3;
+    const std::size_t kPulse    = 40;
+
+    const std::vector< double > receivers =
+    {
+          a, 0.0, 0.0,   -a, 0.0, 0.0,
+        0.0,   a, 0.0,  0.0,  -a, 0.0,
+        0.0, 0.0,   a,  0.0, 0.0,  -a,
+    };
+
+    /// measurement 0 : the same pulse on every receiver, delayed as a plane wave from +x
+    /// (3 - 2.5, 3 or 3 + 2.5 samples) ; measurement 1 : noise, arbitrary fractional delays
+    std::vector< double > pulse;
+    Noise( pulse, kPulse, 48 );
+
+    std::vector< double > noise;
+    Noise( noise, R * N, 49 );
+
+    std::vector< double > ir( M * R * N, 0.0 );
+    std::vector< double > delay( M * R );
+
+    for( std::size_t r = 0; r < R; r++ )
+    {
+        std::copy( pulse.begin(), pulse.end(), &ir[ r * N ] );
+        std::copy( &noise[ r * N ], &noise[ r * N ] + N, &ir[ ( R + r ) * N ] );
+
+        delay[r]        = 3.0 - fs * receivers[ 3 * r ] / c;
+        delay[ R + r ]  = 0.37 * r + 0.25;
+    }
+
+    WriteSingleRoomDRIR( kTemporaryFile, receivers, ir, delay, fs );
+
+    /// +x, +y, 45 degrees up, -z
+    const std::vector< double > directions = { 0.0, 0.0, 90.0, 0.0, 30.0, 45.0, 0.0, -90.0 };
+    const std::size_t D = directions.size() / 2;
+
+    sofa::ArrayBeamformer beamformer;
+    beamformer.SetDirections( directions );
+
+    bool computed = false;
+    {
+        const sofa::SingleRoomDRIR file( kTemporaryFile );
+        computed = beamformer.Compute( file );
+    }
+
+    std::remove( kTemporaryFile.c_str() );
+
+    const bool dimensionsOk = computed == true
+                           && beamformer.GetNumMeasurements() == M
+                           && beamformer.GetNumDirections() == D
+                           && beamformer.GetResponseLength() == F
+                           && beamformer.GetLatency() == kLatency
+                           && std::fabs( beamformer.GetArrayRadius() - a ) < 1e-15;
+
+    Report( "ArrayBeamformer dimensions and latency", ( dimensionsOk == true ) ? 0.0 : 1.0, 0.0 );
+
+    if( dimensionsOk == false )
+    {
+        return;
+    }
+
+    //==============================================================================
+    /// the plane wave realigned : the pulse delayed by 3 + latency samples
+    double alignedError = 0.0;
+    {
+        const double *y         = beamformer.GetResponse( 0, 0 );
+        const std::size_t shift = 3 + kLatency;
+
+        for( std::size_t n = 0; n < F; n++ )
+        {
+            const double expected = ( n >= shift && n < shift + kPulse ) ? pulse[ n - shift ] : 0.0;
+
+            alignedError = std::max( alignedError, std::fabs( y[n] - expected ) );
+        }
+
+        for( std::size_t d = 1; d < D; d++ )
+        {
+            alignedError += ( beamformer.GetEnergy( 0, d ) < beamformer.GetEnergy( 0, 0 ) ) ? 0.0 : 1.0;
+        }
+    }
+
+    Report( "ArrayBeamformer plane wave realigned", alignedError, 1e-5 );
+
+    //==============================================================================
+    /// Y[k] = 1/R sum_r X_r[k] exp( -2 j pi k ( delay_r + tau_r ) / F ) over one period
+    double dftError     = 0.0;
+    double binError     = 0.0;
+    double peak         = 0.0;
+
+    for( std::size_t m = 0; m < M; m++ )
+    {
+        for( std::size_t d = 0; d < D; d++ )
+        {
+            const double spherical[3] = { directions[ 2 * d ], directions[ 2 * d + 1 ], 1.0 };
+
+            double u[3];
+            sofa::Geometry::SphericalToCartesian( u, spherical );
+
+            std::vector< Complex > Y( F / 2 + 1, 0.0 );
+            double dc       = 0.0;
+            double nyquist  = 0.0;
+
+            for( std::size_t r = 0; r < R; r++ )
+            {
+                const double *q     = &receivers[ 3 * r ];
+                const double tau    = kLatency + fs * ( q[0] * u[0] + q[1] * u[1] + q[2] * u[2] ) / c;
+                const double total  = delay[ m * R + r ] + tau;
+                const double *x     = &ir[ ( m * R + r ) * N ];
+
+                for( std::size_t k = 0; k <= F / 2; k++ )
+                {
+                    Complex X = 0.0;
+                    for( std::size_t n = 0; n < N; n++ )
+                    {
+                        X += x[n] * std::polar( 1.0, -2.0 * kPi * k * n / F );
+                    }
+
+                    Y[k] += X * std::polar( 1.0 / R, -2.0 * kPi * k * total / F );
+                }
+
+                /// X_r is real at DC and Nyquist
+                double sum          = 0.0;
+                double alternating  = 0.0;
+                for( std::size_t n = 0; n < N; n++ )
+                {
+                    sum         += x[n];
+                    alternating += ( n % 2 == 0 ) ? x[n] : -x[n];
+                }
+
+                dc      += sum / R;
+                nyquist += alternating * std::cos( kPi * total ) / R;
+            }
+
+            const double *y = beamformer.GetResponse( m, d );
+
+            double sum          = 0.0;
+            double alternating  = 0.0;
+
+            for( std::size_t n = 0; n < F; n++ )
+            {
+                double expected = Y[0].real() + Y[ F / 2 ].real() * ( ( n % 2 == 0 ) ? 1.0 : -1.0 );
+                for( std::size_t k = 1; k < F / 2; k++ )
+                {
+                    expected += 2.0 * ( Y[k] * std::polar( 1.0, 2.0 * kPi * k * n / F ) ).real();
+                }
+                expected /= F;
+
+                dftError    = std::max( dftError, std::fabs( y[n] - expected ) );
+                peak        = std::max( peak, std::fabs( expected ) );
+
+                sum         += y[n];
+                alternating += ( n % 2 == 0 ) ? y[n] : -y[n];
+            }
+
+            binError = std::max( binError, std::fabs( sum - dc ) );
+            binError = std::max( binError, std::fabs( alternating - nyquist ) );
+        }
+    }
+
+    Report( "ArrayBeamformer fractional delays vs direct DFT", dftError / peak, 1e-5 );
+    Report( "ArrayBeamformer DC and Nyquist bins", binError, 1e-5 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          AmbisonicEncoder : open-sphere radial filters of orders 0 and 1 vs a
+ *                  direct DFT of their design (j_0 and i j_1 mode strengths), with closed
+ *                  forms of the DC and Nyquist bins ; first-order encoding of an octahedral
+ *                  array (exact fit) with fractional delays, vs direct convolution
+ *
+ */
+/************************************************************************************/
+static void TestAmbisonicEncoder()
+{
+    typedef std::complex< double > Complex;
+
+    const double fs             = 48000.0;
+    const double c              = 343.0;
+    const double a              = 0.042;
+    const unsigned int L        = 64;
+    const double kMaxGain       = 20.0;
+    const std::size_t R         = 6;
+    const std::size_t M         = 2;
+    const std::size_t N         = 40;
+    const unsigned int kOrder   = 1;
+    const std::size_t K         = 4;
+
+    const std::vector< double > receivers =
+    {
+          a, 0.0, 0.0,   -a, 0.0, 0.0,
+        0.0,   a, 0.0,  0.0,  -a, 0.0,
+        0.0, 0.0,   a,  0.0, 0.0,  -a,
+    };
+
+    std::vector< double > ir;
+    Noise( ir, M * R * N, 49 );
+
+    std::vector< double > delay( M * R );
+    for( std::size_t i = 0; i < M * R; i++ )
+    {
+        delay[i] = 0.3 * i + 0.45;
+    }
+
+    WriteSingleRoomDRIR( kTemporaryFile, receivers, ir, delay, fs );
+
+    sofa::AmbisonicEncoder encoder;
+    encoder.SetArrayType( sofa::AmbisonicEncoder::kOpenSphere );
+    encoder.SetRadialFilterLength( L );
+    encoder.SetMaxRadialGain( kMaxGain );
+    encoder.SetSpeedOfSound( c );
+
+    bool computed = false;
+    {
+        const sofa::SingleRoomDRIR file( kTemporaryFile );
+        computed = encoder.Compute( file, kOrder, 0.0 );
+    }
+
+    std::remove( kTemporaryFile.c_str() );
+
+    const bool dimensionsOk = computed == true
+                           && encoder.GetNumCoefficients() == K
+                           && encoder.GetNumMeasurements() == M
+                           && encoder.GetLatency() == L / 2
+                           && std::fabs( encoder.GetArrayRadius() - a ) < 1e-12;
+
+    Report( "AmbisonicEncoder dimensions and latency", ( dimensionsOk == true ) ? 0.0 : 1.0, 0.0 );
+
+    if( dimensionsOk == false )
+    {
+        return;
+    }
+
+    //==============================================================================
+    /// T[k] = (-1)^k conj( d_n ) / ( |d_n|^2 + mu^2 ), d_0 = j_0( kr ), d_1 = i j_1( kr ) ;
+    /// the filter is the inverse DFT (real : Nyquist is Re T) times a Hann window
+    const double mu = 0.5 / std::pow( 10.0, kMaxGain / 20.0 );
+
+    double filterError  = 0.0;
+    double binError     = 0.0;
+
+    for( unsigned int n = 0; n <= kOrder; n++ )
+    {
+        std::vector< Complex > T( L / 2 + 1 );
+
+        for( unsigned int k = 0; k <= L / 2; k++ )
+        {
+            const double x = 2.0 * kPi * k * fs / L * a / c;
+
+            Complex d = ( n == 0 ) ? 1.0 : 0.0;
+            if( k > 0 )
+            {
+                d = ( n == 0 ) ? Complex( std::sin( x ) / x )
+                               : Complex( 0.0, std::sin( x ) / ( x * x ) - std::cos( x ) / x );
+            }
+
+            T[k] = ( ( k % 2 == 0 ) ? 1.0 : -1.0 ) * std::conj( d ) / ( std::norm( d ) + mu * mu );
+        }
+
+        const double *h = encoder.GetRadialFilter( n );
+
+        double peak         = 0.0;
+        double error        = 0.0;
+        double sum          = 0.0;
+        double alternating  = 0.0;
+
+        for( unsigned int i = 0; i < L; i++ )
+        {
+            double t = T[0].real() + T[ L / 2 ].real() * ( ( i % 2 == 0 ) ? 1.0 : -1.0 );
+            for( unsigned int k = 1; k < L / 2; k++ )
+            {
+                t += 2.0 * ( T[k] * std::polar( 1.0, 2.0 * kPi * k * i / L ) ).real();
+            }
+
+            const double expected = ( 0.5 - 0.5 * std::cos( 2.0 * kPi * i / L ) ) * t / L;
+
+            error = std::max( error, std::fabs( h[i] - expected ) );
+            peak  = std::max( peak, std::fabs( expected ) );
+
+            sum         += h[i];
+            alternating += ( i % 2 == 0 ) ? h[i] : -h[i];
+        }
+
+        filterError = std::max( filterError, error / peak );
+
+        /// the window mixes each bin with its neighbours : W[k] = T[k] / 2 - ( T[k-1] + T[k+1] ) / 4
+        binError = std::max( binError, std::fabs( sum - ( 0.5 * T[0].real() - 0.5 * T[1].real() ) ) / peak );
+        binError = std::max( binError, std::fabs( alternating - ( 0.5 * T[ L / 2 ].real() - 0.5 * T[ L / 2 - 1 ].real() ) ) / peak );
+    }
+
+    Report( "AmbisonicEncoder radial filters vs direct DFT", filterError, 1e-5 );
+    Report( "AmbisonicEncoder radial filters DC and Nyquist", binError, 1e-5 );
+
+    //==============================================================================
+    /// the octahedron fits the first order exactly : P = 4 pi / R Y^T, so coefficient k
+    /// is h_n * sqrt( 4 pi ) / R sum_r Y_k( u_r ) x_r( t - delay_r )
+    const std::size_t length    = encoder.GetResponseLength() - L + 1;
+    double encodingError        = 0.0;
+    double peak                 = 0.0;
+
+    for( std::size_t m = 0; m < M; m++ )
+    {
+        std::vector< double > mixes( K * length, 0.0 );
+
+        for( std::size_t r = 0; r < R; r++ )
+        {
+            double u[3] = { receivers[ 3 * r ] / a, receivers[ 3 * r + 1 ] / a, receivers[ 3 * r + 2 ] / a };
+
+            double Y[ K ];
+            sofa::SphericalHarmonics::Evaluate( Y, kOrder, u );
+
+            std::vector< double > delayed( length );
+            sofa::dsp::FractionalDelayLine::ApplyDelay( &delayed[0], length, &ir[ ( m * R + r ) * N ], N, delay[ m * R + r ] );
+
+            for( std::size_t k = 0; k < K; k++ )
+            {
+                for( std::size_t i = 0; i < length; i++ )
+                {
+                    mixes[ k * length + i ] += std::sqrt( 4.0 * kPi ) / R * Y[k] * delayed[i];
+                }
+            }
+        }
+
+        for( std::size_t k = 0; k < K; k++ )
+        {
+            const double *h         = encoder.GetRadialFilter( ( k == 0 ) ? 0 : 1 );
+            const double *response  = encoder.GetResponse( m, static_cast< unsigned int >( k ) );
+
+            for( std::size_t i = 0; i < encoder.GetResponseLength(); i++ )
+            {
+                double expected = 0.0;
+                for( std::size_t j = 0; j < L; j++ )
+                {
+                    if( i >= j && i - j < length )
+                    {
+                        expected += h[j] * mixes[ k * length + i - j ];
+                    }
+                }
+
+                encodingError   = std::max( encodingError, std::fabs( response[i] - expected ) );
+                peak            = std::max( peak, std::fabs( expected ) );
+            }
+        }
+    }
+
+    Report( "AmbisonicEncoder first order vs direct convolution", encodingError / peak, 1e-5 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          NavigationRenderer : DRIRs at three listener positions on a line, each
+ *                  a pulse (direct sound, within the unfaded part of the split) followed by
+ *                  a tail, with fractional delays. At a measured position the DRIR is
+ *                  rendered as is ; between two positions, the pulses are mixed with the
+ *                  inverse squared distance weights and delayed by the weighted arrival,
+ *                  the tails mixed with the square roots of the weights
+ *
+ */
+/************************************************************************************/
+static void TestNavigationRenderer()
+{
+    typedef sofa::dsp::FractionalDelayLine FDL;
+
+    const double fs                 = 48000.0;
+    const std::size_t M             = 3;
+    const std::size_t R             = 2;
+    const std::size_t N             = 400;
+    const unsigned int kBlockSize   = 64;
+    const std::size_t kMoveBlock    = 20;
+    const std::size_t kSettleBlocks = 10;      ///< longer than the filters
+    const std::size_t kNumBlocks    = 60;
+    const std::size_t kInputLength  = kNumBlocks * kBlockSize;
+    const std::size_t kPreOnset     = 8;
+    const std::size_t kDirectLength = kPreOnset + 120;     ///< 2.5 ms
+    const std::size_t kPulseLength  = 40;
+    const unsigned int kOrder       = 16;
+
+    const std::vector< double > listeners = { 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 3.0, 0.0, 0.0 };
+    const std::vector< double > receivers = { 0.0, 0.09, 0.0, 0.0, -0.09, 0.0 };
+
+    /// onset of ( m, r ), late enough for the delay line to interpolate with all its taps ;
+    /// the tail starts where the direct sound ends
+    const auto onset = [](const std::size_t i)
+    {
+        return 40 + 7 * ( i / 2 ) + 3 * ( i % 2 );
+    };
+
+    std::vector< double > noise;
+    Noise( noise, M * R * N, 50 );
+
+    std::vector< double > pulses( M * R * N, 0.0 );
+    std::vector< double > tails( M * R * N, 0.0 );
+    std::vector< double > ir( M * R * N );
+    std::vector< double > delay( M * R );
+
+    for( std::size_t i = 0; i < M * R; i++ )
+    {
+        const std::size_t s = onset( i );
+
+        pulses[ i * N + s ] = 1.0;
+        for( std::size_t n = 1; n < kPulseLength; n++ )
+        {
+            pulses[ i * N + s + n ] = 0.5 * noise[ i * N + n ];
+        }
+
+        for( std::size_t n = s - kPreOnset + kDirectLength; n < N; n++ )
+        {
+            tails[ i * N + n ] = 0.3 * noise[ i * N + n ] * std::exp( -static_cast< double >( n ) / 100.0 );
+        }
+
+        for( std::size_t n = 0; n < N; n++ )
+        {
+            ir[ i * N + n ] = pulses[ i * N + n ] + tails[ i * N + n ];
+        }
+
+        delay[i] = 1.3 + 0.7 * ( i / 2 ) + 0.4 * ( i % 2 );
+    }
+
+    WriteSingleRoomDRIR( kTemporaryFile, receivers, ir, delay, fs, listeners );
+
+    const sofa::SingleRoomDRIR file( kTemporaryFile );
+
+    sofa::dsp::NavigationRenderer renderer( file, kBlockSize, 2, 8, false, 1024 );
+
+    std::remove( kTemporaryFile.c_str() );
+
+    //==============================================================================
+    /// neighbours : 0.25 m from measurement 0 and 0.75 m from measurement 1
+    const double kPosition[3] = { 0.25, 0.0, 0.0 };
+    const double weights[2]   = { 0.9, 0.1 };
+
+    double indexError = 0.0;
+    {
+        std::vector< unsigned long > measurements;
+        std::vector< double > found;
+
+        renderer.GetPositionIndex().FindNearest( measurements, found, listeners.data() + 3, 2 );
+        indexError += ( measurements.size() == 1 && measurements[0] == 1 && found[0] == 1.0 ) ? 0.0 : 1.0;
+
+        renderer.GetPositionIndex().FindNearest( measurements, found, kPosition, 2 );
+        indexError += ( measurements.size() == 2 && measurements[0] == 0 && measurements[1] == 1 ) ? 0.0 : 1.0;
+
+        for( std::size_t i = 0; i < std::min< std::size_t >( 2, found.size() ); i++ )
+        {
+            indexError += std::fabs( found[i] - weights[i] );
+        }
+    }
+
+    Report( "PositionIndex neighbours and weights", indexError, 1e-12 );
+
+    //==============================================================================
+    std::vector< float > input;
+    Noise( input, kInputLength, 51 );
+
+    std::vector< float > outputs[2] = { std::vector< float >( kInputLength ), std::vector< float >( kInputLength ) };
+
+    for( std::size_t b = 0; b < kNumBlocks; b++ )
+    {
+        if( b == kMoveBlock )
+        {
+            renderer.SetListenerPosition( kPosition );
+        }
+
+        const float *in[1]  = { &input[ b * kBlockSize ] };
+        float *out[2]       = { &outputs[0][ b * kBlockSize ], &outputs[1][ b * kBlockSize ] };
+
+        renderer.Process( out, in, kBlockSize );
+    }
+
+    const auto delayed = [ & ](std::vector< double > &output,
+                               const double *filter,
+                               const double filterDelay)
+    {
+        std::vector< double > h( FDL::GetDelayedLength( N, filterDelay, FDL::kWindowedSinc, kOrder ) );
+        FDL::ApplyDelay( &h[0], h.size(), filter, N, filterDelay, FDL::kWindowedSinc, kOrder );
+
+        Convolve( output, input, h );
+    };
+
+    double measuredError    = 0.0;
+    double mixedError       = 0.0;
+    double peak             = 0.0;
+
+    for( std::size_t r = 0; r < R; r++ )
+    {
+        /// at measurement 0 : the delayed DRIR
+        std::vector< double > expected;
+        delayed( expected, &ir[ r * N ], delay[r] );
+
+        for( std::size_t n = 0; n < kMoveBlock * kBlockSize; n++ )
+        {
+            measuredError   = std::max( measuredError, std::fabs( outputs[r][n] - expected[n] ) );
+            peak            = std::max( peak, std::fabs( expected[n] ) );
+        }
+
+        /// between measurements 0 and 1 : the aligned pulses delayed by the weighted arrival,
+        /// plus the tails
+        std::vector< double > aligned( N, 0.0 );
+        double arrival = 0.0;
+
+        expected.assign( kInputLength, 0.0 );
+
+        for( std::size_t m = 0; m < 2; m++ )
+        {
+            const std::size_t i     = m * R + r;
+            const std::size_t start = onset( i ) - kPreOnset;
+
+            for( std::size_t n = 0; n < kDirectLength; n++ )
+            {
+                aligned[n] += weights[m] * pulses[ i * N + start + n ];
+            }
+
+            arrival += weights[m] * ( delay[i] + start );
+
+            std::vector< double > tail;
+            delayed( tail, &tails[ i * N ], delay[i] );
+
+            for( std::size_t n = 0; n < kInputLength; n++ )
+            {
+                expected[n] += std::sqrt( weights[m] ) * tail[n];
+            }
+        }
+
+        /// the delay line runs in single precision
+        std::vector< double > direct;
+        delayed( direct, &aligned[0], static_cast< float >( arrival ) );
+
+        for( std::size_t n = ( kMoveBlock + kSettleBlocks ) * kBlockSize; n < kInputLength; n++ )
+        {
+            mixedError = std::max( mixedError, std::fabs( outputs[r][n] - expected[n] - direct[n] ) );
+        }
+    }
+
+    Report( "NavigationRenderer at a measured position", measuredError / peak, 1e-5 );
+    Report( "NavigationRenderer between two positions", mixedError / peak, 1e-5 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          FractionalDelayLine : constant and ramped fractional delays of a sinusoid,
+ *                  and ApplyDelay of a finite burst, vs the analytic delayed signals
+ *
+ */
+/************************************************************************************/
+static void TestFractionalDelayLine()
+{
+    typedef sofa::dsp::FractionalDelayLine FDL;
+
+    const unsigned int kBlockSize   = 256;
+    const unsigned int kNumBlocks   = 16;
+    const unsigned int kWarmup      = 512;     ///< transient of the delay line (and of the allpass)
+
+    struct Configuration
+    {
+        FDL::Interpolation interpolation;
+        unsigned int order;
+        double frequency;                       ///< normalized (cycles per sample)
+        double tolerance;                       ///< constant delay
+        double rampTolerance;                   ///< ramped delay
+        const char *name;
+    };
+
+    const Configuration configurations[] =
+    {
+        { FDL::kLagrange,       3,  0.02,   1e-4,   1e-4,   "Lagrange 3" },
+        { FDL::kThiran,         3,  0.02,   1e-4,   2e-3,   "Thiran 3" },
+        { FDL::kWindowedSinc,   16, 0.1,    5e-4,   5e-4,   "windowed sinc 16" },
+    };
+
+    for( std::size_t i = 0; i < sizeof( configurations ) / sizeof( Configuration ); i++ )
+    {
+        const Configuration &configuration = configurations[i];
+
+        const double omega = 2.0 * kPi * configuration.frequency;
+
+        /// two channels : a constant delay, and a delay ramped over the third block ;
+        /// the delays are larger than half the interpolators (no off-center interpolation)
+        const float fromDelays[2]   = { 30.3f, 20.71f };
+        const float toDelays[2]     = { 30.3f, 24.15f };
+
+        FDL delayLine( 2, 40.0, kBlockSize, configuration.interpolation, configuration.order );
+
+        std::vector< float > input( kBlockSize );
+        std::vector< float > outputs[2];
+        outputs[0].resize( kBlockSize );
+        outputs[1].resize( kBlockSize );
+
+        const float *inputs[2]  = { &input[0], &input[0] };
+        float *const output[2]  = { &outputs[0][0], &outputs[1][0] };
+
+        double errors[2] = { 0.0, 0.0 };
+
+        for( unsigned int b = 0; b < kNumBlocks; b++ )
+        {
+            for( unsigned int n = 0; n < kBlockSize; n++ )
+            {
+                input[n] = static_cast< float >( std::sin( omega * ( b * kBlockSize + n ) ) );
+            }
+
+            const float *from   = ( b >= 3 ) ? toDelays : fromDelays;
+            const float *to     = ( b >= 2 ) ? toDelays : fromDelays;
+
+            delayLine.Process( output, inputs, kBlockSize, from, to );
+
+            for( unsigned int c = 0; c < 2; c++ )
+            {
+                for( unsigned int n = 0; n < kBlockSize; n++ )
+                {
+                    const double ramp   = static_cast< double >( n + 1 ) / kBlockSize;
+                    const double delay  = from[c] + ( to[c] - from[c] ) * ramp;
+                    const double t      = static_cast< double >( b * kBlockSize + n ) - delay;
+
+                    if( t >= kWarmup || ( c == 1 && b == 2 ) )
+                    {
+                        errors[c] = std::max( errors[c], std::fabs( outputs[c][n] - std::sin( omega * t ) ) );
+                    }
+                }
+            }
+        }
+
+        Report( std::string( "FractionalDelayLine " ) + configuration.name, errors[0], configuration.tolerance );
+        Report( std::string( "FractionalDelayLine " ) + configuration.name + " (ramp)", errors[1], configuration.rampTolerance );
+    }
+
+    /// ApplyDelay : a Hann-windowed burst, delayed by a fractional number of samples
+    {
+        const std::size_t kLength   = 200;
+        const double kDelay         = 12.37;
+        const double omega          = 2.0 * kPi * 0.05;
+
+        const auto burst = [ & ](const double t)
+        {
+            if( t <= 0.0 || t >= kLength )
+            {
+                return 0.0;
+            }
+
+            const double window = 0.5 - 0.5 * std::cos( 2.0 * kPi * t / kLength );
+
+            return window * std::sin( omega * t );
+        };
+
+        std::vector< double > input( kLength );
+        for( std::size_t n = 0; n < kLength; n++ )
+        {
+            input[n] = burst( static_cast< double >( n ) );
+        }
+
+        const std::size_t outputLength = FDL::GetDelayedLength( kLength, kDelay );
+
+        std::vector< double > output( outputLength );
+        FDL::ApplyDelay( &output[0], outputLength, &input[0], kLength, kDelay );
+
+        double error = 0.0;
+        for( std::size_t n = 0; n < outputLength; n++ )
+        {
+            error = std::max( error, std::fabs( output[n] - burst( static_cast< double >( n ) - kDelay ) ) );
+        }
+
+        Report( "FractionalDelayLine::ApplyDelay (windowed sinc 16)", error, 1e-4 );
+
+        /// an integer delay is a plain shift
+        std::vector< double > shifted( FDL::GetDelayedLength( kLength, 5.0 ) );
+        FDL::ApplyDelay( &shifted[0], shifted.size(), &input[0], kLength, 5.0 );
+
+        std::vector< double > reference( 5, 0.0 );
+        reference.insert( reference.end(), input.begin(), input.end() );
+
+        Report( "FractionalDelayLine::ApplyDelay (integer delay)",
+                ( shifted.size() == reference.size() ) ? MaxError( &shifted[0], &reference[0], reference.size() ) : 1.0, 0.0 );
+    }
+
+    /// integer delays are plain shifts with every interpolator, also off-center
+    {
+        const FDL::Interpolation interpolations[3] = { FDL::kLagrange, FDL::kThiran, FDL::kWindowedSinc };
+        const unsigned int orders[3]               = { 3, 3, 16 };
+
+        /// Thiran : integer delays above its order - 1 only
+        const float delays[3][2]                   = { { 3.0f, 21.0f }, { 21.0f, 26.0f }, { 3.0f, 21.0f } };
+
+        const unsigned int kLength = 64;
+
+        std::vector< float > input;
+        Noise( input, kLength, 6 );
+
+        double error = 0.0;
+
+        for( int i = 0; i < 3; i++ )
+        {
+            FDL delayLine( 2, 40.0, kLength, interpolations[i], orders[i] );
+
+            std::vector< float > outputs[2];
+            outputs[0].resize( kLength );
+            outputs[1].resize( kLength );
+
+            const float *inputs[2]  = { &input[0], &input[0] };
+            float *const output[2]  = { &outputs[0][0], &outputs[1][0] };
+
+            const float *channelDelays = delays[i];
+
+            delayLine.Process( output, inputs, kLength, channelDelays );
+
+            for( unsigned int c = 0; c < 2; c++ )
+            {
+                const unsigned int shift = static_cast< unsigned int >( channelDelays[c] );
+
+                for( unsigned int n = 0; n < kLength; n++ )
+                {
+                    const float expected = ( n >= shift ) ? input[ n - shift ] : 0.0f;
+
+                    error = std::max( error, static_cast< double >( std::fabs( outputs[c][n] - expected ) ) );
+                }
+            }
+        }
+
+        Report( "FractionalDelayLine integer delays (all interpolators)", error, 1e-6 );
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          SampleRateConverter : conversion of band-limited bursts to other
+ *                  sampling rates, vs the analytic bursts sampled at the new rates
+ *
+ */
+/************************************************************************************/
+static void TestSampleRateConverter()
+{
+    const double kSamplingRate  = 48000.0;
+    const std::size_t M         = 2;
+    const std::size_t N         = 256;
+    const double kLength        = 200.0;        ///< of the bursts, in samples at 48 kHz
+
+    /// Hann-windowed sinusoids, well below the lowest Nyquist frequency (4 to 7 kHz)
+    const auto burst = [ & ](const std::size_t filter,
+                             const double t)
+    {
+        if( t <= 0.0 || t >= kLength )
+        {
+            return 0.0;
+        }
+
+        const double frequency = ( 4000.0 + 1000.0 * filter ) / kSamplingRate;
+        const double window    = 0.5 - 0.5 * std::cos( 2.0 * kPi * t / kLength );
+
+        return window * std::sin( 2.0 * kPi * frequency * t );
+    };
+
+    std::vector< double > positions = { 0.0, 0.0, 1.2, 90.0, 0.0, 1.2 };
+
+    std::vector< double > ir( M * 2 * N );
+    for( std::size_t i = 0; i < M * 2; i++ )
+    {
+        for( std::size_t n = 0; n < N; n++ )
+        {
+            ir[ i * N + n ] = burst( i, static_cast< double >( n ) );
+        }
+    }
+
+    const std::vector< double > delay = { 1.5, 2.5, 3.5, 4.5 };
+
+    WriteSimpleFreeFieldHRIR( kTemporaryFile, positions, ir, delay, kSamplingRate );
+
+    sofa::FIRDataSet dataSet;
+    {
+        const sofa::SimpleFreeFieldHRIR file( kTemporaryFile );
+        dataSet.Load( file );
+    }
+
+    std::remove( kTemporaryFile.c_str() );
+
+    /// integer rates (exact polyphase kernel), and a non-integer rate (output times rounded)
+    const double targets[]      = { 44100.0, 96000.0, 32000.0, 37800.5 };
+    const double tolerances[]   = { 1e-4, 1e-4, 1e-4, 5e-4 };
+
+    for( std::size_t i = 0; i < sizeof( targets ) / sizeof( double ); i++ )
+    {
+        const double ratio = targets[i] / kSamplingRate;
+
+        std::ostringstream name;
+        name << "SampleRateConverter to " << targets[i] << " Hz";
+
+        sofa::SampleRateConverter converter;
+
+        if( converter.Compute( dataSet, targets[i] ) == false )
+        {
+            Report( name.str(), 1.0, 0.0 );
+            continue;
+        }
+
+        double error      = 0.0;
+        double delayError = 0.0;
+
+        for( std::size_t m = 0; m < M; m++ )
+        {
+            for( std::size_t r = 0; r < 2; r++ )
+            {
+                const double *y = converter.GetIR( m, r );
+
+                /// the IRs are scaled by the inverse ratio (same frequency response)
+                for( std::size_t n = 0; n < converter.GetNumDataSamples(); n++ )
+                {
+                    const double expected = burst( m * 2 + r, static_cast< double >( n ) / ratio ) / ratio;
+
+                    error = std::max( error, std::fabs( y[n] - expected ) * ratio );
+                }
+
+                delayError = std::max( delayError, std::fabs( converter.GetDelay( m, r ) - delay[ m * 2 + r ] * ratio ) );
+            }
+        }
+
+        Report( name.str(), error, tolerances[i] );
+        Report( name.str() + " (Data.Delay)", delayError, 1e-12 );
+    }
+
+    sofa::SampleRateConverter::ClearCache();
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Impulse response of a cascade of second-order sections (direct form I)
+ *  @param[in]      sections : [ Q 6 ] ( b0 b1 b2 a0 a1 a2 )
+ *
+ */
+/************************************************************************************/
+static void SectionsImpulseResponse(std::vector< double > &output,
+                                    const double *sections,
+                                    const unsigned int numSections,
+                                    const std::size_t length)
+{
+    output.assign( length, 0.0 );
+    output[0] = 1.0;
+
+    for( unsigned int q = 0; q < numSections; q++ )
+    {
+        const double *c = sections + 6 * q;
+
+        double x1 = 0.0, x2 = 0.0;
+        double y1 = 0.0, y2 = 0.0;
+
+        for( std::size_t n = 0; n < length; n++ )
+        {
+            const double x = output[n];
+            const double y = ( c[0] * x + c[1] * x1 + c[2] * x2 - c[4] * y1 - c[5] * y2 ) / c[3];
+
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = y;
+
+            output[n] = y;
+        }
+    }
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          SOSConverter : fit of IRs generated by known minimum-phase sections,
+ *                  and rendering of the fitted sections vs a direct-form reference
+ *
+ */
+/************************************************************************************/
+static void TestSOSConverter()
+{
+    const unsigned int Q        = 3;
+    const std::size_t M         = 2;
+    const std::size_t N         = 256;
+
+    /// IRs of Q sections per measurement and receiver, poles and zeros inside the unit circle
+    std::vector< double > ir( M * 2 * N );
+
+    for( std::size_t i = 0; i < M * 2; i++ )
+    {
+        std::vector< double > sections( 6 * Q );
+
+        for( unsigned int q = 0; q < Q; q++ )
+        {
+            const double poleRadius = 0.75 + 0.05 * q;
+            const double poleAngle  = 0.2 + 0.7 * q + 0.1 * i;
+            const double zeroRadius = 0.5 + 0.1 * q;
+            const double zeroAngle  = 0.6 + 0.8 * q;
+
+            double *c = &sections[ 6 * q ];
+
+            c[0] = 1.0;
+            c[1] = -2.0 * zeroRadius * std::cos( zeroAngle );
+            c[2] = zeroRadius * zeroRadius;
+            c[3] = 1.0;
+            c[4] = -2.0 * poleRadius * std::cos( poleAngle );
+            c[5] = poleRadius * poleRadius;
+        }
+
+        std::vector< double > h;
+        SectionsImpulseResponse( h, &sections[0], Q, N );
+
+        std::copy( h.begin(), h.end(), ir.begin() + i * N );
+    }
+
+    const std::vector< double > positions   = { 0.0, 0.0, 1.2, 90.0, 0.0, 1.2 };
+    const std::vector< double > delay       = { 0.0, 0.0 };
+
+    WriteSimpleFreeFieldHRIR( kTemporaryFile, positions, ir, delay, 48000.0 );
+
+    const std::string sosFile = "sofatests_sos.sofa";
+
+    sofa::FIRDataSet dataSet;
+    sofa::SOSConverter converter;
+
+    bool fitted  = false;
+    bool written = false;
+    {
+        const sofa::SimpleFreeFieldHRIR file( kTemporaryFile );
+        dataSet.Load( file );
+
+        fitted  = converter.Fit( dataSet, Q );
+        written = ( fitted == true && converter.Write( sosFile, file, dataSet ) == true );
+    }
+
+    std::remove( kTemporaryFile.c_str() );
+
+    if( fitted == false )
+    {
+        Report( "SOSConverter fit", 1.0, 0.0 );
+        return;
+    }
+
+    /// the written SimpleFreeFieldSOS gives back the same sections
+    {
+        bool reloaded = false;
+
+        if( written == true )
+        {
+            const sofa::SimpleFreeFieldSOS file( sosFile );
+
+            sofa::SOSConverter loaded;
+
+            reloaded = ( loaded.Load( file ) == true
+                        && loaded.GetDataSOS().size() == converter.GetDataSOS().size()
+                        && MaxError( &loaded.GetDataSOS()[0], &converter.GetDataSOS()[0], converter.GetDataSOS().size() ) < 1e-12 );
+        }
+
+        std::remove( sosFile.c_str() );
+
+        Report( "SOSConverter write and reload", ( reloaded == true ) ? 0.0 : 1.0, 0.0 );
+    }
+
+    double fitError     = 0.0;
+    double renderError  = 0.0;
+    double delayError   = 0.0;
+
+    for( std::size_t m = 0; m < M; m++ )
+    {
+        for( std::size_t r = 0; r < 2; r++ )
+        {
+            std::vector< double > rendered( N );
+            converter.Render( &rendered[0], m, r, N );
+
+            std::vector< double > reference;
+            SectionsImpulseResponse( reference, converter.GetSections( m, r ), Q, N );
+
+            const double *h = dataSet.GetIR( m, r );
+
+            double peak = 0.0;
+            for( std::size_t n = 0; n < N; n++ )
+            {
+                peak = std::max( peak, std::fabs( h[n] ) );
+            }
+
+            fitError    = std::max( fitError, MaxError( &rendered[0], h, N ) / peak );
+            renderError = std::max( renderError, MaxError( &rendered[0], &reference[0], N ) / peak );
+            delayError  = std::max( delayError, std::fabs( converter.GetDelay( m, r ) ) );
+        }
+    }
+
+    Report( "SOSConverter fit of exact sections (log-spectral dB)", converter.GetMaxSpectralError(), 0.01 );
+    Report( "SOSConverter fit of exact sections (IR)", fitError, 1e-3 );
+    Report( "SOSConverter fit of exact sections (delay)", delayError, 0.01 );
+    Report( "SOSConverter render vs direct form", renderError, 1e-12 );
+}
+
+/************************************************************************************/
+/*!
+ *  @brief          Main entry point
+ *
+ */
+/************************************************************************************/
+int main(int argc, char *argv[])
+{
+    std::ostream & output = std::cout;
+
+    sofa::String::PrintSeparationLine( output );
+    output << sofa::String::PadWith( "test", 56 ) << sofa::String::PadWith( "error", 16 ) << "result" << std::endl;
+    sofa::String::PrintSeparationLine( output );
+
+    TestFFT();
+    TestNonUniformConvolver();
+    TestBinauralConvolver();
+    TestMinimumPhaseDecomposition();
+    TestFIRDataSet();
+    TestHyperslabs();
+    TestMultiSpeakerBRIR();
+    TestMultiRadiusInterpolator();
+    TestSymmetricFIRDataSet();
+    TestDirectFilterBank();
+    TestImpulseResponseTrimmer();
+    TestMultiSourceRenderer();
+    TestBiquadFilterBank();
+    TestMinimumPhaseSpectrum();
+    TestVirtualLoudspeakerRenderer();
+    TestArrayBeamformer();
+    TestAmbisonicEncoder();
+    TestNavigationRenderer();
+    TestFractionalDelayLine();
+    TestSampleRateConverter();
+    TestSOSConverter();
+
+    sofa::String::PrintSeparationLine( output );
+    output << numFailures << " test(s) failed" << std::endl;
+
+    return static_cast< int >( numFailures );
+}